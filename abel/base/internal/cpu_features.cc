@@ -0,0 +1,66 @@
+//
+
+#include <abel/base/internal/cpu_features.h>
+
+#include <cstdint>
+
+#if defined(ABEL_PROCESSOR_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#define ABEL_BASE_USE_X86_CPUID
+#endif
+
+namespace abel {
+
+namespace base_internal {
+
+namespace {
+
+#if defined(ABEL_BASE_USE_X86_CPUID)
+
+void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+  __asm__ volatile("cpuid \n\t"
+                   : "=a"(regs[0]), "=b"(regs[1]), "=c"(regs[2]),
+                     "=d"(regs[3])
+                   : "a"(leaf), "c"(subleaf));
+}
+
+uint64_t xgetbv() {
+  uint32_t lo, hi;
+  __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return (static_cast<uint64_t>(hi) << 32) | lo;
+}
+
+CpuFeatures DetectCpuFeatures() {
+  CpuFeatures features = CpuFeatures();
+  uint32_t regs[4];
+  cpuid(0, 0, regs);
+  const uint32_t max_leaf = regs[0];
+  cpuid(1, 0, regs);
+  features.ssse3 = (regs[2] & (1u << 9)) != 0;
+  features.sse4_1 = (regs[2] & (1u << 19)) != 0;
+  // The OS must save the ymm registers, as reported by XCR0.
+  const bool osxsave = (regs[2] & (1u << 27)) != 0;
+  const bool ymm_saved = osxsave && (xgetbv() & 0x6) == 0x6;
+  if (max_leaf >= 7) {
+    cpuid(7, 0, regs);
+    features.avx2 = ymm_saved && (regs[1] & (1u << 5)) != 0;
+    features.sha = (regs[1] & (1u << 29)) != 0;
+  }
+  return features;
+}
+
+#else
+
+CpuFeatures DetectCpuFeatures() { return CpuFeatures(); }
+
+#endif  // ABEL_BASE_USE_X86_CPUID
+
+}  // namespace
+
+const CpuFeatures& GetCpuFeatures() {
+  static const CpuFeatures features = DetectCpuFeatures();
+  return features;
+}
+
+}  // namespace base_internal
+
+}  // namespace abel
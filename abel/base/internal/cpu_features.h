@@ -0,0 +1,32 @@
+//
+// Runtime detection of the x86 instruction set extensions that abel's SIMD
+// kernels dispatch on.
+
+#ifndef ABEL_BASE_INTERNAL_CPU_FEATURES_H_
+#define ABEL_BASE_INTERNAL_CPU_FEATURES_H_
+
+#include <abel/base/profile.h>
+
+namespace abel {
+
+namespace base_internal {
+
+// The extensions of the running processor, as reported by CPUID. `avx2` also
+// requires the operating system to save the ymm registers. Everything is
+// false on other processors and compilers.
+struct CpuFeatures {
+  bool ssse3;
+  bool sse4_1;
+  bool avx2;
+  bool sha;
+};
+
+// Detects the features on first use and returns the same result afterwards.
+// Thread-safe.
+const CpuFeatures& GetCpuFeatures();
+
+}  // namespace base_internal
+
+}  // namespace abel
+
+#endif  // ABEL_BASE_INTERNAL_CPU_FEATURES_H_
@@ -32,4 +32,23 @@
 #define ABEL_BLOCK_TAIL_CALL_OPTIMIZATION() if (volatile int x = 0) { (void)x; }
 #endif
 
+// ABEL_INTERNAL_CPU_RELAX
+//
+// Tells the processor that the caller is spinning on a contended location,
+// so that it may back off and leave the other hardware thread of the core,
+// and the interconnect, to the thread that owns the location. Use it on the
+// retry path of a spin or compare-and-swap loop.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define ABEL_INTERNAL_CPU_RELAX() __asm__ __volatile__("pause" ::: "memory")
+#elif (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__aarch64__) || defined(__arm__))
+#define ABEL_INTERNAL_CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define ABEL_INTERNAL_CPU_RELAX() _mm_pause()
+#else
+#define ABEL_INTERNAL_CPU_RELAX() do {} while (false)
+#endif
+
 #endif  // ABEL_BASE_OPTIMIZATION_H_
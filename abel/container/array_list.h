@@ -5,8 +5,12 @@
 #ifndef ABEL_CONTAINER_ARRAY_LIST_H_
 #define ABEL_CONTAINER_ARRAY_LIST_H_
 
+#include <abel/meta/type_traits.h>
 #include <memory>
 #include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
 
 namespace abel {
 
@@ -110,8 +114,18 @@ public:
     const T &back () const;
     template<typename... A>
     inline void emplace_back (A &&... args);
+    // Appends the elements of [first, last). Chunks are filled one contiguous
+    // run at a time; when T is trivially copyable and the range is given as
+    // pointers, each run is a single memcpy.
+    template<typename InputIt>
+    void push_back (InputIt first, InputIt last);
     inline T &front () const noexcept;
     inline void pop_front () noexcept;
+    // Moves up to n elements from the front to `out` and returns how many were
+    // popped. When T is trivially copyable and `out` is a pointer, each run
+    // is a single memcpy.
+    template<typename OutputIt>
+    size_t pop_front (size_t n, OutputIt out);
     inline bool empty () const noexcept;
     inline size_t size () const noexcept;
     void clear () noexcept;
@@ -137,6 +151,26 @@ private:
     inline void ensure_room_back ();
     void undo_room_back ();
     static inline size_t mask (size_t idx) noexcept;
+    // True if `It` points at a contiguous sequence of T that may be copied
+    // with memcpy.
+    template<typename It>
+    using is_memcpy_iterator = std::integral_constant<bool,
+        std::is_pointer<It>::value &&
+        std::is_same<typename std::remove_cv<
+            typename std::remove_pointer<It>::type>::type, T>::value &&
+        abel::is_trivially_copy_constructible<T>::value &&
+        abel::is_trivially_destructible<T>::value>;
+    // Appends at most `run` elements to the back chunk, which must have that
+    // much contiguous room.
+    template<typename InputIt>
+    void append_run (size_t run, InputIt &first, InputIt last, std::false_type);
+    template<typename InputIt>
+    void append_run (size_t run, InputIt &first, InputIt last, std::true_type);
+    // Moves `run` contiguous elements out of the front chunk.
+    template<typename OutputIt>
+    void remove_run (size_t run, OutputIt &out, std::false_type);
+    template<typename OutputIt>
+    void remove_run (size_t run, OutputIt &out, std::true_type);
 
 };
 
@@ -486,6 +520,86 @@ array_list<T, items_per_chunk>::pop_front () noexcept {
     }
 }
 
+template<typename T, size_t items_per_chunk>
+template<typename InputIt>
+void
+array_list<T, items_per_chunk>::append_run (size_t run, InputIt &first, InputIt last, std::false_type) {
+    for (; run != 0 && first != last; --run, ++first) {
+        auto p = &_back_chunk->items[mask(_back_chunk->end)].data;
+        try {
+            new(p) T(*first);
+        } catch (...) {
+            undo_room_back();
+            throw;
+        }
+        ++_back_chunk->end;
+    }
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename InputIt>
+void
+array_list<T, items_per_chunk>::append_run (size_t run, InputIt &first, InputIt last, std::true_type) {
+    static_assert(sizeof(maybe_item) == sizeof(T), "items must be contiguous");
+    size_t n = std::min<size_t>(run, last - first);
+    std::memcpy(&_back_chunk->items[mask(_back_chunk->end)].data, first, n * sizeof(T));
+    _back_chunk->end += n;
+    first += n;
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename InputIt>
+void
+array_list<T, items_per_chunk>::push_back (InputIt first, InputIt last) {
+    while (first != last) {
+        ensure_room_back();
+        // The items of a chunk are a ring, so its free space may be split in
+        // two runs.
+        size_t room = items_per_chunk - (_back_chunk->end - _back_chunk->begin);
+        size_t run = std::min(room, items_per_chunk - mask(_back_chunk->end));
+        append_run(run, first, last, is_memcpy_iterator<InputIt>());
+    }
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename OutputIt>
+void
+array_list<T, items_per_chunk>::remove_run (size_t run, OutputIt &out, std::false_type) {
+    for (; run != 0; --run, ++out) {
+        T &item = front();
+        *out = std::move(item);
+        item.~T();
+        ++_front_chunk->begin;
+    }
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename OutputIt>
+void
+array_list<T, items_per_chunk>::remove_run (size_t run, OutputIt &out, std::true_type) {
+    std::memcpy(out, &front(), run * sizeof(T));
+    _front_chunk->begin += run;
+    out += run;
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename OutputIt>
+size_t
+array_list<T, items_per_chunk>::pop_front (size_t n, OutputIt out) {
+    size_t done = 0;
+    while (done != n && _front_chunk != nullptr) {
+        size_t avail = _front_chunk->end - _front_chunk->begin;
+        size_t run = std::min(std::min(avail, n - done),
+                              items_per_chunk - mask(_front_chunk->begin));
+        remove_run(run, out, is_memcpy_iterator<OutputIt>());
+        done += run;
+        if (_front_chunk->begin == _front_chunk->end) {
+            front_chunk_delete();
+        }
+    }
+    return done;
+}
+
 template<typename T, size_t items_per_chunk>
 void array_list<T, items_per_chunk>::reserve (size_t n) {
     // reserve() guarantees that (n - size()) additional push()es will
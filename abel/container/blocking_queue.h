@@ -0,0 +1,256 @@
+//
+
+#ifndef ABEL_CONTAINER_BLOCKING_QUEUE_H_
+#define ABEL_CONTAINER_BLOCKING_QUEUE_H_
+
+#include <abel/base/profile.h>
+#include <abel/chrono/clock.h>
+#include <abel/chrono/time.h>
+#include <abel/synchronization/internal/kernel_timeout.h>
+#include <abel/synchronization/internal/parking_lot.h>
+#include <abel/types/optional.h>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace abel {
+
+// blocking_queue
+//
+// Adds waiting push() and pop() to a bounded lock-free queue, spsc_queue<T>
+// or mpmc_queue<T>. A blocked call first retries `spin_count` times, which is
+// enough to ride out the short gaps of a busy queue, and only then parks the
+// thread on its PerThreadSem until the other side makes progress. Successful
+// operations wake a parked thread only when there is one, so the fast path
+// costs one fence over the underlying queue.
+//
+// The threading rules of `Queue` still apply: wrapping an spsc_queue does not
+// make it safe for several producers.
+template<typename Queue>
+class blocking_queue {
+public:
+    using queue_type = Queue;
+    using value_type = typename Queue::value_type;
+    using size_type = size_t;
+
+    static constexpr int kDefaultSpinCount = 128;
+public:
+    explicit blocking_queue (size_t capacity,
+                             int spin_count = kDefaultSpinCount)
+        : _queue(capacity), _spin_count(spin_count) { }
+    blocking_queue (const blocking_queue &) = delete;
+    blocking_queue &operator = (const blocking_queue &) = delete;
+
+    // Waits until there is room.
+    void push (const value_type &data);
+    void push (value_type &&data);
+    template<typename... A>
+    void emplace (A &&... args);
+    // Waits until all `n` elements have been pushed.
+    template<typename ForwardIt>
+    void push_n (ForwardIt first, size_t n);
+
+    // Waits until there is an element. The second form move-constructs the
+    // result from the queue's slot, so value_type need not be
+    // default-constructible or assignable.
+    void pop (value_type &out);
+    value_type pop ();
+    // Waits until at least one element is available, then pops up to `n`.
+    // Returns the number popped.
+    template<typename OutputIt>
+    size_t pop_n (OutputIt out, size_t n);
+    // Waits until there is an element or `deadline` passes. Returns false on
+    // timeout.
+    bool pop_until (value_type &out, abel::abel_time deadline);
+    bool pop_for (value_type &out, abel::duration timeout) {
+        return pop_until(out, abel::now() + timeout);
+    }
+
+    // Non-blocking; they still wake the other side on success.
+    bool try_push (const value_type &data);
+    bool try_push (value_type &&data);
+    bool try_pop (value_type &out);
+
+    size_t size () const { return _queue.size(); }
+    bool empty () const { return _queue.empty(); }
+    size_t capacity () const { return _queue.capacity(); }
+private:
+    // Retries `op` until it succeeds, spinning first and then parking on
+    // `lot`. Returns false if `t` expires.
+    template<typename Op>
+    bool wait_for (synchronization_internal::ParkingLot &lot, Op op,
+                   synchronization_internal::KernelTimeout t =
+                       synchronization_internal::KernelTimeout::Never());
+
+    Queue _queue;
+    const int _spin_count;
+    synchronization_internal::ParkingLot _not_empty;
+    synchronization_internal::ParkingLot _not_full;
+};
+
+template<typename Queue>
+constexpr int blocking_queue<Queue>::kDefaultSpinCount;
+
+template<typename Queue>
+template<typename Op>
+inline
+bool
+blocking_queue<Queue>::wait_for (synchronization_internal::ParkingLot &lot,
+                                 Op op,
+                                 synchronization_internal::KernelTimeout t) {
+    for (int i = 0; i < _spin_count; ++i) {
+        if (op()) {
+            return true;
+        }
+        ABEL_INTERNAL_CPU_RELAX();
+    }
+    return lot.WaitUntil(op, t);
+}
+
+template<typename Queue>
+ABEL_FORCE_INLINE
+void
+blocking_queue<Queue>::push (const value_type &data) {
+    if (!_queue.try_push(data)) {
+        wait_for(_not_full, [&] { return _queue.try_push(data); });
+    }
+    _not_empty.NotifyOne();
+}
+
+template<typename Queue>
+ABEL_FORCE_INLINE
+void
+blocking_queue<Queue>::push (value_type &&data) {
+    // A failed try_push() leaves `data` untouched, so it may be retried.
+    if (!_queue.try_push(std::move(data))) {
+        wait_for(_not_full, [&] { return _queue.try_push(std::move(data)); });
+    }
+    _not_empty.NotifyOne();
+}
+
+template<typename Queue>
+template<typename... A>
+inline
+void
+blocking_queue<Queue>::emplace (A &&... args) {
+    push(value_type(std::forward<A>(args)...));
+}
+
+template<typename Queue>
+template<typename ForwardIt>
+inline
+void
+blocking_queue<Queue>::push_n (ForwardIt first, size_t n) {
+    while (n > 0) {
+        size_t pushed = _queue.try_push_n(first, n);
+        if (pushed == 0) {
+            wait_for(_not_full, [&] {
+                pushed = _queue.try_push_n(first, n);
+                return pushed != 0;
+            });
+        }
+        std::advance(first, pushed);
+        n -= pushed;
+        if (pushed == 1) {
+            _not_empty.NotifyOne();
+        } else {
+            _not_empty.NotifyAll();
+        }
+    }
+}
+
+template<typename Queue>
+ABEL_FORCE_INLINE
+void
+blocking_queue<Queue>::pop (value_type &out) {
+    if (!_queue.try_pop(out)) {
+        wait_for(_not_empty, [&] { return _queue.try_pop(out); });
+    }
+    _not_full.NotifyOne();
+}
+
+template<typename Queue>
+ABEL_FORCE_INLINE
+typename blocking_queue<Queue>::value_type
+blocking_queue<Queue>::pop () {
+    abel::optional<value_type> out;
+    auto consume = [&out] (value_type &&v) { out.emplace(std::move(v)); };
+    if (!_queue.try_consume(consume)) {
+        wait_for(_not_empty, [&] { return _queue.try_consume(consume); });
+    }
+    _not_full.NotifyOne();
+    return std::move(*out);
+}
+
+template<typename Queue>
+template<typename OutputIt>
+inline
+size_t
+blocking_queue<Queue>::pop_n (OutputIt out, size_t n) {
+    if (n == 0) {
+        return 0;
+    }
+    size_t popped = _queue.try_pop_n(out, n);
+    if (popped == 0) {
+        wait_for(_not_empty, [&] {
+            popped = _queue.try_pop_n(out, n);
+            return popped != 0;
+        });
+    }
+    if (popped == 1) {
+        _not_full.NotifyOne();
+    } else {
+        _not_full.NotifyAll();
+    }
+    return popped;
+}
+
+template<typename Queue>
+inline
+bool
+blocking_queue<Queue>::pop_until (value_type &out, abel::abel_time deadline) {
+    if (!_queue.try_pop(out) &&
+        !wait_for(_not_empty, [&] { return _queue.try_pop(out); },
+                  synchronization_internal::KernelTimeout(deadline))) {
+        return false;
+    }
+    _not_full.NotifyOne();
+    return true;
+}
+
+template<typename Queue>
+ABEL_FORCE_INLINE
+bool
+blocking_queue<Queue>::try_push (const value_type &data) {
+    if (!_queue.try_push(data)) {
+        return false;
+    }
+    _not_empty.NotifyOne();
+    return true;
+}
+
+template<typename Queue>
+ABEL_FORCE_INLINE
+bool
+blocking_queue<Queue>::try_push (value_type &&data) {
+    if (!_queue.try_push(std::move(data))) {
+        return false;
+    }
+    _not_empty.NotifyOne();
+    return true;
+}
+
+template<typename Queue>
+ABEL_FORCE_INLINE
+bool
+blocking_queue<Queue>::try_pop (value_type &out) {
+    if (!_queue.try_pop(out)) {
+        return false;
+    }
+    _not_full.NotifyOne();
+    return true;
+}
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_BLOCKING_QUEUE_H_
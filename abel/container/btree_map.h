@@ -213,6 +213,29 @@ class btree_map
   //   Inserts the elements within the initializer list `ilist`.
   using Base::insert;
 
+  // btree_map::insert_sorted_range()
+  //
+  // Inserts a range of values [`first`, `last`) that is sorted by
+  // `key_comp()`. When the range is large compared to the `btree_map`, the
+  // container is rebuilt from a single linear merge of both sequences instead
+  // of inserting one value at a time. Unsorted ranges are still inserted
+  // correctly, but without the linear-time path.
+  using Base::insert_sorted_range;
+
+  // btree_map::bulk_load()
+  //
+  // void bulk_load(InputIterator first, InputIterator last,
+  //                double fill_factor = 1.0):
+  //
+  // Replaces the contents of the `btree_map` with the values in [`first`,
+  // `last`). If the range is a sorted forward range, the B-tree is built
+  // bottom-up in linear time, with each node filled to `fill_factor` of its
+  // capacity (but no less than half full); lower fill factors leave room for
+  // later insertions without splitting nodes. Otherwise the values are
+  // inserted one at a time. Only the first of a run of equivalent values is
+  // kept.
+  using Base::bulk_load;
+
   // btree_map::emplace()
   //
   // Inserts an element of the specified value by constructing it in-place
@@ -299,6 +322,10 @@ class btree_map
   // Extracts elements from a given `source` btree_map into this
   // `btree_map`. If the destination `btree_map` already contains an
   // element with an equivalent key, that element is not extracted.
+  //
+  // If `source` is ordered consistently with this `btree_map` and is not much
+  // smaller, both containers are walked once and this `btree_map` is rebuilt
+  // bottom-up, which takes linear time.
   using Base::merge;
 
   // btree_map::swap(btree_map& other)
@@ -582,6 +609,28 @@ class btree_multimap
   //   Inserts the elements within the initializer list `ilist`.
   using Base::insert;
 
+  // btree_multimap::insert_sorted_range()
+  //
+  // Inserts a range of values [`first`, `last`) that is sorted by
+  // `key_comp()`. When the range is large compared to the `btree_multimap`,
+  // the container is rebuilt from a single linear merge of both sequences
+  // instead of inserting one value at a time. Unsorted ranges are still
+  // inserted correctly, but without the linear-time path.
+  using Base::insert_sorted_range;
+
+  // btree_multimap::bulk_load()
+  //
+  // void bulk_load(InputIterator first, InputIterator last,
+  //                double fill_factor = 1.0):
+  //
+  // Replaces the contents of the `btree_multimap` with the values in
+  // [`first`, `last`). If the range is a sorted forward range, the B-tree is
+  // built bottom-up in linear time, with each node filled to `fill_factor` of
+  // its capacity (but no less than half full); lower fill factors leave room
+  // for later insertions without splitting nodes. Otherwise the values are
+  // inserted one at a time.
+  using Base::bulk_load;
+
   // btree_multimap::emplace()
   //
   // Inserts an element of the specified value by constructing it in-place
@@ -626,6 +675,10 @@ class btree_multimap
   // Extracts elements from a given `source` btree_multimap into this
   // `btree_multimap`. If the destination `btree_multimap` already contains an
   // element with an equivalent key, that element is not extracted.
+  //
+  // If `source` is ordered consistently with this `btree_multimap` and is not
+  // much smaller, both containers are walked once and this `btree_multimap` is
+  // rebuilt bottom-up, which takes linear time.
   using Base::merge;
 
   // btree_multimap::swap(btree_multimap& other)
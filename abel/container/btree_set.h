@@ -211,6 +211,29 @@ class btree_set
   //   Inserts the elements within the initializer list `ilist`.
   using Base::insert;
 
+  // btree_set::insert_sorted_range()
+  //
+  // Inserts a range of values [`first`, `last`) that is sorted by
+  // `key_comp()`. When the range is large compared to the `btree_set`, the
+  // container is rebuilt from a single linear merge of both sequences instead
+  // of inserting one value at a time. Unsorted ranges are still inserted
+  // correctly, but without the linear-time path.
+  using Base::insert_sorted_range;
+
+  // btree_set::bulk_load()
+  //
+  // void bulk_load(InputIterator first, InputIterator last,
+  //                double fill_factor = 1.0):
+  //
+  // Replaces the contents of the `btree_set` with the values in [`first`,
+  // `last`). If the range is a sorted forward range, the B-tree is built
+  // bottom-up in linear time, with each node filled to `fill_factor` of its
+  // capacity (but no less than half full); lower fill factors leave room for
+  // later insertions without splitting nodes. Otherwise the values are
+  // inserted one at a time. Only the first of a run of equivalent values is
+  // kept.
+  using Base::bulk_load;
+
   // btree_set::emplace()
   //
   // Inserts an element of the specified value by constructing it in-place
@@ -268,6 +291,10 @@ class btree_set
   // Extracts elements from a given `source` btree_set into this
   // `btree_set`. If the destination `btree_set` already contains an
   // element with an equivalent key, that element is not extracted.
+  //
+  // If `source` is ordered consistently with this `btree_set` and is not much
+  // smaller, both containers are walked once and this `btree_set` is rebuilt
+  // bottom-up, which takes linear time.
   using Base::merge;
 
   // btree_set::swap(btree_set& other)
@@ -528,6 +555,28 @@ class btree_multiset
   //   Inserts the elements within the initializer list `ilist`.
   using Base::insert;
 
+  // btree_multiset::insert_sorted_range()
+  //
+  // Inserts a range of values [`first`, `last`) that is sorted by
+  // `key_comp()`. When the range is large compared to the `btree_multiset`,
+  // the container is rebuilt from a single linear merge of both sequences
+  // instead of inserting one value at a time. Unsorted ranges are still
+  // inserted correctly, but without the linear-time path.
+  using Base::insert_sorted_range;
+
+  // btree_multiset::bulk_load()
+  //
+  // void bulk_load(InputIterator first, InputIterator last,
+  //                double fill_factor = 1.0):
+  //
+  // Replaces the contents of the `btree_multiset` with the values in
+  // [`first`, `last`). If the range is a sorted forward range, the B-tree is
+  // built bottom-up in linear time, with each node filled to `fill_factor` of
+  // its capacity (but no less than half full); lower fill factors leave room
+  // for later insertions without splitting nodes. Otherwise the values are
+  // inserted one at a time.
+  using Base::bulk_load;
+
   // btree_multiset::emplace()
   //
   // Inserts an element of the specified value by constructing it in-place
@@ -572,6 +621,10 @@ class btree_multiset
   // Extracts elements from a given `source` btree_multiset into this
   // `btree_multiset`. If the destination `btree_multiset` already contains an
   // element with an equivalent key, that element is not extracted.
+  //
+  // If `source` is ordered consistently with this `btree_multiset` and is not
+  // much smaller, both containers are walked once and this `btree_multiset` is
+  // rebuilt bottom-up, which takes linear time.
   using Base::merge;
 
   // btree_multiset::swap(btree_multiset& other)
@@ -8,11 +8,34 @@
 #include <abel/base/profile.h>
 #include <abel/base/math.h>
 #include <abel/memory/transfer.h>
+#include <abel/meta/type_traits.h>
+#include <abel/types/span.h>
 #include <memory>
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
 
 namespace abel {
 
+// A growable ring of T with a power-of-two capacity.
+//
+// Besides element-at-a-time access, the buffer hands out its contents and
+// its free space as up to two contiguous spans each, so that a byte buffer
+// can be filled by read()/readv() and drained by write()/writev() in place:
+//
+//   abel::circular_buffer<char> buf;
+//   auto free = buf.writable_spans(4096);
+//   iovec in[2] = {{free[0].data(), free[0].size()},
+//                  {free[1].data(), free[1].size()}};
+//   ssize_t n = ::readv(fd, in, 2);
+//   if (n > 0) buf.commit(n);
+//   ...
+//   auto data = buf.readable_spans();
+//   iovec out[2] = {{data[0].data(), data[0].size()},
+//                   {data[1].data(), data[1].size()}};
+//   n = ::writev(fd, out, 2);
+//   if (n > 0) buf.consume(n);
 template <typename T, typename Alloc = std::allocator<T>>
 class circular_buffer {
     struct impl : Alloc {
@@ -30,6 +53,10 @@ public:
     using pointer = T*;
     using const_reference = const T&;
     using const_pointer = const T*;
+    // Up to two contiguous runs; the second is empty unless the run wraps
+    // around the end of the storage.
+    using spans = std::array<Span<T>, 2>;
+    using const_spans = std::array<Span<const T>, 2>;
 public:
     circular_buffer() = default;
     circular_buffer(circular_buffer&& X) noexcept;
@@ -56,6 +83,20 @@ public:
     size_t capacity() const;
     void reserve(size_t);
     void clear();
+    // Appends copies of all elements of `data`.
+    void push_back(Span<const T> data);
+    // The elements, front to back.
+    spans readable_spans();
+    const_spans readable_spans() const;
+    // Destroys the first n elements; n must not exceed size().
+    void consume(size_t n);
+    // The free slots after the back, growing the buffer first if there are
+    // fewer than `min_size`. Only available for trivial types, since the
+    // slots hold no objects until commit().
+    spans writable_spans(size_t min_size = 0);
+    // Appends the first n slots returned by writable_spans(), which the
+    // caller has filled.
+    void commit(size_t n);
     T& operator[](size_t idx);
     const T& operator[](size_t idx) const;
     template <typename Func>
@@ -64,10 +105,17 @@ public:
     // only useful if you do not rely on data accuracy (e.g. prefetch)
     T& access_element_unsafe(size_t idx);
 private:
+    // True if elements may be moved between slots with memcpy().
+    using relocate_ok = std::integral_constant<bool,
+        std::is_same<Alloc, std::allocator<T>>::value &&
+        is_trivially_relocatable<T>::value>;
+
     void expand();
     void expand(size_t);
     void maybe_expand(size_t nr = 1);
     size_t mask(size_t idx) const;
+    static void relocate(T* to, const T* from, size_t n);
+    spans free_spans();
 
     template<typename CB, typename ValueType>
     struct cbiterator : std::iterator<std::random_access_iterator_tag, ValueType> {
@@ -210,6 +258,89 @@ circular_buffer<T, Alloc>::clear() {
     erase(begin(), end());
 }
 
+template <typename T, typename Alloc>
+void
+circular_buffer<T, Alloc>::push_back(Span<const T> data) {
+    reserve(size() + data.size());
+    if (type_traits_internal::is_trivially_copyable<T>::value &&
+        std::is_same<Alloc, std::allocator<T>>::value) {
+        spans free = free_spans();
+        size_t run = std::min(data.size(), free[0].size());
+        relocate(free[0].data(), data.data(), run);
+        relocate(free[1].data(), data.data() + run, data.size() - run);
+        _impl.end += data.size();
+    } else {
+        for (const T& v : data) {
+            push_back(v);
+        }
+    }
+}
+
+template <typename T, typename Alloc>
+ABEL_FORCE_INLINE
+typename circular_buffer<T, Alloc>::spans
+circular_buffer<T, Alloc>::readable_spans() {
+    size_t n = size();
+    size_t first = mask(_impl.begin);
+    size_t run = std::min(n, _impl.capacity - first);
+    return spans{{Span<T>(_impl.storage + first, run), Span<T>(_impl.storage, n - run)}};
+}
+
+template <typename T, typename Alloc>
+ABEL_FORCE_INLINE
+typename circular_buffer<T, Alloc>::const_spans
+circular_buffer<T, Alloc>::readable_spans() const {
+    size_t n = size();
+    size_t first = mask(_impl.begin);
+    size_t run = std::min(n, _impl.capacity - first);
+    return const_spans{{Span<const T>(_impl.storage + first, run),
+                        Span<const T>(_impl.storage, n - run)}};
+}
+
+template <typename T, typename Alloc>
+ABEL_FORCE_INLINE
+void
+circular_buffer<T, Alloc>::consume(size_t n) {
+    assert(n <= size());
+    if (!is_trivially_destructible<T>::value) {
+        for (size_t i = 0; i != n; ++i) {
+            _impl.destroy(&_impl.storage[mask(_impl.begin + i)]);
+        }
+    }
+    _impl.begin += n;
+}
+
+template <typename T, typename Alloc>
+ABEL_FORCE_INLINE
+typename circular_buffer<T, Alloc>::spans
+circular_buffer<T, Alloc>::writable_spans(size_t min_size) {
+    static_assert(is_trivially_default_constructible<T>::value &&
+                  is_trivially_destructible<T>::value,
+                  "writable_spans() hands out raw slots and needs a trivial type");
+    if (_impl.capacity - size() < min_size) {
+        reserve(size() + min_size);
+    }
+    return free_spans();
+}
+
+template <typename T, typename Alloc>
+ABEL_FORCE_INLINE
+typename circular_buffer<T, Alloc>::spans
+circular_buffer<T, Alloc>::free_spans() {
+    size_t n = _impl.capacity - size();
+    size_t first = mask(_impl.end);
+    size_t run = std::min(n, _impl.capacity - first);
+    return spans{{Span<T>(_impl.storage + first, run), Span<T>(_impl.storage, n - run)}};
+}
+
+template <typename T, typename Alloc>
+ABEL_FORCE_INLINE
+void
+circular_buffer<T, Alloc>::commit(size_t n) {
+    assert(n <= _impl.capacity - size());
+    _impl.end += n;
+}
+
 template <typename T, typename Alloc>
 ABEL_FORCE_INLINE
 circular_buffer<T, Alloc>::circular_buffer(circular_buffer&& x) noexcept
@@ -254,10 +385,33 @@ circular_buffer<T, Alloc>::expand() {
     expand(std::max<size_t>(_impl.capacity * 2, 1));
 }
 
+template <typename T, typename Alloc>
+ABEL_FORCE_INLINE
+void
+circular_buffer<T, Alloc>::relocate(T* to, const T* from, size_t n) {
+    if (n != 0) {
+        std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(T));
+    }
+}
+
 template <typename T, typename Alloc>
 void
 circular_buffer<T, Alloc>::expand(size_t new_cap) {
     auto new_storage = _impl.allocate(new_cap);
+    if (relocate_ok::value) {
+        // The elements form a ring, so they are at most two runs.
+        size_t n = size();
+        size_t first = mask(_impl.begin);
+        size_t run = std::min(n, _impl.capacity - first);
+        relocate(new_storage, _impl.storage + first, run);
+        relocate(new_storage + run, _impl.storage, n - run);
+        std::swap(_impl.storage, new_storage);
+        std::swap(_impl.capacity, new_cap);
+        _impl.begin = 0;
+        _impl.end = n;
+        _impl.deallocate(new_storage, new_cap);
+        return;
+    }
     auto p = new_storage;
     try {
         for_each([this, &p] (T& obj) {
@@ -426,6 +580,28 @@ circular_buffer<T, Alloc>::erase(iterator first, iterator last) {
     if (first == last) {
         return last;
     }
+    if (relocate_ok::value) {
+        // Destroy the erased elements and shift the shorter side over the gap.
+        for (auto i = first; i != last; ++i) {
+            _impl.destroy(&*i);
+        }
+        if (std::distance(begin(), first) < std::distance(last, end())) {
+            auto src = first;
+            auto dst = last;
+            while (src != begin()) {
+                relocate(&*--dst, &*--src, 1);
+            }
+            _impl.begin = dst.idx;
+            return last;
+        } else {
+            auto dst = first;
+            for (auto src = last; src != end(); ++src, ++dst) {
+                relocate(&*dst, &*src, 1);
+            }
+            _impl.end = dst.idx;
+            return first;
+        }
+    }
     // Move to the left or right depending on which would result in least amount of moves.
     // This also guarantees that iterators will be stable when removing from either front or back.
     if (std::distance(begin(), first) < std::distance(last, end())) {
@@ -0,0 +1,307 @@
+//
+
+#ifndef ABEL_CONTAINER_CONCURRENT_CACHE_H_
+#define ABEL_CONTAINER_CONCURRENT_CACHE_H_
+
+#include <abel/base/profile.h>
+#include <abel/container/flat_hash_map.h>
+#include <abel/container/lru_cache.h>
+#include <abel/synchronization/mutex.h>
+#include <abel/types/optional.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace abel {
+
+// concurrent_cache
+//
+// A thread safe lru_cache. Keys are spread over `num_shards` lru_caches by
+// hash, each behind its own mutex, so that threads working on different keys
+// rarely contend. The capacity is split evenly between the shards, and so is
+// the eviction order: an entry is evicted when its own shard is full.
+//
+//   abel::concurrent_cache<std::string, std::shared_ptr<const page>> cache(1 << 20);
+//   auto p = cache.get_or_load(url, [&] { return fetch(url); });
+//
+// Values are returned by copy, as another thread may drop an entry at any
+// time; large values are best held through a shared_ptr.
+//
+// get_or_load() coalesces requests: while one thread runs the loader of a
+// key, others asking for the same key wait for its result instead of
+// loading it again. If the loader throws, the exception goes to the thread
+// that ran it, and one of the waiting threads tries again. Each call counts
+// once in stats(): as a hit, as a miss when it runs the loader, or as
+// coalesced when it takes another thread's result.
+template<typename K, typename V, typename Weigher = cache_unit_weigher,
+         typename Hash = container_internal::hash_default_hash<K>,
+         typename Eq = container_internal::hash_default_eq<K>>
+class concurrent_cache {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using size_type = size_t;
+    using weigher_type = Weigher;
+    using shard_type = lru_cache<K, V, Weigher, Hash, Eq>;
+
+    static constexpr size_t kDefaultShards = 16;
+public:
+    // `num_shards` is rounded up to a power of two.
+    explicit concurrent_cache (size_t capacity, size_t num_shards = kDefaultShards,
+                               abel::duration ttl = abel::infinite_duration(),
+                               const Weigher &weigher = Weigher());
+    concurrent_cache (const concurrent_cache &) = delete;
+    concurrent_cache &operator = (const concurrent_cache &) = delete;
+
+    abel::optional<V> get (const K &key);
+    bool contains (const K &key) const;
+    // See lru_cache::put().
+    bool put (const K &key, V value);
+    // Returns the value of `key`, calling `loader()` and caching its result
+    // on a miss. Concurrent calls for the same key run one loader.
+    template<typename F>
+    V get_or_load (const K &key, F &&loader);
+    bool erase (const K &key);
+    void clear ();
+    size_t purge_expired ();
+
+    // These lock every shard in turn, so they are only a snapshot.
+    size_t size () const;
+    size_t weight () const;
+    cache_stats stats () const;
+    void reset_stats ();
+
+    size_t capacity () const {
+        return _capacity;
+    }
+    size_t num_shards () const {
+        return _shards.size();
+    }
+private:
+    // A load in progress, shared by the loading thread and those waiting
+    // for it.
+    struct load_state {
+        bool done = false;
+        // Set on success when there are waiters.
+        abel::optional<V> value;
+    };
+
+    struct shard {
+        mutable abel::mutex mu;
+        shard_type cache;
+        flat_hash_map<K, std::shared_ptr<load_state>, Hash, Eq> loading;
+        // Signalled when a load finishes.
+        abel::cond_var loaded;
+        // Added to cache.stats().coalesced.
+        uint64_t coalesced = 0;
+
+        shard (size_t capacity, abel::duration ttl, const Weigher &weigher)
+            : cache(capacity, ttl, weigher) { }
+    };
+
+    shard &shard_for (const K &key) const {
+        const uint64_t h = static_cast<uint64_t>(_hash(key)) * 0x9e3779b97f4a7c15ull;
+        return *_shards[static_cast<size_t>(h >> 32) & (_shards.size() - 1)];
+    }
+    // Ends the load of `key` and wakes its waiters.
+    static void finish_load (shard &s, const K &key, load_state &state);
+private:
+    size_t _capacity;
+    Hash _hash;
+    std::vector<std::unique_ptr<shard>> _shards;
+};
+
+template<typename K, typename V, typename W, typename H, typename E>
+constexpr size_t concurrent_cache<K, V, W, H, E>::kDefaultShards;
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+concurrent_cache<K, V, W, H, E>::concurrent_cache (size_t capacity, size_t num_shards,
+                                                   abel::duration ttl, const W &weigher)
+    : _capacity(capacity) {
+    size_t n = 1;
+    while (n < num_shards) {
+        n <<= 1;
+    }
+    _shards.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        // Spread the remainder over the first shards.
+        const size_t cap = capacity / n + (i < capacity % n ? 1 : 0);
+        _shards.emplace_back(new shard(cap, ttl, weigher));
+    }
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+abel::optional<V>
+concurrent_cache<K, V, W, H, E>::get (const K &key) {
+    shard &s = shard_for(key);
+    abel::mutex_lock l(&s.mu);
+    if (V *v = s.cache.get(key)) {
+        return *v;
+    }
+    return abel::nullopt;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+bool
+concurrent_cache<K, V, W, H, E>::contains (const K &key) const {
+    shard &s = shard_for(key);
+    abel::mutex_lock l(&s.mu);
+    return s.cache.contains(key);
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+bool
+concurrent_cache<K, V, W, H, E>::put (const K &key, V value) {
+    shard &s = shard_for(key);
+    abel::mutex_lock l(&s.mu);
+    return s.cache.put(key, std::move(value));
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+template<typename F>
+inline
+V
+concurrent_cache<K, V, W, H, E>::get_or_load (const K &key, F &&loader) {
+    shard &s = shard_for(key);
+    std::shared_ptr<load_state> state;
+    {
+        abel::mutex_lock l(&s.mu);
+        for (;;) {
+            // Join a load in progress before looking the key up, so that
+            // a waiter is not also counted as a miss.
+            auto it = s.loading.find(key);
+            if (it == s.loading.end()) {
+                if (V *v = s.cache.get(key)) {
+                    return *v;
+                }
+                break;
+            }
+            state = it->second;
+            while (!state->done) {
+                s.loaded.wait(&s.mu);
+            }
+            if (state->value) {
+                ++s.coalesced;
+                return *state->value;
+            }
+            // The loader threw; try again.
+            state.reset();
+        }
+        state = std::make_shared<load_state>();
+        s.loading.emplace(key, state);
+    }
+    ABEL_INTERNAL_TRY {
+        V value = loader();
+        abel::mutex_lock l(&s.mu);
+        s.cache.put(key, value);
+        // Waiters hold the other references, all taken under the lock.
+        if (state.use_count() > 2) {
+            state->value = value;
+        }
+        finish_load(s, key, *state);
+        return value;
+    }
+    ABEL_INTERNAL_CATCH_ANY {
+        abel::mutex_lock l(&s.mu);
+        finish_load(s, key, *state);
+        ABEL_INTERNAL_RETHROW;
+    }
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+void
+concurrent_cache<K, V, W, H, E>::finish_load (shard &s, const K &key, load_state &state) {
+    state.done = true;
+    s.loading.erase(key);
+    s.loaded.signal_all();
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+bool
+concurrent_cache<K, V, W, H, E>::erase (const K &key) {
+    shard &s = shard_for(key);
+    abel::mutex_lock l(&s.mu);
+    return s.cache.erase(key);
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+void
+concurrent_cache<K, V, W, H, E>::clear () {
+    for (auto &s : _shards) {
+        abel::mutex_lock l(&s->mu);
+        s->cache.clear();
+    }
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+size_t
+concurrent_cache<K, V, W, H, E>::purge_expired () {
+    size_t n = 0;
+    for (auto &s : _shards) {
+        abel::mutex_lock l(&s->mu);
+        n += s->cache.purge_expired();
+    }
+    return n;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+size_t
+concurrent_cache<K, V, W, H, E>::size () const {
+    size_t n = 0;
+    for (auto &s : _shards) {
+        abel::mutex_lock l(&s->mu);
+        n += s->cache.size();
+    }
+    return n;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+size_t
+concurrent_cache<K, V, W, H, E>::weight () const {
+    size_t n = 0;
+    for (auto &s : _shards) {
+        abel::mutex_lock l(&s->mu);
+        n += s->cache.weight();
+    }
+    return n;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+cache_stats
+concurrent_cache<K, V, W, H, E>::stats () const {
+    cache_stats total;
+    for (auto &s : _shards) {
+        abel::mutex_lock l(&s->mu);
+        total += s->cache.stats();
+        total.coalesced += s->coalesced;
+    }
+    return total;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+void
+concurrent_cache<K, V, W, H, E>::reset_stats () {
+    for (auto &s : _shards) {
+        abel::mutex_lock l(&s->mu);
+        s->cache.reset_stats();
+        s->coalesced = 0;
+    }
+}
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_CONCURRENT_CACHE_H_
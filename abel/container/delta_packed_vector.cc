@@ -0,0 +1,197 @@
+//
+
+#include <abel/container/delta_packed_vector.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace abel {
+
+constexpr size_t delta_packed_vector::kBlockSize;
+constexpr uint32_t delta_packed_vector::kRawBits;
+
+delta_packed_vector::delta_packed_vector (const uint64_t *values, size_t n) {
+    _skips.reserve(n / kBlockSize);
+    _tail.reserve(kBlockSize);
+    for (size_t i = 0; i < n; ++i) {
+        push_back(values[i]);
+    }
+}
+
+void delta_packed_vector::push_back (uint64_t value) {
+    assert(empty() || value >= back());
+    _tail.push_back(value);
+    if (_tail.size() == kBlockSize) {
+        flush_tail();
+    }
+}
+
+void delta_packed_vector::clear () {
+    _data.clear();
+    _skips.clear();
+    _tail.clear();
+}
+
+void delta_packed_vector::flush_tail () {
+    uint32_t deltas[kBlockSize];
+    uint64_t max_delta = 0;
+    deltas[0] = 0;
+    for (size_t i = 1; i < kBlockSize; ++i) {
+        const uint64_t d = _tail[i] - _tail[i - 1];
+        max_delta = std::max(max_delta, d);
+        deltas[i] = static_cast<uint32_t>(d);
+    }
+    skip_entry skip;
+    skip.first = _tail[0];
+    skip.offset = _data.size();
+    if (max_delta >> 32 != 0) {
+        skip.bits = kRawBits;
+        const size_t at = _data.size();
+        _data.resize(at + kBlockSize * 2);
+        memcpy(&_data[at], _tail.data(), kBlockSize * sizeof(uint64_t));
+    } else {
+        const unsigned bits = container_internal::bit_width(max_delta);
+        skip.bits = bits;
+        const size_t at = _data.size();
+        _data.resize(at + container_internal::packed_block_words(bits));
+        container_internal::pack_block(deltas, bits, _data.data() + at);
+    }
+    _skips.push_back(skip);
+    _tail.clear();
+}
+
+size_t delta_packed_vector::decode_block (size_t block, uint64_t *out) const {
+    if (block >= _skips.size()) {
+        std::copy(_tail.begin(), _tail.end(), out);
+        return _tail.size();
+    }
+    const skip_entry &skip = _skips[block];
+    const uint32_t *in = _data.data() + skip.offset;
+    if (skip.bits == kRawBits) {
+        memcpy(out, in, kBlockSize * sizeof(uint64_t));
+        return kBlockSize;
+    }
+    uint32_t deltas[kBlockSize];
+    container_internal::unpack_block(in, static_cast<unsigned>(skip.bits), deltas);
+    uint64_t v = skip.first;
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        v += deltas[i];
+        out[i] = v;
+    }
+    return kBlockSize;
+}
+
+size_t delta_packed_vector::find_block (uint64_t x, size_t from) const {
+    // Binary search over [from, num_blocks()) for the last first value < x.
+    size_t lo = from;
+    size_t hi = num_blocks();
+    while (hi - lo > 1) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (first_of(mid) < x) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+uint64_t delta_packed_vector::operator [] (size_t i) const {
+    uint64_t values[kBlockSize];
+    decode_block(i / kBlockSize, values);
+    return values[i % kBlockSize];
+}
+
+uint64_t delta_packed_vector::back () const {
+    if (!_tail.empty()) {
+        return _tail.back();
+    }
+    return (*this)[size() - 1];
+}
+
+size_t delta_packed_vector::lower_bound (uint64_t x) const {
+    if (empty()) {
+        return 0;
+    }
+    // The first value >= x is in this block, or is the first of the next.
+    const size_t block = find_block(x, 0);
+    uint64_t values[kBlockSize];
+    const size_t len = decode_block(block, values);
+    return block * kBlockSize + (std::lower_bound(values, values + len, x) - values);
+}
+
+bool delta_packed_vector::contains (uint64_t x) const {
+    const size_t i = lower_bound(x);
+    return i < size() && (*this)[i] == x;
+}
+
+void delta_packed_vector::decode (uint64_t *out) const {
+    const size_t blocks = num_blocks();
+    for (size_t b = 0; b < blocks; ++b) {
+        out += decode_block(b, out);
+    }
+}
+
+std::vector<uint64_t> delta_packed_vector::decode () const {
+    std::vector<uint64_t> out(size());
+    decode(out.data());
+    return out;
+}
+
+delta_packed_vector::cursor::cursor (const delta_packed_vector &v) : _vec(&v) {
+    load(0);
+}
+
+void delta_packed_vector::cursor::load (size_t block) {
+    _block = block;
+    _pos = 0;
+    _len = block < _vec->num_blocks() ? _vec->decode_block(block, _values) : 0;
+}
+
+void delta_packed_vector::cursor::skip_to (uint64_t x) {
+    if (!valid() || value() >= x) {
+        return;
+    }
+    if (_values[_len - 1] < x) {
+        const size_t block = _vec->find_block(x, _block + 1);
+        if (block == _vec->num_blocks()) {
+            // Past the last block.
+            load(block);
+            return;
+        }
+        load(block);
+        if (_values[_len - 1] < x) {
+            load(block + 1);
+            return;
+        }
+    }
+    // Targets are often close by; look at a few values before searching.
+    const size_t probe_end = std::min(_pos + 8, _len);
+    while (_pos < probe_end) {
+        if (_values[_pos] >= x) {
+            return;
+        }
+        ++_pos;
+    }
+    _pos = std::lower_bound(_values + _pos, _values + _len, x) - _values;
+}
+
+void intersect (const delta_packed_vector &a, const delta_packed_vector &b,
+                std::vector<uint64_t> *out) {
+    delta_packed_vector::cursor ca(a);
+    delta_packed_vector::cursor cb(b);
+    while (ca.valid() && cb.valid()) {
+        if (ca.value() < cb.value()) {
+            ca.skip_to(cb.value());
+        } else if (cb.value() < ca.value()) {
+            cb.skip_to(ca.value());
+        } else {
+            out->push_back(ca.value());
+            ca.next();
+            cb.next();
+        }
+    }
+}
+
+}  // namespace abel
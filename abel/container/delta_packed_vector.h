@@ -0,0 +1,146 @@
+//
+
+#ifndef ABEL_CONTAINER_DELTA_PACKED_VECTOR_H_
+#define ABEL_CONTAINER_DELTA_PACKED_VECTOR_H_
+
+#include <abel/base/profile.h>
+#include <abel/container/internal/bit_packing.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace abel {
+
+// delta_packed_vector
+//
+// A compressed, append-only sequence of sorted 64-bit integers, such as the
+// document ids of a posting list:
+//
+//   abel::delta_packed_vector ids(sorted.data(), sorted.size());
+//   abel::delta_packed_vector::cursor c(ids);
+//   c.skip_to(1000);  // the first id >= 1000, if c.valid()
+//
+// Values are coded in blocks of 256 as the differences to their
+// predecessors, bit-packed at the width of the largest difference of the
+// block (frame of reference), and unpacked eight at a time with AVX2. A
+// skip entry per block holds its first value and where its data starts, so
+// that lookups and skip_to() binary search the skip entries and decode a
+// single block. The values of the last, incomplete block are kept
+// unpacked until it fills up.
+//
+// A block whose differences do not all fit in 32 bits stores its values
+// unpacked instead.
+class delta_packed_vector {
+public:
+    using value_type = uint64_t;
+    using size_type = size_t;
+
+    static constexpr size_t kBlockSize = container_internal::kPackedBlockSize;
+
+    class cursor;
+public:
+    delta_packed_vector () = default;
+    // `values` must be sorted.
+    delta_packed_vector (const uint64_t *values, size_t n);
+    explicit delta_packed_vector (const std::vector<uint64_t> &values)
+        : delta_packed_vector(values.data(), values.size()) { }
+
+    // `value` must not be less than back().
+    void push_back (uint64_t value);
+    void clear ();
+
+    size_t size () const {
+        return _skips.size() * kBlockSize + _tail.size();
+    }
+    bool empty () const {
+        return size() == 0;
+    }
+    // The bytes taken by the compressed data, the skip entries and the tail.
+    size_t memory_bytes () const {
+        return _data.size() * sizeof(uint32_t) + _skips.size() * sizeof(skip_entry) +
+               _tail.size() * sizeof(uint64_t);
+    }
+
+    // Decodes the block holding `i`; prefer a cursor for scans.
+    uint64_t operator [] (size_t i) const;
+    uint64_t back () const;
+    // The index of the first value >= `x`, or size().
+    size_t lower_bound (uint64_t x) const;
+    bool contains (uint64_t x) const;
+
+    // Decodes all values to `out`, which has room for size().
+    void decode (uint64_t *out) const;
+    std::vector<uint64_t> decode () const;
+private:
+    // A bits value for blocks stored unpacked, as their raw 64-bit values.
+    static constexpr uint32_t kRawBits = 64;
+
+    struct skip_entry {
+        uint64_t first;
+        // Of the block data in _data, in 32-bit words.
+        uint64_t offset : 56;
+        uint64_t bits : 8;
+    };
+
+    size_t num_blocks () const {
+        return _skips.size() + (_tail.empty() ? 0 : 1);
+    }
+    uint64_t first_of (size_t block) const {
+        return block < _skips.size() ? _skips[block].first : _tail.front();
+    }
+    // Decodes block `block` to `out` and returns its length.
+    size_t decode_block (size_t block, uint64_t *out) const;
+    // The last block whose first value is below `x`, or 0.
+    size_t find_block (uint64_t x, size_t from) const;
+    void flush_tail ();
+private:
+    std::vector<uint32_t> _data;
+    std::vector<skip_entry> _skips;
+    std::vector<uint64_t> _tail;
+};
+
+// delta_packed_vector::cursor
+//
+// Walks a delta_packed_vector forward, one decoded block at a time. The
+// vector must not change while a cursor is in use.
+class delta_packed_vector::cursor {
+public:
+    // Starts at the first value.
+    explicit cursor (const delta_packed_vector &v);
+
+    bool valid () const {
+        return _pos < _len;
+    }
+    uint64_t value () const {
+        return _values[_pos];
+    }
+    // The position of value() in the vector.
+    size_t index () const {
+        return _block * kBlockSize + _pos;
+    }
+    void next () {
+        if (++_pos == _len) {
+            load(_block + 1);
+        }
+    }
+    // Moves forward to the first value >= `x`, skipping whole blocks by
+    // their first values. Never moves back.
+    void skip_to (uint64_t x);
+private:
+    void load (size_t block);
+private:
+    const delta_packed_vector *_vec;
+    size_t _block = 0;
+    size_t _pos = 0;
+    size_t _len = 0;
+    uint64_t _values[kBlockSize];
+};
+
+// Appends the values present in both `a` and `b` to `out`, leapfrogging
+// over blocks of either that cannot match.
+void intersect (const delta_packed_vector &a, const delta_packed_vector &b,
+                std::vector<uint64_t> *out);
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_DELTA_PACKED_VECTOR_H_
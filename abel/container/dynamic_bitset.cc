@@ -0,0 +1,274 @@
+//
+
+#include <abel/container/dynamic_bitset.h>
+
+#include <abel/base/math/ctz.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#if ABEL_AVX2
+#include <immintrin.h>
+#endif
+
+namespace abel {
+
+namespace container_internal {
+
+#if ABEL_AVX2
+
+#define ABEL_BITSET_BINARY_OP(name, expr)                                        \
+void name (uint64_t *dst, const uint64_t *src, size_t n) {                     \
+    size_t i = 0;                                                              \
+    for (; i + 4 <= n; i += 4) {                                               \
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i)); \
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i)); \
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), expr);         \
+    }                                                                          \
+    for (; i < n; ++i) {                                                       \
+        const uint64_t a = dst[i];                                             \
+        const uint64_t b = src[i];                                             \
+        dst[i] = name##_word(a, b);                                            \
+    }                                                                          \
+}
+
+namespace {
+
+// Counts the bits of each byte with two table lookups of a nibble each.
+ABEL_FORCE_INLINE __m256i popcount_bytes (__m256i v) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_and_si256(v, low);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(table, lo), _mm256_shuffle_epi8(table, hi));
+}
+
+ABEL_FORCE_INLINE size_t sum_lanes (__m256i v) {
+    return static_cast<size_t>(_mm256_extract_epi64(v, 0) + _mm256_extract_epi64(v, 1) +
+                               _mm256_extract_epi64(v, 2) + _mm256_extract_epi64(v, 3));
+}
+
+}  // namespace
+
+#else
+
+#define ABEL_BITSET_BINARY_OP(name, expr)                                        \
+void name (uint64_t *dst, const uint64_t *src, size_t n) {                     \
+    for (size_t i = 0; i < n; ++i) {                                           \
+        dst[i] = name##_word(dst[i], src[i]);                                  \
+    }                                                                          \
+}
+
+#endif
+
+namespace {
+
+ABEL_FORCE_INLINE uint64_t bitset_and_word (uint64_t a, uint64_t b) {
+    return a & b;
+}
+ABEL_FORCE_INLINE uint64_t bitset_or_word (uint64_t a, uint64_t b) {
+    return a | b;
+}
+ABEL_FORCE_INLINE uint64_t bitset_xor_word (uint64_t a, uint64_t b) {
+    return a ^ b;
+}
+ABEL_FORCE_INLINE uint64_t bitset_and_not_word (uint64_t a, uint64_t b) {
+    return a & ~b;
+}
+
+}  // namespace
+
+ABEL_BITSET_BINARY_OP(bitset_and, _mm256_and_si256(a, b))
+ABEL_BITSET_BINARY_OP(bitset_or, _mm256_or_si256(a, b))
+ABEL_BITSET_BINARY_OP(bitset_xor, _mm256_xor_si256(a, b))
+ABEL_BITSET_BINARY_OP(bitset_and_not, _mm256_andnot_si256(b, a))
+
+#undef ABEL_BITSET_BINARY_OP
+
+size_t bitset_count (const uint64_t *words, size_t n) {
+    size_t total = 0;
+    size_t i = 0;
+#if ABEL_AVX2
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(popcount_bytes(v), zero));
+    }
+    total = sum_lanes(acc);
+#endif
+    for (; i < n; ++i) {
+        total += popcount(words[i]);
+    }
+    return total;
+}
+
+size_t bitset_count_and (const uint64_t *a, const uint64_t *b, size_t n) {
+    size_t total = 0;
+    size_t i = 0;
+#if ABEL_AVX2
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i v = _mm256_and_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(popcount_bytes(v), zero));
+    }
+    total = sum_lanes(acc);
+#endif
+    for (; i < n; ++i) {
+        total += popcount(a[i] & b[i]);
+    }
+    return total;
+}
+
+}  // namespace container_internal
+
+constexpr size_t bitset_view::kWordBits;
+constexpr size_t bitset_view::npos;
+constexpr size_t dynamic_bitset::kWordBits;
+constexpr size_t dynamic_bitset::npos;
+
+bool bitset_view::any () const {
+    const size_t n = num_words();
+    for (size_t i = 0; i < n; ++i) {
+        if (_words[i] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t bitset_view::find_from (size_t pos) const {
+    if (pos >= _size) {
+        return npos;
+    }
+    size_t i = pos / kWordBits;
+    word_type w = _words[i] & (~word_type(0) << (pos % kWordBits));
+    const size_t n = num_words();
+    while (w == 0) {
+        if (++i == n) {
+            return npos;
+        }
+        w = _words[i];
+    }
+    return i * kWordBits + count_trailing_zeros(w);
+}
+
+size_t bitset_view::count_and (bitset_view other) const {
+    assert(other.size() == _size);
+    return container_internal::bitset_count_and(_words, other.data(), num_words());
+}
+
+bool bitset_view::map (const void *data, size_t size, bitset_view *out) {
+    if (size < 2 * sizeof(word_type) || reinterpret_cast<uintptr_t>(data) % alignof(word_type) != 0) {
+        return false;
+    }
+    const word_type *header = static_cast<const word_type *>(data);
+    if (header[0] != container_internal::kBitsetMagic) {
+        return false;
+    }
+    const size_t num_bits = static_cast<size_t>(header[1]);
+    const size_t num_words = num_bits / kWordBits + (num_bits % kWordBits != 0);
+    if ((size - 2 * sizeof(word_type)) / sizeof(word_type) < num_words) {
+        return false;
+    }
+    *out = bitset_view(header + 2, num_bits);
+    return true;
+}
+
+bool operator == (bitset_view a, bitset_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.data(), a.data() + a.num_words(), b.data());
+}
+
+dynamic_bitset::dynamic_bitset (size_t num_bits, bool value)
+    : _words((num_bits + kWordBits - 1) / kWordBits, value ? ~word_type(0) : 0),
+      _size(num_bits) {
+    trim();
+}
+
+dynamic_bitset::dynamic_bitset (bitset_view bits)
+    : _words(bits.data(), bits.data() + bits.num_words()), _size(bits.size()) {
+}
+
+void dynamic_bitset::resize (size_t num_bits, bool value) {
+    const size_t old_size = _size;
+    _words.resize((num_bits + kWordBits - 1) / kWordBits, value ? ~word_type(0) : 0);
+    _size = num_bits;
+    if (value && num_bits > old_size && old_size % kWordBits != 0) {
+        // Fill the rest of the old last word.
+        _words[old_size / kWordBits] |= ~word_type(0) << (old_size % kWordBits);
+    }
+    trim();
+}
+
+void dynamic_bitset::push_back (bool value) {
+    if (_size % kWordBits == 0) {
+        _words.push_back(0);
+    }
+    ++_size;
+    set(_size - 1, value);
+}
+
+dynamic_bitset &dynamic_bitset::set () {
+    std::fill(_words.begin(), _words.end(), ~word_type(0));
+    trim();
+    return *this;
+}
+
+dynamic_bitset &dynamic_bitset::reset () {
+    std::fill(_words.begin(), _words.end(), word_type(0));
+    return *this;
+}
+
+dynamic_bitset &dynamic_bitset::flip () {
+    for (word_type &w : _words) {
+        w = ~w;
+    }
+    trim();
+    return *this;
+}
+
+dynamic_bitset &dynamic_bitset::operator &= (bitset_view other) {
+    assert(other.size() == _size);
+    container_internal::bitset_and(_words.data(), other.data(), _words.size());
+    return *this;
+}
+
+dynamic_bitset &dynamic_bitset::operator |= (bitset_view other) {
+    assert(other.size() == _size);
+    container_internal::bitset_or(_words.data(), other.data(), _words.size());
+    return *this;
+}
+
+dynamic_bitset &dynamic_bitset::operator ^= (bitset_view other) {
+    assert(other.size() == _size);
+    container_internal::bitset_xor(_words.data(), other.data(), _words.size());
+    return *this;
+}
+
+dynamic_bitset &dynamic_bitset::operator -= (bitset_view other) {
+    assert(other.size() == _size);
+    container_internal::bitset_and_not(_words.data(), other.data(), _words.size());
+    return *this;
+}
+
+void dynamic_bitset::serialize (void *out) const {
+    const word_type header[2] = {container_internal::kBitsetMagic, static_cast<word_type>(_size)};
+    char *p = static_cast<char *>(out);
+    memcpy(p, header, sizeof(header));
+    if (!_words.empty()) {
+        memcpy(p + sizeof(header), _words.data(), _words.size() * sizeof(word_type));
+    }
+}
+
+void dynamic_bitset::trim () {
+    if (_size % kWordBits != 0) {
+        _words.back() &= ~(~word_type(0) << (_size % kWordBits));
+    }
+}
+
+}  // namespace abel
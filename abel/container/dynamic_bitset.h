@@ -0,0 +1,241 @@
+//
+
+#ifndef ABEL_CONTAINER_DYNAMIC_BITSET_H_
+#define ABEL_CONTAINER_DYNAMIC_BITSET_H_
+
+#include <abel/base/math/pop_count.h>
+#include <abel/base/profile.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace abel {
+
+namespace container_internal {
+
+// Word-array kernels behind dynamic_bitset, vectorized with AVX2 when the
+// target has it.
+void bitset_and (uint64_t *dst, const uint64_t *src, size_t n);
+void bitset_or (uint64_t *dst, const uint64_t *src, size_t n);
+void bitset_xor (uint64_t *dst, const uint64_t *src, size_t n);
+void bitset_and_not (uint64_t *dst, const uint64_t *src, size_t n);
+size_t bitset_count (const uint64_t *words, size_t n);
+size_t bitset_count_and (const uint64_t *a, const uint64_t *b, size_t n);
+
+// First word of a serialized bitset: "ABELBITS".
+constexpr uint64_t kBitsetMagic = 0x535449424c454241ull;
+
+}  // namespace container_internal
+
+// bitset_view
+//
+// A read-only view of a bitset stored as 64-bit words, bit `i` being bit
+// `i % 64` of word `i / 64`. The bits of the last word past size() must be
+// zero. Views are cheap to copy and do not own the words, which may live in a
+// dynamic_bitset or in a mapped file (see map()).
+class bitset_view {
+public:
+    using word_type = uint64_t;
+
+    static constexpr size_t kWordBits = 64;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+public:
+    bitset_view () = default;
+    bitset_view (const word_type *words, size_t num_bits)
+        : _words(words), _size(num_bits) { }
+
+    size_t size () const {
+        return _size;
+    }
+    bool empty () const {
+        return _size == 0;
+    }
+    size_t num_words () const {
+        return (_size + kWordBits - 1) / kWordBits;
+    }
+    const word_type *data () const {
+        return _words;
+    }
+
+    bool test (size_t i) const {
+        return (_words[i / kWordBits] >> (i % kWordBits)) & 1;
+    }
+    bool operator [] (size_t i) const {
+        return test(i);
+    }
+
+    // The number of set bits.
+    size_t count () const {
+        return container_internal::bitset_count(_words, num_words());
+    }
+    bool any () const;
+    bool none () const {
+        return !any();
+    }
+    bool all () const {
+        return count() == _size;
+    }
+
+    // The first set bit, or the first one after `pos`; npos if none.
+    size_t find_first () const {
+        return find_from(0);
+    }
+    size_t find_next (size_t pos) const {
+        return pos + 1 >= _size ? npos : find_from(pos + 1);
+    }
+
+    // The number of bits set in both `*this` and `other`, which must be of
+    // the same size.
+    size_t count_and (bitset_view other) const;
+
+    // Points `*out` at a bitset written by dynamic_bitset::serialize(), for
+    // example in a mapped file. `data` must be 8-byte aligned and outlive the
+    // view. Returns false if `data` does not hold a bitset.
+    static bool map (const void *data, size_t size, bitset_view *out);
+private:
+    size_t find_from (size_t pos) const;
+private:
+    const word_type *_words = nullptr;
+    size_t _size = 0;
+};
+
+bool operator == (bitset_view a, bitset_view b);
+inline bool operator != (bitset_view a, bitset_view b) {
+    return !(a == b);
+}
+
+// dynamic_bitset
+//
+// A resizable bitset for large bitmaps. Bitwise operations and counting run
+// a word, or with AVX2 four words, at a time, and find_first()/find_next()
+// skip whole zero words. The serialized form is the words with a short
+// header, so that a bitset written to a file can be mapped and used through
+// bitset_view without parsing; see also rank_select.
+class dynamic_bitset {
+public:
+    using word_type = uint64_t;
+
+    static constexpr size_t kWordBits = bitset_view::kWordBits;
+    static constexpr size_t npos = bitset_view::npos;
+public:
+    dynamic_bitset () = default;
+    explicit dynamic_bitset (size_t num_bits, bool value = false);
+    explicit dynamic_bitset (bitset_view bits);
+
+    size_t size () const {
+        return _size;
+    }
+    bool empty () const {
+        return _size == 0;
+    }
+    size_t num_words () const {
+        return _words.size();
+    }
+    const word_type *data () const {
+        return _words.data();
+    }
+    bitset_view view () const {
+        return bitset_view(_words.data(), _size);
+    }
+
+    void resize (size_t num_bits, bool value = false);
+    void push_back (bool value);
+    void clear () {
+        _words.clear();
+        _size = 0;
+    }
+
+    bool test (size_t i) const {
+        return (_words[i / kWordBits] >> (i % kWordBits)) & 1;
+    }
+    bool operator [] (size_t i) const {
+        return test(i);
+    }
+    dynamic_bitset &set (size_t i) {
+        _words[i / kWordBits] |= word_type(1) << (i % kWordBits);
+        return *this;
+    }
+    dynamic_bitset &set (size_t i, bool value) {
+        return value ? set(i) : reset(i);
+    }
+    dynamic_bitset &reset (size_t i) {
+        _words[i / kWordBits] &= ~(word_type(1) << (i % kWordBits));
+        return *this;
+    }
+    dynamic_bitset &flip (size_t i) {
+        _words[i / kWordBits] ^= word_type(1) << (i % kWordBits);
+        return *this;
+    }
+    // Set, clear or flip all bits.
+    dynamic_bitset &set ();
+    dynamic_bitset &reset ();
+    dynamic_bitset &flip ();
+
+    size_t count () const {
+        return view().count();
+    }
+    bool any () const {
+        return view().any();
+    }
+    bool none () const {
+        return !any();
+    }
+    bool all () const {
+        return view().all();
+    }
+    size_t find_first () const {
+        return view().find_first();
+    }
+    size_t find_next (size_t pos) const {
+        return view().find_next(pos);
+    }
+    size_t count_and (bitset_view other) const {
+        return view().count_and(other);
+    }
+
+    // The operands must be of the same size.
+    dynamic_bitset &operator &= (bitset_view other);
+    dynamic_bitset &operator |= (bitset_view other);
+    dynamic_bitset &operator ^= (bitset_view other);
+    // Clears the bits that are set in `other`.
+    dynamic_bitset &operator -= (bitset_view other);
+
+    // The serialized form: the words of "ABELBITS" and the size, then the
+    // bits, all in native byte order.
+    size_t serialized_size () const {
+        return (2 + _words.size()) * sizeof(word_type);
+    }
+    // Writes serialized_size() bytes to `out`.
+    void serialize (void *out) const;
+
+    operator bitset_view () const {
+        return view();
+    }
+private:
+    // Clears the bits of the last word past size().
+    void trim ();
+private:
+    std::vector<word_type> _words;
+    size_t _size = 0;
+};
+
+inline dynamic_bitset operator & (dynamic_bitset a, bitset_view b) {
+    a &= b;
+    return a;
+}
+inline dynamic_bitset operator | (dynamic_bitset a, bitset_view b) {
+    a |= b;
+    return a;
+}
+inline dynamic_bitset operator ^ (dynamic_bitset a, bitset_view b) {
+    a ^= b;
+    return a;
+}
+inline dynamic_bitset operator - (dynamic_bitset a, bitset_view b) {
+    a -= b;
+    return a;
+}
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_DYNAMIC_BITSET_H_
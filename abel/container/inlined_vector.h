@@ -61,6 +61,7 @@ class InlinedVector {
   using RValueReference = typename Storage::RValueReference;
   using MoveIterator = typename Storage::MoveIterator;
   using IsMemcpyOk = typename Storage::IsMemcpyOk;
+  using IsRelocateOk = typename Storage::IsRelocateOk;
 
   template <typename Iterator>
   using IteratorValueAdapter =
@@ -178,7 +179,7 @@ class InlinedVector {
       abel::allocator_is_nothrow<allocator_type>::value ||
       std::is_nothrow_move_constructible<value_type>::value)
       : storage_(*other.storage_.GetAllocPtr()) {
-    if (IsMemcpyOk::value) {
+    if (IsRelocateOk::value) {
       storage_.MemcpyFrom(other.storage_);
 
       other.storage_.SetInlinedSize(0);
@@ -210,7 +211,7 @@ class InlinedVector {
   InlinedVector(InlinedVector&& other, const allocator_type& alloc) noexcept(
       abel::allocator_is_nothrow<allocator_type>::value)
       : storage_(alloc) {
-    if (IsMemcpyOk::value) {
+    if (IsRelocateOk::value) {
       storage_.MemcpyFrom(other.storage_);
 
       other.storage_.SetInlinedSize(0);
@@ -467,7 +468,7 @@ class InlinedVector {
   // unspecified state.
   InlinedVector& operator=(InlinedVector&& other) {
     if (ABEL_LIKELY(this != std::addressof(other))) {
-      if (IsMemcpyOk::value || other.storage_.GetIsAllocated()) {
+      if (IsRelocateOk::value || other.storage_.GetIsAllocated()) {
         inlined_vector_internal::DestroyElements(storage_.GetAllocPtr(), data(),
                                                  size());
         storage_.DeallocateIfAllocated();
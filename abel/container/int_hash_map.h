@@ -0,0 +1,518 @@
+//
+
+#ifndef ABEL_CONTAINER_INT_HASH_MAP_H_
+#define ABEL_CONTAINER_INT_HASH_MAP_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <abel/base/internal/throw_delegate.h>
+#include <abel/base/math/ctz.h>
+#include <abel/base/profile.h>
+
+#if ABEL_AVX2
+#include <immintrin.h>
+#endif
+
+namespace abel {
+
+namespace container_internal {
+
+// Compares a group of integer keys against one key at a time, returning a
+// bitmask with bit `i` set if key `i` of the group matches.
+template <size_t KeySize>
+struct IntKeyGroup;
+
+#if ABEL_AVX2
+
+template <>
+struct IntKeyGroup<8> {
+  static constexpr size_t kWidth = 4;
+  explicit IntKeyGroup(const void* keys)
+      : v_(_mm256_loadu_si256(static_cast<const __m256i*>(keys))) {}
+  uint32_t Match(uint64_t key) const {
+    const __m256i k = _mm256_set1_epi64x(static_cast<long long>(key));
+    return static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v_, k))));
+  }
+  __m256i v_;
+};
+
+template <>
+struct IntKeyGroup<4> {
+  static constexpr size_t kWidth = 8;
+  explicit IntKeyGroup(const void* keys)
+      : v_(_mm256_loadu_si256(static_cast<const __m256i*>(keys))) {}
+  uint32_t Match(uint32_t key) const {
+    const __m256i k = _mm256_set1_epi32(static_cast<int>(key));
+    return static_cast<uint32_t>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v_, k))));
+  }
+  __m256i v_;
+};
+
+#else
+
+template <size_t KeySize>
+struct IntKeyGroup {
+  using Word = typename std::conditional<KeySize == 8, uint64_t, uint32_t>::type;
+  static constexpr size_t kWidth = 4;
+  explicit IntKeyGroup(const void* keys) : keys_(static_cast<const Word*>(keys)) {}
+  uint32_t Match(Word key) const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<uint32_t>(keys_[i] == key) << i;
+    }
+    return mask;
+  }
+  const Word* keys_;
+};
+
+#endif
+
+}  // namespace container_internal
+
+// -----------------------------------------------------------------------------
+// abel::int_hash_map
+// -----------------------------------------------------------------------------
+//
+// An `abel::int_hash_map<K, V>` is a hash map for 32- and 64-bit integer keys
+// with the interface of `abel::flat_hash_map<K, V>`, tuned for lookups:
+//
+// * The hash is a single multiplication by 2^64 / phi, keeping the high bits
+//   (Fibonacci hashing), instead of the `abel::Hash` mixing.
+// * There are no control bytes. Keys are kept in an array of their own, an
+//   empty slot being marked by the key with all bits set, and collisions are
+//   resolved by linear probing. A probe compares a group of 4 (or 8 for
+//   32-bit keys) keys at once with AVX2.
+// * Erasing shifts the following keys of the probe sequence back instead of
+//   leaving tombstones, so lookups never slow down as keys come and go.
+// * The key with all bits set can still be stored, in a slot of its own.
+//
+// Values are kept apart from the keys, so dereferencing an iterator yields a
+// `std::pair<const K&, V&>` proxy rather than a reference to a stored pair:
+// iterate with `for (auto kv : map)` or `for (const auto& kv : map)`.
+//
+// Like `flat_hash_map`, rehashing invalidates iterators and references, and
+// `erase(iterator)` returns `void`. Erasing also invalidates iterators, as
+// following elements may move back.
+template <class K, class V>
+class int_hash_map {
+  static_assert(std::is_integral<K>::value && (sizeof(K) == 4 || sizeof(K) == 8),
+                "int_hash_map requires 32- or 64-bit integer keys");
+
+  using Word = typename std::make_unsigned<K>::type;
+  using Group = container_internal::IntKeyGroup<sizeof(K)>;
+  using ValueStorage = typename std::aligned_storage<sizeof(V), alignof(V)>::type;
+
+  static constexpr size_t kGroupWidth = Group::kWidth;
+  static constexpr Word kEmpty = static_cast<Word>(~Word(0));
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<const K, V>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = std::pair<const K&, V&>;
+  using const_reference = std::pair<const K&, const V&>;
+
+  template <bool IsConst>
+  class iterator_impl {
+    using map_type = typename std::conditional<IsConst, const int_hash_map, int_hash_map>::type;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename int_hash_map::value_type;
+    using difference_type = ptrdiff_t;
+    using reference = typename std::conditional<IsConst, const_reference,
+                                                typename int_hash_map::reference>::type;
+    struct pointer {
+      reference ref;
+      const reference* operator->() const { return &ref; }
+    };
+
+    iterator_impl() = default;
+    // Converts an iterator to a const_iterator.
+    template <bool C = IsConst, typename = typename std::enable_if<C>::type>
+    iterator_impl(const iterator_impl<false>& it)  // NOLINT
+        : map_(it.map_), index_(it.index_) {}
+
+    reference operator*() const {
+      return reference(map_->key_at(index_), map_->value_at(index_));
+    }
+    pointer operator->() const { return pointer{**this}; }
+
+    iterator_impl& operator++() {
+      index_ = map_->next_occupied(index_ + 1);
+      return *this;
+    }
+    iterator_impl operator++(int) {
+      iterator_impl tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const iterator_impl& a, const iterator_impl& b) {
+      return a.index_ == b.index_;
+    }
+    friend bool operator!=(const iterator_impl& a, const iterator_impl& b) {
+      return a.index_ != b.index_;
+    }
+
+   private:
+    friend class int_hash_map;
+    iterator_impl(map_type* map, size_t index) : map_(map), index_(index) {}
+
+    map_type* map_ = nullptr;
+    size_t index_ = 0;
+  };
+
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  int_hash_map() = default;
+  explicit int_hash_map(size_t bucket_count) { reserve(bucket_count); }
+  int_hash_map(std::initializer_list<value_type> init) {
+    reserve(init.size());
+    insert(init.begin(), init.end());
+  }
+  template <class InputIt>
+  int_hash_map(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  int_hash_map(const int_hash_map& other) {
+    reserve(other.size());
+    for (const auto& kv : other) try_emplace(kv.first, kv.second);
+  }
+  int_hash_map(int_hash_map&& other) noexcept { swap(other); }
+  int_hash_map& operator=(const int_hash_map& other) {
+    if (this != &other) {
+      int_hash_map tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+  int_hash_map& operator=(int_hash_map&& other) noexcept {
+    int_hash_map tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  }
+  ~int_hash_map() { destroy(); }
+
+  iterator begin() { return iterator(this, next_occupied(0)); }
+  iterator end() { return iterator(this, end_index()); }
+  const_iterator begin() const { return const_iterator(this, next_occupied(0)); }
+  const_iterator end() const { return const_iterator(this, end_index()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  // The number of key slots, a power of two, or 0 before the first insert.
+  size_t capacity() const { return capacity_; }
+  size_t bucket_count() const { return capacity_; }
+  float load_factor() const {
+    return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / capacity_;
+  }
+  // The table grows past this load factor.
+  float max_load_factor() const { return 0.75f; }
+
+  void clear();
+  // Makes room for `n` elements without rehashing.
+  void reserve(size_t n);
+  // Rehashes to the smallest capacity holding max(n, size()) elements.
+  void rehash(size_t n);
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(K key, Args&&... args);
+  std::pair<iterator, bool> insert(const value_type& kv) {
+    return try_emplace(kv.first, kv.second);
+  }
+  std::pair<iterator, bool> insert(value_type&& kv) {
+    return try_emplace(kv.first, std::move(kv.second));
+  }
+  template <class P, typename = typename std::enable_if<
+                         std::is_constructible<value_type, P&&>::value>::type>
+  std::pair<iterator, bool> insert(P&& kv) {
+    value_type tmp(std::forward<P>(kv));
+    return try_emplace(tmp.first, std::move(tmp.second));
+  }
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+  void insert(std::initializer_list<value_type> init) {
+    insert(init.begin(), init.end());
+  }
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(K key, M&& value) {
+    auto res = try_emplace(key, std::forward<M>(value));
+    if (!res.second) value_at(res.first.index_) = std::forward<M>(value);
+    return res;
+  }
+  // Constructs the value from `args` if `key` is absent.
+  template <class... Args>
+  std::pair<iterator, bool> emplace(K key, Args&&... args) {
+    return try_emplace(key, std::forward<Args>(args)...);
+  }
+
+  V& operator[](K key) { return value_at(try_emplace(key).first.index_); }
+  V& at(K key) {
+    const size_t i = find_index(key);
+    if (i == end_index()) base_internal::ThrowStdOutOfRange("int_hash_map::at");
+    return value_at(i);
+  }
+  const V& at(K key) const {
+    const size_t i = find_index(key);
+    if (i == end_index()) base_internal::ThrowStdOutOfRange("int_hash_map::at");
+    return value_at(i);
+  }
+
+  iterator find(K key) { return iterator(this, find_index(key)); }
+  const_iterator find(K key) const { return const_iterator(this, find_index(key)); }
+  size_t count(K key) const { return find_index(key) != end_index() ? 1 : 0; }
+  bool contains(K key) const { return find_index(key) != end_index(); }
+
+  size_t erase(K key) {
+    const size_t i = find_index(key);
+    if (i == end_index()) return 0;
+    erase_index(i);
+    return 1;
+  }
+  void erase(const_iterator it) { erase_index(it.index_); }
+  void erase(iterator it) { erase_index(it.index_); }
+
+  void swap(int_hash_map& other) noexcept {
+    using std::swap;
+    swap(keys_, other.keys_);
+    swap(values_, other.values_);
+    swap(capacity_, other.capacity_);
+    swap(shift_, other.shift_);
+    swap(size_, other.size_);
+    swap(has_empty_key_, other.has_empty_key_);
+  }
+
+  friend bool operator==(const int_hash_map& a, const int_hash_map& b) {
+    if (a.size() != b.size()) return false;
+    for (const auto& kv : a) {
+      auto it = b.find(kv.first);
+      if (it == b.end() || !(it->second == kv.second)) return false;
+    }
+    return true;
+  }
+  friend bool operator!=(const int_hash_map& a, const int_hash_map& b) {
+    return !(a == b);
+  }
+  friend void swap(int_hash_map& a, int_hash_map& b) noexcept { a.swap(b); }
+
+ private:
+  // The home slot of `key`.
+  size_t home(Word key) const {
+    return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ull) >> shift_);
+  }
+  // Slot `capacity_` holds the value of the key kEmpty, if present.
+  size_t empty_key_index() const { return capacity_; }
+  size_t end_index() const { return capacity_ + 1; }
+
+  const K& key_at(size_t i) const {
+    return reinterpret_cast<const K&>(i == capacity_ ? kEmptyKey : keys_[i]);
+  }
+  V& value_at(size_t i) const { return *reinterpret_cast<V*>(&values_[i]); }
+
+  size_t next_occupied(size_t i) const {
+    for (; i < capacity_; ++i) {
+      if (keys_[i] != kEmpty) return i;
+    }
+    return i == capacity_ && has_empty_key_ ? i : end_index();
+  }
+
+  // Returns the slot of `key`, or the slot it should be inserted at and
+  // false.
+  std::pair<size_t, bool> probe(Word key) const;
+  size_t find_index(K key) const {
+    const Word k = static_cast<Word>(key);
+    if (k == kEmpty) return has_empty_key_ ? empty_key_index() : end_index();
+    if (capacity_ == 0) return end_index();
+    const std::pair<size_t, bool> p = probe(k);
+    return p.second ? p.first : end_index();
+  }
+  void erase_index(size_t i);
+  // Reallocates to `capacity` slots, a power of two, and reinserts.
+  void resize(size_t capacity);
+  void destroy();
+
+  static const Word kEmptyKey;
+
+  Word* keys_ = nullptr;
+  ValueStorage* values_ = nullptr;
+  size_t capacity_ = 0;
+  int shift_ = 64;
+  size_t size_ = 0;
+  bool has_empty_key_ = false;
+};
+
+template <class K, class V>
+constexpr size_t int_hash_map<K, V>::kGroupWidth;
+
+template <class K, class V>
+constexpr typename int_hash_map<K, V>::Word int_hash_map<K, V>::kEmpty;
+
+template <class K, class V>
+const typename int_hash_map<K, V>::Word int_hash_map<K, V>::kEmptyKey = kEmpty;
+
+template <class K, class V>
+std::pair<size_t, bool> int_hash_map<K, V>::probe(Word key) const {
+  const size_t mask = capacity_ - 1;
+  const size_t pos = home(key);
+  // Most keys sit in their home slot.
+  if (keys_[pos] == key) return {pos, true};
+  if (keys_[pos] == kEmpty) return {pos, false};
+  size_t group = pos & ~(kGroupWidth - 1);
+  // Empty slots before the home slot do not end the first group's probe.
+  uint32_t skip = (uint32_t(1) << (pos - group)) - 1;
+  while (true) {
+    const Group g(keys_ + group);
+    const uint32_t match = g.Match(key);
+    if (match != 0) return {group + count_trailing_zeros(match), true};
+    const uint32_t empty = g.Match(kEmpty) & ~skip;
+    if (empty != 0) return {group + count_trailing_zeros(empty), false};
+    group = (group + kGroupWidth) & mask;
+    skip = 0;
+  }
+}
+
+template <class K, class V>
+template <class... Args>
+std::pair<typename int_hash_map<K, V>::iterator, bool> int_hash_map<K, V>::try_emplace(
+    K key, Args&&... args) {
+  const Word k = static_cast<Word>(key);
+  if (k == kEmpty) {
+    if (capacity_ == 0) resize(kGroupWidth);
+    if (has_empty_key_) return {iterator(this, empty_key_index()), false};
+    new (&values_[empty_key_index()]) V(std::forward<Args>(args)...);
+    has_empty_key_ = true;
+    ++size_;
+    return {iterator(this, empty_key_index()), true};
+  }
+  if (capacity_ == 0) resize(kGroupWidth);
+  std::pair<size_t, bool> p = probe(k);
+  if (p.second) return {iterator(this, p.first), false};
+  if ((size_ + 1) * 4 > capacity_ * 3) {
+    resize(capacity_ * 2);
+    p = probe(k);
+  }
+  new (&values_[p.first]) V(std::forward<Args>(args)...);
+  keys_[p.first] = k;
+  ++size_;
+  return {iterator(this, p.first), true};
+}
+
+template <class K, class V>
+void int_hash_map<K, V>::erase_index(size_t i) {
+  value_at(i).~V();
+  --size_;
+  if (i == empty_key_index()) {
+    has_empty_key_ = false;
+    return;
+  }
+  keys_[i] = kEmpty;
+  // Shift back the keys after `i` that may live closer to their home slot.
+  const size_t mask = capacity_ - 1;
+  for (size_t j = (i + 1) & mask; keys_[j] != kEmpty; j = (j + 1) & mask) {
+    const size_t h = home(keys_[j]);
+    // Keys whose home lies cyclically in (i, j] stay.
+    const bool stays = i <= j ? (i < h && h <= j) : (i < h || h <= j);
+    if (stays) continue;
+    new (&values_[i]) V(std::move(value_at(j)));
+    value_at(j).~V();
+    keys_[i] = keys_[j];
+    keys_[j] = kEmpty;
+    i = j;
+  }
+}
+
+template <class K, class V>
+void int_hash_map<K, V>::resize(size_t capacity) {
+  assert(capacity >= kGroupWidth && (capacity & (capacity - 1)) == 0);
+  Word* old_keys = keys_;
+  ValueStorage* old_values = values_;
+  const size_t old_capacity = capacity_;
+
+  keys_ = new Word[capacity];
+  std::fill(keys_, keys_ + capacity, kEmpty);
+  ABEL_INTERNAL_TRY {
+    values_ = new ValueStorage[capacity + 1];
+  }
+  ABEL_INTERNAL_CATCH_ANY {
+    delete[] keys_;
+    keys_ = old_keys;
+    ABEL_INTERNAL_RETHROW;
+  }
+  capacity_ = capacity;
+  shift_ = 64 - static_cast<int>(count_trailing_zeros(static_cast<uint64_t>(capacity)));
+  if (old_capacity == 0) return;
+  for (size_t i = 0; i < old_capacity; ++i) {
+    if (old_keys[i] == kEmpty) continue;
+    V& v = *reinterpret_cast<V*>(&old_values[i]);
+    const size_t slot = probe(old_keys[i]).first;
+    new (&values_[slot]) V(std::move(v));
+    v.~V();
+    keys_[slot] = old_keys[i];
+  }
+  if (has_empty_key_) {
+    V& v = *reinterpret_cast<V*>(&old_values[old_capacity]);
+    new (&values_[capacity_]) V(std::move(v));
+    v.~V();
+  }
+  delete[] old_keys;
+  delete[] old_values;
+}
+
+template <class K, class V>
+void int_hash_map<K, V>::clear() {
+  for (size_t i = next_occupied(0); i != end_index(); i = next_occupied(i + 1)) {
+    value_at(i).~V();
+  }
+  if (keys_ != nullptr) std::fill(keys_, keys_ + capacity_, kEmpty);
+  size_ = 0;
+  has_empty_key_ = false;
+}
+
+template <class K, class V>
+void int_hash_map<K, V>::reserve(size_t n) {
+  size_t capacity = std::max(capacity_, kGroupWidth);
+  while (n * 4 > capacity * 3) capacity *= 2;
+  if (capacity != capacity_) resize(capacity);
+}
+
+template <class K, class V>
+void int_hash_map<K, V>::rehash(size_t n) {
+  n = std::max(n, size_);
+  size_t capacity = kGroupWidth;
+  while (n * 4 > capacity * 3) capacity *= 2;
+  if (capacity != capacity_) resize(capacity);
+}
+
+template <class K, class V>
+void int_hash_map<K, V>::destroy() {
+  clear();
+  delete[] keys_;
+  delete[] values_;
+  keys_ = nullptr;
+  values_ = nullptr;
+  capacity_ = 0;
+  shift_ = 64;
+}
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_INT_HASH_MAP_H_
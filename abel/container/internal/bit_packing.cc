@@ -0,0 +1,92 @@
+//
+
+#include <abel/container/internal/bit_packing.h>
+
+#include <cstring>
+
+#if ABEL_AVX2
+#include <immintrin.h>
+#endif
+
+namespace abel {
+namespace container_internal {
+
+void pack_block (const uint32_t *in, unsigned bits, uint32_t *out) {
+    if (bits == 0) {
+        return;
+    }
+    for (size_t lane = 0; lane < kPackedLanes; ++lane) {
+        uint64_t acc = 0;
+        unsigned filled = 0;
+        size_t word = 0;
+        for (size_t j = 0; j < kPackedBlockSize / kPackedLanes; ++j) {
+            acc |= static_cast<uint64_t>(in[j * kPackedLanes + lane]) << filled;
+            filled += bits;
+            if (filled >= 32) {
+                out[word++ * kPackedLanes + lane] = static_cast<uint32_t>(acc);
+                acc >>= 32;
+                filled -= 32;
+            }
+        }
+    }
+}
+
+#if ABEL_AVX2
+
+void unpack_block (const uint32_t *in, unsigned bits, uint32_t *out) {
+    if (bits == 0) {
+        memset(out, 0, kPackedBlockSize * sizeof(uint32_t));
+        return;
+    }
+    const __m256i *src = reinterpret_cast<const __m256i *>(in);
+    __m256i *dst = reinterpret_cast<__m256i *>(out);
+    const __m256i mask = _mm256_set1_epi32(bits == 32 ? -1 : static_cast<int>((1u << bits) - 1));
+    __m256i cur = _mm256_loadu_si256(src);
+    unsigned shift = 0;
+    unsigned word = 0;
+    for (size_t j = 0; j < kPackedBlockSize / kPackedLanes; ++j) {
+        __m256i v = _mm256_srl_epi32(cur, _mm_cvtsi32_si128(static_cast<int>(shift)));
+        shift += bits;
+        if (shift >= 32) {
+            shift -= 32;
+            if (++word < bits) {
+                cur = _mm256_loadu_si256(src + word);
+                if (shift != 0) {
+                    // The integer straddles two words.
+                    v = _mm256_or_si256(
+                        v, _mm256_sll_epi32(cur, _mm_cvtsi32_si128(static_cast<int>(bits - shift))));
+                }
+            }
+        }
+        _mm256_storeu_si256(dst + j, _mm256_and_si256(v, mask));
+    }
+}
+
+#else
+
+void unpack_block (const uint32_t *in, unsigned bits, uint32_t *out) {
+    if (bits == 0) {
+        memset(out, 0, kPackedBlockSize * sizeof(uint32_t));
+        return;
+    }
+    const uint32_t mask = bits == 32 ? ~uint32_t(0) : (uint32_t(1) << bits) - 1;
+    for (size_t lane = 0; lane < kPackedLanes; ++lane) {
+        uint64_t acc = in[lane];
+        unsigned avail = 32;
+        size_t word = 1;
+        for (size_t j = 0; j < kPackedBlockSize / kPackedLanes; ++j) {
+            if (avail < bits) {
+                acc |= static_cast<uint64_t>(in[word++ * kPackedLanes + lane]) << avail;
+                avail += 32;
+            }
+            out[j * kPackedLanes + lane] = static_cast<uint32_t>(acc) & mask;
+            acc >>= bits;
+            avail -= bits;
+        }
+    }
+}
+
+#endif
+
+}  // namespace container_internal
+}  // namespace abel
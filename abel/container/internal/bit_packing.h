@@ -0,0 +1,43 @@
+//
+
+#ifndef ABEL_CONTAINER_INTERNAL_BIT_PACKING_H_
+#define ABEL_CONTAINER_INTERNAL_BIT_PACKING_H_
+
+#include <abel/base/math/clz.h>
+#include <abel/base/profile.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace abel {
+namespace container_internal {
+
+// Blocks of 256 32-bit integers packed at a common bit width.
+//
+// The layout is vertical over eight 32-bit lanes: integer `i` goes to lane
+// `i % 8`, and each lane packs its 32 integers into `bits` consecutive words
+// of its own, word `k` of lane `l` being stored at `k * 8 + l`. A block so
+// takes exactly `8 * bits` words, and AVX2 unpacks eight integers, which are
+// consecutive in the input, per step. The scalar code reads and writes the
+// same layout.
+constexpr size_t kPackedBlockSize = 256;
+constexpr size_t kPackedLanes = 8;
+
+// The number of bits needed to represent `x`; 0 for 0.
+ABEL_FORCE_INLINE unsigned bit_width (uint64_t x) {
+    return x == 0 ? 0 : 64 - count_leading_zeros(x);
+}
+
+// The number of 32-bit words of a block packed at `bits` (at most 32).
+constexpr size_t packed_block_words (unsigned bits) {
+    return kPackedLanes * bits;
+}
+
+// Packs kPackedBlockSize integers of `in`, each below 2^bits, to `out`.
+void pack_block (const uint32_t *in, unsigned bits, uint32_t *out);
+// Unpacks a block written by pack_block().
+void unpack_block (const uint32_t *in, unsigned bits, uint32_t *out);
+
+}  // namespace container_internal
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_INTERNAL_BIT_PACKING_H_
@@ -0,0 +1,25 @@
+//
+
+#ifndef ABEL_CONTAINER_INTERNAL_BOUNDED_QUEUE_H_
+#define ABEL_CONTAINER_INTERNAL_BOUNDED_QUEUE_H_
+
+#include <abel/base/profile.h>
+#include <cstddef>
+
+namespace abel {
+namespace container_internal {
+
+// Rounds a requested queue capacity up to a power of two, and to at least 2,
+// so that slot indices can be taken with a mask.
+ABEL_FORCE_INLINE size_t queue_capacity (size_t n) {
+    size_t c = 2;
+    while (c < n) {
+        c <<= 1;
+    }
+    return c;
+}
+
+}  // namespace container_internal
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_INTERNAL_BOUNDED_QUEUE_H_
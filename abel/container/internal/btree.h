@@ -45,6 +45,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <abel/base/profile.h>
 #include <abel/container/internal/common.h>
@@ -1140,6 +1141,38 @@ class btree {
   template <typename InputIterator>
   void insert_iterator_multi(InputIterator b, InputIterator e);
 
+  // Replaces the contents of the btree with the values in [b, e). If the range
+  // is a multi-pass range sorted by key_comp(), the tree is built bottom-up in
+  // O(n) with every node filled to `fill_factor` of its capacity; otherwise
+  // the values are inserted one at a time. For the unique variant, only the
+  // first of a run of equivalent values is kept.
+  template <typename InputIterator>
+  void bulk_load_unique(InputIterator b, InputIterator e, double fill_factor);
+  template <typename InputIterator>
+  void bulk_load_multi(InputIterator b, InputIterator e, double fill_factor);
+
+  // Inserts the values in [b, e), which should be sorted by key_comp(). When
+  // the range is large compared to the tree, the tree is rebuilt from a single
+  // linear merge of the two sequences. Otherwise each value is inserted with
+  // the position of the previous one as a hint, which is amortized constant
+  // time when consecutive values land in the same node. Unsorted ranges are
+  // still inserted correctly, just without the fast path.
+  template <typename InputIterator>
+  void insert_sorted_unique(InputIterator b, InputIterator e);
+  template <typename InputIterator>
+  void insert_sorted_multi(InputIterator b, InputIterator e);
+
+  // Moves the values of the btree container `src` into this btree. The unique
+  // variant leaves values whose key already exists in `src`. When `src` is
+  // ordered consistently with key_comp() and is not much smaller than this
+  // btree, both trees are walked once and this btree is rebuilt bottom-up
+  // from copies of their values; the merged values are erased from `src`
+  // once that has succeeded, so an exception leaves both trees unchanged.
+  template <typename Container>
+  void merge_unique(Container *src);
+  template <typename Container>
+  void merge_multi(Container *src);
+
   // Erase the specified iterator from the btree. The iterator must be valid
   // (i.e. not equal to end()).  Return an iterator pointing to the node after
   // the one that was erased (or end() if none exists).
@@ -1418,6 +1451,121 @@ class btree {
   // Deletes a node and all of its children.
   void internal_clear(node_type *node);
 
+  // Builds a btree bottom-up from values supplied in ascending order. See the
+  // definition below for details.
+  class sorted_builder;
+
+  // The linear bulk paths walk a range twice and keep references to the keys
+  // of its elements, so they are only taken for multi-pass ranges of the
+  // container's own value types. Other ranges are dispatched as input ranges.
+  template <typename Iterator>
+  using sorted_range_tag = typename std::conditional<
+      std::is_convertible<
+          typename std::iterator_traits<Iterator>::iterator_category,
+          std::forward_iterator_tag>::value &&
+          (std::is_same<typename std::iterator_traits<Iterator>::value_type,
+                        value_type>::value ||
+           std::is_same<typename std::iterator_traits<Iterator>::value_type,
+                        typename Params::init_type>::value),
+      std::forward_iterator_tag, std::input_iterator_tag>::type;
+
+  // Returns true if merging `n` sorted values into this btree is cheaper as a
+  // single linear pass over both sequences than as `n` separate insertions.
+  // The linear pass copies the values of this btree, so it is not taken for
+  // move-only values unless the btree is empty.
+  bool prefer_linear_merge(size_type n) const {
+    if (!std::is_copy_constructible<value_type>::value && !empty()) {
+      return false;
+    }
+    size_type log_size = 0;
+    for (size_type s = size(); s != 0; s >>= 1) ++log_size;
+    return n * log_size >= size();
+  }
+
+  // Counts the values in the union of this btree and the range [b, e), keeping
+  // one value per key. Returns false if the range is not sorted.
+  template <typename ForwardIterator>
+  bool count_merged_unique(ForwardIterator b, ForwardIterator e,
+                           size_type *n) const;
+
+  // Returns true if the range [b, e) is sorted by key_comp().
+  template <typename ForwardIterator>
+  bool is_sorted_range(ForwardIterator b, ForwardIterator e) const;
+
+  // Rebuilds this btree from the union of its values and the sorted range
+  // [b, e), which together hold `n` distinct keys. The values of this btree
+  // win over equivalent values of the range. If `skipped` is non-null, the
+  // offsets of the range values that were not consumed are appended to it.
+  //
+  // The merged tree is built from copies of the values of this btree, which
+  // is only replaced once that succeeds: if a comparison or a copy throws,
+  // this btree is unchanged.
+  template <typename ForwardIterator>
+  void internal_merge_unique(ForwardIterator b, ForwardIterator e, size_type n,
+                             double fill_factor,
+                             std::vector<size_type> *skipped);
+
+  // Rebuilds this btree from its values and the `n` values of the sorted range
+  // [b, e). Values of this btree precede equivalent values of the range. As
+  // above, this btree is unchanged if building the merged tree throws.
+  template <typename ForwardIterator>
+  void internal_merge_multi(ForwardIterator b, ForwardIterator e, size_type n,
+                            double fill_factor);
+
+  // Appends a copy of the value at `it` to `builder`, for the merges above.
+  // Move-only values are only merged into an empty btree.
+  const key_type &append_copy(sorted_builder *builder, iterator it) {
+    return append_copy(builder, it,
+                       std::is_copy_constructible<value_type>());
+  }
+  const key_type &append_copy(sorted_builder *builder, iterator it,
+                              std::true_type) {
+    return builder->append(*it);
+  }
+  const key_type &append_copy(sorted_builder *builder, iterator it,
+                              std::false_type) {
+    assert(false && "move-only values are not merged linearly");
+    return builder->append(it.slot());
+  }
+
+  // The linear paths of merge_unique() and merge_multi(). They return false,
+  // having done nothing, when the values cannot be copied or per-value
+  // insertion is expected to be cheaper.
+  template <typename Container>
+  bool merge_unique_linear(Container *src, std::true_type);
+  template <typename Container>
+  bool merge_unique_linear(Container *, std::false_type) { return false; }
+  template <typename Container>
+  bool merge_multi_linear(Container *src, std::true_type);
+  template <typename Container>
+  bool merge_multi_linear(Container *, std::false_type) { return false; }
+
+  template <typename InputIterator>
+  void internal_bulk_load_unique(InputIterator b, InputIterator e,
+                                 double fill_factor, std::input_iterator_tag);
+  template <typename ForwardIterator>
+  void internal_bulk_load_unique(ForwardIterator b, ForwardIterator e,
+                                 double fill_factor, std::forward_iterator_tag);
+  template <typename InputIterator>
+  void internal_bulk_load_multi(InputIterator b, InputIterator e,
+                                double fill_factor, std::input_iterator_tag);
+  template <typename ForwardIterator>
+  void internal_bulk_load_multi(ForwardIterator b, ForwardIterator e,
+                                double fill_factor, std::forward_iterator_tag);
+
+  template <typename InputIterator>
+  void insert_sorted_unique(InputIterator b, InputIterator e,
+                            std::input_iterator_tag);
+  template <typename ForwardIterator>
+  void insert_sorted_unique(ForwardIterator b, ForwardIterator e,
+                            std::forward_iterator_tag);
+  template <typename InputIterator>
+  void insert_sorted_multi(InputIterator b, InputIterator e,
+                           std::input_iterator_tag);
+  template <typename ForwardIterator>
+  void insert_sorted_multi(ForwardIterator b, ForwardIterator e,
+                           std::forward_iterator_tag);
+
   // Verifies the tree structure of node.
   int internal_verify(const node_type *node,
                       const key_type *lo, const key_type *hi) const;
@@ -1805,16 +1953,13 @@ void btree<P>::copy_or_move_values_in_order(Btree *x) {
   assert(empty());
 
   // We can avoid key comparisons because we know the order of the
-  // values is the same order we'll store them in.
-  auto iter = x->begin();
-  if (iter == x->end()) return;
-  insert_multi(maybe_move_from_iterator(iter));
-  ++iter;
-  for (; iter != x->end(); ++iter) {
-    // If the btree is not empty, we can just insert the new value at the end
-    // of the tree.
-    internal_emplace(end(), maybe_move_from_iterator(iter));
+  // values is the same order we'll store them in, so the tree is built
+  // bottom-up with full nodes.
+  sorted_builder builder(this, x->size(), 1.0);
+  for (auto iter = x->begin(); iter != x->end(); ++iter) {
+    builder.append(maybe_move_from_iterator(iter));
   }
+  builder.finish();
 }
 
 template <typename P>
@@ -1962,6 +2107,450 @@ void btree<P>::insert_iterator_multi(InputIterator b, InputIterator e) {
   }
 }
 
+template <typename P>
+template <typename InputIterator>
+void btree<P>::bulk_load_unique(InputIterator b, InputIterator e,
+                                double fill_factor) {
+  clear();
+  internal_bulk_load_unique(b, e, fill_factor,
+                            sorted_range_tag<InputIterator>());
+}
+
+template <typename P>
+template <typename InputIterator>
+void btree<P>::bulk_load_multi(InputIterator b, InputIterator e,
+                               double fill_factor) {
+  clear();
+  internal_bulk_load_multi(b, e, fill_factor,
+                           sorted_range_tag<InputIterator>());
+}
+
+template <typename P>
+template <typename InputIterator>
+void btree<P>::internal_bulk_load_unique(InputIterator b, InputIterator e,
+                                         double /*fill_factor*/,
+                                         std::input_iterator_tag) {
+  insert_iterator_unique(b, e);
+}
+
+template <typename P>
+template <typename ForwardIterator>
+void btree<P>::internal_bulk_load_unique(ForwardIterator b, ForwardIterator e,
+                                         double fill_factor,
+                                         std::forward_iterator_tag) {
+  size_type n = 0;
+  if (count_merged_unique(b, e, &n)) {
+    internal_merge_unique(b, e, n, fill_factor, nullptr);
+  } else {
+    insert_iterator_unique(b, e);
+  }
+}
+
+template <typename P>
+template <typename InputIterator>
+void btree<P>::internal_bulk_load_multi(InputIterator b, InputIterator e,
+                                        double /*fill_factor*/,
+                                        std::input_iterator_tag) {
+  insert_iterator_multi(b, e);
+}
+
+template <typename P>
+template <typename ForwardIterator>
+void btree<P>::internal_bulk_load_multi(ForwardIterator b, ForwardIterator e,
+                                        double fill_factor,
+                                        std::forward_iterator_tag) {
+  if (is_sorted_range(b, e)) {
+    internal_merge_multi(b, e, static_cast<size_type>(std::distance(b, e)),
+                         fill_factor);
+  } else {
+    insert_iterator_multi(b, e);
+  }
+}
+
+template <typename P>
+template <typename InputIterator>
+void btree<P>::insert_sorted_unique(InputIterator b, InputIterator e) {
+  insert_sorted_unique(b, e, sorted_range_tag<InputIterator>());
+}
+
+template <typename P>
+template <typename InputIterator>
+void btree<P>::insert_sorted_unique(InputIterator b, InputIterator e,
+                                    std::input_iterator_tag) {
+  if (b == e) return;
+  iterator hint = lower_bound(params_type::key(*b));
+  for (; b != e; ++b) {
+    // For sorted input the next value usually belongs right after the
+    // previous one, which insert_hint_unique() handles without a descent.
+    hint = insert_hint_unique(hint, params_type::key(*b), *b).first;
+    ++hint;
+  }
+}
+
+template <typename P>
+template <typename ForwardIterator>
+void btree<P>::insert_sorted_unique(ForwardIterator b, ForwardIterator e,
+                                    std::forward_iterator_tag) {
+  size_type n = 0;
+  if (prefer_linear_merge(static_cast<size_type>(std::distance(b, e))) &&
+      count_merged_unique(b, e, &n)) {
+    internal_merge_unique(b, e, n, 1.0, nullptr);
+  } else {
+    insert_sorted_unique(b, e, std::input_iterator_tag());
+  }
+}
+
+template <typename P>
+template <typename InputIterator>
+void btree<P>::insert_sorted_multi(InputIterator b, InputIterator e) {
+  insert_sorted_multi(b, e, sorted_range_tag<InputIterator>());
+}
+
+template <typename P>
+template <typename InputIterator>
+void btree<P>::insert_sorted_multi(InputIterator b, InputIterator e,
+                                   std::input_iterator_tag) {
+  if (b == e) return;
+  iterator hint = upper_bound(params_type::key(*b));
+  for (; b != e; ++b) {
+    hint = insert_hint_multi(hint, *b);
+    ++hint;
+  }
+}
+
+template <typename P>
+template <typename ForwardIterator>
+void btree<P>::insert_sorted_multi(ForwardIterator b, ForwardIterator e,
+                                   std::forward_iterator_tag) {
+  const size_type n = static_cast<size_type>(std::distance(b, e));
+  if (prefer_linear_merge(n) && is_sorted_range(b, e)) {
+    internal_merge_multi(b, e, size() + n, 1.0);
+  } else {
+    insert_sorted_multi(b, e, std::input_iterator_tag());
+  }
+}
+
+template <typename P>
+template <typename Container>
+void btree<P>::merge_unique(Container *src) {
+  if (merge_unique_linear(src, std::is_copy_constructible<value_type>())) {
+    return;
+  }
+  for (auto src_it = src->begin(); src_it != src->end();) {
+    if (insert_unique(params_type::key(*src_it), std::move(*src_it)).second) {
+      src_it = src->erase(src_it);
+    } else {
+      ++src_it;
+    }
+  }
+}
+
+template <typename P>
+template <typename Container>
+bool btree<P>::merge_unique_linear(Container *src, std::true_type) {
+  size_type n = 0;
+  if (!prefer_linear_merge(src->size()) ||
+      !count_merged_unique(src->begin(), src->end(), &n)) {
+    return false;
+  }
+  std::vector<size_type> skipped;
+  internal_merge_unique(src->begin(), src->end(), n, 1.0, &skipped);
+  // Erase the merged runs of `src` in between the skipped values.
+  auto it = src->begin();
+  size_type offset = 0;
+  for (size_type next : skipped) {
+    auto run_end = std::next(it, next - offset);
+    it = src->erase(it, run_end);
+    ++it;
+    offset = next + 1;
+  }
+  src->erase(it, src->end());
+  return true;
+}
+
+template <typename P>
+template <typename Container>
+void btree<P>::merge_multi(Container *src) {
+  if (!merge_multi_linear(src, std::is_copy_constructible<value_type>())) {
+    insert_iterator_multi(std::make_move_iterator(src->begin()),
+                          std::make_move_iterator(src->end()));
+  }
+  src->clear();
+}
+
+template <typename P>
+template <typename Container>
+bool btree<P>::merge_multi_linear(Container *src, std::true_type) {
+  if (!prefer_linear_merge(src->size()) ||
+      !is_sorted_range(src->begin(), src->end())) {
+    return false;
+  }
+  internal_merge_multi(src->begin(), src->end(), size() + src->size(), 1.0);
+  return true;
+}
+
+template <typename P>
+template <typename ForwardIterator>
+bool btree<P>::count_merged_unique(ForwardIterator b, ForwardIterator e,
+                                   size_type *n) const {
+  size_type count = 0;
+  const_iterator a = begin();
+  const const_iterator a_end = end();
+  ForwardIterator prev = b;
+  for (bool first = true; b != e; first = false, prev = b, ++b) {
+    const key_type &key = params_type::key(*b);
+    if (!first) {
+      const key_type &prev_key = params_type::key(*prev);
+      if (compare_keys(key, prev_key)) return false;
+      // Equivalent to its predecessor, which was either taken or matched a
+      // value of the tree.
+      if (!compare_keys(prev_key, key)) continue;
+    }
+    for (; a != a_end && compare_keys(a.key(), key); ++a) ++count;
+    if (a == a_end || compare_keys(key, a.key())) ++count;
+  }
+  for (; a != a_end; ++a) ++count;
+  *n = count;
+  return true;
+}
+
+template <typename P>
+template <typename ForwardIterator>
+bool btree<P>::is_sorted_range(ForwardIterator b, ForwardIterator e) const {
+  if (b == e) return true;
+  for (ForwardIterator prev = b; ++b != e; prev = b) {
+    if (compare_keys(params_type::key(*b), params_type::key(*prev))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename P>
+template <typename ForwardIterator>
+void btree<P>::internal_merge_unique(ForwardIterator b, ForwardIterator e,
+                                     size_type n, double fill_factor,
+                                     std::vector<size_type> *skipped) {
+  btree merged(key_comp(), allocator());
+  {
+    sorted_builder builder(&merged, n, fill_factor);
+    iterator a = begin();
+    const iterator a_end = end();
+    // The key of the last value handed to the builder, which lives in its
+    // final slot and therefore stays valid.
+    const key_type *last = nullptr;
+    for (size_type offset = 0; b != e; ++b, ++offset) {
+      const key_type &key = params_type::key(*b);
+      for (; a != a_end && compare_keys(a.key(), key); ++a) {
+        last = &append_copy(&builder, a);
+      }
+      if ((last != nullptr && !compare_keys(*last, key)) ||
+          (a != a_end && !compare_keys(key, a.key()))) {
+        if (skipped != nullptr) skipped->push_back(offset);
+        continue;
+      }
+      last = &builder.append(*b);
+    }
+    for (; a != a_end; ++a) append_copy(&builder, a);
+    builder.finish();
+  }
+  swap(merged);
+}
+
+template <typename P>
+template <typename ForwardIterator>
+void btree<P>::internal_merge_multi(ForwardIterator b, ForwardIterator e,
+                                    size_type n, double fill_factor) {
+  btree merged(key_comp(), allocator());
+  {
+    sorted_builder builder(&merged, n, fill_factor);
+    iterator a = begin();
+    const iterator a_end = end();
+    for (; b != e; ++b) {
+      const key_type &key = params_type::key(*b);
+      for (; a != a_end && !compare_keys(key, a.key()); ++a) {
+        append_copy(&builder, a);
+      }
+      builder.append(*b);
+    }
+    for (; a != a_end; ++a) append_copy(&builder, a);
+    builder.finish();
+  }
+  swap(merged);
+}
+
+////
+// btree::sorted_builder
+//
+// The shape of the tree is planned up front from the final number of values.
+// A level with `nodes` nodes and `values` values gives node i
+// values / nodes values, plus one if i < values % nodes. Values are appended
+// to the rightmost leaf until it reaches its planned size; the next value
+// becomes the delimiting key on the lowest ancestor with room left and a fresh
+// chain of nodes is started below it. Every node is allocated exactly once
+// and no value is moved after it has been constructed.
+template <typename P>
+class btree<P>::sorted_builder {
+ public:
+  // Prepares to build a tree of exactly `n` values into `tree`, which must be
+  // empty. Nodes are planned at `fill_factor` of their capacity, but at no
+  // less than half of it. A level's values are then spread evenly over as
+  // few nodes as hold them at that size, so a node may end up with about half
+  // of the planned count: a quarter of its capacity at the lowest fill.
+  sorted_builder(btree *tree, size_type n, double fill_factor);
+  sorted_builder(const sorted_builder &) = delete;
+  sorted_builder &operator=(const sorted_builder &) = delete;
+  ~sorted_builder() { release(); }
+
+  // Constructs the next value from `args` and returns its key.
+  template <typename... Args>
+  const key_type &append(Args &&... args);
+
+  // Hands the tree over to `tree`. All `n` values must have been appended.
+  void finish();
+
+ private:
+  struct level {
+    size_type nodes;   // The number of nodes on the level.
+    size_type values;  // The number of values on the level.
+    size_type index;   // The index of the node being filled.
+    size_type target;  // The number of values planned for that node.
+    node_type *node;   // The node being filled, or null if not started.
+  };
+
+  // Every node has at least two children, so this bounds the height.
+  enum { kMaxHeight = 8 * sizeof(size_type) };
+
+  // Starts node `index` of level `l` as the last child of `parent`.
+  void start_node(int l, size_type index, node_type *parent);
+
+  // Deletes the partially built tree after an exception.
+  void release();
+
+  btree *tree_;
+  size_type size_;
+  int height_;
+  level levels_[kMaxHeight];
+};
+
+template <typename P>
+btree<P>::sorted_builder::sorted_builder(btree *tree, size_type n,
+                                         double fill_factor)
+    : tree_(tree), size_(n), height_(0) {
+  assert(tree_->empty());
+  if (n == 0) return;
+  // A node needs at least 2 values so that every internal node of an evenly
+  // split level keeps at least 2 children.
+  const double fill = (std::min)((std::max)(fill_factor, 0.0), 1.0);
+  const size_type target = (std::max)(
+      static_cast<size_type>((std::max)(2, static_cast<int>(kMinNodeValues))),
+      static_cast<size_type>(fill * kNodeValues + 0.5));
+
+  // `nodes` leaves hold all values but the `nodes - 1` delimiting keys, so
+  // `nodes * (target + 1) - 1` values fit.
+  size_type nodes = (n + target + 1) / (target + 1);
+  levels_[0] = level{nodes, n - (nodes - 1), 0, 0, nullptr};
+  // `nodes` internal nodes with `children` children hold `children - nodes`
+  // values.
+  while (levels_[height_].nodes > 1) {
+    const size_type children = levels_[height_].nodes;
+    nodes = (children + target) / (target + 1);
+    ++height_;
+    assert(height_ < kMaxHeight);
+    levels_[height_] = level{nodes, children - nodes, 0, 0, nullptr};
+  }
+  ++height_;
+
+  ABEL_INTERNAL_TRY {
+    node_type *parent = nullptr;
+    for (int l = height_ - 1; l >= 0; --l) {
+      start_node(l, 0, parent);
+      parent = levels_[l].node;
+    }
+  }
+  ABEL_INTERNAL_CATCH_ANY {
+    release();
+    ABEL_INTERNAL_RETHROW;
+  }
+  // The parent of the root is the leftmost leaf.
+  levels_[height_ - 1].node->set_parent(levels_[0].node);
+}
+
+template <typename P>
+void btree<P>::sorted_builder::start_node(int l, size_type index,
+                                          node_type *parent) {
+  level &lv = levels_[l];
+  assert(index < lv.nodes);
+  lv.index = index;
+  lv.target = lv.values / lv.nodes + (index < lv.values % lv.nodes ? 1 : 0);
+  if (l > 0) {
+    lv.node = tree_->new_internal_node(parent);
+  } else if (height_ == 1) {
+    lv.node = tree_->new_leaf_root_node(static_cast<int>(size_));
+  } else {
+    lv.node = tree_->new_leaf_node(parent);
+  }
+  if (parent != nullptr) parent->init_child(parent->count(), lv.node);
+}
+
+template <typename P>
+template <typename... Args>
+auto btree<P>::sorted_builder::append(Args &&... args) -> const key_type & {
+  node_type *node = levels_[0].node;
+  if (node->count() < levels_[0].target) {
+    node->emplace_value(node->count(), tree_->mutable_allocator(),
+                        std::forward<Args>(args)...);
+    return node->key(node->count() - 1);
+  }
+  int l = 1;
+  while (levels_[l].node->count() == levels_[l].target) {
+    ++l;
+    assert(l < height_);
+  }
+  node = levels_[l].node;
+  node->emplace_value(node->count(), tree_->mutable_allocator(),
+                      std::forward<Args>(args)...);
+  const key_type &key = node->key(node->count() - 1);
+  // The completed nodes below are now owned by `node`.
+  for (int i = 0; i < l; ++i) levels_[i].node = nullptr;
+  for (int i = l - 1; i >= 0; --i) {
+    start_node(i, levels_[i].index + 1, node);
+    node = levels_[i].node;
+  }
+  return key;
+}
+
+template <typename P>
+void btree<P>::sorted_builder::finish() {
+  if (size_ == 0) return;
+  for (int l = 0; l < height_; ++l) {
+    assert(levels_[l].index + 1 == levels_[l].nodes);
+    assert(levels_[l].node->count() == levels_[l].target);
+  }
+  tree_->mutable_root() = levels_[height_ - 1].node;
+  tree_->rightmost_ = levels_[0].node;
+  tree_->size_ = size_;
+  height_ = 0;
+}
+
+template <typename P>
+void btree<P>::sorted_builder::release() {
+  for (int l = height_ - 1; l >= 0 && levels_[l].node != nullptr; --l) {
+    node_type *node = levels_[l].node;
+    if (l == 0) {
+      tree_->delete_leaf_node(node);
+      break;
+    }
+    // Children [0, count) are complete subtrees. Child `count`, if attached,
+    // is the node being filled on the level below.
+    for (int i = 0; i < node->count(); ++i) {
+      tree_->internal_clear(node->child(i));
+    }
+    tree_->delete_internal_node(node);
+  }
+  height_ = 0;
+}
+
 template <typename P>
 auto btree<P>::operator=(const btree &x) -> btree & {
   if (this != &x) {
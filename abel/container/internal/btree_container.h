@@ -277,11 +277,19 @@ class btree_set_container : public btree_container<Tree> {
   }
   template <typename InputIterator>
   void insert(InputIterator b, InputIterator e) {
-    this->tree_.insert_iterator_unique(b, e);
+    this->tree_.insert_sorted_unique(b, e);
   }
   void insert(std::initializer_list<init_type> init) {
     this->tree_.insert_iterator_unique(init.begin(), init.end());
   }
+  template <typename InputIterator>
+  void insert_sorted_range(InputIterator b, InputIterator e) {
+    this->tree_.insert_sorted_unique(b, e);
+  }
+  template <typename InputIterator>
+  void bulk_load(InputIterator b, InputIterator e, double fill_factor = 1.0) {
+    this->tree_.bulk_load_unique(b, e, fill_factor);
+  }
   insert_return_type insert(node_type &&node) {
     if (!node) return {this->end(), false, node_type()};
     std::pair<iterator, bool> res =
@@ -331,13 +339,7 @@ class btree_set_container : public btree_container<Tree> {
                            typename T::params_type::is_map_container>>::value,
           int> = 0>
   void merge(btree_container<T> &src) {  // NOLINT
-    for (auto src_it = src.begin(); src_it != src.end();) {
-      if (insert(std::move(*src_it)).second) {
-        src_it = src.erase(src_it);
-      } else {
-        ++src_it;
-      }
-    }
+    this->tree_.merge_unique(&src);
   }
 
   template <
@@ -499,11 +501,19 @@ class btree_multiset_container : public btree_container<Tree> {
   }
   template <typename InputIterator>
   void insert(InputIterator b, InputIterator e) {
-    this->tree_.insert_iterator_multi(b, e);
+    this->tree_.insert_sorted_multi(b, e);
   }
   void insert(std::initializer_list<init_type> init) {
     this->tree_.insert_iterator_multi(init.begin(), init.end());
   }
+  template <typename InputIterator>
+  void insert_sorted_range(InputIterator b, InputIterator e) {
+    this->tree_.insert_sorted_multi(b, e);
+  }
+  template <typename InputIterator>
+  void bulk_load(InputIterator b, InputIterator e, double fill_factor = 1.0) {
+    this->tree_.bulk_load_multi(b, e, fill_factor);
+  }
   template <typename... Args>
   iterator emplace(Args &&... args) {
     return this->tree_.insert_multi(init_type(std::forward<Args>(args)...));
@@ -557,9 +567,7 @@ class btree_multiset_container : public btree_container<Tree> {
                            typename T::params_type::is_map_container>>::value,
           int> = 0>
   void merge(btree_container<T> &src) {  // NOLINT
-    insert(std::make_move_iterator(src.begin()),
-           std::make_move_iterator(src.end()));
-    src.clear();
+    this->tree_.merge_multi(&src);
   }
 
   template <
@@ -35,6 +35,13 @@ using IsMemcpyOk =
                       abel::is_trivially_copy_assignable<ValueType>,
                       abel::is_trivially_destructible<ValueType>>;
 
+template <typename AllocatorType,
+          typename ValueType =
+              typename abel::allocator_traits<AllocatorType>::value_type>
+using IsRelocateOk =
+    abel::conjunction<std::is_same<AllocatorType, std::allocator<ValueType>>,
+                      abel::is_trivially_relocatable<ValueType>>;
+
 template <typename AllocatorType, typename Pointer, typename SizeType>
 void DestroyElements(AllocatorType* alloc_ptr, Pointer destroy_first,
                      SizeType destroy_size) {
@@ -78,6 +85,21 @@ void ConstructElements(AllocatorType* alloc_ptr, Pointer construct_first,
   }
 }
 
+// Moves `relocate_size` elements from `relocate_from` to the uninitialized
+// `relocate_to`, which may overlap. Only valid if `IsRelocateOk`; the
+// elements at `relocate_from` must not be destroyed afterwards.
+template <typename Pointer, typename SizeType>
+void RelocateElements(Pointer relocate_to, Pointer relocate_from,
+                      SizeType relocate_size) {
+  using ValueType = typename std::iterator_traits<Pointer>::value_type;
+
+  // Cast to `void*` to tell the compiler that we don't care that the type is
+  // not trivially copyable.
+  std::memmove(static_cast<void*>(relocate_to),
+               static_cast<const void*>(relocate_from),
+               relocate_size * sizeof(ValueType));
+}
+
 template <typename Pointer, typename ValueAdapter, typename SizeType>
 void AssignElements(Pointer assign_first, ValueAdapter* values_ptr,
                     SizeType assign_size) {
@@ -257,6 +279,7 @@ class Storage {
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
   using MoveIterator = std::move_iterator<iterator>;
   using IsMemcpyOk = inlined_vector_internal::IsMemcpyOk<allocator_type>;
+  using IsRelocateOk = inlined_vector_internal::IsRelocateOk<allocator_type>;
 
   using StorageView = inlined_vector_internal::StorageView<allocator_type>;
 
@@ -419,7 +442,7 @@ class Storage {
   }
 
   void MemcpyFrom(const Storage& other_storage) {
-    assert(IsMemcpyOk::value || other_storage.GetIsAllocated());
+    assert(IsRelocateOk::value || other_storage.GetIsAllocated());
 
     GetSizeAndIsAllocated() = other_storage.GetSizeAndIsAllocated();
     data_ = other_storage.data_;
@@ -558,12 +581,17 @@ auto Storage<T, N, A>::Resize(ValueAdapter values, size_type new_size) -> void {
   construction_tx.Construct(construct_loop.data(), &values,
                             construct_loop.size());
 
-  inlined_vector_internal::ConstructElements(
-      GetAllocPtr(), move_construct_loop.data(), &move_values,
-      move_construct_loop.size());
+  if (IsRelocateOk::value && allocation_tx.DidAllocate()) {
+    inlined_vector_internal::RelocateElements(
+        move_construct_loop.data(), storage_view.data, storage_view.size);
+  } else {
+    inlined_vector_internal::ConstructElements(
+        GetAllocPtr(), move_construct_loop.data(), &move_values,
+        move_construct_loop.size());
 
-  inlined_vector_internal::DestroyElements(GetAllocPtr(), destroy_loop.data(),
-                                           destroy_loop.size());
+    inlined_vector_internal::DestroyElements(
+        GetAllocPtr(), destroy_loop.data(), destroy_loop.size());
+  }
 
   construction_tx.Commit();
   if (allocation_tx.DidAllocate()) {
@@ -599,14 +627,22 @@ auto Storage<T, N, A>::Insert(const_iterator pos, ValueAdapter values,
 
     construction_tx.Construct(new_data + insert_index, &values, insert_count);
 
-    move_construciton_tx.Construct(new_data, &move_values, insert_index);
+    if (IsRelocateOk::value) {
+      inlined_vector_internal::RelocateElements(new_data, storage_view.data,
+                                                insert_index);
+      inlined_vector_internal::RelocateElements(
+          new_data + insert_end_index, storage_view.data + insert_index,
+          storage_view.size - insert_index);
+    } else {
+      move_construciton_tx.Construct(new_data, &move_values, insert_index);
 
-    inlined_vector_internal::ConstructElements(
-        GetAllocPtr(), new_data + insert_end_index, &move_values,
-        storage_view.size - insert_index);
+      inlined_vector_internal::ConstructElements(
+          GetAllocPtr(), new_data + insert_end_index, &move_values,
+          storage_view.size - insert_index);
 
-    inlined_vector_internal::DestroyElements(GetAllocPtr(), storage_view.data,
-                                             storage_view.size);
+      inlined_vector_internal::DestroyElements(
+          GetAllocPtr(), storage_view.data, storage_view.size);
+    }
 
     construction_tx.Commit();
     move_construciton_tx.Commit();
@@ -615,6 +651,25 @@ auto Storage<T, N, A>::Insert(const_iterator pos, ValueAdapter values,
 
     SetAllocatedSize(new_size);
     return iterator(new_data + insert_index);
+  } else if (IsRelocateOk::value) {
+    // Opens a gap by shifting the tail and constructs the new elements in it.
+    pointer insert_data = storage_view.data + insert_index;
+    size_type tail_size = storage_view.size - insert_index;
+
+    inlined_vector_internal::RelocateElements(insert_data + insert_count,
+                                              insert_data, tail_size);
+    ABEL_INTERNAL_TRY {
+      inlined_vector_internal::ConstructElements(GetAllocPtr(), insert_data,
+                                                 &values, insert_count);
+    }
+    ABEL_INTERNAL_CATCH_ANY {
+      inlined_vector_internal::RelocateElements(
+          insert_data, insert_data + insert_count, tail_size);
+      ABEL_INTERNAL_RETHROW;
+    }
+
+    AddSize(insert_count);
+    return iterator(insert_data);
   } else {
     size_type move_construction_destination_index =
         (std::max)(insert_end_index, storage_view.size);
@@ -692,18 +747,23 @@ auto Storage<T, N, A>::EmplaceBack(Args&&... args) -> reference {
                              std::forward<Args>(args)...);
 
   if (allocation_tx.DidAllocate()) {
-    ABEL_INTERNAL_TRY {
-      inlined_vector_internal::ConstructElements(
-          GetAllocPtr(), allocation_tx.GetData(), &move_values,
-          storage_view.size);
+    if (IsRelocateOk::value) {
+      inlined_vector_internal::RelocateElements(
+          allocation_tx.GetData(), storage_view.data, storage_view.size);
+    } else {
+      ABEL_INTERNAL_TRY {
+        inlined_vector_internal::ConstructElements(
+            GetAllocPtr(), allocation_tx.GetData(), &move_values,
+            storage_view.size);
+      }
+      ABEL_INTERNAL_CATCH_ANY {
+        AllocatorTraits::destroy(*GetAllocPtr(), last_ptr);
+        ABEL_INTERNAL_RETHROW;
+      }
+
+      inlined_vector_internal::DestroyElements(
+          GetAllocPtr(), storage_view.data, storage_view.size);
     }
-    ABEL_INTERNAL_CATCH_ANY {
-      AllocatorTraits::destroy(*GetAllocPtr(), last_ptr);
-      ABEL_INTERNAL_RETHROW;
-    }
-
-    inlined_vector_internal::DestroyElements(GetAllocPtr(), storage_view.data,
-                                             storage_view.size);
 
     DeallocateIfAllocated();
     AcquireAllocatedData(&allocation_tx);
@@ -724,16 +784,25 @@ auto Storage<T, N, A>::Erase(const_iterator from, const_iterator to)
       std::distance(const_iterator(storage_view.data), from);
   size_type erase_end_index = erase_index + erase_size;
 
-  IteratorValueAdapter<MoveIterator> move_values(
-      MoveIterator(storage_view.data + erase_end_index));
+  if (IsRelocateOk::value) {
+    inlined_vector_internal::DestroyElements(
+        GetAllocPtr(), storage_view.data + erase_index, erase_size);
 
-  inlined_vector_internal::AssignElements(storage_view.data + erase_index,
-                                          &move_values,
-                                          storage_view.size - erase_end_index);
+    inlined_vector_internal::RelocateElements(
+        storage_view.data + erase_index, storage_view.data + erase_end_index,
+        storage_view.size - erase_end_index);
+  } else {
+    IteratorValueAdapter<MoveIterator> move_values(
+        MoveIterator(storage_view.data + erase_end_index));
+
+    inlined_vector_internal::AssignElements(
+        storage_view.data + erase_index, &move_values,
+        storage_view.size - erase_end_index);
 
-  inlined_vector_internal::DestroyElements(
-      GetAllocPtr(), storage_view.data + (storage_view.size - erase_size),
-      erase_size);
+    inlined_vector_internal::DestroyElements(
+        GetAllocPtr(), storage_view.data + (storage_view.size - erase_size),
+        erase_size);
+  }
 
   SubtractSize(erase_size);
   return iterator(storage_view.data + erase_index);
@@ -754,11 +823,16 @@ auto Storage<T, N, A>::Reserve(size_type requested_capacity) -> void {
       ComputeCapacity(storage_view.capacity, requested_capacity);
   pointer new_data = allocation_tx.Allocate(new_capacity);
 
-  inlined_vector_internal::ConstructElements(GetAllocPtr(), new_data,
-                                             &move_values, storage_view.size);
+  if (IsRelocateOk::value) {
+    inlined_vector_internal::RelocateElements(new_data, storage_view.data,
+                                              storage_view.size);
+  } else {
+    inlined_vector_internal::ConstructElements(GetAllocPtr(), new_data,
+                                               &move_values, storage_view.size);
 
-  inlined_vector_internal::DestroyElements(GetAllocPtr(), storage_view.data,
-                                           storage_view.size);
+    inlined_vector_internal::DestroyElements(GetAllocPtr(), storage_view.data,
+                                             storage_view.size);
+  }
 
   DeallocateIfAllocated();
   AcquireAllocatedData(&allocation_tx);
@@ -788,17 +862,22 @@ auto Storage<T, N, A>::ShrinkToFit() -> void {
     construct_data = GetInlinedData();
   }
 
-  ABEL_INTERNAL_TRY {
-    inlined_vector_internal::ConstructElements(GetAllocPtr(), construct_data,
-                                               &move_values, storage_view.size);
-  }
-  ABEL_INTERNAL_CATCH_ANY {
-    SetAllocatedData(storage_view.data, storage_view.capacity);
-    ABEL_INTERNAL_RETHROW;
-  }
+  if (IsRelocateOk::value) {
+    inlined_vector_internal::RelocateElements(construct_data, storage_view.data,
+                                              storage_view.size);
+  } else {
+    ABEL_INTERNAL_TRY {
+      inlined_vector_internal::ConstructElements(
+          GetAllocPtr(), construct_data, &move_values, storage_view.size);
+    }
+    ABEL_INTERNAL_CATCH_ANY {
+      SetAllocatedData(storage_view.data, storage_view.capacity);
+      ABEL_INTERNAL_RETHROW;
+    }
 
-  inlined_vector_internal::DestroyElements(GetAllocPtr(), storage_view.data,
-                                           storage_view.size);
+    inlined_vector_internal::DestroyElements(
+        GetAllocPtr(), storage_view.data, storage_view.size);
+  }
 
   AllocatorTraits::deallocate(*GetAllocPtr(), storage_view.data,
                               storage_view.capacity);
@@ -817,6 +896,10 @@ auto Storage<T, N, A>::Swap(Storage* other_storage_ptr) -> void {
 
   if (GetIsAllocated() && other_storage_ptr->GetIsAllocated()) {
     swap(data_.allocated, other_storage_ptr->data_.allocated);
+  } else if (IsRelocateOk::value) {
+    // Either both are inlined or the inlined elements can change places with
+    // the allocation by copying bytes.
+    swap(data_, other_storage_ptr->data_);
   } else if (!GetIsAllocated() && !other_storage_ptr->GetIsAllocated()) {
     Storage* small_ptr = this;
     Storage* large_ptr = other_storage_ptr;
@@ -0,0 +1,488 @@
+//
+
+#ifndef ABEL_CONTAINER_INTRUSIVE_HASH_SET_H_
+#define ABEL_CONTAINER_INTRUSIVE_HASH_SET_H_
+
+#include <abel/base/profile.h>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace abel {
+
+// The hook of an element of an intrusive_hash_set. Element types derive from
+// it, and may also derive from intrusive_list_node to be on a list at the same
+// time:
+//
+//   struct entry : abel::intrusive_hash_node, abel::intrusive_list_node {
+//       std::string key;
+//       ...
+//   };
+//
+// The hash of the element is cached in the hook, so that resizing never calls
+// the hash function and most mismatches in a bucket are rejected without
+// calling the equality function.
+struct intrusive_hash_node {
+    intrusive_hash_node *hash_next;
+    size_t hash_value;
+
+    intrusive_hash_node () {
+        hash_next = nullptr;
+        hash_value = 0;
+    }
+};
+
+template<typename T, typename Hash, typename Equal>
+class intrusive_hash_set;
+
+template<typename T, typename Set, typename Pointer, typename Reference>
+class intrusive_hash_set_iterator {
+public:
+    typedef intrusive_hash_set_iterator<T, Set, Pointer, Reference> this_type;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Pointer pointer;
+    typedef Reference reference;
+    typedef std::forward_iterator_tag iterator_category;
+
+public:
+    intrusive_hash_set_iterator () : _set(nullptr), _node(nullptr), _table(0), _bucket(0) { }
+    // Converts an iterator to a const_iterator.
+    template<typename P, typename R,
+        typename = typename std::enable_if<std::is_convertible<P, Pointer>::value>::type>
+    intrusive_hash_set_iterator (const intrusive_hash_set_iterator<T, Set, P, R> &x)
+        : _set(x._set), _node(x._node), _table(x._table), _bucket(x._bucket) { }
+
+    reference operator * () const { return *static_cast<pointer>(_node); }
+    pointer operator -> () const { return static_cast<pointer>(_node); }
+
+    this_type &operator ++ ();
+    this_type operator ++ (int) {
+        this_type it(*this);
+        ++*this;
+        return it;
+    }
+
+    template<typename P, typename R>
+    bool operator == (const intrusive_hash_set_iterator<T, Set, P, R> &x) const {
+        return _node == x._node;
+    }
+    template<typename P, typename R>
+    bool operator != (const intrusive_hash_set_iterator<T, Set, P, R> &x) const {
+        return _node != x._node;
+    }
+
+private:
+    template<typename, typename, typename, typename>
+    friend class intrusive_hash_set_iterator;
+    template<typename, typename, typename>
+    friend class intrusive_hash_set;
+
+    intrusive_hash_set_iterator (const Set *set, intrusive_hash_node *node, int table, size_t bucket)
+        : _set(set), _node(node), _table(table), _bucket(bucket) { }
+
+    const Set *_set;
+    intrusive_hash_node *_node;
+    // The bucket array (0: current, 1: the one being migrated from) and the
+    // bucket of `_node`.
+    int _table;
+    size_t _bucket;
+};
+
+// intrusive_hash_set
+//
+// A chained hash set of objects that carry their own hook, so that inserting
+// and erasing never allocate and a lookup touches the bucket array and the
+// elements only. The set does not own its elements: they must outlive their
+// membership, and erasing only unlinks them.
+//
+// `Hash` and `Equal` are called on elements, and on any key type that find(),
+// count() and erase() are used with; a functor that accepts both the element
+// and its key allows lookups without building an element:
+//
+//   struct entry_hash {
+//       size_t operator () (const entry &e) const { return std::hash<std::string>()(e.key); }
+//       size_t operator () (const std::string &k) const { return std::hash<std::string>()(k); }
+//   };
+//
+// The bucket array doubles when the number of elements reaches the number of
+// buckets. The elements are not rehashed at once: each later insert or erase
+// moves a few buckets of the old array to the new one, and lookups check the
+// array that holds the bucket of their hash, so no single operation pays for
+// a full rehash. Inserting invalidates iterators; erasing invalidates
+// iterators to the erased element only.
+template<typename T, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+class intrusive_hash_set {
+public:
+    typedef intrusive_hash_set<T, Hash, Equal> this_type;
+    typedef T value_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef T *pointer;
+    typedef const T *const_pointer;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef Hash hasher;
+    typedef Equal key_equal;
+    typedef intrusive_hash_set_iterator<T, this_type, T *, T &> iterator;
+    typedef intrusive_hash_set_iterator<T, this_type, const T *, const T &> const_iterator;
+
+public:
+    explicit intrusive_hash_set (size_t bucket_count = 0, const Hash &hash = Hash(),
+                                 const Equal &equal = Equal());
+    intrusive_hash_set (const this_type &) = delete;
+    this_type &operator = (const this_type &) = delete;
+    // Unlinks all elements.
+    ~intrusive_hash_set ();
+
+    iterator begin () ABEL_NOEXCEPT;
+    const_iterator begin () const ABEL_NOEXCEPT;
+    const_iterator cbegin () const ABEL_NOEXCEPT { return begin(); }
+    iterator end () ABEL_NOEXCEPT { return iterator(); }
+    const_iterator end () const ABEL_NOEXCEPT { return const_iterator(); }
+    const_iterator cend () const ABEL_NOEXCEPT { return const_iterator(); }
+
+    bool empty () const ABEL_NOEXCEPT { return _size == 0; }
+    size_t size () const ABEL_NOEXCEPT { return _size; }
+    size_t bucket_count () const ABEL_NOEXCEPT { return _mask + 1; }
+    // True while buckets of the previous array remain to be moved.
+    bool rehashing () const ABEL_NOEXCEPT { return _old != nullptr; }
+
+    // Links `x` unless an equal element is present; returns the element with
+    // its key and whether `x` was inserted.
+    std::pair<iterator, bool> insert (value_type &x);
+
+    template<typename K>
+    iterator find (const K &key);
+    template<typename K>
+    const_iterator find (const K &key) const;
+    template<typename K>
+    size_t count (const K &key) const { return find(key) != end() ? 1 : 0; }
+    template<typename K>
+    bool contains (const K &key) const { return find(key) != end(); }
+
+    // Unlinks the element equal to `key`; returns the number unlinked.
+    template<typename K>
+    size_t erase (const K &key);
+    // Unlinks `pos` and returns the element after it.
+    iterator erase (const_iterator pos);
+    iterator erase (iterator pos) { return erase(const_iterator(pos)); }
+    // Unlinks `x`, which must be in the set.
+    void remove (value_type &x);
+
+    // Unlinks all elements.
+    void clear () ABEL_NOEXCEPT;
+
+    // Finishes any rehash and resizes the bucket array to hold `n` elements
+    // without growing.
+    void reserve (size_t n);
+
+private:
+    typedef intrusive_hash_node *bucket_type;
+
+    // Buckets moved by each insert and erase while rehashing. With the array
+    // doubling when the size reaches the bucket count, one is enough to
+    // finish before the next resize; two keep the old array short-lived.
+    static constexpr size_t kRehashStep = 2;
+    static constexpr size_t kMinBuckets = 8;
+
+    template<typename K>
+    intrusive_hash_node *find_node (const K &key, size_t hash, int *table, size_t *bucket) const;
+    // The bucket array and index that hold elements with hash `hash`.
+    bucket_type *bucket_for (size_t hash, int *table, size_t *bucket) const;
+    void unlink (intrusive_hash_node *node, bucket_type *slot);
+    iterator first_from (int table, size_t bucket) const;
+    void grow (size_t bucket_count);
+    void rehash_step (size_t n);
+    void finish_rehash () { rehash_step(static_cast<size_t>(-1)); }
+
+    friend iterator;
+    friend const_iterator;
+
+    std::unique_ptr<bucket_type[]> _buckets;
+    size_t _mask;
+    size_t _size;
+    // The previous bucket array, whose buckets below `_old_index` have been
+    // moved to `_buckets`.
+    std::unique_ptr<bucket_type[]> _old;
+    size_t _old_mask;
+    size_t _old_index;
+    Hash _hash;
+    Equal _equal;
+};
+
+template<typename T, typename Set, typename Pointer, typename Reference>
+inline
+typename intrusive_hash_set_iterator<T, Set, Pointer, Reference>::this_type &
+intrusive_hash_set_iterator<T, Set, Pointer, Reference>::operator ++ () {
+    if (_node->hash_next != nullptr) {
+        _node = _node->hash_next;
+    } else {
+        *this = this_type(_set->first_from(_table, _bucket + 1));
+    }
+    return *this;
+}
+
+template<typename T, typename Hash, typename Equal>
+inline
+intrusive_hash_set<T, Hash, Equal>::intrusive_hash_set (size_t bucket_count, const Hash &hash,
+                                                        const Equal &equal)
+    : _mask(0), _size(0), _old_mask(0), _old_index(0), _hash(hash), _equal(equal) {
+    size_t n = kMinBuckets;
+    while (n < bucket_count) {
+        n *= 2;
+    }
+    _buckets.reset(new bucket_type[n]());
+    _mask = n - 1;
+}
+
+template<typename T, typename Hash, typename Equal>
+inline
+intrusive_hash_set<T, Hash, Equal>::~intrusive_hash_set () {
+    clear();
+}
+
+template<typename T, typename Hash, typename Equal>
+inline
+typename intrusive_hash_set<T, Hash, Equal>::iterator
+intrusive_hash_set<T, Hash, Equal>::first_from (int table, size_t bucket) const {
+    // Old buckets that have not been moved come first.
+    if (table == 1) {
+        for (; bucket <= _old_mask; ++bucket) {
+            if (_old[bucket] != nullptr) {
+                return iterator(this, _old[bucket], 1, bucket);
+            }
+        }
+        bucket = 0;
+    }
+    for (; bucket <= _mask; ++bucket) {
+        if (_buckets[bucket] != nullptr) {
+            return iterator(this, _buckets[bucket], 0, bucket);
+        }
+    }
+    return iterator();
+}
+
+template<typename T, typename Hash, typename Equal>
+inline
+typename intrusive_hash_set<T, Hash, Equal>::iterator
+intrusive_hash_set<T, Hash, Equal>::begin () ABEL_NOEXCEPT {
+    return _size == 0 ? end() : first_from(rehashing() ? 1 : 0, rehashing() ? _old_index : 0);
+}
+
+template<typename T, typename Hash, typename Equal>
+inline
+typename intrusive_hash_set<T, Hash, Equal>::const_iterator
+intrusive_hash_set<T, Hash, Equal>::begin () const ABEL_NOEXCEPT {
+    return _size == 0 ? end() : first_from(rehashing() ? 1 : 0, rehashing() ? _old_index : 0);
+}
+
+template<typename T, typename Hash, typename Equal>
+ABEL_FORCE_INLINE
+typename intrusive_hash_set<T, Hash, Equal>::bucket_type *
+intrusive_hash_set<T, Hash, Equal>::bucket_for (size_t hash, int *table, size_t *bucket) const {
+    if (ABEL_UNLIKELY(_old != nullptr)) {
+        size_t i = hash & _old_mask;
+        if (i >= _old_index) {
+            *table = 1;
+            *bucket = i;
+            return &_old[i];
+        }
+    }
+    *table = 0;
+    *bucket = hash & _mask;
+    return &_buckets[*bucket];
+}
+
+template<typename T, typename Hash, typename Equal>
+template<typename K>
+ABEL_FORCE_INLINE
+intrusive_hash_node *
+intrusive_hash_set<T, Hash, Equal>::find_node (const K &key, size_t hash, int *table, size_t *bucket) const {
+    for (intrusive_hash_node *node = *bucket_for(hash, table, bucket); node != nullptr;
+         node = node->hash_next) {
+        if (node->hash_value == hash && _equal(*static_cast<const T *>(node), key)) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+template<typename T, typename Hash, typename Equal>
+template<typename K>
+inline
+typename intrusive_hash_set<T, Hash, Equal>::iterator
+intrusive_hash_set<T, Hash, Equal>::find (const K &key) {
+    int table;
+    size_t bucket;
+    intrusive_hash_node *node = find_node(key, _hash(key), &table, &bucket);
+    return node != nullptr ? iterator(this, node, table, bucket) : end();
+}
+
+template<typename T, typename Hash, typename Equal>
+template<typename K>
+inline
+typename intrusive_hash_set<T, Hash, Equal>::const_iterator
+intrusive_hash_set<T, Hash, Equal>::find (const K &key) const {
+    int table;
+    size_t bucket;
+    intrusive_hash_node *node = find_node(key, _hash(key), &table, &bucket);
+    return node != nullptr ? const_iterator(iterator(this, node, table, bucket)) : end();
+}
+
+template<typename T, typename Hash, typename Equal>
+inline
+std::pair<typename intrusive_hash_set<T, Hash, Equal>::iterator, bool>
+intrusive_hash_set<T, Hash, Equal>::insert (value_type &x) {
+    if (_old != nullptr) {
+        rehash_step(kRehashStep);
+    }
+    const size_t hash = _hash(static_cast<const T &>(x));
+    int table;
+    size_t bucket;
+    intrusive_hash_node *found = find_node(static_cast<const T &>(x), hash, &table, &bucket);
+    if (found != nullptr) {
+        return std::make_pair(iterator(this, found, table, bucket), false);
+    }
+    if (_size > _mask) {
+        grow(2 * (_mask + 1));
+    }
+    intrusive_hash_node *node = &x;
+    node->hash_value = hash;
+    bucket_type *slot = bucket_for(hash, &table, &bucket);
+    node->hash_next = *slot;
+    *slot = node;
+    ++_size;
+    return std::make_pair(iterator(this, node, table, bucket), true);
+}
+
+template<typename T, typename Hash, typename Equal>
+inline
+void
+intrusive_hash_set<T, Hash, Equal>::unlink (intrusive_hash_node *node, bucket_type *slot) {
+    while (*slot != node) {
+        slot = &(*slot)->hash_next;
+    }
+    *slot = node->hash_next;
+    node->hash_next = nullptr;
+    --_size;
+}
+
+template<typename T, typename Hash, typename Equal>
+template<typename K>
+inline
+size_t
+intrusive_hash_set<T, Hash, Equal>::erase (const K &key) {
+    int table;
+    size_t bucket;
+    const size_t hash = _hash(key);
+    intrusive_hash_node *node = find_node(key, hash, &table, &bucket);
+    if (node == nullptr) {
+        return 0;
+    }
+    unlink(node, table == 1 ? &_old[bucket] : &_buckets[bucket]);
+    if (_old != nullptr) {
+        rehash_step(kRehashStep);
+    }
+    return 1;
+}
+
+template<typename T, typename Hash, typename Equal>
+inline
+typename intrusive_hash_set<T, Hash, Equal>::iterator
+intrusive_hash_set<T, Hash, Equal>::erase (const_iterator pos) {
+    iterator next(this, pos._node, pos._table, pos._bucket);
+    ++next;
+    unlink(pos._node, pos._table == 1 ? &_old[pos._bucket] : &_buckets[pos._bucket]);
+    // No rehash step here: it could move `next` to a bucket the caller has
+    // already visited.
+    return next;
+}
+
+template<typename T, typename Hash, typename Equal>
+inline
+void
+intrusive_hash_set<T, Hash, Equal>::remove (value_type &x) {
+    intrusive_hash_node *node = &x;
+    int table;
+    size_t bucket;
+    unlink(node, bucket_for(node->hash_value, &table, &bucket));
+    if (_old != nullptr) {
+        rehash_step(kRehashStep);
+    }
+}
+
+template<typename T, typename Hash, typename Equal>
+inline
+void
+intrusive_hash_set<T, Hash, Equal>::clear () ABEL_NOEXCEPT {
+    for (iterator it = begin(); it != end();) {
+        intrusive_hash_node *node = it._node;
+        ++it;
+        node->hash_next = nullptr;
+    }
+    _old.reset();
+    _old_mask = 0;
+    _old_index = 0;
+    std::fill(_buckets.get(), _buckets.get() + _mask + 1, nullptr);
+    _size = 0;
+}
+
+template<typename T, typename Hash, typename Equal>
+inline
+void
+intrusive_hash_set<T, Hash, Equal>::reserve (size_t n) {
+    finish_rehash();
+    if (n > _mask + 1) {
+        size_t buckets = _mask + 1;
+        while (buckets < n) {
+            buckets *= 2;
+        }
+        grow(buckets);
+        finish_rehash();
+    }
+}
+
+template<typename T, typename Hash, typename Equal>
+void
+intrusive_hash_set<T, Hash, Equal>::grow (size_t bucket_count) {
+    // A resize while the previous one is in progress only happens after
+    // reserve() or many erases; finish the old one first.
+    finish_rehash();
+    _old = std::move(_buckets);
+    _old_mask = _mask;
+    _old_index = 0;
+    _buckets.reset(new bucket_type[bucket_count]());
+    _mask = bucket_count - 1;
+}
+
+template<typename T, typename Hash, typename Equal>
+void
+intrusive_hash_set<T, Hash, Equal>::rehash_step (size_t n) {
+    if (_old == nullptr) {
+        return;
+    }
+    for (; n != 0 && _old_index <= _old_mask; --n, ++_old_index) {
+        intrusive_hash_node *node = _old[_old_index];
+        while (node != nullptr) {
+            intrusive_hash_node *next = node->hash_next;
+            bucket_type &slot = _buckets[node->hash_value & _mask];
+            node->hash_next = slot;
+            slot = node;
+            node = next;
+        }
+    }
+    if (_old_index > _old_mask) {
+        _old.reset();
+        _old_mask = 0;
+        _old_index = 0;
+    }
+}
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_INTRUSIVE_HASH_SET_H_
@@ -405,25 +405,25 @@ inline typename intrusive_list<T>::const_reverse_iterator intrusive_list<T>::cre
 
 template<typename T>
 inline typename intrusive_list<T>::reference intrusive_list<T>::front () {
-    ABEL_ASSERT_MSG(_anchor.next == &_anchor, "intrusive_list::front(): empty list.");
+    ABEL_ASSERT_MSG(_anchor.next != &_anchor, "intrusive_list::front(): empty list.");
     return *static_cast<T *>(_anchor.next);
 }
 
 template<typename T>
 inline typename intrusive_list<T>::const_reference intrusive_list<T>::front () const {
-    ABEL_ASSERT_MSG(_anchor.next == &_anchor, "intrusive_list::front(): empty list.");
+    ABEL_ASSERT_MSG(_anchor.next != &_anchor, "intrusive_list::front(): empty list.");
     return *static_cast<const T *>(_anchor.next);
 }
 
 template<typename T>
 inline typename intrusive_list<T>::reference intrusive_list<T>::back () {
-    ABEL_ASSERT_MSG(_anchor.next == &_anchor, "intrusive_list::front(): empty list.");
+    ABEL_ASSERT_MSG(_anchor.next != &_anchor, "intrusive_list::back(): empty list.");
     return *static_cast<T *>(_anchor.prev);
 }
 
 template<typename T>
 inline typename intrusive_list<T>::const_reference intrusive_list<T>::back () const {
-    ABEL_ASSERT_MSG(_anchor.next == &_anchor, "intrusive_list::front(): empty list.");
+    ABEL_ASSERT_MSG(_anchor.next != &_anchor, "intrusive_list::back(): empty list.");
     return *static_cast<const T *>(_anchor.prev);
 }
 
@@ -0,0 +1,387 @@
+//
+
+#ifndef ABEL_CONTAINER_LRU_CACHE_H_
+#define ABEL_CONTAINER_LRU_CACHE_H_
+
+#include <abel/base/profile.h>
+#include <abel/chrono/clock.h>
+#include <abel/chrono/time.h>
+#include <abel/container/flat_hash_map.h>
+#include <abel/container/intrusive_list.h>
+#include <abel/memory/object_pool.h>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+
+namespace abel {
+
+// Counters kept by lru_cache and concurrent_cache.
+struct cache_stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    // Entries dropped to make room for others.
+    uint64_t evictions = 0;
+    // Entries dropped because their time to live ran out. An expired entry
+    // that is looked up also counts as a miss.
+    uint64_t expirations = 0;
+    // concurrent_cache::get_or_load() calls that found another thread
+    // loading the key and took its result. They run no loader, so hit_rate()
+    // counts them as hits; they are not counted as hits or misses above.
+    uint64_t coalesced = 0;
+
+    double hit_rate () const {
+        const uint64_t lookups = hits + misses + coalesced;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits + coalesced) / lookups;
+    }
+
+    cache_stats &operator += (const cache_stats &other) {
+        hits += other.hits;
+        misses += other.misses;
+        evictions += other.evictions;
+        expirations += other.expirations;
+        coalesced += other.coalesced;
+        return *this;
+    }
+};
+
+// The default weigher of lru_cache and concurrent_cache: every entry weighs
+// one, so the capacity is a number of entries.
+struct cache_unit_weigher {
+    template<typename K, typename V>
+    size_t operator () (const K &, const V &) const {
+        return 1;
+    }
+};
+
+// lru_cache
+//
+// A map with a bounded total weight that drops the least recently used
+// entries to make room for new ones. It is not thread safe; see
+// concurrent_cache for a sharded, locked version.
+//
+//   abel::lru_cache<std::string, std::string> cache(1000);
+//   cache.put("k", "v");
+//   if (std::string *v = cache.get("k")) {
+//       ...
+//   }
+//
+// Eviction is segmented LRU: new entries start on a probation list, and are
+// promoted to a protected list when they are hit again. Entries are evicted
+// from the end of the probation list first, so a scan over many keys that
+// are used once does not flush the entries that are used all the time. The
+// protected list holds up to 80% of the capacity; entries pushed off its end
+// go back to the front of the probation list.
+//
+// `Weigher` gives the weight of an entry as `size_t(const K &, const V &)`,
+// such as the size of a string value for a capacity in bytes. Entries heavier
+// than the whole capacity are not cached.
+//
+// With a finite `ttl`, an entry expires that long after it was last put.
+// Expired entries are dropped when they are looked up or reach the end of
+// the probation list, or by purge_expired().
+//
+// Entries live in nodes from object_pool, indexed by a flat_hash_map from
+// key to node. Value pointers stay valid until the entry is dropped.
+template<typename K, typename V, typename Weigher = cache_unit_weigher,
+         typename Hash = container_internal::hash_default_hash<K>,
+         typename Eq = container_internal::hash_default_eq<K>>
+class lru_cache {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using size_type = size_t;
+    using weigher_type = Weigher;
+
+    // Share of the capacity kept for the protected list.
+    static constexpr size_t kProtectedPercent = 80;
+public:
+    explicit lru_cache (size_t capacity, abel::duration ttl = abel::infinite_duration(),
+                        const Weigher &weigher = Weigher());
+    lru_cache (const lru_cache &) = delete;
+    lru_cache &operator = (const lru_cache &) = delete;
+    ~lru_cache ();
+
+    // Returns the value of `key`, or nullptr if it is absent or has expired.
+    // A hit marks the entry as the most recently used.
+    V *get (const K &key);
+    // Like get(), but leaves the order of entries and the statistics alone.
+    const V *peek (const K &key) const;
+    bool contains (const K &key) const {
+        return peek(key) != nullptr;
+    }
+
+    // Inserts or replaces the value of `key` and evicts entries until the
+    // weight fits the capacity again. Returns false, and leaves `key` absent,
+    // if the entry weighs more than the whole capacity.
+    bool put (const K &key, V value);
+
+    // Returns the value of `key`, caching `loader()` first on a miss.
+    template<typename F>
+    V get_or_load (const K &key, F &&loader);
+
+    // Returns whether `key` was present.
+    bool erase (const K &key);
+    void clear ();
+    // Drops all expired entries and returns their number.
+    size_t purge_expired ();
+
+    size_t size () const {
+        return _map.size();
+    }
+    bool empty () const {
+        return _map.empty();
+    }
+    // The total weight of the entries.
+    size_t weight () const {
+        return _probation_weight + _protected_weight;
+    }
+    size_t capacity () const {
+        return _capacity;
+    }
+    const cache_stats &stats () const {
+        return _stats;
+    }
+    void reset_stats () {
+        _stats = cache_stats();
+    }
+private:
+    struct entry : intrusive_list_node {
+        K key;
+        V value;
+        size_t weight;
+        abel::abel_time expires;
+        bool is_protected = false;
+
+        entry (const K &k, V &&v, size_t w, abel::abel_time e)
+            : key(k), value(std::move(v)), weight(w), expires(e) { }
+    };
+    using pool = object_pool<entry>;
+    using map_type = flat_hash_map<K, entry *, Hash, Eq>;
+
+    abel::abel_time deadline () const {
+        return _ttl == abel::infinite_duration() ? abel::infinite_future() : abel::now() + _ttl;
+    }
+    static bool expired (const entry &e) {
+        return e.expires != abel::infinite_future() && e.expires <= abel::now();
+    }
+    // Marks `e` as the most recently used, promoting it if needed, and
+    // demotes others until the protected list fits its share again.
+    void touch (entry &e);
+    // Unlinks and destroys `e`.
+    void drop (entry &e);
+    // Evicts entries other than `keep` until the weight fits.
+    void evict (const entry *keep);
+private:
+    size_t _capacity;
+    size_t _protected_capacity;
+    abel::duration _ttl;
+    Weigher _weigher;
+    map_type _map;
+    intrusive_list<entry> _probation;
+    intrusive_list<entry> _protected;
+    size_t _probation_weight = 0;
+    size_t _protected_weight = 0;
+    cache_stats _stats;
+};
+
+template<typename K, typename V, typename W, typename H, typename E>
+constexpr size_t lru_cache<K, V, W, H, E>::kProtectedPercent;
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+lru_cache<K, V, W, H, E>::lru_cache (size_t capacity, abel::duration ttl, const W &weigher)
+    : _capacity(capacity),
+      _protected_capacity(capacity / 100 * kProtectedPercent + capacity % 100 * kProtectedPercent / 100),
+      _ttl(ttl),
+      _weigher(weigher) {
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+lru_cache<K, V, W, H, E>::~lru_cache () {
+    clear();
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+V *
+lru_cache<K, V, W, H, E>::get (const K &key) {
+    auto it = _map.find(key);
+    if (it == _map.end()) {
+        ++_stats.misses;
+        return nullptr;
+    }
+    entry &e = *it->second;
+    if (expired(e)) {
+        ++_stats.misses;
+        ++_stats.expirations;
+        drop(e);
+        return nullptr;
+    }
+    ++_stats.hits;
+    touch(e);
+    return &e.value;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+const V *
+lru_cache<K, V, W, H, E>::peek (const K &key) const {
+    auto it = _map.find(key);
+    if (it == _map.end() || expired(*it->second)) {
+        return nullptr;
+    }
+    return &it->second->value;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+bool
+lru_cache<K, V, W, H, E>::put (const K &key, V value) {
+    const size_t weight = _weigher(key, value);
+    auto it = _map.find(key);
+    if (weight > _capacity) {
+        if (it != _map.end()) {
+            drop(*it->second);
+        }
+        return false;
+    }
+    entry *e;
+    if (it != _map.end()) {
+        e = it->second;
+        e->value = std::move(value);
+        (e->is_protected ? _protected_weight : _probation_weight) += weight - e->weight;
+        e->weight = weight;
+        e->expires = deadline();
+        touch(*e);
+    } else {
+        e = pool::create(key, std::move(value), weight, deadline());
+        ABEL_INTERNAL_TRY {
+            _map.emplace(key, e);
+        }
+        ABEL_INTERNAL_CATCH_ANY {
+            pool::destroy(e);
+            ABEL_INTERNAL_RETHROW;
+        }
+        _probation.push_front(*e);
+        _probation_weight += weight;
+    }
+    evict(e);
+    return true;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+template<typename F>
+inline
+V
+lru_cache<K, V, W, H, E>::get_or_load (const K &key, F &&loader) {
+    if (V *v = get(key)) {
+        return *v;
+    }
+    V value = loader();
+    put(key, value);
+    return value;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+bool
+lru_cache<K, V, W, H, E>::erase (const K &key) {
+    auto it = _map.find(key);
+    if (it == _map.end()) {
+        return false;
+    }
+    drop(*it->second);
+    return true;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+void
+lru_cache<K, V, W, H, E>::clear () {
+    for (intrusive_list<entry> *list : {&_probation, &_protected}) {
+        while (!list->empty()) {
+            entry &e = list->front();
+            list->pop_front();
+            pool::destroy(&e);
+        }
+    }
+    _map.clear();
+    _probation_weight = _protected_weight = 0;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+size_t
+lru_cache<K, V, W, H, E>::purge_expired () {
+    size_t n = 0;
+    for (intrusive_list<entry> *list : {&_probation, &_protected}) {
+        for (auto it = list->begin(); it != list->end();) {
+            entry &e = *it++;
+            if (expired(e)) {
+                drop(e);
+                ++n;
+            }
+        }
+    }
+    _stats.expirations += n;
+    return n;
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+void
+lru_cache<K, V, W, H, E>::touch (entry &e) {
+    intrusive_list<entry>::remove(e);
+    if (!e.is_protected) {
+        e.is_protected = true;
+        _probation_weight -= e.weight;
+        _protected_weight += e.weight;
+    }
+    _protected.push_front(e);
+    // Demote the least recently used protected entries to probation. This
+    // also applies to an entry that was already protected, since put() may
+    // have made it heavier.
+    while (_protected_weight > _protected_capacity && &_protected.back() != &e) {
+        entry &d = _protected.back();
+        _protected.pop_back();
+        d.is_protected = false;
+        _protected_weight -= d.weight;
+        _probation_weight += d.weight;
+        _probation.push_front(d);
+    }
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+void
+lru_cache<K, V, W, H, E>::drop (entry &e) {
+    intrusive_list<entry>::remove(e);
+    (e.is_protected ? _protected_weight : _probation_weight) -= e.weight;
+    _map.erase(e.key);
+    pool::destroy(&e);
+}
+
+template<typename K, typename V, typename W, typename H, typename E>
+inline
+void
+lru_cache<K, V, W, H, E>::evict (const entry *keep) {
+    // `keep` fits on its own, so this stops before running out of victims.
+    while (weight() > _capacity) {
+        entry *victim = _probation.empty() ? nullptr : &_probation.back();
+        if (victim == nullptr || victim == keep) {
+            victim = &_protected.back();
+        }
+        if (expired(*victim)) {
+            ++_stats.expirations;
+        } else {
+            ++_stats.evictions;
+        }
+        drop(*victim);
+    }
+}
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_LRU_CACHE_H_
@@ -0,0 +1,377 @@
+//
+
+#ifndef ABEL_CONTAINER_MPMC_QUEUE_H_
+#define ABEL_CONTAINER_MPMC_QUEUE_H_
+
+#include <abel/base/profile.h>
+#include <abel/container/internal/bounded_queue.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace abel {
+
+// mpmc_queue
+//
+// A bounded, lock-free queue for any number of producer and consumer threads.
+// The capacity is rounded up to a power of two. Every slot carries a sequence
+// number that tells whether it is free or filled for the current lap, so a
+// producer and a consumer only contend on the same slot when the queue is
+// full or empty. The head and the tail each live on their own cache line.
+//
+// Elements are moved into their slots with nothrow operations only: when T
+// cannot be constructed from the arguments without throwing, try_emplace()
+// constructs a temporary before claiming a slot. See blocking_queue.h for a
+// wrapper whose push and pop wait instead of failing.
+template<typename T>
+class mpmc_queue {
+    static_assert(std::is_nothrow_move_constructible<T>::value &&
+                  std::is_nothrow_destructible<T>::value,
+                  "mpmc_queue only supports nothrow-move value types");
+    union maybe_item {
+        maybe_item () noexcept { }
+        ~maybe_item () { }
+        T data;
+    };
+    struct cell {
+        // Equal to the slot's position when it is free for the producer of
+        // that position, and to the position plus one once it is filled.
+        std::atomic<size_t> seq;
+        maybe_item item;
+    };
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T &;
+    using const_reference = const T &;
+public:
+    explicit mpmc_queue (size_t capacity);
+    mpmc_queue (const mpmc_queue &) = delete;
+    mpmc_queue &operator = (const mpmc_queue &) = delete;
+    ~mpmc_queue ();
+
+    // Returns false, leaving the arguments untouched, if the queue is full.
+    bool try_push (const T &data);
+    bool try_push (T &&data);
+    template<typename... A>
+    bool try_emplace (A &&... args);
+    // Claims up to `n` slots with a single CAS and fills them from `first`,
+    // `first + 1`, ... Returns the number pushed. A slot claimed this way may
+    // still be being emptied by a slow consumer, in which case this waits for
+    // it. Falls back to one try_emplace() per element if constructing T from
+    // `*first` may throw.
+    template<typename InputIt>
+    size_t try_push_n (InputIt first, size_t n);
+
+    // Returns false if the queue is empty. The element is released before it
+    // is assigned to `out`; if that assignment throws the element is lost.
+    bool try_pop (T &out);
+    // Like try_pop(), but hands the element to `f` as a `T &&` rather than
+    // assigning it to an existing object. The element is released before `f`
+    // runs; if `f` throws the element is lost.
+    template<typename F>
+    bool try_consume (F &&f);
+    // Claims up to `n` filled slots with a single CAS and moves them to `out`.
+    // Returns the number popped. A slot claimed this way may still be being
+    // filled by a slow producer, in which case this waits for it. If assigning
+    // to `out` throws, the remaining claimed elements are destroyed.
+    template<typename OutputIt>
+    size_t try_pop_n (OutputIt out, size_t n);
+
+    // Approximate under concurrent access.
+    size_t size () const;
+    bool empty () const;
+    size_t capacity () const { return _mask + 1; }
+private:
+    template<typename... A>
+    bool emplace_impl (std::true_type, A &&... args);
+    template<typename... A>
+    bool emplace_impl (std::false_type, A &&... args);
+    template<typename InputIt>
+    size_t push_n_impl (std::true_type, InputIt first, size_t n);
+    template<typename InputIt>
+    size_t push_n_impl (std::false_type, InputIt first, size_t n);
+    // Empties the filled slot at `pos` into a value returned to the caller.
+    T take (size_t pos);
+    cell &at (size_t pos) { return _cells[pos & _mask]; }
+private:
+    const size_t _mask;
+    cell *const _cells;
+    char _pad0[ABEL_CACHE_LINE_SIZE - sizeof(size_t) - sizeof(cell *)];
+    std::atomic<size_t> _tail;
+    char _pad1[ABEL_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> _head;
+    char _pad2[ABEL_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+template<typename T>
+inline
+mpmc_queue<T>::mpmc_queue (size_t capacity)
+    : _mask(container_internal::queue_capacity(capacity) - 1),
+      _cells(new cell[_mask + 1]),
+      _tail(0),
+      _head(0) {
+    for (size_t i = 0; i <= _mask; ++i) {
+        _cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+inline
+mpmc_queue<T>::~mpmc_queue () {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    for (size_t i = _head.load(std::memory_order_relaxed); i != tail; ++i) {
+        at(i).item.data.~T();
+    }
+    delete[] _cells;
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+bool
+mpmc_queue<T>::try_push (const T &data) {
+    return try_emplace(data);
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+bool
+mpmc_queue<T>::try_push (T &&data) {
+    return try_emplace(std::move(data));
+}
+
+template<typename T>
+template<typename... A>
+ABEL_FORCE_INLINE
+bool
+mpmc_queue<T>::try_emplace (A &&... args) {
+    return emplace_impl(std::integral_constant<bool,
+                            std::is_nothrow_constructible<T, A &&...>::value>(),
+                        std::forward<A>(args)...);
+}
+
+template<typename T>
+template<typename... A>
+ABEL_FORCE_INLINE
+bool
+mpmc_queue<T>::emplace_impl (std::true_type, A &&... args) {
+    size_t pos = _tail.load(std::memory_order_relaxed);
+    cell *c;
+    for (;;) {
+        c = &at(pos);
+        const size_t seq = c->seq.load(std::memory_order_acquire);
+        const intptr_t dif = static_cast<intptr_t>(seq - pos);
+        if (dif == 0) {
+            if (_tail.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+                break;
+            }
+            ABEL_INTERNAL_CPU_RELAX();
+        } else if (dif < 0) {
+            // The slot still holds the element from the previous lap.
+            return false;
+        } else {
+            ABEL_INTERNAL_CPU_RELAX();
+            pos = _tail.load(std::memory_order_relaxed);
+        }
+    }
+    new(&c->item.data) T(std::forward<A>(args)...);
+    c->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+template<typename... A>
+inline
+bool
+mpmc_queue<T>::emplace_impl (std::false_type, A &&... args) {
+    T tmp(std::forward<A>(args)...);
+    return emplace_impl(std::true_type(), std::move(tmp));
+}
+
+template<typename T>
+template<typename InputIt>
+inline
+size_t
+mpmc_queue<T>::try_push_n (InputIt first, size_t n) {
+    return push_n_impl(std::integral_constant<bool,
+                           std::is_nothrow_constructible<T,
+                               decltype(*first)>::value>(),
+                       first, n);
+}
+
+template<typename T>
+template<typename InputIt>
+inline
+size_t
+mpmc_queue<T>::push_n_impl (std::true_type, InputIt first, size_t n) {
+    size_t pos = _tail.load(std::memory_order_relaxed);
+    size_t k;
+    for (;;) {
+        const size_t head = _head.load(std::memory_order_acquire);
+        const intptr_t used = static_cast<intptr_t>(pos - head);
+        if (used < 0) {
+            // `pos` is stale.
+            ABEL_INTERNAL_CPU_RELAX();
+            pos = _tail.load(std::memory_order_relaxed);
+            continue;
+        }
+        const size_t free = used >= static_cast<intptr_t>(capacity())
+                            ? 0 : capacity() - static_cast<size_t>(used);
+        k = n < free ? n : free;
+        if (k == 0) {
+            return 0;
+        }
+        if (_tail.compare_exchange_weak(pos, pos + k,
+                                        std::memory_order_relaxed)) {
+            break;
+        }
+        ABEL_INTERNAL_CPU_RELAX();
+    }
+    for (size_t i = 0; i < k; ++i, ++first) {
+        cell &c = at(pos + i);
+        while (c.seq.load(std::memory_order_acquire) != pos + i) {
+            ABEL_INTERNAL_CPU_RELAX();
+        }
+        new(&c.item.data) T(*first);
+        c.seq.store(pos + i + 1, std::memory_order_release);
+    }
+    return k;
+}
+
+template<typename T>
+template<typename InputIt>
+inline
+size_t
+mpmc_queue<T>::push_n_impl (std::false_type, InputIt first, size_t n) {
+    size_t i = 0;
+    for (; i < n; ++i, ++first) {
+        if (!try_emplace(*first)) {
+            break;
+        }
+    }
+    return i;
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+T
+mpmc_queue<T>::take (size_t pos) {
+    cell &c = at(pos);
+    T value(std::move(c.item.data));
+    c.item.data.~T();
+    c.seq.store(pos + capacity(), std::memory_order_release);
+    return value;
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+bool
+mpmc_queue<T>::try_pop (T &out) {
+    return try_consume([&out] (T &&v) { out = std::move(v); });
+}
+
+template<typename T>
+template<typename F>
+ABEL_FORCE_INLINE
+bool
+mpmc_queue<T>::try_consume (F &&f) {
+    size_t pos = _head.load(std::memory_order_relaxed);
+    for (;;) {
+        const size_t seq = at(pos).seq.load(std::memory_order_acquire);
+        const intptr_t dif = static_cast<intptr_t>(seq - (pos + 1));
+        if (dif == 0) {
+            if (_head.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+                break;
+            }
+            ABEL_INTERNAL_CPU_RELAX();
+        } else if (dif < 0) {
+            // The slot has not been filled for this lap yet.
+            return false;
+        } else {
+            ABEL_INTERNAL_CPU_RELAX();
+            pos = _head.load(std::memory_order_relaxed);
+        }
+    }
+    f(take(pos));
+    return true;
+}
+
+template<typename T>
+template<typename OutputIt>
+inline
+size_t
+mpmc_queue<T>::try_pop_n (OutputIt out, size_t n) {
+    size_t pos = _head.load(std::memory_order_relaxed);
+    size_t k;
+    for (;;) {
+        const size_t tail = _tail.load(std::memory_order_acquire);
+        const intptr_t avail = static_cast<intptr_t>(tail - pos);
+        if (avail < 0) {
+            ABEL_INTERNAL_CPU_RELAX();
+            pos = _head.load(std::memory_order_relaxed);
+            continue;
+        }
+        k = n < static_cast<size_t>(avail) ? n : static_cast<size_t>(avail);
+        if (k == 0) {
+            return 0;
+        }
+        if (_head.compare_exchange_weak(pos, pos + k,
+                                        std::memory_order_relaxed)) {
+            break;
+        }
+        ABEL_INTERNAL_CPU_RELAX();
+    }
+    size_t i = 0;
+    ABEL_INTERNAL_TRY {
+        for (; i < k; ++i, ++out) {
+            while (at(pos + i).seq.load(std::memory_order_acquire) !=
+                   pos + i + 1) {
+                ABEL_INTERNAL_CPU_RELAX();
+            }
+            *out = take(pos + i);
+        }
+    }
+    ABEL_INTERNAL_CATCH_ANY {
+        // Slot `i` was already released by take(). Release the rest so that
+        // producers do not wait on them forever.
+        for (++i; i < k; ++i) {
+            while (at(pos + i).seq.load(std::memory_order_acquire) !=
+                   pos + i + 1) {
+                ABEL_INTERNAL_CPU_RELAX();
+            }
+            take(pos + i);
+        }
+        ABEL_INTERNAL_RETHROW;
+    }
+    return k;
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+size_t
+mpmc_queue<T>::size () const {
+    const size_t head = _head.load(std::memory_order_acquire);
+    const size_t tail = _tail.load(std::memory_order_acquire);
+    const intptr_t n = static_cast<intptr_t>(tail - head);
+    if (n < 0) {
+        return 0;
+    }
+    return static_cast<size_t>(n) > capacity() ? capacity()
+                                               : static_cast<size_t>(n);
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+bool
+mpmc_queue<T>::empty () const {
+    return size() == 0;
+}
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_MPMC_QUEUE_H_
@@ -0,0 +1,132 @@
+//
+
+#ifndef ABEL_CONTAINER_PACKED_INT_VECTOR_H_
+#define ABEL_CONTAINER_PACKED_INT_VECTOR_H_
+
+#include <abel/base/profile.h>
+#include <abel/container/internal/bit_packing.h>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace abel {
+
+// packed_int_vector
+//
+// A vector of unsigned integers stored at a fixed width of 1 to 64 bits
+// each, with constant time get() and set():
+//
+//   abel::packed_int_vector v(1000, 12);  // 1000 integers below 4096
+//   v.set(3, 4000);
+//   uint64_t x = v.get(3);
+//
+// from() picks the smallest width that holds all of its input. For sorted
+// sequences, delta_packed_vector usually compresses much better.
+class packed_int_vector {
+public:
+    using value_type = uint64_t;
+    using size_type = size_t;
+public:
+    explicit packed_int_vector (unsigned bits = 64) : _bits(bits), _words(1, 0) {
+        assert(bits >= 1 && bits <= 64);
+    }
+    packed_int_vector (size_t n, unsigned bits) : packed_int_vector(bits) {
+        resize(n);
+    }
+
+    // Packs `n` integers at the width of the largest.
+    static packed_int_vector from (const uint64_t *values, size_t n) {
+        uint64_t all = 0;
+        for (size_t i = 0; i < n; ++i) {
+            all |= values[i];
+        }
+        const unsigned bits = container_internal::bit_width(all);
+        packed_int_vector v(n, bits == 0 ? 1 : bits);
+        for (size_t i = 0; i < n; ++i) {
+            v.set(i, values[i]);
+        }
+        return v;
+    }
+
+    size_t size () const {
+        return _size;
+    }
+    bool empty () const {
+        return _size == 0;
+    }
+    unsigned bits () const {
+        return _bits;
+    }
+    // The largest value that fits.
+    uint64_t max_value () const {
+        return mask();
+    }
+    size_t memory_bytes () const {
+        return _words.size() * sizeof(uint64_t);
+    }
+
+    uint64_t get (size_t i) const {
+        const size_t pos = i * _bits;
+        const unsigned shift = pos % 64;
+        uint64_t v = _words[pos / 64] >> shift;
+        if (shift + _bits > 64) {
+            v |= _words[pos / 64 + 1] << (64 - shift);
+        }
+        return v & mask();
+    }
+    uint64_t operator [] (size_t i) const {
+        return get(i);
+    }
+    // `value` must fit in bits().
+    void set (size_t i, uint64_t value) {
+        assert(value <= mask());
+        const size_t pos = i * _bits;
+        const unsigned shift = pos % 64;
+        uint64_t &w = _words[pos / 64];
+        w = (w & ~(mask() << shift)) | (value << shift);
+        if (shift + _bits > 64) {
+            uint64_t &next = _words[pos / 64 + 1];
+            const unsigned high = shift + _bits - 64;
+            next = (next & (~uint64_t(0) << high)) | (value >> (64 - shift));
+        }
+    }
+    void push_back (uint64_t value) {
+        resize(_size + 1);
+        set(_size - 1, value);
+    }
+    // New integers are zero.
+    void resize (size_t n) {
+        if (n < _size) {
+            // Clear the dropped bits, which a later resize() exposes again.
+            for (size_t i = n; i < _size; ++i) {
+                set(i, 0);
+            }
+        }
+        _size = n;
+        // One spare word lets get() read past the last integer.
+        _words.resize((n * _bits + 63) / 64 + 1, 0);
+    }
+    void clear () {
+        resize(0);
+    }
+
+    // Copies `n` integers from position `first` to `out`.
+    void decode (size_t first, size_t n, uint64_t *out) const {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = get(first + i);
+        }
+    }
+private:
+    uint64_t mask () const {
+        return _bits == 64 ? ~uint64_t(0) : (uint64_t(1) << _bits) - 1;
+    }
+private:
+    unsigned _bits;
+    size_t _size = 0;
+    std::vector<uint64_t> _words;
+};
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_PACKED_INT_VECTOR_H_
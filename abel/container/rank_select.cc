@@ -0,0 +1,192 @@
+//
+
+#include <abel/container/rank_select.h>
+
+#include <abel/base/math/ctz.h>
+#include <cstring>
+#include <utility>
+
+#if ABEL_BMI2
+#include <immintrin.h>
+#endif
+
+namespace abel {
+
+namespace {
+
+constexpr size_t kHeaderWords = 6;
+
+// The arrays of an index over no bits: one block with zero counts, and a
+// single select hint pointing at it.
+const uint64_t kEmptyIndex[2] = {0, 0};
+
+// The position of the `r`-th set bit of `w`, which has more than `r`.
+ABEL_FORCE_INLINE size_t select_in_word (uint64_t w, size_t r) {
+#if ABEL_BMI2
+    return count_trailing_zeros(static_cast<uint64_t>(_pdep_u64(uint64_t(1) << r, w)));
+#else
+    for (; r != 0; --r) {
+        w &= w - 1;
+    }
+    return count_trailing_zeros(w);
+#endif
+}
+
+}  // namespace
+
+constexpr size_t rank_select::npos;
+constexpr size_t rank_select::kBlockWords;
+constexpr size_t rank_select::kBlockBits;
+constexpr size_t rank_select::kSelectSample;
+
+rank_select::rank_select ()
+    : _counts(kEmptyIndex),
+      _select1(kEmptyIndex),
+      _select0(kEmptyIndex),
+      _num_select1(1),
+      _num_select0(1) {
+}
+
+rank_select::rank_select (bitset_view bits) : _bits(bits) {
+    const size_t words = bits.num_words();
+    const size_t blocks = num_blocks();
+    std::vector<word_type> counts(2 * blocks);
+    size_t ones = 0;
+    for (size_t b = 0; b < blocks; ++b) {
+        counts[2 * b] = ones;
+        word_type packed = 0;
+        size_t within = 0;
+        for (size_t j = 0; j < kBlockWords; ++j) {
+            if (j != 0) {
+                packed |= static_cast<word_type>(within) << (9 * (j - 1));
+            }
+            const size_t w = b * kBlockWords + j;
+            if (w < words) {
+                within += popcount(bits.data()[w]);
+            }
+        }
+        counts[2 * b + 1] = packed;
+        ones += within;
+    }
+    _num_ones = ones;
+
+    // Record the block of every kSelectSample-th set and clear bit.
+    std::vector<word_type> select1;
+    std::vector<word_type> select0;
+    for (size_t b = 0; b < blocks; ++b) {
+        const size_t end1 = b + 1 < blocks ? counts[2 * b + 2] : _num_ones;
+        const size_t end0 = b + 1 < blocks ? (b + 1) * kBlockBits - counts[2 * b + 2] : num_zeros();
+        while (select1.size() * kSelectSample < end1) {
+            select1.push_back(b);
+        }
+        while (select0.size() * kSelectSample < end0) {
+            select0.push_back(b);
+        }
+    }
+    select1.push_back(blocks - 1);
+    select0.push_back(blocks - 1);
+
+    _num_select1 = select1.size();
+    _num_select0 = select0.size();
+    _storage.reserve(counts.size() + _num_select1 + _num_select0);
+    _storage.insert(_storage.end(), counts.begin(), counts.end());
+    _storage.insert(_storage.end(), select1.begin(), select1.end());
+    _storage.insert(_storage.end(), select0.begin(), select0.end());
+    _counts = _storage.data();
+    _select1 = _counts + counts.size();
+    _select0 = _select1 + _num_select1;
+}
+
+template<bool Bit>
+size_t rank_select::select (size_t k, const word_type *hints) const {
+    // The number of `Bit` bits before block `b`.
+    auto before = [this](size_t b) -> size_t {
+        return Bit ? _counts[2 * b] : b * kBlockBits - _counts[2 * b];
+    };
+    // The last block starting at or before the bit lies between two hints.
+    size_t lo = hints[k / kSelectSample];
+    size_t hi = hints[k / kSelectSample + 1];
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo + 1) / 2;
+        if (before(mid) <= k) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    size_t rem = k - before(lo);
+    const word_type packed = _counts[2 * lo + 1];
+    size_t j = 0;
+    size_t skipped = 0;
+    for (; j + 1 < kBlockWords; ++j) {
+        const size_t ones = (packed >> (9 * j)) & 0x1ff;
+        const size_t n = Bit ? ones : (j + 1) * bitset_view::kWordBits - ones;
+        if (n > rem) {
+            break;
+        }
+        skipped = n;
+    }
+    rem -= skipped;
+    const size_t w = lo * kBlockWords + j;
+    const word_type word = Bit ? _bits.data()[w] : ~_bits.data()[w];
+    return w * bitset_view::kWordBits + select_in_word(word, rem);
+}
+
+size_t rank_select::select1 (size_t k) const {
+    return k < _num_ones ? select<true>(k, _select1) : npos;
+}
+
+size_t rank_select::select0 (size_t k) const {
+    return k < num_zeros() ? select<false>(k, _select0) : npos;
+}
+
+size_t rank_select::serialized_size () const {
+    return (kHeaderWords + _bits.num_words() + 2 * num_blocks() + _num_select1 + _num_select0) *
+           sizeof(word_type);
+}
+
+void rank_select::serialize (void *out) const {
+    const word_type header[kHeaderWords] = {
+        container_internal::kRankSelectMagic, _bits.size(), _num_ones, num_blocks(),
+        _num_select1, _num_select0};
+    char *p = static_cast<char *>(out);
+    memcpy(p, header, sizeof(header));
+    p += sizeof(header);
+    auto write = [&p](const word_type *words, size_t n) {
+        if (n != 0) {
+            memcpy(p, words, n * sizeof(word_type));
+            p += n * sizeof(word_type);
+        }
+    };
+    write(_bits.data(), _bits.num_words());
+    write(_counts, 2 * num_blocks());
+    write(_select1, _num_select1);
+    write(_select0, _num_select0);
+}
+
+bool rank_select::map (const void *data, size_t size, rank_select *out) {
+    if (size < kHeaderWords * sizeof(word_type) ||
+        reinterpret_cast<uintptr_t>(data) % alignof(word_type) != 0) {
+        return false;
+    }
+    const word_type *p = static_cast<const word_type *>(data);
+    if (p[0] != container_internal::kRankSelectMagic) {
+        return false;
+    }
+    rank_select r;
+    r._bits = bitset_view(p + kHeaderWords, static_cast<size_t>(p[1]));
+    r._num_ones = static_cast<size_t>(p[2]);
+    r._num_select1 = static_cast<size_t>(p[4]);
+    r._num_select0 = static_cast<size_t>(p[5]);
+    if (p[3] != r.num_blocks() || r._num_ones > r.size() || r.serialized_size() > size ||
+        r._num_select1 == 0 || r._num_select0 == 0) {
+        return false;
+    }
+    r._counts = p + kHeaderWords + r._bits.num_words();
+    r._select1 = r._counts + 2 * r.num_blocks();
+    r._select0 = r._select1 + r._num_select1;
+    *out = std::move(r);
+    return true;
+}
+
+}  // namespace abel
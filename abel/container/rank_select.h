@@ -0,0 +1,129 @@
+//
+
+#ifndef ABEL_CONTAINER_RANK_SELECT_H_
+#define ABEL_CONTAINER_RANK_SELECT_H_
+
+#include <abel/base/math/pop_count.h>
+#include <abel/base/profile.h>
+#include <abel/container/dynamic_bitset.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace abel {
+
+namespace container_internal {
+
+// First word of a serialized rank_select: "ABELRKSL".
+constexpr uint64_t kRankSelectMagic = 0x4c534b524c454241ull;
+
+}  // namespace container_internal
+
+// rank_select
+//
+// A constant time rank and select index over a bitset:
+//
+//   abel::dynamic_bitset bits = ...;
+//   abel::rank_select index(bits);
+//   index.rank1(i);    // set bits before position i
+//   index.select1(k);  // position of the k-th set bit, from 0
+//
+// The index follows rank9: for every 512 bits it keeps the number of set
+// bits before them, plus seven 9-bit counts for the words within, for 25%
+// extra space. rank1() reads one count pair and one word. select1() and
+// select0() start from a hint kept for every 512th set (or clear) bit, search
+// the few blocks up to the next hint, and finish within a word with PDEP when
+// BMI2 is available.
+//
+// The index refers to the bits and does not copy them; they must outlive it
+// and not change. serialize() writes the bits and the index together, and
+// map() reads them back in place, for example from a mapped file.
+class rank_select {
+public:
+    using word_type = uint64_t;
+
+    static constexpr size_t npos = bitset_view::npos;
+public:
+    // An index over no bits.
+    rank_select ();
+    explicit rank_select (bitset_view bits);
+    rank_select (const rank_select &) = delete;
+    rank_select &operator = (const rank_select &) = delete;
+    rank_select (rank_select &&) = default;
+    rank_select &operator = (rank_select &&) = default;
+
+    bitset_view bits () const {
+        return _bits;
+    }
+    size_t size () const {
+        return _bits.size();
+    }
+    size_t num_ones () const {
+        return _num_ones;
+    }
+    size_t num_zeros () const {
+        return _bits.size() - _num_ones;
+    }
+
+    // The number of set bits in [0, i), for i <= size().
+    size_t rank1 (size_t i) const {
+        const size_t block = i / kBlockBits;
+        const size_t word = i / bitset_view::kWordBits % kBlockWords;
+        size_t r = _counts[2 * block];
+        if (word != 0) {
+            r += (_counts[2 * block + 1] >> (9 * (word - 1))) & 0x1ff;
+        }
+        if (i % bitset_view::kWordBits != 0) {
+            r += popcount(_bits.data()[i / bitset_view::kWordBits] &
+                          ~(~word_type(0) << (i % bitset_view::kWordBits)));
+        }
+        return r;
+    }
+    // The number of clear bits in [0, i).
+    size_t rank0 (size_t i) const {
+        return i - rank1(i);
+    }
+
+    // The position of the set (clear) bit of rank `k`, or npos if there are
+    // not that many.
+    size_t select1 (size_t k) const;
+    size_t select0 (size_t k) const;
+
+    // The serialized form, in native byte order: a header of six words, the
+    // bits, the block counts, then the select hints.
+    size_t serialized_size () const;
+    // Writes serialized_size() bytes to `out`.
+    void serialize (void *out) const;
+    // Points `*out` at an index written by serialize(). `data` must be 8-byte
+    // aligned and outlive the index. Returns false if `data` does not hold an
+    // index.
+    static bool map (const void *data, size_t size, rank_select *out);
+private:
+    static constexpr size_t kBlockWords = 8;
+    static constexpr size_t kBlockBits = kBlockWords * bitset_view::kWordBits;
+    // One select hint per this many set (clear) bits.
+    static constexpr size_t kSelectSample = 512;
+
+    size_t num_blocks () const {
+        return _bits.num_words() / kBlockWords + 1;
+    }
+    template<bool Bit>
+    size_t select (size_t k, const word_type *hints) const;
+private:
+    bitset_view _bits;
+    size_t _num_ones = 0;
+    // Per block: the count before it, and the packed counts within.
+    const word_type *_counts = nullptr;
+    // The block of every kSelectSample-th set and clear bit, with a final
+    // entry of num_blocks() - 1.
+    const word_type *_select1 = nullptr;
+    const word_type *_select0 = nullptr;
+    size_t _num_select1 = 0;
+    size_t _num_select0 = 0;
+    // Holds the arrays above unless they are mapped.
+    std::vector<word_type> _storage;
+};
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_RANK_SELECT_H_
@@ -0,0 +1,332 @@
+//
+
+#ifndef ABEL_CONTAINER_SPSC_ARRAY_LIST_H_
+#define ABEL_CONTAINER_SPSC_ARRAY_LIST_H_
+
+#include <abel/base/profile.h>
+#include <abel/meta/type_traits.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace abel {
+
+// spsc_array_list
+//
+// An unbounded FIFO of chunks, like array_list, that one producer thread
+// fills while one consumer thread drains it. Each chunk is written front to
+// back exactly once: the producer publishes new elements by storing the
+// chunk's end index, and links a fresh chunk once the current one is full.
+// The consumer follows those links and hands every drained chunk back to the
+// producer through a free list, so a steady stream allocates no memory and
+// neither side ever executes a read-modify-write on the data path.
+//
+// push_back() may only be called by the producer, pop_front() and empty()
+// only by the consumer. Drained chunks are kept for reuse, so the memory held
+// is that of the longest backlog seen.
+template<typename T, size_t items_per_chunk = 128>
+class spsc_array_list {
+    static_assert(items_per_chunk > 0, "spsc_array_list chunk can not be empty");
+    static_assert(std::is_nothrow_destructible<T>::value,
+                  "spsc_array_list only supports nothrow-destructible types");
+    union maybe_item {
+        maybe_item () noexcept { }
+        ~maybe_item () { }
+        T data;
+    };
+    struct chunk {
+        maybe_item items[items_per_chunk];
+        // Published by the producer.
+        std::atomic<size_t> end;
+        std::atomic<chunk *> next;
+        // Owned by the consumer.
+        size_t begin;
+        // Link in the free list.
+        chunk *free_next;
+    };
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T &;
+    using const_reference = const T &;
+public:
+    spsc_array_list ();
+    spsc_array_list (const spsc_array_list &) = delete;
+    spsc_array_list &operator = (const spsc_array_list &) = delete;
+    ~spsc_array_list ();
+
+    // Producer side.
+    void push_back (const T &data) { emplace_back(data); }
+    void push_back (T &&data) { emplace_back(std::move(data)); }
+    template<typename... A>
+    void emplace_back (A &&... args);
+    // Appends [first, last), publishing each chunk's share with one store.
+    // When T is trivially copyable and the range is given as pointers, each
+    // chunk's share is copied with memcpy.
+    template<typename InputIt>
+    void push_back (InputIt first, InputIt last);
+
+    // Consumer side. Moves the front element to `out`; returns false if the
+    // list is empty.
+    bool try_pop_front (T &out);
+    // Moves up to `n` elements to `out` and returns how many were popped.
+    template<typename OutputIt>
+    size_t pop_front (size_t n, OutputIt out);
+    bool empty () const;
+private:
+    template<typename It>
+    using is_memcpy_iterator = std::integral_constant<bool,
+        std::is_pointer<It>::value &&
+        std::is_same<typename std::remove_cv<
+            typename std::remove_pointer<It>::type>::type, T>::value &&
+        abel::is_trivially_copy_constructible<T>::value &&
+        abel::is_trivially_destructible<T>::value>;
+
+    static void delete_free_list (chunk *c) noexcept;
+    chunk *new_chunk ();
+    // Links a new chunk after the full back chunk.
+    void back_chunk_new ();
+    // Makes the next chunk the front chunk once the front chunk is drained,
+    // and hands the drained one to the producer. Returns false if the
+    // producer has not moved past the front chunk yet.
+    bool front_chunk_next ();
+    template<typename InputIt>
+    size_t append_run (chunk *c, size_t end, size_t run, InputIt &first, InputIt last, std::false_type);
+    template<typename InputIt>
+    size_t append_run (chunk *c, size_t end, size_t run, InputIt &first, InputIt last, std::true_type);
+    template<typename OutputIt>
+    void remove_run (chunk *c, size_t run, OutputIt &out, std::false_type);
+    template<typename OutputIt>
+    void remove_run (chunk *c, size_t run, OutputIt &out, std::true_type);
+private:
+    // Consumer state.
+    chunk *_front_chunk;
+    char _pad0[ABEL_CACHE_LINE_SIZE - sizeof(chunk *)];
+    // Producer state. Drained chunks come back through _free_chunks, which the
+    // producer takes over as a whole into _spare_chunks.
+    chunk *_back_chunk;
+    chunk *_spare_chunks;
+    char _pad1[ABEL_CACHE_LINE_SIZE - 2 * sizeof(chunk *)];
+    std::atomic<chunk *> _free_chunks;
+};
+
+template<typename T, size_t items_per_chunk>
+inline
+spsc_array_list<T, items_per_chunk>::spsc_array_list ()
+    : _front_chunk(nullptr), _back_chunk(nullptr), _spare_chunks(nullptr), _free_chunks(nullptr) {
+    _front_chunk = _back_chunk = new_chunk();
+}
+
+template<typename T, size_t items_per_chunk>
+spsc_array_list<T, items_per_chunk>::~spsc_array_list () {
+    chunk *c = _front_chunk;
+    while (c != nullptr) {
+        chunk *next = c->next.load(std::memory_order_relaxed);
+        size_t end = c->end.load(std::memory_order_relaxed);
+        for (size_t i = c->begin; i != end; ++i) {
+            c->items[i].data.~T();
+        }
+        delete c;
+        c = next;
+    }
+    delete_free_list(_spare_chunks);
+    delete_free_list(_free_chunks.load(std::memory_order_relaxed));
+}
+
+template<typename T, size_t items_per_chunk>
+void
+spsc_array_list<T, items_per_chunk>::delete_free_list (chunk *c) noexcept {
+    while (c != nullptr) {
+        chunk *next = c->free_next;
+        delete c;
+        c = next;
+    }
+}
+
+template<typename T, size_t items_per_chunk>
+inline
+typename spsc_array_list<T, items_per_chunk>::chunk *
+spsc_array_list<T, items_per_chunk>::new_chunk () {
+    if (_spare_chunks == nullptr) {
+        _spare_chunks = _free_chunks.exchange(nullptr, std::memory_order_acquire);
+    }
+    chunk *c = _spare_chunks;
+    if (c != nullptr) {
+        _spare_chunks = c->free_next;
+    } else {
+        c = new chunk;
+    }
+    c->end.store(0, std::memory_order_relaxed);
+    c->next.store(nullptr, std::memory_order_relaxed);
+    c->begin = 0;
+    c->free_next = nullptr;
+    return c;
+}
+
+template<typename T, size_t items_per_chunk>
+inline void
+spsc_array_list<T, items_per_chunk>::back_chunk_new () {
+    chunk *c = new_chunk();
+    // Publishes the initialized chunk together with the link.
+    _back_chunk->next.store(c, std::memory_order_release);
+    _back_chunk = c;
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename... A>
+inline void
+spsc_array_list<T, items_per_chunk>::emplace_back (A &&... args) {
+    size_t end = _back_chunk->end.load(std::memory_order_relaxed);
+    if (end == items_per_chunk) {
+        back_chunk_new();
+        end = 0;
+    }
+    new(&_back_chunk->items[end].data) T(std::forward<A>(args)...);
+    _back_chunk->end.store(end + 1, std::memory_order_release);
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename InputIt>
+size_t
+spsc_array_list<T, items_per_chunk>::append_run (chunk *c, size_t end, size_t run, InputIt &first, InputIt last,
+                                                 std::false_type) {
+    size_t i = 0;
+    try {
+        for (; i != run && first != last; ++i, ++first) {
+            new(&c->items[end + i].data) T(*first);
+        }
+    } catch (...) {
+        // Keep what was constructed before the throw.
+        c->end.store(end + i, std::memory_order_release);
+        throw;
+    }
+    return i;
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename InputIt>
+size_t
+spsc_array_list<T, items_per_chunk>::append_run (chunk *c, size_t end, size_t run, InputIt &first, InputIt last,
+                                                 std::true_type) {
+    static_assert(sizeof(maybe_item) == sizeof(T), "items must be contiguous");
+    size_t n = std::min<size_t>(run, last - first);
+    std::memcpy(&c->items[end].data, first, n * sizeof(T));
+    first += n;
+    return n;
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename InputIt>
+void
+spsc_array_list<T, items_per_chunk>::push_back (InputIt first, InputIt last) {
+    while (first != last) {
+        size_t end = _back_chunk->end.load(std::memory_order_relaxed);
+        if (end == items_per_chunk) {
+            back_chunk_new();
+            end = 0;
+        }
+        end += append_run(_back_chunk, end, items_per_chunk - end, first, last, is_memcpy_iterator<InputIt>());
+        _back_chunk->end.store(end, std::memory_order_release);
+    }
+}
+
+template<typename T, size_t items_per_chunk>
+inline bool
+spsc_array_list<T, items_per_chunk>::front_chunk_next () {
+    chunk *next = _front_chunk->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+        return false;
+    }
+    chunk *old = _front_chunk;
+    _front_chunk = next;
+    // Only the consumer pushes and the producer only takes the whole list, so
+    // a plain CAS loop is free of ABA.
+    chunk *head = _free_chunks.load(std::memory_order_relaxed);
+    do {
+        old->free_next = head;
+    } while (!_free_chunks.compare_exchange_weak(head, old, std::memory_order_release,
+                                                 std::memory_order_relaxed));
+    return true;
+}
+
+template<typename T, size_t items_per_chunk>
+inline bool
+spsc_array_list<T, items_per_chunk>::try_pop_front (T &out) {
+    while (true) {
+        chunk *c = _front_chunk;
+        if (c->begin != c->end.load(std::memory_order_acquire)) {
+            T &item = c->items[c->begin].data;
+            out = std::move(item);
+            item.~T();
+            ++c->begin;
+            return true;
+        }
+        if (c->begin != items_per_chunk || !front_chunk_next()) {
+            return false;
+        }
+    }
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename OutputIt>
+void
+spsc_array_list<T, items_per_chunk>::remove_run (chunk *c, size_t run, OutputIt &out, std::false_type) {
+    for (; run != 0; --run, ++out) {
+        T &item = c->items[c->begin].data;
+        *out = std::move(item);
+        item.~T();
+        ++c->begin;
+    }
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename OutputIt>
+void
+spsc_array_list<T, items_per_chunk>::remove_run (chunk *c, size_t run, OutputIt &out, std::true_type) {
+    std::memcpy(out, &c->items[c->begin].data, run * sizeof(T));
+    c->begin += run;
+    out += run;
+}
+
+template<typename T, size_t items_per_chunk>
+template<typename OutputIt>
+size_t
+spsc_array_list<T, items_per_chunk>::pop_front (size_t n, OutputIt out) {
+    size_t done = 0;
+    while (done != n) {
+        chunk *c = _front_chunk;
+        size_t avail = c->end.load(std::memory_order_acquire) - c->begin;
+        if (avail == 0) {
+            if (c->begin != items_per_chunk || !front_chunk_next()) {
+                break;
+            }
+            continue;
+        }
+        size_t run = std::min(avail, n - done);
+        remove_run(c, run, out, is_memcpy_iterator<OutputIt>());
+        done += run;
+    }
+    return done;
+}
+
+template<typename T, size_t items_per_chunk>
+inline bool
+spsc_array_list<T, items_per_chunk>::empty () const {
+    chunk *c = _front_chunk;
+    if (c->begin != c->end.load(std::memory_order_acquire)) {
+        return false;
+    }
+    if (c->begin != items_per_chunk) {
+        return true;
+    }
+    // The producer links the next chunk before writing to it.
+    chunk *next = c->next.load(std::memory_order_acquire);
+    return next == nullptr || next->end.load(std::memory_order_acquire) == 0;
+}
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_SPSC_ARRAY_LIST_H_
@@ -0,0 +1,264 @@
+//
+
+#ifndef ABEL_CONTAINER_SPSC_QUEUE_H_
+#define ABEL_CONTAINER_SPSC_QUEUE_H_
+
+#include <abel/base/profile.h>
+#include <abel/container/internal/bounded_queue.h>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace abel {
+
+// spsc_queue
+//
+// A bounded, lock-free queue for exactly one producer thread and one consumer
+// thread. The capacity is rounded up to a power of two. The producer and the
+// consumer each own one index on its own cache line and keep a cached copy of
+// the other side's index, so in the steady state a push or pop touches no
+// cache line written by the other thread except the slot itself.
+//
+// try_push*() may only be called by the producer, try_pop*() only by the
+// consumer. size() and empty() may be called from either and are exact only
+// when the other side is idle. See blocking_queue.h for a wrapper whose
+// push and pop wait instead of failing.
+template<typename T>
+class spsc_queue {
+    static_assert(std::is_nothrow_move_constructible<T>::value &&
+                  std::is_nothrow_destructible<T>::value,
+                  "spsc_queue only supports nothrow-move value types");
+    union maybe_item {
+        maybe_item () noexcept { }
+        ~maybe_item () { }
+        T data;
+    };
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T &;
+    using const_reference = const T &;
+public:
+    explicit spsc_queue (size_t capacity);
+    spsc_queue (const spsc_queue &) = delete;
+    spsc_queue &operator = (const spsc_queue &) = delete;
+    ~spsc_queue ();
+
+    // Producer side. Returns false, leaving the arguments untouched, if the
+    // queue is full.
+    bool try_push (const T &data);
+    bool try_push (T &&data);
+    template<typename... A>
+    bool try_emplace (A &&... args);
+    // Pushes up to `n` elements constructed from `first`, `first + 1`, ...
+    // and publishes them with a single store. Returns the number pushed.
+    template<typename InputIt>
+    size_t try_push_n (InputIt first, size_t n);
+
+    // Consumer side. Returns false if the queue is empty.
+    bool try_pop (T &out);
+    // Like try_pop(), but hands the element to `f` as a `T &&` rather than
+    // assigning it to an existing object. If `f` throws, the element stays in
+    // the queue.
+    template<typename F>
+    bool try_consume (F &&f);
+    // Moves up to `n` elements to `out` and releases their slots with a single
+    // store. Returns the number popped.
+    template<typename OutputIt>
+    size_t try_pop_n (OutputIt out, size_t n);
+
+    size_t size () const;
+    bool empty () const;
+    size_t capacity () const { return _mask + 1; }
+private:
+    // Returns the number of free slots, refreshing the cached head only when
+    // the cached view says fewer than `want` are free.
+    size_t writable (size_t tail, size_t want);
+    // Returns the number of filled slots, refreshing the cached tail only when
+    // the cached view says fewer than `want` are filled.
+    size_t readable (size_t head, size_t want);
+    T *slot (size_t idx) { return &_items[idx & _mask].data; }
+private:
+    const size_t _mask;
+    maybe_item *const _items;
+    char _pad0[ABEL_CACHE_LINE_SIZE - sizeof(size_t) - sizeof(maybe_item *)];
+    // Written by the consumer.
+    std::atomic<size_t> _head;
+    size_t _tail_cache;
+    char _pad1[ABEL_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+    // Written by the producer.
+    std::atomic<size_t> _tail;
+    size_t _head_cache;
+    char _pad2[ABEL_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+};
+
+template<typename T>
+ABEL_FORCE_INLINE
+spsc_queue<T>::spsc_queue (size_t capacity)
+    : _mask(container_internal::queue_capacity(capacity) - 1),
+      _items(new maybe_item[_mask + 1]),
+      _head(0),
+      _tail_cache(0),
+      _tail(0),
+      _head_cache(0) {
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+spsc_queue<T>::~spsc_queue () {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    for (size_t i = _head.load(std::memory_order_relaxed); i != tail; ++i) {
+        slot(i)->~T();
+    }
+    delete[] _items;
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+size_t
+spsc_queue<T>::writable (size_t tail, size_t want) {
+    size_t n = capacity() - (tail - _head_cache);
+    if (n < want) {
+        _head_cache = _head.load(std::memory_order_acquire);
+        n = capacity() - (tail - _head_cache);
+    }
+    return n;
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+size_t
+spsc_queue<T>::readable (size_t head, size_t want) {
+    size_t n = _tail_cache - head;
+    if (n < want) {
+        _tail_cache = _tail.load(std::memory_order_acquire);
+        n = _tail_cache - head;
+    }
+    return n;
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+bool
+spsc_queue<T>::try_push (const T &data) {
+    return try_emplace(data);
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+bool
+spsc_queue<T>::try_push (T &&data) {
+    return try_emplace(std::move(data));
+}
+
+template<typename T>
+template<typename... A>
+ABEL_FORCE_INLINE
+bool
+spsc_queue<T>::try_emplace (A &&... args) {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if (writable(tail, 1) == 0) {
+        return false;
+    }
+    new(slot(tail)) T(std::forward<A>(args)...);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+template<typename InputIt>
+inline
+size_t
+spsc_queue<T>::try_push_n (InputIt first, size_t n) {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    const size_t free = writable(tail, n);
+    if (n > free) {
+        n = free;
+    }
+    size_t i = 0;
+    ABEL_INTERNAL_TRY {
+        for (; i < n; ++i, ++first) {
+            new(slot(tail + i)) T(*first);
+        }
+    }
+    ABEL_INTERNAL_CATCH_ANY {
+        // Keep what was constructed before the throw.
+        _tail.store(tail + i, std::memory_order_release);
+        ABEL_INTERNAL_RETHROW;
+    }
+    _tail.store(tail + n, std::memory_order_release);
+    return n;
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+bool
+spsc_queue<T>::try_pop (T &out) {
+    return try_consume([&out] (T &&v) { out = std::move(v); });
+}
+
+template<typename T>
+template<typename F>
+ABEL_FORCE_INLINE
+bool
+spsc_queue<T>::try_consume (F &&f) {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    if (readable(head, 1) == 0) {
+        return false;
+    }
+    T *p = slot(head);
+    f(std::move(*p));
+    p->~T();
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+template<typename OutputIt>
+inline
+size_t
+spsc_queue<T>::try_pop_n (OutputIt out, size_t n) {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    const size_t filled = readable(head, n);
+    if (n > filled) {
+        n = filled;
+    }
+    size_t i = 0;
+    ABEL_INTERNAL_TRY {
+        for (; i < n; ++i, ++out) {
+            T *p = slot(head + i);
+            *out = std::move(*p);
+            p->~T();
+        }
+    }
+    ABEL_INTERNAL_CATCH_ANY {
+        // The element whose assignment threw stays in the queue.
+        _head.store(head + i, std::memory_order_release);
+        ABEL_INTERNAL_RETHROW;
+    }
+    _head.store(head + n, std::memory_order_release);
+    return n;
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+size_t
+spsc_queue<T>::size () const {
+    const size_t head = _head.load(std::memory_order_acquire);
+    const size_t tail = _tail.load(std::memory_order_acquire);
+    // The two loads are not atomic together, so the head may be stale.
+    return tail - head > capacity() ? capacity() : tail - head;
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+bool
+spsc_queue<T>::empty () const {
+    return size() == 0;
+}
+
+}  // namespace abel
+
+#endif  // ABEL_CONTAINER_SPSC_QUEUE_H_
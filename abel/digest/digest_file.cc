@@ -0,0 +1,159 @@
+//
+
+#include <abel/digest/digest_file.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <memory>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace abel {
+
+namespace digest_detail {
+
+namespace {
+
+// Large enough that the syscall per block is lost in the hashing.
+constexpr size_t kBlockSize = 1 << 20;
+// How much of a file is mapped at a time.
+constexpr size_t kMapWindow = 64 << 20;
+// How far ahead of the block being hashed the kernel is asked to read.
+constexpr off_t kReadAhead = 16 << 20;
+
+bool fail (std::error_code &ec) {
+    ec = std::error_code(errno, std::generic_category());
+    return false;
+}
+
+std::unique_ptr<uint8_t[]> new_block (std::error_code &ec) {
+    std::unique_ptr<uint8_t[]> buf(new (std::nothrow) uint8_t[kBlockSize]);
+    if (!buf) {
+        ec = std::make_error_code(std::errc::not_enough_memory);
+    }
+    return buf;
+}
+
+bool digest_stream (int fd, void *hasher, digest_consumer consume, std::error_code &ec) {
+    std::unique_ptr<uint8_t[]> buf = new_block(ec);
+    if (!buf) {
+        return false;
+    }
+    for (;;) {
+        const ssize_t n = ::read(fd, buf.get(), kBlockSize);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return fail(ec);
+        }
+        if (n == 0) {
+            return true;
+        }
+        consume(hasher, buf.get(), static_cast<size_t>(n));
+    }
+}
+
+// Keeps kReadAhead bytes past `offset` requested from the disk, in steps of
+// a quarter so the kernel has reads queued while the caller hashes.
+void read_ahead (int fd, off_t offset, off_t &advised) {
+#if defined(POSIX_FADV_WILLNEED)
+    if (advised - offset < kReadAhead / 4 * 3) {
+        ::posix_fadvise(fd, advised, offset + kReadAhead - advised, POSIX_FADV_WILLNEED);
+        advised = offset + kReadAhead;
+    }
+#endif
+}
+
+// Hashes [offset, end) through read-only mappings of kMapWindow bytes,
+// which saves copying the file out of the page cache. Returns where it
+// stopped: `end`, or earlier if a mapping failed.
+off_t digest_mapped (int fd, off_t offset, off_t end, off_t &advised, void *hasher,
+                     digest_consumer consume) {
+    const off_t page = ::sysconf(_SC_PAGESIZE);
+    while (offset < end) {
+        const off_t base = offset / page * page;
+        const size_t size = static_cast<size_t>(std::min<off_t>(kMapWindow, end - base));
+        void *map = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, base);
+        if (map == MAP_FAILED) {
+            break;
+        }
+        ::madvise(map, size, MADV_SEQUENTIAL);
+        const uint8_t *data = static_cast<const uint8_t *>(map);
+        while (offset < base + off_t(size)) {
+            read_ahead(fd, offset, advised);
+            const size_t n = std::min<size_t>(kBlockSize, base + off_t(size) - offset);
+            consume(hasher, data + (offset - base), n);
+            offset += n;
+        }
+        ::munmap(map, size);
+    }
+    return offset;
+}
+
+}  // namespace
+
+bool digest_fd (int fd, void *hasher, digest_consumer consume, std::error_code &ec) noexcept {
+    ec.clear();
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        return fail(ec);
+    }
+    off_t offset = S_ISREG(st.st_mode) ? ::lseek(fd, 0, SEEK_CUR) : -1;
+    // Pipes, sockets, and files such as those in /proc that report no size.
+    if (offset < 0 || st.st_size == 0) {
+        return digest_stream(fd, hasher, consume, ec);
+    }
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(fd, offset, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    off_t advised = offset;
+    offset = digest_mapped(fd, offset, st.st_size, advised, hasher, consume);
+    // Whatever could not be mapped, and anything appended since fstat().
+    std::unique_ptr<uint8_t[]> buf = new_block(ec);
+    if (!buf) {
+        return false;
+    }
+    for (;;) {
+        read_ahead(fd, offset, advised);
+        const ssize_t n = ::pread(fd, buf.get(), kBlockSize, offset);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return fail(ec);
+        }
+        if (n == 0) {
+            break;
+        }
+        offset += n;
+        consume(hasher, buf.get(), static_cast<size_t>(n));
+    }
+    // Leave the offset at end of file, as read() would have.
+    if (::lseek(fd, offset, SEEK_SET) < 0) {
+        return fail(ec);
+    }
+    return true;
+}
+
+bool digest_file (const std::string &path, void *hasher, digest_consumer consume,
+                  std::error_code &ec) noexcept {
+    int fd;
+    do {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    if (fd < 0) {
+        return fail(ec);
+    }
+    const bool ok = digest_fd(fd, hasher, consume, ec);
+    ::close(fd);
+    return ok;
+}
+
+}  // namespace digest_detail
+
+}  // namespace abel
@@ -0,0 +1,50 @@
+//
+
+#ifndef ABEL_DIGEST_DIGEST_FILE_H_
+#define ABEL_DIGEST_DIGEST_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+namespace abel {
+
+namespace digest_detail {
+
+typedef void (*digest_consumer) (void *hasher, const void *data, size_t size);
+
+bool digest_fd (int fd, void *hasher, digest_consumer consume, std::error_code &ec) noexcept;
+bool digest_file (const std::string &path, void *hasher, digest_consumer consume,
+                  std::error_code &ec) noexcept;
+
+template <typename Hasher>
+void consume_into (void *hasher, const void *data, size_t size) {
+    static_cast<Hasher *>(hasher)->process(data, size);
+}
+
+}  // namespace digest_detail
+
+/*!
+ * feed everything from the current offset of `fd` to end of file into
+ * `hasher` (MD5, SHA1, SHA256, SHA512), which is left unfinalized.
+ *
+ * Regular files are hashed through mmap() windows while the kernel is asked
+ * to read the blocks after them ahead, so disk reads overlap with hashing;
+ * pipes and sockets are read() to EOF. As with any mapping, truncating the
+ * file while it is hashed raises SIGBUS. On failure returns false and sets
+ * `ec` from errno; `hasher` has then seen a prefix of the data.
+ */
+template <typename Hasher>
+bool digest_fd (Hasher &hasher, int fd, std::error_code &ec) noexcept {
+    return digest_detail::digest_fd(fd, &hasher, digest_detail::consume_into<Hasher>, ec);
+}
+
+//! open the file at `path` and feed it all into `hasher`, as digest_fd()
+template <typename Hasher>
+bool digest_file (Hasher &hasher, const std::string &path, std::error_code &ec) noexcept {
+    return digest_detail::digest_file(path, &hasher, digest_detail::consume_into<Hasher>, ec);
+}
+
+}  // namespace abel
+
+#endif  // ABEL_DIGEST_DIGEST_FILE_H_
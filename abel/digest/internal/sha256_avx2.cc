@@ -0,0 +1,157 @@
+//
+// SHA-256 over 8 independent messages at once, one per 32-bit lane of the
+// AVX2 registers. The functions carry their own target attribute, so that
+// this file builds without -mavx2 and is only run after cpu_supports_avx2().
+
+#include <abel/digest/internal/sha_simd.h>
+
+#if defined(ABEL_PROCESSOR_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#define ABEL_SHA_HAVE_AVX2_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace abel {
+
+namespace digest_detail {
+
+#if ABEL_SHA_HAVE_AVX2_KERNELS
+
+namespace {
+
+#define ABEL_TARGET_AVX2 __attribute__((target("avx2")))
+
+const uint32_t kSha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2,
+};
+
+template <int N>
+ABEL_TARGET_AVX2 ABEL_FORCE_INLINE __m256i ror (__m256i x) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+ABEL_TARGET_AVX2 ABEL_FORCE_INLINE __m256i add (__m256i a, __m256i b) {
+    return _mm256_add_epi32(a, b);
+}
+
+// Words `offset / 4` to `offset / 4 + 7` of the 8 blocks, word t of every
+// lane in w[t]: an 8x8 transpose of 32-bit words, then a byte swap.
+ABEL_TARGET_AVX2 ABEL_FORCE_INLINE void load_words (const uint8_t *const blocks[8],
+                                                    size_t offset, __m256i *w) {
+    __m256i r[8];
+    for (int i = 0; i < 8; ++i) {
+        r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[i] + offset));
+    }
+    const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    w[0] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x20), bswap);
+    w[1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x20), bswap);
+    w[2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x20), bswap);
+    w[3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x20), bswap);
+    w[4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x31), bswap);
+    w[5] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x31), bswap);
+    w[6] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x31), bswap);
+    w[7] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x31), bswap);
+}
+
+ABEL_TARGET_AVX2 void sha256_x8_avx2 (uint32_t state[8][8], const uint8_t *const blocks[8],
+                                      unsigned active) {
+    // Idle lanes read a block of zeros rather than their pointer.
+    static const uint8_t kZeros[64] = {};
+    const uint8_t *in[8];
+    for (int i = 0; i < 8; ++i) {
+        in[i] = (active & (1u << i)) ? blocks[i] : kZeros;
+    }
+
+    __m256i w[16];
+    load_words(in, 0, w);
+    load_words(in, 32, w + 8);
+
+    __m256i s[8];
+    for (int i = 0; i < 8; ++i) {
+        s[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[i]));
+    }
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3];
+    __m256i e = s[4], f = s[5], g = s[6], h = s[7];
+
+    for (int i = 0; i < 64; ++i) {
+        if (i >= 16) {
+            const __m256i w15 = w[(i - 15) & 15];
+            const __m256i w2 = w[(i - 2) & 15];
+            const __m256i gamma0 =
+                _mm256_xor_si256(_mm256_xor_si256(ror<7>(w15), ror<18>(w15)),
+                                 _mm256_srli_epi32(w15, 3));
+            const __m256i gamma1 =
+                _mm256_xor_si256(_mm256_xor_si256(ror<17>(w2), ror<19>(w2)),
+                                 _mm256_srli_epi32(w2, 10));
+            w[i & 15] = add(add(w[i & 15], gamma0), add(w[(i - 7) & 15], gamma1));
+        }
+        const __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(ror<6>(e), ror<11>(e)), ror<25>(e));
+        const __m256i ch = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+        const __m256i t1 = add(add(add(h, sigma1), add(ch, w[i & 15])),
+                               _mm256_set1_epi32(static_cast<int>(kSha256K[i])));
+        const __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(ror<2>(a), ror<13>(a)), ror<22>(a));
+        const __m256i maj = _mm256_or_si256(_mm256_and_si256(_mm256_or_si256(a, b), c),
+                                            _mm256_and_si256(a, b));
+        h = g;
+        g = f;
+        f = e;
+        e = add(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = add(t1, add(sigma0, maj));
+    }
+
+    const __m256i keep = _mm256_cmpeq_epi32(
+        _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(active)),
+                         _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128)),
+        _mm256_setzero_si256());
+    const __m256i out[8] = {a, b, c, d, e, f, g, h};
+    for (int i = 0; i < 8; ++i) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(state[i]),
+                            _mm256_blendv_epi8(add(s[i], out[i]), s[i], keep));
+    }
+}
+
+}  // namespace
+
+sha256_x8_kernel sha256_x8_avx2_kernel () {
+    return sha256_x8_avx2;
+}
+
+#else
+
+sha256_x8_kernel sha256_x8_avx2_kernel () {
+    return nullptr;
+}
+
+#endif  // ABEL_SHA_HAVE_AVX2_KERNELS
+
+}  // namespace digest_detail
+
+}  // namespace abel
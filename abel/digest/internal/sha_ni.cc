@@ -0,0 +1,196 @@
+//
+// SHA-1 and SHA-256 block functions on the x86 SHA extensions. The functions
+// carry their own target attribute, so that this file builds without -msha
+// and is only run after cpu_supports_sha_ni().
+
+#include <abel/digest/internal/sha_simd.h>
+
+#if defined(ABEL_PROCESSOR_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#define ABEL_SHA_HAVE_NI_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace abel {
+
+namespace digest_detail {
+
+#if ABEL_SHA_HAVE_NI_KERNELS
+
+namespace {
+
+#define ABEL_TARGET_SHA __attribute__((target("sha,sse4.1")))
+
+const uint32_t kSha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2,
+};
+
+// Four rounds of SHA-256, rounds 4 * Q to 4 * Q + 3. `m` holds the message
+// schedule as a ring of four 4-word groups; group Q % 4 is current, and the
+// next ones are advanced while the rounds run.
+template <int Q>
+ABEL_TARGET_SHA ABEL_FORCE_INLINE void sha256_quad (__m128i &abef, __m128i &cdgh,
+                                                    __m128i (&m)[4]) {
+    __m128i msg = _mm_add_epi32(
+        m[Q % 4], _mm_loadu_si128(reinterpret_cast<const __m128i *>(kSha256K + 4 * Q)));
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+    if (Q >= 3 && Q <= 14) {
+        const __m128i t = _mm_alignr_epi8(m[Q % 4], m[(Q + 3) % 4], 4);
+        m[(Q + 1) % 4] = _mm_sha256msg2_epu32(_mm_add_epi32(m[(Q + 1) % 4], t), m[Q % 4]);
+    }
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, msg);
+    if (Q >= 1 && Q <= 12) {
+        m[(Q + 3) % 4] = _mm_sha256msg1_epu32(m[(Q + 3) % 4], m[Q % 4]);
+    }
+}
+
+ABEL_TARGET_SHA void sha256_blocks_ni (uint32_t state[8], const uint8_t *data, size_t blocks) {
+    // Big-endian words.
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The rounds instruction wants the state as ABEF and CDGH.
+    __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state));
+    __m128i cdgh = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4));
+    t = _mm_shuffle_epi32(t, 0xB1);                // CDAB
+    cdgh = _mm_shuffle_epi32(cdgh, 0x1B);          // EFGH
+    __m128i abef = _mm_alignr_epi8(t, cdgh, 8);    // ABEF
+    cdgh = _mm_blend_epi16(cdgh, t, 0xF0);         // CDGH
+
+    for (; blocks != 0; --blocks, data += 64) {
+        const __m128i abef_save = abef;
+        const __m128i cdgh_save = cdgh;
+        __m128i m[4];
+        for (int i = 0; i < 4; ++i) {
+            m[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i)), bswap);
+        }
+        sha256_quad<0>(abef, cdgh, m);
+        sha256_quad<1>(abef, cdgh, m);
+        sha256_quad<2>(abef, cdgh, m);
+        sha256_quad<3>(abef, cdgh, m);
+        sha256_quad<4>(abef, cdgh, m);
+        sha256_quad<5>(abef, cdgh, m);
+        sha256_quad<6>(abef, cdgh, m);
+        sha256_quad<7>(abef, cdgh, m);
+        sha256_quad<8>(abef, cdgh, m);
+        sha256_quad<9>(abef, cdgh, m);
+        sha256_quad<10>(abef, cdgh, m);
+        sha256_quad<11>(abef, cdgh, m);
+        sha256_quad<12>(abef, cdgh, m);
+        sha256_quad<13>(abef, cdgh, m);
+        sha256_quad<14>(abef, cdgh, m);
+        sha256_quad<15>(abef, cdgh, m);
+        abef = _mm_add_epi32(abef, abef_save);
+        cdgh = _mm_add_epi32(cdgh, cdgh_save);
+    }
+
+    t = _mm_shuffle_epi32(abef, 0x1B);             // FEBA
+    cdgh = _mm_shuffle_epi32(cdgh, 0xB1);          // DCHG
+    abef = _mm_blend_epi16(t, cdgh, 0xF0);         // DCBA
+    cdgh = _mm_alignr_epi8(cdgh, t, 8);            // HGFE
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), abef);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), cdgh);
+}
+
+// Four rounds of SHA-1, rounds 4 * Q to 4 * Q + 3, with the message schedule
+// kept as for SHA-256. `e0` and `e1` take turns carrying E.
+template <int Q>
+ABEL_TARGET_SHA ABEL_FORCE_INLINE void sha1_quad (__m128i &abcd, __m128i &e0, __m128i &e1,
+                                                  __m128i (&m)[4]) {
+    __m128i &e = Q % 2 == 0 ? e0 : e1;
+    __m128i &next = Q % 2 == 0 ? e1 : e0;
+    if (Q == 0) {
+        e = _mm_add_epi32(e, m[0]);
+    } else {
+        e = _mm_sha1nexte_epu32(e, m[Q % 4]);
+    }
+    next = abcd;
+    if (Q >= 3 && Q <= 18) {
+        m[(Q + 1) % 4] = _mm_sha1msg2_epu32(m[(Q + 1) % 4], m[Q % 4]);
+    }
+    abcd = _mm_sha1rnds4_epu32(abcd, e, Q / 5);
+    if (Q >= 1 && Q <= 16) {
+        m[(Q + 3) % 4] = _mm_sha1msg1_epu32(m[(Q + 3) % 4], m[Q % 4]);
+    }
+    if (Q >= 2 && Q <= 17) {
+        m[(Q + 2) % 4] = _mm_xor_si128(m[(Q + 2) % 4], m[Q % 4]);
+    }
+}
+
+ABEL_TARGET_SHA void sha1_blocks_ni (uint32_t state[5], const uint8_t *data, size_t blocks) {
+    // Big-endian words, in reverse order.
+    const __m128i bswap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    __m128i abcd = _mm_shuffle_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0x1B);
+    __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+    for (; blocks != 0; --blocks, data += 64) {
+        const __m128i abcd_save = abcd;
+        const __m128i e0_save = e0;
+        __m128i e1;
+        __m128i m[4];
+        for (int i = 0; i < 4; ++i) {
+            m[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i)), bswap);
+        }
+        sha1_quad<0>(abcd, e0, e1, m);
+        sha1_quad<1>(abcd, e0, e1, m);
+        sha1_quad<2>(abcd, e0, e1, m);
+        sha1_quad<3>(abcd, e0, e1, m);
+        sha1_quad<4>(abcd, e0, e1, m);
+        sha1_quad<5>(abcd, e0, e1, m);
+        sha1_quad<6>(abcd, e0, e1, m);
+        sha1_quad<7>(abcd, e0, e1, m);
+        sha1_quad<8>(abcd, e0, e1, m);
+        sha1_quad<9>(abcd, e0, e1, m);
+        sha1_quad<10>(abcd, e0, e1, m);
+        sha1_quad<11>(abcd, e0, e1, m);
+        sha1_quad<12>(abcd, e0, e1, m);
+        sha1_quad<13>(abcd, e0, e1, m);
+        sha1_quad<14>(abcd, e0, e1, m);
+        sha1_quad<15>(abcd, e0, e1, m);
+        sha1_quad<16>(abcd, e0, e1, m);
+        sha1_quad<17>(abcd, e0, e1, m);
+        sha1_quad<18>(abcd, e0, e1, m);
+        sha1_quad<19>(abcd, e0, e1, m);
+        e0 = _mm_sha1nexte_epu32(e0, e0_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+}
+
+const sha_kernels kShaNiKernels = {
+    "sha-ni",
+    sha1_blocks_ni,
+    sha256_blocks_ni,
+};
+
+}  // namespace
+
+const sha_kernels *sha_ni_kernels () {
+    return &kShaNiKernels;
+}
+
+#else
+
+const sha_kernels *sha_ni_kernels () {
+    return nullptr;
+}
+
+#endif  // ABEL_SHA_HAVE_NI_KERNELS
+
+}  // namespace digest_detail
+
+}  // namespace abel
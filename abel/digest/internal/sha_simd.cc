@@ -0,0 +1,60 @@
+//
+
+#include <abel/digest/internal/sha_simd.h>
+
+#include <abel/base/internal/cpu_features.h>
+
+namespace abel {
+
+namespace digest_detail {
+
+namespace {
+
+const sha_kernels kScalarKernels = {
+    "scalar",
+    sha1_blocks_scalar,
+    sha256_blocks_scalar,
+};
+
+}  // namespace
+
+const sha_kernels &sha_scalar_kernels () {
+    return kScalarKernels;
+}
+
+bool cpu_supports_sha_ni () {
+    const base_internal::CpuFeatures &features = base_internal::GetCpuFeatures();
+    // SSSE3 and SSE4.1, which the kernels shuffle and blend with.
+    return features.sha && features.ssse3 && features.sse4_1;
+}
+
+bool cpu_supports_avx2 () {
+    return base_internal::GetCpuFeatures().avx2;
+}
+
+const sha_kernels &sha_best_kernels () {
+    static const sha_kernels *kernels = [] {
+        if (sha_ni_kernels() != nullptr && cpu_supports_sha_ni()) {
+            return sha_ni_kernels();
+        }
+        return &kScalarKernels;
+    }();
+    return *kernels;
+}
+
+sha256_x8_kernel sha256_best_x8_kernel () {
+    static const sha256_x8_kernel kernel = [] () -> sha256_x8_kernel {
+        if (sha_ni_kernels() != nullptr && cpu_supports_sha_ni()) {
+            return nullptr;
+        }
+        if (sha256_x8_avx2_kernel() != nullptr && cpu_supports_avx2()) {
+            return sha256_x8_avx2_kernel();
+        }
+        return nullptr;
+    }();
+    return kernel;
+}
+
+}  // namespace digest_detail
+
+}  // namespace abel
@@ -0,0 +1,62 @@
+//
+// The block functions behind SHA1 and SHA256: the portable ones, the SHA
+// extension (SHA-NI) ones and an 8-lane AVX2 SHA-256 for hashing many
+// messages at once, picked once at runtime by CPU feature.
+
+#ifndef ABEL_DIGEST_INTERNAL_SHA_SIMD_H_
+#define ABEL_DIGEST_INTERNAL_SHA_SIMD_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <abel/base/profile.h>
+#include <abel/strings/string_view.h>
+#include <abel/types/span.h>
+
+namespace abel {
+
+namespace digest_detail {
+
+struct sha_kernels {
+    const char *name;
+    // Compress the `blocks` 64-byte blocks at `data` into `state`.
+    void (*sha1_blocks) (uint32_t state[5], const uint8_t *data, size_t blocks);
+    void (*sha256_blocks) (uint32_t state[8], const uint8_t *data, size_t blocks);
+};
+
+// Compresses one 64-byte block into each of 8 SHA-256 states held word by
+// word: state[w][lane] is word w of lane `lane`. Lanes whose bit of `active`
+// is clear keep their state, and their block pointer is not read.
+typedef void (*sha256_x8_kernel) (uint32_t state[8][8], const uint8_t *const blocks[8],
+                                  unsigned active);
+
+// The portable block functions, always available.
+void sha1_blocks_scalar (uint32_t state[5], const uint8_t *data, size_t blocks);
+void sha256_blocks_scalar (uint32_t state[8], const uint8_t *data, size_t blocks);
+const sha_kernels &sha_scalar_kernels ();
+
+// nullptr unless built for x86-64.
+const sha_kernels *sha_ni_kernels ();
+sha256_x8_kernel sha256_x8_avx2_kernel ();
+
+// Whether the running CPU has the SHA extensions (with SSE4.1) / AVX2.
+bool cpu_supports_sha_ni ();
+bool cpu_supports_avx2 ();
+
+// The best block functions for the running CPU, chosen on first use.
+const sha_kernels &sha_best_kernels ();
+
+// The 8-lane kernel sha256_many() uses, or nullptr when it hashes messages
+// one at a time with sha_best_kernels(): with the SHA extensions a single
+// stream is faster than eight AVX2 lanes.
+sha256_x8_kernel sha256_best_x8_kernel ();
+
+// sha256_many() over `kernel`, whatever the CPU would pick.
+void sha256_many_x8 (sha256_x8_kernel kernel, abel::Span<const abel::string_view> messages,
+                     uint8_t *digests);
+
+}  // namespace digest_detail
+
+}  // namespace abel
+
+#endif  // ABEL_DIGEST_INTERNAL_SHA_SIMD_H_
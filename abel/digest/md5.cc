@@ -3,6 +3,7 @@
 //
 
 #include <abel/digest/md5.h>
+#include <abel/strings/cord.h>
 #include <abel/strings/hex_dump.h>
 #include <abel/base/math/rol.h>
 
@@ -18,7 +19,7 @@ namespace abel {
 
 namespace digest_detail {
 
-static ABEL_FORCE_INLINE uint32_t min (uint32_t x, uint32_t y) {
+static ABEL_FORCE_INLINE size_t min (size_t x, size_t y) {
     return x < y ? x : y;
 }
 
@@ -161,7 +162,7 @@ MD5::MD5 () {
     _state[3] = 0x10325476UL;
 }
 
-MD5::MD5 (const void *data, uint32_t size) : MD5() {
+MD5::MD5 (const void *data, size_t size) : MD5() {
     process(data, size);
 }
 
@@ -169,7 +170,7 @@ MD5::MD5 (const std::string &str) : MD5() {
     process(str);
 }
 
-void MD5::process (const void *data, uint32_t size) {
+void MD5::process (const void *data, size_t size) {
     const uint32_t block_size = sizeof(MD5::_buf);
     auto in = static_cast<const uint8_t *>(data);
 
@@ -180,7 +181,7 @@ void MD5::process (const void *data, uint32_t size) {
             in += block_size;
             size -= block_size;
         } else {
-            uint32_t n = digest_detail::min(size, (block_size - _curlen));
+            uint32_t n = static_cast<uint32_t>(digest_detail::min(size, (block_size - _curlen)));
             uint8_t *b = _buf + _curlen;
             for (const uint8_t *a = in; a != in + n; ++a, ++b) {
                 *b = *a;
@@ -202,6 +203,16 @@ void MD5::process (const std::string &str) {
     return process(str.data(), str.size());
 }
 
+void MD5::process (abel::Span<const uint8_t> data) {
+    process(data.data(), data.size());
+}
+
+void MD5::process (const cord &c) {
+    for (abel::string_view chunk : c.chunks()) {
+        process(chunk.data(), chunk.size());
+    }
+}
+
 void MD5::finalize (void *digest) {
     // Increase the length of the message
     _length += _curlen * 8;
@@ -252,7 +263,19 @@ std::string MD5::digest_hex_uc () {
     return hex_dump(digest, kDigestLength);
 }
 
-std::string md5_hex (const void *data, uint32_t size) {
+void MD5::digest_hex_to (string_sink out) {
+    uint8_t digest[kDigestLength];
+    finalize(digest);
+    hex_dump_lc_to(out, digest, kDigestLength);
+}
+
+void MD5::digest_hex_uc_to (string_sink out) {
+    uint8_t digest[kDigestLength];
+    finalize(digest);
+    hex_dump_to(out, digest, kDigestLength);
+}
+
+std::string md5_hex (const void *data, size_t size) {
     return MD5(data, size).digest_hex();
 }
 
@@ -260,7 +283,7 @@ std::string md5_hex (const std::string &str) {
     return MD5(str).digest_hex();
 }
 
-std::string md5_hex_uc (const void *data, uint32_t size) {
+std::string md5_hex_uc (const void *data, size_t size) {
     return MD5(data, size).digest_hex_uc();
 }
 
@@ -7,22 +7,30 @@
 
 #include <cstdint>
 #include <string>
+#include <abel/types/span.h>
+#include <abel/strings/string_sink.h>
 
 namespace abel {
 
+class cord;
+
 class MD5 {
 public:
     //! construct empty object.
     MD5 ();
     //! construct context and process data range
-    MD5 (const void *data, uint32_t size);
+    MD5 (const void *data, size_t size);
     //! construct context and process string
     explicit MD5 (const std::string &str);
 
     //! process more data
-    void process (const void *data, uint32_t size);
+    void process (const void *data, size_t size);
     //! process more data
     void process (const std::string &str);
+    //! process more data
+    void process (abel::Span<const uint8_t> data);
+    //! process the chunks of a cord in order, without flattening it
+    void process (const cord &c);
 
     //! digest length in bytes
     static constexpr size_t kDigestLength = 16;
@@ -36,6 +44,10 @@ public:
     std::string digest_hex ();
     //! finalize computation and return 16 byte (128 bit) digest upper-case hex
     std::string digest_hex_uc ();
+    //! finalize computation and append the digest hex encoded to `out`
+    void digest_hex_to (string_sink out);
+    //! finalize computation and append the digest upper-case hex encoded to `out`
+    void digest_hex_uc_to (string_sink out);
 
 private:
     uint64_t _length;
@@ -45,12 +57,12 @@ private:
 };
 
 //! process data and return 16 byte (128 bit) digest hex encoded
-std::string md5_hex (const void *data, uint32_t size);
+std::string md5_hex (const void *data, size_t size);
 //! process data and return 16 byte (128 bit) digest hex encoded
 std::string md5_hex (const std::string &str);
 
 //! process data and return 16 byte (128 bit) digest upper-case hex encoded
-std::string md5_hex_uc (const void *data, uint32_t size);
+std::string md5_hex_uc (const void *data, size_t size);
 //! process data and return 16 byte (128 bit) digest upper-case hex encoded
 std::string md5_hex_uc (const std::string &str);
 
@@ -3,8 +3,10 @@
 //
 
 #include <abel/digest/sha1.h>
+#include <abel/strings/cord.h>
 #include <abel/strings/hex_dump.h>
 #include <abel/base/math/rol.h>
+#include <abel/digest/internal/sha_simd.h>
 
 namespace abel {
 
@@ -19,7 +21,7 @@ namespace abel {
 
 namespace digest_detail {
 
-static ABEL_FORCE_INLINE uint32_t min (uint32_t x, uint32_t y) {
+static ABEL_FORCE_INLINE size_t min (size_t x, size_t y) {
     return x < y ? x : y;
 }
 
@@ -53,7 +55,7 @@ uint32_t F3 (const uint32_t &x, const uint32_t &y, const uint32_t &z) {
     return (x ^ y ^ z);
 }
 
-static void sha1_compress (uint32_t state[4], const uint8_t *buf) {
+static void sha1_compress (uint32_t state[5], const uint8_t *buf) {
     uint32_t a, b, c, d, e, W[80], i, t;
 
     /* copy the state into 512-bits into W[0..15] */
@@ -103,6 +105,11 @@ static void sha1_compress (uint32_t state[4], const uint8_t *buf) {
     state[4] = state[4] + e;
 }
 
+void sha1_blocks_scalar (uint32_t state[5], const uint8_t *data, size_t blocks) {
+    for (; blocks != 0; --blocks, data += 64)
+        sha1_compress(state, data);
+}
+
 } // namespace digest_detail
 
 SHA1::SHA1 () {
@@ -115,7 +122,7 @@ SHA1::SHA1 () {
     _state[4] = 0xc3d2e1f0UL;
 }
 
-SHA1::SHA1 (const void *data, uint32_t size) : SHA1() {
+SHA1::SHA1 (const void *data, size_t size) : SHA1() {
     process(data, size);
 }
 
@@ -123,18 +130,20 @@ SHA1::SHA1 (const std::string &str) : SHA1() {
     process(str);
 }
 
-void SHA1::process (const void *data, uint32_t size) {
+void SHA1::process (const void *data, size_t size) {
     const uint32_t block_size = sizeof(SHA1::_buf);
     auto in = static_cast<const uint8_t *>(data);
+    auto compress = digest_detail::sha_best_kernels().sha1_blocks;
 
     while (size > 0) {
         if (_curlen == 0 && size >= block_size) {
-            digest_detail::sha1_compress(_state, in);
-            _length += block_size * 8;
-            in += block_size;
-            size -= block_size;
+            const size_t n = size / block_size;
+            compress(_state, in, n);
+            _length += uint64_t(n) * block_size * 8;
+            in += n * block_size;
+            size -= n * block_size;
         } else {
-            uint32_t n = digest_detail::min(size, (block_size - _curlen));
+            uint32_t n = static_cast<uint32_t>(digest_detail::min(size, (block_size - _curlen)));
             uint8_t *b = _buf + _curlen;
             for (const uint8_t *a = in; a != in + n; ++a, ++b) {
                 *b = *a;
@@ -144,7 +153,7 @@ void SHA1::process (const void *data, uint32_t size) {
             size -= n;
 
             if (_curlen == block_size) {
-                digest_detail::sha1_compress(_state, _buf);
+                compress(_state, _buf, 1);
                 _length += 8 * block_size;
                 _curlen = 0;
             }
@@ -156,7 +165,19 @@ void SHA1::process (const std::string &str) {
     return process(str.data(), str.size());
 }
 
+void SHA1::process (abel::Span<const uint8_t> data) {
+    process(data.data(), data.size());
+}
+
+void SHA1::process (const cord &c) {
+    for (abel::string_view chunk : c.chunks()) {
+        process(chunk.data(), chunk.size());
+    }
+}
+
 void SHA1::finalize (void *digest) {
+    auto compress = digest_detail::sha_best_kernels().sha1_blocks;
+
     // Increase the length of the message
     _length += _curlen * 8;
 
@@ -169,7 +190,7 @@ void SHA1::finalize (void *digest) {
     if (_curlen > 56) {
         while (_curlen < 64)
             _buf[_curlen++] = 0;
-        digest_detail::sha1_compress(_state, _buf);
+        compress(_state, _buf, 1);
         _curlen = 0;
     }
 
@@ -179,7 +200,7 @@ void SHA1::finalize (void *digest) {
 
     // Store length
     digest_detail::store64h(_length, _buf + 56);
-    digest_detail::sha1_compress(_state, _buf);
+    compress(_state, _buf, 1);
 
     // Copy output
     for (size_t i = 0; i < 5; i++)
@@ -204,7 +225,19 @@ std::string SHA1::digest_hex_uc () {
     return hex_dump(digest, kDigestLength);
 }
 
-std::string sha1_hex (const void *data, uint32_t size) {
+void SHA1::digest_hex_to (string_sink out) {
+    uint8_t digest[kDigestLength];
+    finalize(digest);
+    hex_dump_lc_to(out, digest, kDigestLength);
+}
+
+void SHA1::digest_hex_uc_to (string_sink out) {
+    uint8_t digest[kDigestLength];
+    finalize(digest);
+    hex_dump_to(out, digest, kDigestLength);
+}
+
+std::string sha1_hex (const void *data, size_t size) {
     return SHA1(data, size).digest_hex();
 }
 
@@ -212,7 +245,7 @@ std::string sha1_hex (const std::string &str) {
     return SHA1(str).digest_hex();
 }
 
-std::string sha1_hex_uc (const void *data, uint32_t size) {
+std::string sha1_hex_uc (const void *data, size_t size) {
     return SHA1(data, size).digest_hex_uc();
 }
 
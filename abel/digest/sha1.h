@@ -6,9 +6,13 @@
 #define ABEL_DIGEST_SHA1_H_
 #include <cstdint>
 #include <string>
+#include <abel/types/span.h>
+#include <abel/strings/string_sink.h>
 
 namespace abel {
 
+class cord;
+
 /*!
  * SHA-1 processor without external dependencies.
  */
@@ -17,14 +21,18 @@ public:
     //! construct empty object.
     SHA1 ();
     //! construct context and process data range
-    SHA1 (const void *data, uint32_t size);
+    SHA1 (const void *data, size_t size);
     //! construct context and process string
     explicit SHA1 (const std::string &str);
 
     //! process more data
-    void process (const void *data, uint32_t size);
+    void process (const void *data, size_t size);
     //! process more data
     void process (const std::string &str);
+    //! process more data
+    void process (abel::Span<const uint8_t> data);
+    //! process the chunks of a cord in order, without flattening it
+    void process (const cord &c);
 
     //! digest length in bytes
     static constexpr size_t kDigestLength = 20;
@@ -38,6 +46,10 @@ public:
     std::string digest_hex ();
     //! finalize computation and return 20 byte (160 bit) digest upper-case hex
     std::string digest_hex_uc ();
+    //! finalize computation and append the digest hex encoded to `out`
+    void digest_hex_to (string_sink out);
+    //! finalize computation and append the digest upper-case hex encoded to `out`
+    void digest_hex_uc_to (string_sink out);
 
 private:
     uint64_t _length;
@@ -47,12 +59,12 @@ private:
 };
 
 //! process data and return 20 byte (160 bit) digest hex encoded
-std::string sha1_hex (const void *data, uint32_t size);
+std::string sha1_hex (const void *data, size_t size);
 //! process data and return 20 byte (160 bit) digest hex encoded
 std::string sha1_hex (const std::string &str);
 
 //! process data and return 20 byte (160 bit) digest upper-case hex encoded
-std::string sha1_hex_uc (const void *data, uint32_t size);
+std::string sha1_hex_uc (const void *data, size_t size);
 //! process data and return 20 byte (160 bit) digest upper-case hex encoded
 std::string sha1_hex_uc (const std::string &str);
 
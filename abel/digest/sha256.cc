@@ -3,6 +3,9 @@
 //
 #include <abel/base/profile.h>
 #include <abel/digest/sha256.h>
+#include <algorithm>
+#include <abel/digest/internal/sha_simd.h>
+#include <abel/strings/cord.h>
 #include <abel/strings/hex_dump.h>
 #include <abel/base/math/ror.h>
 
@@ -37,7 +40,7 @@ static const u32 K[64] = {
     0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL
 };
 
-static ABEL_FORCE_INLINE u32 min (u32 x, u32 y) {
+static ABEL_FORCE_INLINE size_t min (size_t x, size_t y) {
     return x < y ? x : y;
 }
 
@@ -111,22 +114,141 @@ static void sha256_compress (uint32_t state[8], const uint8_t *buf) {
         state[i] = state[i] + S[i];
 }
 
+static const u32 kInitialState[8] = {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+};
+
+// Copies the last `size % 64` bytes of a message to `tail` with the padding
+// and length, returning the number of blocks that makes, 1 or 2.
+static size_t pad_tail (const uint8_t *data, size_t size, uint8_t tail[128]) {
+    const size_t rest = size % 64;
+    const size_t blocks = rest + 9 <= 64 ? 1 : 2;
+    std::copy(data + size - rest, data + size, tail);
+    tail[rest] = 0x80;
+    std::fill(tail + rest + 1, tail + 64 * blocks - 8, uint8_t(0));
+    store64(u64(size) * 8, tail + 64 * blocks - 8);
+    return blocks;
+}
+
+static ABEL_FORCE_INLINE abel::string_view message_bytes (abel::string_view m) {
+    return m;
+}
+static ABEL_FORCE_INLINE abel::string_view message_bytes (abel::Span<const uint8_t> m) {
+    return abel::string_view(reinterpret_cast<const char *>(m.data()), m.size());
+}
+
+// Hashes the messages one after the other.
+template <typename Message>
+void sha256_each (abel::Span<const Message> messages, uint8_t *digests) {
+    auto blocks = digest_detail::sha_best_kernels().sha256_blocks;
+    for (const Message &message : messages) {
+        const abel::string_view m = message_bytes(message);
+        const uint8_t *data = reinterpret_cast<const uint8_t *>(m.data());
+        u32 state[8];
+        std::copy(kInitialState, kInitialState + 8, state);
+        blocks(state, data, m.size() / 64);
+        uint8_t tail[128];
+        blocks(state, tail, pad_tail(data, m.size(), tail));
+        for (size_t i = 0; i < 8; i++)
+            store32(state[i], digests + (4 * i));
+        digests += SHA256::kDigestLength;
+    }
+}
+
+// Hashes the messages 8 at a time, one per lane of `kernel`. A lane that
+// finishes its message picks up the next one, so messages of different
+// lengths keep all lanes busy until the last few.
+template <typename Message>
+void sha256_lanes (digest_detail::sha256_x8_kernel kernel, abel::Span<const Message> messages,
+                   uint8_t *digests) {
+    struct lane {
+        const uint8_t *data;
+        size_t full;    // whole blocks of the message
+        size_t blocks;  // whole blocks and tail blocks
+        size_t next;    // the next block to compress
+        size_t index;
+        uint8_t tail[128];
+    };
+    lane lanes[8];
+    u32 state[8][8];
+    unsigned busy = 0;
+    size_t next_message = 0;
+
+    auto start = [&] (int l) {
+        if (next_message == messages.size()) {
+            return;
+        }
+        lane &ln = lanes[l];
+        const abel::string_view m = message_bytes(messages[next_message]);
+        ln.data = reinterpret_cast<const uint8_t *>(m.data());
+        ln.full = m.size() / 64;
+        ln.blocks = ln.full + pad_tail(ln.data, m.size(), ln.tail);
+        ln.next = 0;
+        ln.index = next_message++;
+        for (int w = 0; w < 8; ++w)
+            state[w][l] = kInitialState[w];
+        busy |= 1u << l;
+    };
+    for (int l = 0; l < 8; ++l)
+        start(l);
+
+    while (busy != 0) {
+        const uint8_t *blocks[8];
+        for (int l = 0; l < 8; ++l) {
+            const lane &ln = lanes[l];
+            blocks[l] = !(busy & (1u << l)) ? nullptr
+                : ln.next < ln.full ? ln.data + 64 * ln.next
+                : ln.tail + 64 * (ln.next - ln.full);
+        }
+        kernel(state, blocks, busy);
+        for (int l = 0; l < 8; ++l) {
+            lane &ln = lanes[l];
+            if (!(busy & (1u << l)) || ++ln.next != ln.blocks) {
+                continue;
+            }
+            uint8_t *digest = digests + SHA256::kDigestLength * ln.index;
+            for (size_t w = 0; w < 8; w++)
+                store32(state[w][l], digest + (4 * w));
+            busy &= ~(1u << l);
+            start(l);
+        }
+    }
+}
+
+template <typename Message>
+void sha256_many_impl (abel::Span<const Message> messages, uint8_t *digests) {
+    digest_detail::sha256_x8_kernel kernel = digest_detail::sha256_best_x8_kernel();
+    if (kernel != nullptr && messages.size() > 1) {
+        sha256_lanes(kernel, messages, digests);
+    } else {
+        sha256_each(messages, digests);
+    }
+}
+
 } // namespace
 
+namespace digest_detail {
+
+void sha256_blocks_scalar (uint32_t state[8], const uint8_t *data, size_t blocks) {
+    for (; blocks != 0; --blocks, data += 64)
+        sha256_compress(state, data);
+}
+
+void sha256_many_x8 (sha256_x8_kernel kernel, abel::Span<const abel::string_view> messages,
+                     uint8_t *digests) {
+    sha256_lanes(kernel, messages, digests);
+}
+
+} // namespace digest_detail
+
 SHA256::SHA256 () {
     _curlen = 0;
     _length = 0;
-    _state[0] = 0x6A09E667UL;
-    _state[1] = 0xBB67AE85UL;
-    _state[2] = 0x3C6EF372UL;
-    _state[3] = 0xA54FF53AUL;
-    _state[4] = 0x510E527FUL;
-    _state[5] = 0x9B05688CUL;
-    _state[6] = 0x1F83D9ABUL;
-    _state[7] = 0x5BE0CD19UL;
+    std::copy(kInitialState, kInitialState + 8, _state);
 }
 
-SHA256::SHA256 (const void *data, uint32_t size)
+SHA256::SHA256 (const void *data, size_t size)
     : SHA256() {
     process(data, size);
 }
@@ -136,25 +258,27 @@ SHA256::SHA256 (const std::string &str)
     process(str);
 }
 
-void SHA256::process (const void *data, u32 size) {
+void SHA256::process (const void *data, size_t size) {
     const u32 block_size = sizeof(SHA256::_buf);
     auto in = static_cast<const uint8_t *>(data);
+    auto compress = digest_detail::sha_best_kernels().sha256_blocks;
 
     while (size > 0) {
         if (_curlen == 0 && size >= block_size) {
-            sha256_compress(_state, in);
-            _length += block_size * 8;
-            in += block_size;
-            size -= block_size;
+            const size_t n = size / block_size;
+            compress(_state, in, n);
+            _length += u64(n) * block_size * 8;
+            in += n * block_size;
+            size -= n * block_size;
         } else {
-            u32 n = min(size, (block_size - _curlen));
+            u32 n = static_cast<u32>(min(size, (block_size - _curlen)));
             std::copy(in, in + n, _buf + _curlen);
             _curlen += n;
             in += n;
             size -= n;
 
             if (_curlen == block_size) {
-                sha256_compress(_state, _buf);
+                compress(_state, _buf, 1);
                 _length += 8 * block_size;
                 _curlen = 0;
             }
@@ -166,7 +290,19 @@ void SHA256::process (const std::string &str) {
     return process(str.data(), str.size());
 }
 
+void SHA256::process (abel::Span<const uint8_t> data) {
+    process(data.data(), data.size());
+}
+
+void SHA256::process (const cord &c) {
+    for (abel::string_view chunk : c.chunks()) {
+        process(chunk.data(), chunk.size());
+    }
+}
+
 void SHA256::finalize (void *digest) {
+    auto compress = digest_detail::sha_best_kernels().sha256_blocks;
+
     // Increase the length of the message
     _length += _curlen * 8;
 
@@ -179,7 +315,7 @@ void SHA256::finalize (void *digest) {
     if (_curlen > 56) {
         while (_curlen < 64)
             _buf[_curlen++] = 0;
-        sha256_compress(_state, _buf);
+        compress(_state, _buf, 1);
         _curlen = 0;
     }
 
@@ -189,7 +325,7 @@ void SHA256::finalize (void *digest) {
 
     // Store length
     store64(_length, _buf + 56);
-    sha256_compress(_state, _buf);
+    compress(_state, _buf, 1);
 
     // Copy output
     for (size_t i = 0; i < 8; i++)
@@ -214,7 +350,27 @@ std::string SHA256::digest_hex_uc () {
     return hex_dump(digest, kDigestLength);
 }
 
-std::string sha256_hex (const void *data, uint32_t size) {
+void SHA256::digest_hex_to (string_sink out) {
+    uint8_t digest[kDigestLength];
+    finalize(digest);
+    hex_dump_lc_to(out, digest, kDigestLength);
+}
+
+void SHA256::digest_hex_uc_to (string_sink out) {
+    uint8_t digest[kDigestLength];
+    finalize(digest);
+    hex_dump_to(out, digest, kDigestLength);
+}
+
+void sha256_many (abel::Span<const abel::Span<const uint8_t>> messages, uint8_t *digests) {
+    sha256_many_impl(messages, digests);
+}
+
+void sha256_many (abel::Span<const abel::string_view> messages, uint8_t *digests) {
+    sha256_many_impl(messages, digests);
+}
+
+std::string sha256_hex (const void *data, size_t size) {
     return SHA256(data, size).digest_hex();
 }
 
@@ -222,7 +378,7 @@ std::string sha256_hex (const std::string &str) {
     return SHA256(str).digest_hex();
 }
 
-std::string sha256_hex_uc (const void *data, uint32_t size) {
+std::string sha256_hex_uc (const void *data, size_t size) {
     return SHA256(data, size).digest_hex_uc();
 }
 
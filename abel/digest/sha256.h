@@ -6,9 +6,14 @@
 #define ABEL_BASE_DIGEST_SHA256_H_
 #include <cstdint>
 #include <string>
+#include <abel/strings/string_sink.h>
+#include <abel/strings/string_view.h>
+#include <abel/types/span.h>
 
 namespace abel {
 
+class cord;
+
 /*!
  * SHA-256 processor without external dependencies.
  */
@@ -17,14 +22,18 @@ public:
     //! construct empty object.
     SHA256 ();
     //! construct context and process data range
-    SHA256 (const void *data, uint32_t size);
+    SHA256 (const void *data, size_t size);
     //! construct context and process string
     explicit SHA256 (const std::string &str);
 
     //! process more data
-    void process (const void *data, uint32_t size);
+    void process (const void *data, size_t size);
     //! process more data
     void process (const std::string &str);
+    //! process more data
+    void process (abel::Span<const uint8_t> data);
+    //! process the chunks of a cord in order, without flattening it
+    void process (const cord &c);
 
     //! digest length in bytes
     static constexpr size_t kDigestLength = 32;
@@ -38,6 +47,10 @@ public:
     std::string digest_hex ();
     //! finalize computation and return 32 byte (256 bit) digest upper-case hex
     std::string digest_hex_uc ();
+    //! finalize computation and append the digest hex encoded to `out`
+    void digest_hex_to (string_sink out);
+    //! finalize computation and append the digest upper-case hex encoded to `out`
+    void digest_hex_uc_to (string_sink out);
 
 private:
     uint64_t _length;
@@ -47,14 +60,23 @@ private:
 };
 
 //! process data and return 32 byte (256 bit) digest hex encoded
-std::string sha256_hex (const void *data, uint32_t size);
+std::string sha256_hex (const void *data, size_t size);
 //! process data and return 32 byte (256 bit) digest hex encoded
 std::string sha256_hex (const std::string &str);
 
 //! process data and return 32 byte (256 bit) digest upper-case hex encoded
-std::string sha256_hex_uc (const void *data, uint32_t size);
+std::string sha256_hex_uc (const void *data, size_t size);
 //! process data and return 32 byte (256 bit) digest upper-case hex encoded
 std::string sha256_hex_uc (const std::string &str);
 
+/*!
+ * hash each of `messages` on its own, writing its 32 byte digest to
+ * `digests + 32 * i`. Where the CPU has AVX2 but no SHA extensions, eight
+ * messages are hashed at once, which pays off for batches of small ones.
+ */
+void sha256_many (abel::Span<const abel::Span<const uint8_t>> messages, uint8_t *digests);
+//! hash each of `messages` on its own, as above
+void sha256_many (abel::Span<const abel::string_view> messages, uint8_t *digests);
+
 }
 #endif //ABEL_BASE_DIGEST_SHA256_H_
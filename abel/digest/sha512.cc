@@ -3,6 +3,7 @@
 //
 
 #include <abel/digest/sha512.h>
+#include <abel/strings/cord.h>
 #include <abel/strings/hex_dump.h>
 #include <abel/base/math/ror.h>
 #include <abel/base/profile.h>
@@ -51,7 +52,7 @@ static const uint64_t K[80] = {
     0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
 };
 
-static ABEL_FORCE_INLINE uint32_t min(uint32_t x, uint32_t y) {
+static ABEL_FORCE_INLINE size_t min(size_t x, size_t y) {
     return x < y ? x : y;
 }
 
@@ -148,7 +149,7 @@ SHA512::SHA512() {
     _state[7] = 0x5be0cd19137e2179ULL;
 }
 
-SHA512::SHA512(const void* data, uint32_t size) : SHA512() {
+SHA512::SHA512(const void* data, size_t size) : SHA512() {
     process(data, size);
 }
 
@@ -156,7 +157,7 @@ SHA512::SHA512(const std::string& str) : SHA512() {
     process(str);
 }
 
-void SHA512::process(const void* data, uint32_t size) {
+void SHA512::process(const void* data, size_t size) {
     const uint32_t block_size = sizeof(SHA512::_buf);
     auto in = static_cast<const uint8_t*>(data);
 
@@ -171,7 +172,7 @@ void SHA512::process(const void* data, uint32_t size) {
         }
         else
         {
-            uint32_t n = digest_detail::min(size, (block_size - _curlen));
+            uint32_t n = static_cast<uint32_t>(digest_detail::min(size, (block_size - _curlen)));
             uint8_t* b = _buf + _curlen;
             for (const uint8_t* a = in; a != in + n; ++a, ++b) {
                 *b = *a;
@@ -194,6 +195,16 @@ void SHA512::process(const std::string& str) {
     return process(str.data(), str.size());
 }
 
+void SHA512::process(abel::Span<const uint8_t> data) {
+    process(data.data(), data.size());
+}
+
+void SHA512::process(const cord& c) {
+    for (abel::string_view chunk : c.chunks()) {
+        process(chunk.data(), chunk.size());
+    }
+}
+
 void SHA512::finalize(void* digest) {
     // Increase the length of the message
     _length += _curlen * 8ULL;
@@ -246,7 +257,19 @@ std::string SHA512::digest_hex_uc() {
     return hex_dump(digest, kDigestLength);
 }
 
-std::string sha512_hex(const void* data, uint32_t size) {
+void SHA512::digest_hex_to(string_sink out) {
+    uint8_t digest[kDigestLength];
+    finalize(digest);
+    hex_dump_lc_to(out, digest, kDigestLength);
+}
+
+void SHA512::digest_hex_uc_to(string_sink out) {
+    uint8_t digest[kDigestLength];
+    finalize(digest);
+    hex_dump_to(out, digest, kDigestLength);
+}
+
+std::string sha512_hex(const void* data, size_t size) {
     return SHA512(data, size).digest_hex();
 }
 
@@ -254,7 +277,7 @@ std::string sha512_hex(const std::string& str) {
     return SHA512(str).digest_hex();
 }
 
-std::string sha512_hex_uc(const void* data, uint32_t size) {
+std::string sha512_hex_uc(const void* data, size_t size) {
     return SHA512(data, size).digest_hex_uc();
 }
 
@@ -7,9 +7,13 @@
 
 #include <cstdint>
 #include <string>
+#include <abel/types/span.h>
+#include <abel/strings/string_sink.h>
 
 namespace abel {
 
+class cord;
+
 /*!
  * SHA-512 processor without external dependencies.
  */
@@ -18,14 +22,18 @@ public:
     //! construct empty object.
     SHA512 ();
     //! construct context and process data range
-    SHA512 (const void *data, uint32_t size);
+    SHA512 (const void *data, size_t size);
     //! construct context and process string
     explicit SHA512 (const std::string &str);
 
     //! process more data
-    void process (const void *data, uint32_t size);
+    void process (const void *data, size_t size);
     //! process more data
     void process (const std::string &str);
+    //! process more data
+    void process (abel::Span<const uint8_t> data);
+    //! process the chunks of a cord in order, without flattening it
+    void process (const cord &c);
 
     //! digest length in bytes
     static constexpr size_t kDigestLength = 64;
@@ -39,6 +47,10 @@ public:
     std::string digest_hex ();
     //! finalize computation and return 64 byte (512 bit) digest upper-case hex
     std::string digest_hex_uc ();
+    //! finalize computation and append the digest hex encoded to `out`
+    void digest_hex_to (string_sink out);
+    //! finalize computation and append the digest upper-case hex encoded to `out`
+    void digest_hex_uc_to (string_sink out);
 
 private:
     uint64_t _length;
@@ -48,12 +60,12 @@ private:
 };
 
 //! process data and return 64 byte (512 bit) digest hex encoded
-std::string sha512_hex (const void *data, uint32_t size);
+std::string sha512_hex (const void *data, size_t size);
 //! process data and return 64 byte (512 bit) digest hex encoded
 std::string sha512_hex (const std::string &str);
 
 //! process data and return 64 byte (512 bit) digest upper-case hex encoded
-std::string sha512_hex_uc (const void *data, uint32_t size);
+std::string sha512_hex_uc (const void *data, size_t size);
 //! process data and return 64 byte (512 bit) digest upper-case hex encoded
 std::string sha512_hex_uc (const std::string &str);
 
@@ -0,0 +1,197 @@
+//
+
+#ifndef ABEL_MEMORY_BIASED_SHARED_PTR_H_
+#define ABEL_MEMORY_BIASED_SHARED_PTR_H_
+
+#include <abel/memory/internal/biased_refcount.h>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace abel {
+
+// biased_shared_ptr<> is a thread-safe shared pointer for objects that are
+// mostly, but not only, referenced from the thread that created them.
+//
+// Like lw_shared_ptr<>, a biased_shared_ptr<> occupies one machine word and
+// the count lives next to the object, which must be created with
+// make_biased_shared<>(). Unlike lw_shared_ptr<>, copies may be made and
+// dropped on any thread. Reference counting is biased towards the creating
+// thread, which updates a plain counter, so copying on that thread costs
+// about as much as lw_shared_ptr<> and much less than std::shared_ptr<>.
+// Other threads pay one atomic operation per update, as std::shared_ptr<>
+// does.
+//
+// When the last reference is dropped on another thread while the creator
+// still counts some, the object is handed to the creator and destroyed by it
+// on its next make_biased_shared<>() or biased_shared_merge_queued() call, or
+// when it exits. A thread that creates objects which other threads release
+// for good, and then stops creating objects, should call
+// biased_shared_merge_queued() now and then.
+//
+// biased_shared_ptr<> does not support polymorphism.
+
+template<typename T>
+class biased_shared_ptr;
+
+template<typename T, typename... A>
+biased_shared_ptr<T> make_biased_shared (A &&... a);
+
+namespace memory_internal {
+
+template<typename T>
+struct biased_shared_ptr_count_for final : biased_refcount {
+    T _value;
+
+    template<typename... A>
+    explicit biased_shared_ptr_count_for (A &&... a) : _value(std::forward<A>(a)...) { }
+};
+
+}  // namespace memory_internal
+
+// Destroys the objects that other threads released to the calling thread.
+inline void biased_shared_merge_queued () {
+    memory_internal::biased_refcount::merge_queued();
+}
+
+template<typename T>
+class biased_shared_ptr {
+    using count_type = memory_internal::biased_shared_ptr_count_for<typename std::remove_const<T>::type>;
+    memory_internal::biased_refcount *_p = nullptr;
+private:
+    explicit biased_shared_ptr (memory_internal::biased_refcount *p) noexcept : _p(p) {
+        if (_p) {
+            _p->increment();
+        }
+    }
+    static T *to_value (memory_internal::biased_refcount *p) noexcept {
+        return &static_cast<count_type *>(p)->_value;
+    }
+public:
+    using element_type = T;
+
+    biased_shared_ptr () noexcept = default;
+    biased_shared_ptr (std::nullptr_t) noexcept : biased_shared_ptr() { }
+    biased_shared_ptr (const biased_shared_ptr &x) noexcept : _p(x._p) {
+        if (_p) {
+            _p->increment();
+        }
+    }
+    biased_shared_ptr (biased_shared_ptr &&x) noexcept : _p(x._p) {
+        x._p = nullptr;
+    }
+    [[gnu::always_inline]]
+    ~biased_shared_ptr () {
+        if (_p) {
+            _p->decrement();
+        }
+    }
+    biased_shared_ptr &operator = (const biased_shared_ptr &x) noexcept {
+        if (_p != x._p) {
+            this->~biased_shared_ptr();
+            new(this) biased_shared_ptr(x);
+        }
+        return *this;
+    }
+    biased_shared_ptr &operator = (biased_shared_ptr &&x) noexcept {
+        if (_p != x._p) {
+            this->~biased_shared_ptr();
+            new(this) biased_shared_ptr(std::move(x));
+        }
+        return *this;
+    }
+    biased_shared_ptr &operator = (std::nullptr_t) noexcept {
+        return *this = biased_shared_ptr();
+    }
+
+    T &operator * () const noexcept { return *to_value(_p); }
+    T *operator -> () const noexcept { return to_value(_p); }
+    T *get () const noexcept {
+        if (_p) {
+            return to_value(_p);
+        } else {
+            return nullptr;
+        }
+    }
+
+    // Exact on the creating thread as long as no other thread holds a copy;
+    // elsewhere it is only a lower bound.
+    long int use_count () const noexcept {
+        if (_p) {
+            return _p->use_count();
+        } else {
+            return 0;
+        }
+    }
+
+    operator biased_shared_ptr<const T> () const noexcept {
+        return biased_shared_ptr<const T>(_p);
+    }
+
+    explicit operator bool () const noexcept {
+        return _p;
+    }
+
+    bool operator == (const biased_shared_ptr<const T> &x) const {
+        return _p == x._p;
+    }
+
+    bool operator != (const biased_shared_ptr<const T> &x) const {
+        return !operator ==(x);
+    }
+
+    bool operator == (const biased_shared_ptr<typename std::remove_const<T>::type> &x) const {
+        return _p == x._p;
+    }
+
+    bool operator != (const biased_shared_ptr<typename std::remove_const<T>::type> &x) const {
+        return !operator ==(x);
+    }
+
+    bool operator < (const biased_shared_ptr<const T> &x) const {
+        return _p < x._p;
+    }
+
+    bool operator < (const biased_shared_ptr<typename std::remove_const<T>::type> &x) const {
+        return _p < x._p;
+    }
+
+    template<typename U>
+    friend class biased_shared_ptr;
+
+    template<typename X, typename... A>
+    friend biased_shared_ptr<X> make_biased_shared (A &&...);
+};
+
+template<typename T, typename... A>
+inline
+biased_shared_ptr<T> make_biased_shared (A &&... a) {
+    return biased_shared_ptr<T>(new memory_internal::biased_shared_ptr_count_for<T>(std::forward<A>(a)...));
+}
+
+template<typename T>
+inline
+std::ostream &operator << (std::ostream &out, const biased_shared_ptr<T> &p) {
+    if (!p) {
+        return out << "null";
+    }
+    return out << *p;
+}
+
+}  // namespace abel
+
+namespace std {
+
+template<typename T>
+struct hash<abel::biased_shared_ptr<T>> : private hash<T *> {
+    size_t operator () (const abel::biased_shared_ptr<T> &p) const {
+        return hash<T *>::operator ()(p.get());
+    }
+};
+
+}  // namespace std
+
+#endif  // ABEL_MEMORY_BIASED_SHARED_PTR_H_
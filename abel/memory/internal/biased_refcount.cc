@@ -0,0 +1,236 @@
+//
+
+#include <abel/memory/internal/biased_refcount.h>
+
+#include <abel/threading/internal/spinlock.h>
+
+namespace abel {
+namespace memory_internal {
+
+// Per-thread state of an owner: its id and the objects queued to it by other
+// threads. Live states are linked in a registry so that a queueing thread can
+// tell whether the owner is still running.
+struct biased_thread_state {
+    biased_thread_state ();
+    ~biased_thread_state ();
+
+    // Unlinks and returns the queued objects. REQUIRES: registry lock held.
+    biased_refcount *take_queue ();
+    static void merge_all (biased_refcount *queue) noexcept;
+
+    uintptr_t id;
+    biased_thread_state *prev;
+    biased_thread_state *next;
+    biased_refcount *queue;
+    std::atomic<bool> has_queued;
+};
+
+namespace {
+
+struct biased_registry {
+    threading_internal::SpinLock lock;
+    biased_thread_state *head = nullptr;
+    std::atomic<uintptr_t> next_id {1};
+};
+
+biased_registry &registry () {
+    // Leaked so that threads exiting during static destruction can still
+    // unregister.
+    static biased_registry *r = new biased_registry;
+    return *r;
+}
+
+enum thread_phase {
+    kNotRegistered, kRegistered, kExited
+};
+
+thread_local int tls_phase = kNotRegistered;
+
+}  // namespace
+
+biased_thread_state::biased_thread_state ()
+    : id(registry().next_id.fetch_add(1, std::memory_order_relaxed)),
+      prev(nullptr), next(nullptr), queue(nullptr), has_queued(false) {
+    biased_registry &r = registry();
+    threading_internal::SpinLockHolder l(&r.lock);
+    next = r.head;
+    if (next != nullptr) {
+        next->prev = this;
+    }
+    r.head = this;
+}
+
+biased_thread_state::~biased_thread_state () {
+    biased_refcount *q;
+    {
+        biased_registry &r = registry();
+        threading_internal::SpinLockHolder l(&r.lock);
+        // From here on the thread no longer touches the owner counts of its
+        // objects, and other threads merge them when they would queue them.
+        biased_refcount::current_thread_id() = biased_refcount::kNoThread;
+        tls_phase = kExited;
+        if (prev != nullptr) {
+            prev->next = next;
+        } else {
+            r.head = next;
+        }
+        if (next != nullptr) {
+            next->prev = prev;
+        }
+        q = take_queue();
+    }
+    merge_all(q);
+}
+
+biased_refcount *biased_thread_state::take_queue () {
+    biased_refcount *q = queue;
+    queue = nullptr;
+    has_queued.store(false, std::memory_order_relaxed);
+    return q;
+}
+
+void biased_thread_state::merge_all (biased_refcount *queue) noexcept {
+    while (queue != nullptr) {
+        biased_refcount *next = queue->_queued_next;
+        // Drops the reference that the queueing thread kept alive.
+        if (queue->explicit_merge(-1) == 0) {
+            delete queue;
+        }
+        queue = next;
+    }
+}
+
+namespace {
+
+thread_local biased_thread_state tls_state;
+
+}  // namespace
+
+constexpr intptr_t biased_refcount::kMerged;
+constexpr intptr_t biased_refcount::kQueued;
+constexpr int biased_refcount::kShift;
+constexpr intptr_t biased_refcount::kOne;
+constexpr uintptr_t biased_refcount::kNoThread;
+
+biased_refcount::biased_refcount () noexcept
+    : _owner(0), _local(0), _shared(kMerged), _queued_next(nullptr) {
+    if (tls_phase == kNotRegistered) {
+        // Constructs the thread's state.
+        current_thread_id() = tls_state.id;
+        tls_phase = kRegistered;
+    } else if (tls_phase == kRegistered &&
+               tls_state.has_queued.load(std::memory_order_relaxed)) {
+        merge_queued();
+    }
+    if (tls_phase == kRegistered) {
+        _owner.store(current_thread_id(), std::memory_order_relaxed);
+        _shared.store(0, std::memory_order_relaxed);
+    }
+    // Otherwise the thread is exiting and the object starts out merged.
+}
+
+void biased_refcount::merge_queued () {
+    if (tls_phase != kRegistered) {
+        return;
+    }
+    biased_refcount *q;
+    {
+        threading_internal::SpinLockHolder l(&registry().lock);
+        q = tls_state.take_queue();
+    }
+    biased_thread_state::merge_all(q);
+}
+
+long biased_refcount::use_count () const noexcept {
+    const uintptr_t owner = _owner.load(std::memory_order_relaxed);
+    const long shared = static_cast<long>(
+        _shared.load(std::memory_order_relaxed) >> kShift);
+    if (owner == 0 || owner == current_thread_id()) {
+        return static_cast<long>(_local) + shared;
+    }
+    // The owner's count can not be read from here.
+    return shared > 0 ? shared : 1;
+}
+
+void biased_refcount::merge_zero_local () noexcept {
+    intptr_t shared = _shared.load(std::memory_order_acquire);
+    if (shared == 0) {
+        // No other thread ever held a reference.
+        delete this;
+        return;
+    }
+    _owner.store(0, std::memory_order_relaxed);
+    intptr_t merged;
+    do {
+        // A queued object stays in its queue with the queueing thread's
+        // reference counted here; merge_all() drops it later.
+        merged = (shared & ~(kMerged | kQueued)) | kMerged;
+    } while (!_shared.compare_exchange_weak(shared, merged,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire));
+    if (merged == kMerged) {
+        delete this;
+    }
+}
+
+void biased_refcount::decrement_shared () noexcept {
+    intptr_t shared = _shared.load(std::memory_order_relaxed);
+    intptr_t next;
+    bool queue;
+    do {
+        queue = shared == 0;
+        // Going below zero would leave the owner with the last word, and it
+        // may never decrement again, so hand the object to it instead.
+        next = queue ? kQueued : shared - kOne;
+    } while (!_shared.compare_exchange_weak(shared, next,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_relaxed));
+    if (queue) {
+        enqueue();
+    } else if (next == kMerged) {
+        delete this;
+    }
+}
+
+intptr_t biased_refcount::explicit_merge (intptr_t extra) noexcept {
+    intptr_t shared = _shared.load(std::memory_order_acquire);
+    intptr_t count;
+    do {
+        count = (shared >> kShift) + _local + extra;
+    } while (!_shared.compare_exchange_weak(shared, (count << kShift) | kMerged,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire));
+    _local = 0;
+    _owner.store(0, std::memory_order_relaxed);
+    return count;
+}
+
+void biased_refcount::enqueue () noexcept {
+    const uintptr_t owner = _owner.load(std::memory_order_relaxed);
+    if (owner != 0) {
+        biased_registry &r = registry();
+        threading_internal::SpinLockHolder l(&r.lock);
+        for (biased_thread_state *s = r.head; s != nullptr; s = s->next) {
+            if (s->id == owner) {
+                _queued_next = s->queue;
+                s->queue = this;
+                s->has_queued.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+    if (owner == 0) {
+        // The owner merged after the object was flagged; the reference kept
+        // for the queue is an ordinary shared one now.
+        decrement_shared();
+        return;
+    }
+    // The owner has exited. Its count is final and published by the registry
+    // lock, so the object can be merged here.
+    if (explicit_merge(-1) == 0) {
+        delete this;
+    }
+}
+
+}  // namespace memory_internal
+}  // namespace abel
@@ -0,0 +1,102 @@
+//
+
+#ifndef ABEL_MEMORY_INTERNAL_BIASED_REFCOUNT_H_
+#define ABEL_MEMORY_INTERNAL_BIASED_REFCOUNT_H_
+
+#include <abel/base/profile.h>
+#include <atomic>
+#include <cstdint>
+
+namespace abel {
+namespace memory_internal {
+
+// Biased reference counting.
+//
+// Most shared objects are only ever referenced from the thread that created
+// them, so the count is split in two: a plain counter that only the owning
+// thread touches, and an atomic counter for every other thread. The object is
+// alive while the sum is positive.
+//
+// The shared counter may go negative when references created by the owner
+// are dropped elsewhere. A non-owner that would take it below zero instead
+// keeps its reference alive, flags the object as queued and hands it to the
+// owner, which later folds the two counters together ("merges") and drops
+// that reference. The owner also merges when its own counter reaches zero.
+// Once merged, every thread uses the atomic counter.
+//
+// The owner processes its queue when it creates another biased object, when
+// it calls biased_refcount::merge_queued(), and when it exits. Objects queued
+// to a thread that has already exited are merged on the spot.
+class biased_refcount {
+public:
+    // Merges all objects queued to the calling thread.
+    static void merge_queued ();
+
+    void increment () noexcept {
+        if (_owner.load(std::memory_order_relaxed) == current_thread_id()) {
+            ++_local;
+        } else {
+            _shared.fetch_add(kOne, std::memory_order_relaxed);
+        }
+    }
+
+    // Drops a reference and disposes of the object if it was the last one.
+    void decrement () noexcept {
+        if (_owner.load(std::memory_order_relaxed) == current_thread_id()) {
+            if (--_local == 0) {
+                merge_zero_local();
+            }
+        } else {
+            decrement_shared();
+        }
+    }
+
+    // Exact only when no other thread holds a reference.
+    long use_count () const noexcept;
+
+protected:
+    // The new object is owned by the calling thread, with a count of zero.
+    biased_refcount () noexcept;
+    biased_refcount (const biased_refcount &) = delete;
+    biased_refcount &operator = (const biased_refcount &) = delete;
+    // Destroys the derived object that holds the value.
+    virtual ~biased_refcount () = default;
+
+private:
+    friend struct biased_thread_state;
+
+    // The shared word holds the count shifted left by kShift, and two flags.
+    static constexpr intptr_t kMerged = 1;
+    static constexpr intptr_t kQueued = 2;
+    static constexpr int kShift = 2;
+    static constexpr intptr_t kOne = intptr_t(1) << kShift;
+
+    // Owners are identified by a per-thread number that is never reused.
+    // Zero stands for "no owner" and kNoThread for threads that have not
+    // created a biased object or have exited; neither matches the other.
+    static constexpr uintptr_t kNoThread = ~uintptr_t(0);
+    static uintptr_t &current_thread_id () noexcept {
+        static thread_local uintptr_t id = kNoThread;
+        return id;
+    }
+
+    void merge_zero_local () noexcept;
+    void decrement_shared () noexcept;
+    // Folds the owner's count into the shared count, adds `extra` and marks
+    // the object merged. Returns the resulting count. Only the owner may call
+    // this, or any thread once the owner has exited.
+    intptr_t explicit_merge (intptr_t extra) noexcept;
+    // Hands the object to its owner for merging.
+    void enqueue () noexcept;
+
+    std::atomic<uintptr_t> _owner;
+    intptr_t _local;
+    std::atomic<intptr_t> _shared;
+    // Link in the owner's queue.
+    biased_refcount *_queued_next;
+};
+
+}  // namespace memory_internal
+}  // namespace abel
+
+#endif  // ABEL_MEMORY_INTERNAL_BIASED_REFCOUNT_H_
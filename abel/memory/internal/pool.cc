@@ -0,0 +1,254 @@
+//
+
+#include <abel/memory/internal/pool.h>
+
+#include <abel/base/internal/throw_delegate.h>
+#include <abel/memory/internal/direct_mmap.h>
+#include <abel/synchronization/internal/create_thread_identity.h>
+#include <abel/threading/internal/spinlock.h>
+#include <algorithm>
+#include <new>
+
+namespace abel {
+namespace memory_internal {
+
+namespace {
+
+// Chunks are mapped at this size and alignment so that the kernel can back
+// them with transparent huge pages.
+constexpr size_t kChunkSize = size_t(2) << 20;
+// Each class carves objects from regions of at least this size.
+constexpr size_t kMinRegionSize = size_t(64) << 10;
+// Full batches held by the transfer cache of a class; further objects go to
+// its loose list.
+constexpr size_t kTransferSlots = 64;
+
+// Objects moved between a thread cache and the central lists at a time.
+size_t batch_size (size_t cl) {
+    return std::max<size_t>(4, std::min<size_t>(64, 8192 / pool_class_size(cl)));
+}
+
+char *map_chunk () {
+#if ABEL_HAVE_MMAP
+    // Over-map and trim so that the chunk is aligned.
+    void *p = base_internal::DirectMmap(nullptr, 2 * kChunkSize, PROT_READ | PROT_WRITE,
+                                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        base_internal::ThrowStdBadAlloc();
+    }
+    const uintptr_t start = reinterpret_cast<uintptr_t>(p);
+    const uintptr_t aligned = (start + kChunkSize - 1) & ~(kChunkSize - 1);
+    if (aligned != start) {
+        base_internal::DirectMunmap(p, aligned - start);
+    }
+    const uintptr_t end = start + 2 * kChunkSize;
+    if (end != aligned + kChunkSize) {
+        base_internal::DirectMunmap(reinterpret_cast<void *>(aligned + kChunkSize),
+                                    end - aligned - kChunkSize);
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(reinterpret_cast<void *>(aligned), kChunkSize, MADV_HUGEPAGE);
+#endif
+    return reinterpret_cast<char *>(aligned);
+#else
+    return static_cast<char *>(::operator new(kChunkSize));
+#endif
+}
+
+// Hands out regions carved from the current chunk.
+class region_heap {
+public:
+    char *allocate (size_t size) {
+        threading_internal::SpinLockHolder l(&_lock);
+        if (static_cast<size_t>(_end - _cur) < size) {
+            // The rest of the chunk is smaller than any region; drop it.
+            _cur = map_chunk();
+            _end = _cur + kChunkSize;
+        }
+        char *p = _cur;
+        _cur += size;
+        return p;
+    }
+private:
+    threading_internal::SpinLock _lock;
+    char *_cur = nullptr;
+    char *_end = nullptr;
+};
+
+// The central free objects of one class.
+struct central_list {
+    threading_internal::SpinLock lock;
+    // Transfer cache: chains of exactly batch_size() objects.
+    void *batches[kTransferSlots];
+    size_t num_batches = 0;
+    // Objects returned individually or in partial batches.
+    void *loose = nullptr;
+    size_t num_loose = 0;
+    // Not yet handed out part of the current region.
+    char *region = nullptr;
+    char *region_end = nullptr;
+    // Keeps the locks of neighbouring classes apart.
+    char pad[ABEL_CACHE_LINE_SIZE];
+};
+
+struct central_state {
+    region_heap regions;
+    central_list lists[kPoolNumClasses];
+};
+
+central_state &central () {
+    // Leaked: objects may be freed during static destruction.
+    static central_state *state = new central_state;
+    return *state;
+}
+
+// Links `n` objects carved from the region of `list` and returns the head.
+void *carve (central_list &list, size_t cl, size_t n) {
+    const size_t size = pool_class_size(cl);
+    if (static_cast<size_t>(list.region_end - list.region) < n * size) {
+        const size_t region_size = std::max(kMinRegionSize, 4 * n * size);
+        list.region = central().regions.allocate(region_size);
+        list.region_end = list.region + region_size;
+    }
+    char *first = list.region;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        *reinterpret_cast<void **>(first + i * size) = first + (i + 1) * size;
+    }
+    *reinterpret_cast<void **>(first + (n - 1) * size) = nullptr;
+    list.region += n * size;
+    return first;
+}
+
+// Takes up to `n` objects for a thread cache; returns the chain and its
+// length in `*count`.
+void *remove_range (size_t cl, size_t n, size_t *count) {
+    central_list &list = central().lists[cl];
+    threading_internal::SpinLockHolder l(&list.lock);
+    if (n == batch_size(cl) && list.num_batches > 0) {
+        *count = n;
+        return list.batches[--list.num_batches];
+    }
+    if (list.num_loose == 0 && list.num_batches > 0) {
+        // Break up a batch for a smaller request.
+        list.loose = list.batches[--list.num_batches];
+        list.num_loose = batch_size(cl);
+    }
+    if (list.num_loose > 0) {
+        void *head = list.loose;
+        void *tail = head;
+        size_t taken = 1;
+        while (taken < n && *static_cast<void **>(tail) != nullptr) {
+            tail = *static_cast<void **>(tail);
+            ++taken;
+        }
+        list.loose = *static_cast<void **>(tail);
+        list.num_loose -= taken;
+        *static_cast<void **>(tail) = nullptr;
+        *count = taken;
+        return head;
+    }
+    *count = n;
+    return carve(list, cl, n);
+}
+
+// Gives back a chain of `n` objects ending at `tail`.
+void insert_range (size_t cl, void *head, void *tail, size_t n) {
+    central_list &list = central().lists[cl];
+    threading_internal::SpinLockHolder l(&list.lock);
+    if (n == batch_size(cl) && list.num_batches < kTransferSlots) {
+        list.batches[list.num_batches++] = head;
+        return;
+    }
+    *static_cast<void **>(tail) = list.loose;
+    list.loose = head;
+    list.num_loose += n;
+}
+
+// Moves `n` objects from the front of a thread cache list to the central
+// lists.
+void release_to_central (pool_thread_cache::free_list &fl, size_t cl, size_t n) {
+    void *head = fl.head;
+    void *tail = head;
+    for (size_t i = 1; i < n; ++i) {
+        tail = *static_cast<void **>(tail);
+    }
+    fl.head = *static_cast<void **>(tail);
+    fl.length -= static_cast<uint32_t>(n);
+    *static_cast<void **>(tail) = nullptr;
+    insert_range(cl, head, tail, n);
+}
+
+struct thread_cache_holder : threading_internal::ThreadExitHook {
+    pool_thread_cache cache;
+};
+
+thread_local bool tls_exited = false;
+
+void flush_thread_cache (threading_internal::ThreadExitHook *hook) {
+    thread_cache_holder *holder = static_cast<thread_cache_holder *>(hook);
+    // Hooks run on the exiting thread.
+    pool_thread_cache::current() = nullptr;
+    tls_exited = true;
+    for (size_t cl = 0; cl < kPoolNumClasses; ++cl) {
+        pool_thread_cache::free_list &fl = holder->cache.lists[cl];
+        if (fl.length > 0) {
+            release_to_central(fl, cl, fl.length);
+        }
+    }
+    delete holder;
+}
+
+pool_thread_cache *create_thread_cache () {
+    thread_cache_holder *holder = new thread_cache_holder();
+    for (size_t cl = 0; cl < kPoolNumClasses; ++cl) {
+        pool_thread_cache::free_list &fl = holder->cache.lists[cl];
+        fl.head = nullptr;
+        fl.length = 0;
+        fl.max_length = static_cast<uint32_t>(2 * batch_size(cl));
+    }
+    holder->on_exit = &flush_thread_cache;
+    holder->owner = &central();
+    synchronization_internal::RegisterThreadExitHook(holder);
+    pool_thread_cache::current() = &holder->cache;
+    return &holder->cache;
+}
+
+}  // namespace
+
+void *pool_allocate_slow (size_t cl) {
+    pool_thread_cache *tc = pool_thread_cache::current();
+    size_t count;
+    if (tc == nullptr) {
+        if (tls_exited) {
+            // Past the thread's exit hooks; go to the central list every time.
+            return remove_range(cl, 1, &count);
+        }
+        tc = create_thread_cache();
+    }
+    pool_thread_cache::free_list &fl = tc->lists[cl];
+    void *head = remove_range(cl, batch_size(cl), &count);
+    fl.head = *static_cast<void **>(head);
+    fl.length = static_cast<uint32_t>(count - 1);
+    return head;
+}
+
+void pool_deallocate_slow (void *p, size_t cl) {
+    pool_thread_cache *tc = pool_thread_cache::current();
+    if (tc == nullptr) {
+        if (tls_exited) {
+            insert_range(cl, p, p, 1);
+            return;
+        }
+        tc = create_thread_cache();
+    }
+    pool_thread_cache::free_list &fl = tc->lists[cl];
+    *static_cast<void **>(p) = fl.head;
+    fl.head = p;
+    ++fl.length;
+    if (fl.length > fl.max_length) {
+        release_to_central(fl, cl, batch_size(cl));
+    }
+}
+
+}  // namespace memory_internal
+}  // namespace abel
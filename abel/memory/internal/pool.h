@@ -0,0 +1,63 @@
+//
+
+#ifndef ABEL_MEMORY_INTERNAL_POOL_H_
+#define ABEL_MEMORY_INTERNAL_POOL_H_
+
+#include <abel/base/profile.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace abel {
+namespace memory_internal {
+
+// Size classes of the pool: multiples of 16 up to 128, then four classes per
+// power of two up to kPoolMaxSize, which keeps internal fragmentation under
+// 25%. Every class is a multiple of 16, so every object is 16-byte aligned.
+constexpr size_t kPoolMaxSize = 4096;
+constexpr size_t kPoolNumClasses = 28;
+constexpr size_t kPoolAlignment = 16;
+
+ABEL_FORCE_INLINE size_t pool_size_class (size_t size) {
+    if (size <= 128) {
+        return size == 0 ? 0 : (size - 1) >> 4;
+    }
+    // size - 1 lies in [2^k, 2^(k+1)), which holds four classes.
+    const int k = 63 - __builtin_clzll(static_cast<unsigned long long>(size - 1));
+    return 8 + 4 * (k - 7) + ((size - 1 - (size_t(1) << k)) >> (k - 2));
+}
+
+ABEL_FORCE_INLINE size_t pool_class_size (size_t cl) {
+    if (cl < 8) {
+        return 16 * (cl + 1);
+    }
+    const size_t k = 7 + (cl - 8) / 4;
+    return (size_t(1) << k) + ((cl - 8) % 4 + 1) * (size_t(1) << (k - 2));
+}
+
+// A thread's cache of free objects, one singly-linked list per class. The
+// first word of a free object links to the next one.
+struct pool_thread_cache {
+    struct free_list {
+        void *head;
+        uint32_t length;
+        uint32_t max_length;
+    };
+
+    // The calling thread's cache, or nullptr before its first allocation and
+    // after it has exited.
+    static pool_thread_cache *&current () noexcept {
+        static thread_local pool_thread_cache *cache = nullptr;
+        return cache;
+    }
+
+    free_list lists[kPoolNumClasses];
+};
+
+// Slow paths: refill from or release to the central lists.
+void *pool_allocate_slow (size_t cl);
+void pool_deallocate_slow (void *p, size_t cl);
+
+}  // namespace memory_internal
+}  // namespace abel
+
+#endif  // ABEL_MEMORY_INTERNAL_POOL_H_
@@ -0,0 +1,79 @@
+//
+
+#ifndef ABEL_MEMORY_OBJECT_POOL_H_
+#define ABEL_MEMORY_OBJECT_POOL_H_
+
+#include <abel/base/profile.h>
+#include <abel/memory/pool_allocator.h>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace abel {
+
+// object_pool<T> creates and destroys objects of type T in memory from
+// pool_allocate(), for types that are churned at high rates:
+//
+//   abel::object_pool<message> pool;
+//   message *m = pool.create(id, payload);
+//   ...
+//   pool.destroy(m);  // possibly on another thread
+//
+// The pool has no state of its own: all object_pool instances, and all types
+// of the same size class, share the per-thread caches described in
+// pool_allocator.h. Objects may be destroyed on any thread.
+template<typename T>
+class object_pool {
+    static_assert(alignof(T) <= memory_internal::kPoolAlignment,
+                  "object_pool does not support over-aligned types");
+public:
+    using value_type = T;
+
+    // Deletes objects through destroy(), for use with std::unique_ptr.
+    struct deleter {
+        void operator () (T *p) const noexcept {
+            destroy(p);
+        }
+    };
+    using unique_ptr = std::unique_ptr<T, deleter>;
+
+    template<typename... A>
+    static T *create (A &&... args);
+
+    // Destroys `p`, which may be nullptr.
+    static void destroy (T *p) noexcept;
+
+    template<typename... A>
+    static unique_ptr make_unique (A &&... args) {
+        return unique_ptr(create(std::forward<A>(args)...));
+    }
+};
+
+template<typename T>
+template<typename... A>
+inline
+T *
+object_pool<T>::create (A &&... args) {
+    void *p = pool_allocate(sizeof(T));
+    ABEL_INTERNAL_TRY {
+        return new(p) T(std::forward<A>(args)...);
+    }
+    ABEL_INTERNAL_CATCH_ANY {
+        pool_deallocate(p, sizeof(T));
+        ABEL_INTERNAL_RETHROW;
+    }
+}
+
+template<typename T>
+ABEL_FORCE_INLINE
+void
+object_pool<T>::destroy (T *p) noexcept {
+    if (p != nullptr) {
+        p->~T();
+        pool_deallocate(p, sizeof(T));
+    }
+}
+
+}  // namespace abel
+
+#endif  // ABEL_MEMORY_OBJECT_POOL_H_
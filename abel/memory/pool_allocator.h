@@ -0,0 +1,130 @@
+//
+
+#ifndef ABEL_MEMORY_POOL_ALLOCATOR_H_
+#define ABEL_MEMORY_POOL_ALLOCATOR_H_
+
+#include <abel/base/internal/throw_delegate.h>
+#include <abel/base/profile.h>
+#include <abel/memory/internal/pool.h>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace abel {
+
+// A size-class memory pool for small objects that are allocated and freed at
+// high rates, such as messages and container nodes.
+//
+// Requests of up to 4 KiB are rounded up to one of 28 size classes. Each
+// thread keeps a free list per class and serves most requests from it without
+// any synchronization. Lists that run empty are refilled, and lists that grow
+// too long are trimmed, in batches through a central transfer cache, so the
+// cost of its lock is shared by many objects. New objects are carved from
+// 2 MiB chunks mapped directly from the kernel and advised to be backed by
+// huge pages. Larger requests are passed on to ::operator new.
+//
+// The size must be given back on deallocation, which is what lets the pool
+// do without per-object headers. Memory taken by the pool is reused but never
+// returned to the system. A thread's cache is returned to the central lists
+// when the thread exits.
+
+// Returns 16-byte aligned memory for `size` bytes. Throws std::bad_alloc on
+// failure.
+ABEL_FORCE_INLINE void *pool_allocate (size_t size) {
+    if (ABEL_LIKELY(size <= memory_internal::kPoolMaxSize)) {
+        const size_t cl = memory_internal::pool_size_class(size);
+        memory_internal::pool_thread_cache *tc = memory_internal::pool_thread_cache::current();
+        if (ABEL_LIKELY(tc != nullptr)) {
+            memory_internal::pool_thread_cache::free_list &list = tc->lists[cl];
+            void *p = list.head;
+            if (ABEL_LIKELY(p != nullptr)) {
+                list.head = *static_cast<void **>(p);
+                --list.length;
+                return p;
+            }
+        }
+        return memory_internal::pool_allocate_slow(cl);
+    }
+    return ::operator new(size);
+}
+
+// Frees memory from pool_allocate(). `size` must be the size it was
+// allocated with.
+ABEL_FORCE_INLINE void pool_deallocate (void *p, size_t size) noexcept {
+    if (ABEL_LIKELY(size <= memory_internal::kPoolMaxSize)) {
+        const size_t cl = memory_internal::pool_size_class(size);
+        memory_internal::pool_thread_cache *tc = memory_internal::pool_thread_cache::current();
+        if (ABEL_LIKELY(tc != nullptr)) {
+            memory_internal::pool_thread_cache::free_list &list = tc->lists[cl];
+            if (ABEL_LIKELY(list.length < list.max_length)) {
+                *static_cast<void **>(p) = list.head;
+                list.head = p;
+                ++list.length;
+                return;
+            }
+        }
+        memory_internal::pool_deallocate_slow(p, cl);
+        return;
+    }
+    ::operator delete(p);
+}
+
+// pool_allocator
+//
+// A standard allocator over pool_allocate(), for containers whose nodes
+// are allocated one at a time:
+//
+//   std::list<int, abel::pool_allocator<int>> list;
+//   abel::btree_map<int, int, std::less<int>,
+//                   abel::pool_allocator<std::pair<const int, int>>> map;
+//
+// All instances are interchangeable.
+template<typename T>
+class pool_allocator {
+    static_assert(alignof(T) <= memory_internal::kPoolAlignment,
+                  "pool_allocator does not support over-aligned types");
+public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    template<typename U>
+    struct rebind {
+        using other = pool_allocator<U>;
+    };
+
+    pool_allocator () noexcept = default;
+    template<typename U>
+    pool_allocator (const pool_allocator<U> &) noexcept { }
+
+    T *allocate (size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            base_internal::ThrowStdBadAlloc();
+        }
+        return static_cast<T *>(pool_allocate(n * sizeof(T)));
+    }
+    void deallocate (T *p, size_t n) noexcept {
+        pool_deallocate(p, n * sizeof(T));
+    }
+};
+
+template<typename T, typename U>
+inline bool operator == (const pool_allocator<T> &, const pool_allocator<U> &) noexcept {
+    return true;
+}
+
+template<typename T, typename U>
+inline bool operator != (const pool_allocator<T> &, const pool_allocator<U> &) noexcept {
+    return false;
+}
+
+}  // namespace abel
+
+#endif  // ABEL_MEMORY_POOL_ALLOCATOR_H_
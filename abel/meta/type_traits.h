@@ -526,6 +526,43 @@ struct is_trivially_copyable
 };
 }  // namespace type_traits_internal
 
+// is_trivially_relocatable()
+//
+// Determines whether an object of type `T` may be moved to a new address by
+// copying its bytes, after which the old copy is neither used nor destroyed.
+// Containers use this to move their elements with `memcpy()` when they grow,
+// shrink or erase.
+//
+// This holds for trivially copyable types, which are detected automatically,
+// and for most types that own resources through pointers that do not point
+// into the object itself. Such types may opt in by specializing the trait:
+//
+//   namespace abel {
+//   template <>
+//   struct is_trivially_relocatable<my_string> : std::true_type {};
+//   }  // namespace abel
+//
+// Types holding pointers into themselves, such as libstdc++'s `std::string`
+// or `std::list`, must not opt in.
+template<typename T>
+struct is_trivially_relocatable
+    : std::integral_constant<
+        bool, type_traits_internal::is_trivially_copyable<T>::value> {
+};
+
+template<typename T>
+struct is_trivially_relocatable<std::unique_ptr<T, std::default_delete<T>>>
+    : std::true_type {
+};
+
+template<typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {
+};
+
+template<typename T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {
+};
+
 // -----------------------------------------------------------------------------
 // C++14 "_t" trait aliases
 // -----------------------------------------------------------------------------
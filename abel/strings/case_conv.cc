@@ -2,19 +2,21 @@
 // Created by liyinbin on 2019/12/8.
 //
 #include <abel/strings/case_conv.h>
-#include <abel/strings/ascii.h>
+#include <abel/strings/internal/ascii_simd.h>
 namespace abel {
 
 std::string &string_to_lower (std::string *str) {
-    std::transform(str->begin(), str->end(), str->begin(),
-                   [] (char c) { return ascii::to_lower(c); });
+    strings_internal::ascii_to_lower(&(*str)[0], str->size());
     return *str;
 }
 
 std::string &string_to_upper (std::string *str) {
-    std::transform(str->begin(), str->end(), str->begin(),
-                   [] (char c) { return ascii::to_upper(c); });
+    strings_internal::ascii_to_upper(&(*str)[0], str->size());
     return *str;
 }
 
+bool string_is_ascii (abel::string_view str) {
+    return strings_internal::ascii_all(str.data(), str.size());
+}
+
 }
\ No newline at end of file
@@ -28,5 +28,12 @@ std::string string_to_upper (abel::string_view str) {
     return result;
 }
 
+/**
+ * @brief returns true if no byte of `str` is past 0x7F
+ * @param str
+ * @return
+ */
+bool string_is_ascii (abel::string_view str);
+
 }
 #endif //ABEL_STRINGS_CASE_CONV_H_
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cfloat>
 #include <cmath>
 #include <cstring>
 
@@ -13,6 +14,7 @@
 #include <abel/numeric/int128.h>
 #include <abel/strings/internal/charconv_bigint.h>
 #include <abel/strings/internal/charconv_parse.h>
+#include <abel/strings/internal/charconv_pow10.h>
 
 #ifdef ABEL_BIT_PACK_FLOATS
     #error ABEL_BIT_PACK_FLOATS cannot be directly set
@@ -37,6 +39,9 @@ struct FloatTraits<double> {
 
     static constexpr int kMinNormalExponent = -1074;
 
+    // The largest power of ten that is exactly a double.
+    static constexpr int kMaxExactPower10 = 22;
+
     static double MakeNan (const char *tagp) {
         // Support nan no matter which namespace it's in.  Some platforms
         // incorrectly don't put it in namespace std.
@@ -70,6 +75,7 @@ struct FloatTraits<float> {
     static constexpr int kTargetMantissaBits = 24;
     static constexpr int kMaxExponent = 104;
     static constexpr int kMinNormalExponent = -149;
+    static constexpr int kMaxExactPower10 = 10;
     static float MakeNan (const char *tagp) {
         // Support nanf no matter which namespace it's in.  Some platforms
         // incorrectly don't put it in namespace std.
@@ -310,6 +316,86 @@ CalculatedFloat CalculatedFloatFromRawValues (uint64_t mantissa, int exponent) {
     return result;
 }
 
+// Clinger's fast path: a mantissa that fits in FloatType times or divided by
+// a power of ten that does is one correctly rounded operation. Needs
+// arithmetic done at the precision of the type, without x87 excess
+// precision.
+template<typename FloatType>
+bool ExactDecimalFastPath (const strings_internal::ParsedFloat &parsed_decimal,
+                           bool negative, FloatType *value) {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    static const FloatType kExactPowers[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const int exponent = parsed_decimal.exponent;
+    if (parsed_decimal.subrange_begin != nullptr ||
+        parsed_decimal.mantissa > uint64_t{1} << FloatTraits<FloatType>::kTargetMantissaBits ||
+        exponent < -FloatTraits<FloatType>::kMaxExactPower10 ||
+        exponent > FloatTraits<FloatType>::kMaxExactPower10) {
+        return false;
+    }
+    FloatType v = static_cast<FloatType>(parsed_decimal.mantissa);
+    if (exponent < 0) {
+        v /= kExactPowers[-exponent];
+    } else {
+        v *= kExactPowers[exponent];
+    }
+    *value = negative ? -v : v;
+    return true;
+#else
+    return false;
+#endif
+}
+
+// The Eisel-Lemire algorithm: `mantissa` * 10**`exponent` by way of a 128-bit
+// product with the power of ten, rounded to FloatType. That is exact unless
+// the bits truncated from the power could decide the rounding, or the
+// product is (nearly) halfway between two floats, which is when this returns
+// false. So do subnormal results, which the exact path handles.
+template<typename FloatType>
+bool EiselLemire (uint64_t mantissa, int exponent, CalculatedFloat *result) {
+    constexpr int kMantissaBits = FloatTraits<FloatType>::kTargetMantissaBits;
+    // The product's high word has one or two bits above the mantissa and a
+    // rounding bit; these are the bits below.
+    constexpr int kShift = 64 - kMantissaBits - 2;
+    constexpr uint64_t kLowMask = (uint64_t {1} << kShift) - 1;
+
+    const int lz = abel::count_leading_zeros(mantissa);
+    const uint64_t w = mantissa << lz;
+    const uint64_t *pow10 =
+        strings_internal::kPow10Table[exponent - strings_internal::kPow10TableMin];
+    const uint128 product = uint128(w) * pow10[0];
+    uint64_t hi = Uint128High64(product);
+    uint64_t lo = Uint128Low64(product);
+    if ((hi & kLowMask) == kLowMask && lo + w < lo) {
+        // What was truncated from the power's high word could carry into the
+        // result; bring in its low word.
+        const uint128 next = uint128(w) * pow10[1];
+        const uint64_t next_hi = Uint128High64(next);
+        lo += next_hi;
+        hi += lo < next_hi;
+        if ((hi & kLowMask) == kLowMask && lo + 1 == 0 &&
+            Uint128Low64(next) + w < Uint128Low64(next)) {
+            return false;
+        }
+    }
+    const int upper = static_cast<int>(hi >> 63);
+    uint64_t binary_mantissa = hi >> (upper + kShift);
+    if (lo == 0 && (hi & kLowMask) == 0 && (binary_mantissa & 3) == 1) {
+        return false;
+    }
+    binary_mantissa = (binary_mantissa + (binary_mantissa & 1)) >> 1;
+    // 10**exponent is pow10[0] * 2**(FloorLog2Pow10(exponent) - 63), so the
+    // value is hi * 2**(FloorLog2Pow10(exponent) + 1 - lz).
+    const int binary_exponent = strings_internal::FloorLog2Pow10(exponent) + 1 - lz +
+                                upper + kShift + 1;
+    if (binary_exponent < FloatTraits<FloatType>::kMinNormalExponent) {
+        return false;
+    }
+    *result = CalculatedFloatFromRawValues<FloatType>(binary_mantissa, binary_exponent);
+    return true;
+}
+
 template<typename FloatType>
 CalculatedFloat CalculateFromParsedHexadecimal (
     const strings_internal::ParsedFloat &parsed_hex) {
@@ -339,6 +425,22 @@ CalculatedFloat CalculateFromParsedDecimal (
         return result;
     }
 
+    // Most inputs are settled by Eisel-Lemire. A mantissa cut short at 19
+    // digits is too, when it rounds the same as with its last digit one
+    // higher, which bounds the digits that were dropped.
+    if (EiselLemire<FloatType>(parsed_decimal.mantissa, parsed_decimal.exponent,
+                               &result)) {
+        if (parsed_decimal.subrange_begin == nullptr) {
+            return result;
+        }
+        CalculatedFloat upper;
+        if (EiselLemire<FloatType>(parsed_decimal.mantissa + 1,
+                                   parsed_decimal.exponent, &upper) &&
+            upper.mantissa == result.mantissa && upper.exponent == result.exponent) {
+            return result;
+        }
+    }
+
     uint128 wide_binary_mantissa = parsed_decimal.mantissa;
     wide_binary_mantissa *= Power10Mantissa(parsed_decimal.exponent);
     int binary_exponent = Power10Exponent(parsed_decimal.exponent);
@@ -445,7 +547,8 @@ from_chars_result FromCharsImpl (const char *first, const char *last,
             return result;
         }
         result.ptr = decimal_parse.end;
-        if (HandleEdgeCase(decimal_parse, negative, &value)) {
+        if (HandleEdgeCase(decimal_parse, negative, &value) ||
+            ExactDecimalFastPath(decimal_parse, negative, &value)) {
             return result;
         }
         CalculatedFloat calculated =
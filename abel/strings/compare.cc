@@ -4,33 +4,30 @@
 
 #include <abel/strings/compare.h>
 #include <abel/strings/ascii.h>
+#include <abel/strings/internal/ascii_simd.h>
+#include <algorithm>
 namespace abel {
 
 int compare_case (abel::string_view a, abel::string_view b){
-    abel::string_view::const_iterator ai = a.begin();
-    abel::string_view::const_iterator bi = b.begin();
-
-    while (ai != a.end() && bi != b.end()) {
-        int ca = ascii::to_lower(*ai++);
-        int cb = ascii::to_lower(*bi++);
-
-        if (ca == cb) {
-            continue;
-        }
-        if (ca < cb) {
-            return -1;
-        } else {
-            return +1;
-        }
+    const size_t n = std::min(a.size(), b.size());
+    const size_t i = strings_internal::ascii_case_mismatch(a.data(), b.data(), n);
+    if (i != n) {
+        int ca = ascii::to_lower(a[i]);
+        int cb = ascii::to_lower(b[i]);
+        return ca < cb ? -1 : +1;
     }
 
-    if (ai == a.end() && bi != b.end()) {
+    if (a.size() < b.size()) {
         return +1;
-    } else if (ai != a.end() && bi == b.end()) {
+    } else if (a.size() > b.size()) {
         return -1;
     } else {
         return 0;
     }
 }
 
-} //namespace abel
\ No newline at end of file
+size_t hash_case (abel::string_view s) {
+    return static_cast<size_t>(strings_internal::ascii_case_hash(s.data(), s.size(), 0));
+}
+
+} //namespace abel
@@ -4,6 +4,7 @@
 
 #ifndef ABEL_STRINGS_COMPARE_H_
 #define ABEL_STRINGS_COMPARE_H_
+#include <abel/strings/internal/ascii_simd.h>
 #include <abel/strings/string_view.h>
 
 namespace abel {
@@ -16,9 +17,18 @@ namespace abel {
 int compare_case (abel::string_view a, abel::string_view b);
 
 ABEL_FORCE_INLINE bool equal_case(abel::string_view a, abel::string_view b) {
-    return compare_case(a, b) == 0;
+    return a.size() == b.size() &&
+           strings_internal::ascii_case_mismatch(a.data(), b.data(), a.size()) == a.size();
 }
 
+/**
+ * @brief hashes `s` without regard for letter case, so that strings equal
+ *        under equal_case() hash alike
+ * @param s
+ * @return
+ */
+size_t hash_case (abel::string_view s);
+
 } //namespace abel
 
 #endif //ABEL_STRINGS_COMPARE_H_
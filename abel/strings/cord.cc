@@ -0,0 +1,359 @@
+//
+
+#include <abel/strings/cord.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <ostream>
+
+namespace abel {
+
+namespace {
+
+// A new chunk gets room for as many bytes as the cord already holds, within
+// these bounds, so that a cord grown by small appends has few chunks without
+// small cords reserving much.
+constexpr size_t kMinChunkCapacity = 256;
+constexpr size_t kMaxChunkCapacity = 64 << 10;
+
+// Appending or prepending a cord up to this size copies its bytes rather than
+// sharing its chunks, which would cost more than the bytes themselves.
+constexpr size_t kMaxBytesToCopy = 128;
+
+}  // namespace
+
+namespace cord_internal {
+
+chunk* chunk::make(abel::string_view src, size_t capacity) {
+  void* memory = ::operator new(sizeof(chunk) + capacity);
+  chunk* c = new (memory) chunk();
+  c->data = reinterpret_cast<char*>(c + 1);
+  c->capacity = capacity;
+  c->size = src.size();
+  if (!src.empty()) memcpy(c->data, src.data(), src.size());
+  return c;
+}
+
+chunk* chunk::adopt(std::string&& src) {
+  chunk* c = new (::operator new(sizeof(chunk))) chunk();
+  c->adopted = std::move(src);
+  c->data = &c->adopted[0];
+  c->size = c->adopted.size();
+  // The string's spare room is left alone; appends start new chunks.
+  c->capacity = c->size;
+  return c;
+}
+
+void chunk::destroy() {
+  this->~chunk();
+  ::operator delete(this);
+}
+
+}  // namespace cord_internal
+
+cord::cord(const cord& other)
+    : pieces_(other.pieces_.begin() + other.first_, other.pieces_.end()),
+      first_(0),
+      size_(other.size_) {
+  for (piece& p : pieces_) p.owner->ref();
+}
+
+cord::cord(cord&& other) noexcept
+    : pieces_(std::move(other.pieces_)),
+      first_(other.first_),
+      size_(other.size_) {
+  other.pieces_.clear();
+  other.first_ = 0;
+  other.size_ = 0;
+}
+
+cord& cord::operator=(const cord& other) {
+  if (this != &other) *this = cord(other);
+  return *this;
+}
+
+cord& cord::operator=(cord&& other) noexcept {
+  if (this != &other) {
+    unref_all();
+    pieces_ = std::move(other.pieces_);
+    first_ = other.first_;
+    size_ = other.size_;
+    other.pieces_.clear();
+    other.first_ = 0;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+cord::~cord() { unref_all(); }
+
+void cord::unref_all() {
+  for (size_t i = first_; i < pieces_.size(); ++i) pieces_[i].owner->unref();
+}
+
+cord_internal::chunk* cord::tail_room(size_t n) {
+  if (first_ == pieces_.size()) return nullptr;
+  const piece& last = pieces_.back();
+  cord_internal::chunk* c = last.owner;
+  if (last.offset + last.size != c->size || c->capacity - c->size < n ||
+      !c->unique()) {
+    return nullptr;
+  }
+  return c;
+}
+
+size_t cord::next_chunk_capacity(size_t n) const {
+  return std::max(n, std::min(std::max(size_, kMinChunkCapacity),
+                              kMaxChunkCapacity));
+}
+
+void cord::push_back(const piece& p) {
+  if (pieces_.capacity() == 0) pieces_.reserve(4);
+  pieces_.push_back(p);
+  size_ += p.size;
+}
+
+void cord::push_front(const piece& p) {
+  if (first_ == 0) {
+    // Move the pieces up, leaving as much room in front as they take.
+    const size_t count = pieces_.size();
+    const size_t room = std::max<size_t>(count, 4);
+    std::vector<piece> moved(room + count);
+    std::copy(pieces_.begin(), pieces_.end(), moved.begin() + room);
+    pieces_.swap(moved);
+    first_ = room;
+  }
+  pieces_[--first_] = p;
+  size_ += p.size;
+}
+
+void cord::append(abel::string_view src) {
+  if (src.empty()) return;
+  if (cord_internal::chunk* tail = tail_room(src.size())) {
+    memcpy(tail->data + tail->size, src.data(), src.size());
+    tail->size += src.size();
+    pieces_.back().size += src.size();
+    size_ += src.size();
+    return;
+  }
+  push_back(piece{
+      cord_internal::chunk::make(src, next_chunk_capacity(src.size())), 0,
+      src.size()});
+}
+
+void cord::append(std::string&& src) {
+  if (src.size() <= kMaxBytesToCopy) {
+    append(abel::string_view(src));
+    return;
+  }
+  const size_t size = src.size();
+  push_back(piece{cord_internal::chunk::adopt(std::move(src)), 0, size});
+}
+
+void cord::append(const cord& src) {
+  if (&src == this) {
+    append(cord(src));
+    return;
+  }
+  if (src.size() <= kMaxBytesToCopy) {
+    for (abel::string_view chunk : src.chunks()) append(chunk);
+    return;
+  }
+  pieces_.reserve(pieces_.size() + src.chunk_count());
+  for (size_t i = src.first_; i < src.pieces_.size(); ++i) {
+    src.pieces_[i].owner->ref();
+    push_back(src.pieces_[i]);
+  }
+}
+
+void cord::append_pieces(std::initializer_list<abel::string_view> pieces) {
+  size_t total = 0;
+  for (abel::string_view p : pieces) total += p.size();
+  if (total == 0) return;
+  cord_internal::chunk* tail = tail_room(total);
+  if (tail != nullptr) {
+    pieces_.back().size += total;
+    size_ += total;
+  } else {
+    tail = cord_internal::chunk::make(abel::string_view(),
+                                      next_chunk_capacity(total));
+    push_back(piece{tail, 0, total});
+  }
+  for (abel::string_view p : pieces) {
+    if (p.empty()) continue;
+    memcpy(tail->data + tail->size, p.data(), p.size());
+    tail->size += p.size();
+  }
+}
+
+void cord::prepend(abel::string_view src) {
+  if (src.empty()) return;
+  push_front(piece{cord_internal::chunk::make(src, src.size()), 0, src.size()});
+}
+
+void cord::prepend(std::string&& src) {
+  if (src.empty()) return;
+  const size_t size = src.size();
+  push_front(piece{cord_internal::chunk::adopt(std::move(src)), 0, size});
+}
+
+void cord::prepend(const cord& src) {
+  if (&src == this) {
+    prepend(cord(src));
+    return;
+  }
+  if (src.empty()) return;
+  if (src.size() <= kMaxBytesToCopy && src.chunk_count() > 1) {
+    prepend(std::string(src));
+    return;
+  }
+  for (size_t i = src.pieces_.size(); i-- > src.first_;) {
+    src.pieces_[i].owner->ref();
+    push_front(src.pieces_[i]);
+  }
+}
+
+void cord::remove_prefix(size_t n) {
+  assert(n <= size_);
+  while (n > 0) {
+    piece& p = pieces_[first_];
+    if (p.size > n) {
+      p.offset += n;
+      p.size -= n;
+      size_ -= n;
+      return;
+    }
+    n -= p.size;
+    size_ -= p.size;
+    p.owner->unref();
+    ++first_;
+  }
+  if (first_ == pieces_.size()) clear();
+}
+
+void cord::remove_suffix(size_t n) {
+  assert(n <= size_);
+  while (n > 0) {
+    piece& p = pieces_.back();
+    if (p.size > n) {
+      p.size -= n;
+      size_ -= n;
+      return;
+    }
+    n -= p.size;
+    size_ -= p.size;
+    p.owner->unref();
+    pieces_.pop_back();
+  }
+  if (first_ == pieces_.size()) clear();
+}
+
+void cord::clear() {
+  unref_all();
+  pieces_.clear();
+  first_ = 0;
+  size_ = 0;
+}
+
+cord cord::subcord(size_t pos, size_t n) const {
+  assert(pos <= size_);
+  n = std::min(n, size_ - pos);
+  cord result;
+  for (size_t i = first_; n > 0; ++i) {
+    const piece& p = pieces_[i];
+    if (pos >= p.size) {
+      pos -= p.size;
+      continue;
+    }
+    const size_t take = std::min(p.size - pos, n);
+    p.owner->ref();
+    result.push_back(piece{p.owner, p.offset + pos, take});
+    n -= take;
+    pos = 0;
+  }
+  return result;
+}
+
+char cord::operator[](size_t i) const {
+  assert(i < size_);
+  for (size_t j = first_;; ++j) {
+    const piece& p = pieces_[j];
+    if (i < p.size) return p.owner->data[p.offset + i];
+    i -= p.size;
+  }
+}
+
+abel::string_view cord::flatten() {
+  if (chunk_count() == 0) return abel::string_view();
+  if (chunk_count() > 1) {
+    cord_internal::chunk* flat =
+        cord_internal::chunk::adopt(static_cast<std::string>(*this));
+    const size_t size = size_;
+    clear();
+    push_back(piece{flat, 0, size});
+  }
+  return pieces_[first_].view();
+}
+
+cord::operator std::string() const {
+  std::string result;
+  string_append(&result, *this);
+  return result;
+}
+
+int cord::compare(abel::string_view rhs) const {
+  size_t pos = 0;
+  for (abel::string_view chunk : chunks()) {
+    const size_t n = std::min(chunk.size(), rhs.size() - pos);
+    if (n != 0) {
+      const int c = memcmp(chunk.data(), rhs.data() + pos, n);
+      if (c != 0) return c;
+    }
+    if (n < chunk.size()) return 1;
+    pos += n;
+  }
+  return pos == rhs.size() ? 0 : -1;
+}
+
+int cord::compare(const cord& rhs) const {
+  const chunk_range a_chunks = chunks();
+  const chunk_range b_chunks = rhs.chunks();
+  chunk_iterator a = a_chunks.begin();
+  chunk_iterator b = b_chunks.begin();
+  abel::string_view x, y;
+  for (;;) {
+    if (x.empty()) {
+      if (a == a_chunks.end()) break;
+      x = *a++;
+    }
+    if (y.empty()) {
+      if (b == b_chunks.end()) break;
+      y = *b++;
+    }
+    const size_t n = std::min(x.size(), y.size());
+    const int c = memcmp(x.data(), y.data(), n);
+    if (c != 0) return c;
+    x.remove_prefix(n);
+    y.remove_prefix(n);
+  }
+  // Whichever ran out first is a prefix of the other.
+  return size_ < rhs.size_ ? -1 : size_ > rhs.size_ ? 1 : 0;
+}
+
+std::ostream& operator<<(std::ostream& os, const cord& c) {
+  for (abel::string_view chunk : c.chunks()) {
+    os.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+  }
+  return os;
+}
+
+void string_append(std::string* dest, const cord& src) {
+  dest->reserve(dest->size() + src.size());
+  for (abel::string_view chunk : src.chunks()) {
+    dest->append(chunk.data(), chunk.size());
+  }
+}
+
+}  // namespace abel
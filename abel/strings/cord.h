@@ -0,0 +1,268 @@
+//
+//
+// -----------------------------------------------------------------------------
+// File: cord.h
+// -----------------------------------------------------------------------------
+//
+// This file defines `abel::cord`, a string built from a sequence of shared,
+// reference-counted chunks rather than one contiguous buffer. Appending or
+// prepending another cord, taking a substring or copying a cord shares the
+// chunks instead of copying their bytes, so assembling a large response out
+// of many pieces copies each byte at most once. The bytes are only gathered
+// into one buffer when a caller asks for that with `flatten()`.
+//
+// A cord is a value type with the thread-safety of `std::string`: distinct
+// cords may be used from different threads even when they share chunks.
+//
+// Example:
+//
+//   abel::cord body = RenderPage();
+//   abel::cord response;
+//   abel::string_append(&response, "HTTP/1.1 200 OK\r\nContent-Length: ",
+//                       body.size(), "\r\n\r\n");
+//   response.append(body);  // shares body's chunks
+//
+//   std::vector<iovec> iov;
+//   for (abel::string_view chunk : response.chunks()) {
+//     iov.push_back({const_cast<char*>(chunk.data()), chunk.size()});
+//   }
+//   writev(fd, iov.data(), iov.size());
+
+#ifndef ABEL_STRINGS_CORD_H_
+#define ABEL_STRINGS_CORD_H_
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iosfwd>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <abel/base/profile.h>
+#include <abel/strings/str_cat.h>
+#include <abel/strings/string_view.h>
+
+namespace abel {
+
+namespace cord_internal {
+
+// A block of bytes that pieces of cords point into. Bytes are only ever
+// added at the end, and only while a single cord holds the chunk, so the
+// bytes a piece refers to never change. A chunk either has its bytes
+// allocated right after it or has taken over a string's buffer.
+struct chunk {
+  // A chunk holding a copy of `src` with room for `capacity` bytes.
+  static chunk* make(abel::string_view src, size_t capacity);
+  // A chunk holding the bytes of `src`, without copying them.
+  static chunk* adopt(std::string&& src);
+
+  void ref() { refs.fetch_add(1, std::memory_order_relaxed); }
+  void unref() {
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) destroy();
+  }
+  bool unique() const { return refs.load(std::memory_order_acquire) == 1; }
+
+  std::atomic<int> refs;
+  char* data;
+  size_t size;
+  size_t capacity;
+  std::string adopted;
+
+ private:
+  chunk() : refs(1), data(nullptr), size(0), capacity(0) {}
+  void destroy();
+};
+
+// A range of bytes of a chunk.
+struct piece {
+  abel::string_view view() const {
+    return abel::string_view(owner->data + offset, size);
+  }
+
+  chunk* owner;
+  size_t offset;
+  size_t size;
+};
+
+}  // namespace cord_internal
+
+// cord
+//
+// Copying, appending and prepending cords and taking substrings take time in
+// proportion to the number of chunks involved, never to their bytes. Small
+// appends are copied into spare room at the end of the last chunk when no
+// other cord shares it, so a cord built from many short fragments still has
+// few chunks. Lookups by position (`operator[]`, `subcord()`) walk the
+// chunks.
+class cord {
+ public:
+  class chunk_iterator;
+  class chunk_range;
+
+  cord() : first_(0), size_(0) {}
+  explicit cord(abel::string_view src) : cord() { append(src); }
+  explicit cord(const char* src) : cord() { append(src); }
+  // Takes over the buffer of `src` as a chunk rather than copying it.
+  explicit cord(std::string&& src) : cord() { append(std::move(src)); }
+
+  cord(const cord& other);
+  cord(cord&& other) noexcept;
+  cord& operator=(const cord& other);
+  cord& operator=(cord&& other) noexcept;
+  ~cord();
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Copies `src` to the end, into the last chunk when it has room.
+  void append(abel::string_view src);
+  void append(const char* src) { append(abel::string_view(src)); }
+  // Takes over the buffer of `src` as a new chunk, unless it is short enough
+  // to copy.
+  void append(std::string&& src);
+  // Shares the chunks of `src`, or copies them if they are short.
+  void append(const cord& src);
+
+  void prepend(abel::string_view src);
+  void prepend(const char* src) { prepend(abel::string_view(src)); }
+  void prepend(std::string&& src);
+  void prepend(const cord& src);
+
+  void remove_prefix(size_t n);
+  void remove_suffix(size_t n);
+  void clear();
+
+  // The `n` bytes from `pos`, or as many as there are, sharing this cord's
+  // chunks. `pos` must be at most `size()`.
+  cord subcord(size_t pos, size_t n) const;
+
+  char operator[](size_t i) const;
+
+  // Gathers the bytes into a single chunk, unless they already are in one,
+  // and returns them. The view stays valid until the cord is next modified.
+  abel::string_view flatten();
+
+  // Copies the bytes into a new string, whatever the chunks.
+  explicit operator std::string() const;
+
+  // The chunks in order, as string_views that stay valid until the cord is
+  // next modified. No chunk is empty.
+  chunk_range chunks() const;
+  size_t chunk_count() const { return pieces_.size() - first_; }
+
+  int compare(abel::string_view rhs) const;
+  int compare(const cord& rhs) const;
+
+  // Copies `pieces` to the end. Do not call directly; this is what
+  // `abel::string_append()` on a cord does.
+  void append_pieces(std::initializer_list<abel::string_view> pieces);
+
+ private:
+  typedef cord_internal::piece piece;
+
+  // The last chunk when `n` more bytes can be added after the last piece
+  // without any other piece seeing them, or nullptr.
+  cord_internal::chunk* tail_room(size_t n);
+  size_t next_chunk_capacity(size_t n) const;
+  void push_back(const piece& p);
+  void push_front(const piece& p);
+  void unref_all();
+
+  // The pieces are pieces_[first_, end), with room to prepend before first_.
+  std::vector<piece> pieces_;
+  size_t first_;
+  size_t size_;
+};
+
+class cord::chunk_iterator {
+ public:
+  typedef std::forward_iterator_tag iterator_category;
+  typedef abel::string_view value_type;
+  typedef ptrdiff_t difference_type;
+  typedef const abel::string_view* pointer;
+  typedef abel::string_view reference;
+
+  chunk_iterator() : p_(nullptr) {}
+
+  abel::string_view operator*() const { return p_->view(); }
+  chunk_iterator& operator++() {
+    ++p_;
+    return *this;
+  }
+  chunk_iterator operator++(int) {
+    chunk_iterator old = *this;
+    ++p_;
+    return old;
+  }
+  bool operator==(const chunk_iterator& other) const { return p_ == other.p_; }
+  bool operator!=(const chunk_iterator& other) const { return p_ != other.p_; }
+
+ private:
+  friend class cord;
+  explicit chunk_iterator(const cord_internal::piece* p) : p_(p) {}
+
+  const cord_internal::piece* p_;
+};
+
+class cord::chunk_range {
+ public:
+  chunk_iterator begin() const { return begin_; }
+  chunk_iterator end() const { return end_; }
+
+ private:
+  friend class cord;
+  chunk_range(chunk_iterator begin, chunk_iterator end)
+      : begin_(begin), end_(end) {}
+
+  chunk_iterator begin_;
+  chunk_iterator end_;
+};
+
+inline cord::chunk_range cord::chunks() const {
+  const piece* p = pieces_.data();
+  return chunk_range(chunk_iterator(p + first_), chunk_iterator(p + pieces_.size()));
+}
+
+inline bool operator==(const cord& lhs, const cord& rhs) {
+  return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+inline bool operator!=(const cord& lhs, const cord& rhs) { return !(lhs == rhs); }
+inline bool operator<(const cord& lhs, const cord& rhs) {
+  return lhs.compare(rhs) < 0;
+}
+inline bool operator==(const cord& lhs, abel::string_view rhs) {
+  return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+inline bool operator==(abel::string_view lhs, const cord& rhs) {
+  return rhs == lhs;
+}
+inline bool operator!=(const cord& lhs, abel::string_view rhs) {
+  return !(lhs == rhs);
+}
+inline bool operator!=(abel::string_view lhs, const cord& rhs) {
+  return !(rhs == lhs);
+}
+
+std::ostream& operator<<(std::ostream& os, const cord& c);
+
+// string_append()
+//
+// Appends strings and numbers to a cord the way `string_append()` does to a
+// string, copying them into the cord's last chunk while it has room. Cords
+// themselves go through `cord::append()`, which shares them.
+ABEL_FORCE_INLINE void string_append(cord*) {}
+
+template <typename... AV>
+ABEL_FORCE_INLINE void string_append(cord* dest, const alpha_num& a,
+                                     const AV&... args) {
+  dest->append_pieces(
+      {a.Piece(), static_cast<const alpha_num&>(args).Piece()...});
+}
+
+// Appends the bytes of `src` to `dest` without flattening `src` first.
+void string_append(std::string* dest, const cord& src);
+
+}  // namespace abel
+
+#endif  // ABEL_STRINGS_CORD_H_
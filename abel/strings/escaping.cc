@@ -17,6 +17,7 @@
 #include <abel/strings/internal/utf8.h>
 #include <abel/strings/str_cat.h>
 #include <abel/strings/str_join.h>
+#include <abel/strings/string_sink.h>
 #include <abel/strings/string_view.h>
 
 namespace abel {
@@ -292,20 +293,20 @@ bool CUnescapeInternal(abel::string_view source, bool leave_nulls_escaped,
 //
 //    Escaped chars: \n, \r, \t, ", ', \, and !abel::ascii_isprint().
 // ----------------------------------------------------------------------
-std::string CEscapeInternal(abel::string_view src, bool use_hex,
-                            bool utf8_safe) {
-  std::string dest;
+void CEscapeToInternal(string_sink sink, abel::string_view src, bool use_hex,
+                       bool utf8_safe) {
+  strings_internal::sink_writer dest(sink);
   bool last_hex_escape = false;  // true if last output char was \xNN.
 
   for (unsigned char c : src) {
     bool is_hex_escape = false;
     switch (c) {
-      case '\n': dest.append("\\" "n"); break;
-      case '\r': dest.append("\\" "r"); break;
-      case '\t': dest.append("\\" "t"); break;
-      case '\"': dest.append("\\" "\""); break;
-      case '\'': dest.append("\\" "'"); break;
-      case '\\': dest.append("\\" "\\"); break;
+      case '\n': dest.write("\\" "n"); break;
+      case '\r': dest.write("\\" "r"); break;
+      case '\t': dest.write("\\" "t"); break;
+      case '\"': dest.write("\\" "\""); break;
+      case '\'': dest.write("\\" "'"); break;
+      case '\\': dest.write("\\" "\\"); break;
       default:
         // Note that if we emit \xNN and the src character after that is a hex
         // digit then that digit must be escaped too to prevent it being
@@ -314,24 +315,29 @@ std::string CEscapeInternal(abel::string_view src, bool use_hex,
             (!abel::ascii::is_print(c) ||
              (last_hex_escape && abel::ascii::is_hex_digit(c)))) {
           if (use_hex) {
-            dest.append("\\" "x");
-            dest.push_back(numbers_internal::kHexChar[c / 16]);
-            dest.push_back(numbers_internal::kHexChar[c % 16]);
+            dest.write("\\" "x");
+            dest.put(numbers_internal::kHexChar[c / 16]);
+            dest.put(numbers_internal::kHexChar[c % 16]);
             is_hex_escape = true;
           } else {
-            dest.append("\\");
-            dest.push_back(numbers_internal::kHexChar[c / 64]);
-            dest.push_back(numbers_internal::kHexChar[(c % 64) / 8]);
-            dest.push_back(numbers_internal::kHexChar[c % 8]);
+            dest.write("\\");
+            dest.put(numbers_internal::kHexChar[c / 64]);
+            dest.put(numbers_internal::kHexChar[(c % 64) / 8]);
+            dest.put(numbers_internal::kHexChar[c % 8]);
           }
         } else {
-          dest.push_back(c);
+          dest.put(c);
           break;
         }
     }
     last_hex_escape = is_hex_escape;
   }
+}
 
+std::string CEscapeInternal(abel::string_view src, bool use_hex,
+                            bool utf8_safe) {
+  std::string dest;
+  CEscapeToInternal(dest, src, use_hex, utf8_safe);
   return dest;
 }
 
@@ -1010,18 +1016,38 @@ std::string escape(abel::string_view src) {
   return dest;
 }
 
+void escape_to(string_sink sink, abel::string_view src) {
+  if (CEscapedLength(src) == src.size()) {
+    sink.append(src);
+    return;
+  }
+  CEscapeToInternal(sink, src, false, false);
+}
+
 std::string hex_escape(abel::string_view src) {
   return CEscapeInternal(src, true, false);
 }
 
+void hex_escape_to(string_sink sink, abel::string_view src) {
+  CEscapeToInternal(sink, src, true, false);
+}
+
 std::string utf8_safe_escape(abel::string_view src) {
   return CEscapeInternal(src, false, true);
 }
 
+void utf8_safe_escape_to(string_sink sink, abel::string_view src) {
+  CEscapeToInternal(sink, src, false, true);
+}
+
 std::string utf8_safe_hex_escape(abel::string_view src) {
   return CEscapeInternal(src, true, true);
 }
 
+void utf8_safe_hex_escape_to(string_sink sink, abel::string_view src) {
+  CEscapeToInternal(sink, src, true, true);
+}
+
 // ----------------------------------------------------------------------
 // base64_unescape() - base64 decoder
 // base64_escape() - base64 encoder
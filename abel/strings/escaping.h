@@ -17,6 +17,7 @@
 #include <abel/base/profile.h>
 #include <abel/strings/ascii.h>
 #include <abel/strings/str_join.h>
+#include <abel/strings/string_sink.h>
 #include <abel/strings/string_view.h>
 
 namespace abel {
@@ -104,6 +105,27 @@ std::string utf8_safe_escape(abel::string_view src);
 // conversion.
 std::string utf8_safe_hex_escape(abel::string_view src);
 
+// escape_to()
+// hex_escape_to()
+// utf8_safe_escape_to()
+// utf8_safe_hex_escape_to()
+//
+// Append the same escaped text as the functions above to `sink`, which may be
+// a `std::string`, a `fmt::memory_buffer`, an `abel::char_array_sink` or any
+// other target `abel::string_sink` accepts, without building a temporary
+// string. `escape_to()` appends text with nothing to escape in one piece.
+//
+// Example:
+//
+//   fmt::memory_buffer line;
+//   abel::string_cat_to(line, "bad key \"");
+//   abel::escape_to(line, key);
+//   abel::string_cat_to(line, "\"");
+void escape_to(string_sink sink, abel::string_view src);
+void hex_escape_to(string_sink sink, abel::string_view src);
+void utf8_safe_escape_to(string_sink sink, abel::string_view src);
+void utf8_safe_hex_escape_to(string_sink sink, abel::string_view src);
+
 // base64_unescape()
 //
 // Converts a `src` string encoded in Base64 to its binary equivalent, writing
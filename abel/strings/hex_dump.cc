@@ -2,11 +2,33 @@
 // Created by liyinbin on 2019/12/8.
 //
 #include <abel/strings/hex_dump.h>
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 
 namespace abel {
 
+namespace {
+
+void hex_dump_to_sink(string_sink sink, const void* const data, size_t size,
+                      const char* xdigits) {
+    const unsigned char* const cdata =
+        static_cast<const unsigned char*>(data);
+
+    strings_internal::sink_writer writer(sink);
+    // Whole runs of pairs at a time, each within the writer's buffer.
+    static const size_t run = 128;
+    for (size_t i = 0; i < size; i += run) {
+        const size_t n = std::min(run, size - i);
+        char* oi = writer.extend(n * 2);
+        for (const unsigned char* si = cdata + i; si != cdata + i + n; ++si) {
+            *oi++ = xdigits[(*si & 0xF0) >> 4];
+            *oi++ = xdigits[(*si & 0x0F)];
+        }
+    }
+}
+
+} //namespace
 
 std::string hex_dump(const void* const data, size_t size) {
     const unsigned char* const cdata =
@@ -29,6 +51,10 @@ std::string hex_dump(const void* const data, size_t size) {
     return out;
 }
 
+void hex_dump_to(string_sink sink, const void* const data, size_t size) {
+    hex_dump_to_sink(sink, data, size, "0123456789ABCDEF");
+}
+
 std::string hex_dump(const std::string& str) {
     return hex_dump(str.data(), str.size());
 }
@@ -103,6 +129,10 @@ std::string hex_dump_lc(const void* const data, size_t size) {
     return out;
 }
 
+void hex_dump_lc_to(string_sink sink, const void* const data, size_t size) {
+    hex_dump_to_sink(sink, data, size, "0123456789abcdef");
+}
+
 std::string hex_dump_lc(const std::string& str) {
     return hex_dump_lc(str.data(), str.size());
 }
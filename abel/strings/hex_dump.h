@@ -8,7 +8,7 @@
 #include <cstdint>
 #include <string>
 #include <vector>
-
+#include <abel/strings/string_sink.h>
 
 namespace abel {
 
@@ -58,6 +58,17 @@ std::string hex_dump(const std::vector<char>& data);
  */
 std::string hex_dump(const std::vector<uint8_t>& data);
 
+/*!
+ * Append a (binary) string as a sequence of uppercase hexadecimal pairs to a
+ * sink, such as a std::string, fmt::memory_buffer or char_array_sink, without
+ * building a temporary string.
+ *
+ * \param sink  where to append the hexadecimal pairs
+ * \param data  binary data to output in hex
+ * \param size  length of binary data
+ */
+void hex_dump_to(string_sink sink, const void* const data, size_t size);
+
 /*!
  * Dump a (binary) string into a C source code snippet. The snippet defines an
  * array of const uint8_t* holding the data of the string.
@@ -116,6 +127,17 @@ std::string hex_dump_lc(const std::vector<char>& data);
  */
 std::string hex_dump_lc(const std::vector<uint8_t>& data);
 
+/*!
+ * Append a (binary) string as a sequence of lowercase hexadecimal pairs to a
+ * sink, such as a std::string, fmt::memory_buffer or char_array_sink, without
+ * building a temporary string.
+ *
+ * \param sink  where to append the hexadecimal pairs
+ * \param data  binary data to output in hex
+ * \param size  length of binary data
+ */
+void hex_dump_lc_to(string_sink sink, const void* const data, size_t size);
+
 /******************************************************************************/
 // Parser for Hex Digit Sequence
 
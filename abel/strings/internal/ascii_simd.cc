@@ -0,0 +1,320 @@
+//
+
+#include <abel/strings/internal/ascii_simd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <abel/base/math/clz.h>
+#include <abel/base/math/ctz.h>
+#include <abel/hash/internal/city.h>
+#include <abel/strings/ascii.h>
+
+#if ABEL_AVX2 || ABEL_SSE2
+#include <immintrin.h>
+#define ABEL_ASCII_USE_SSE2
+#if ABEL_AVX2
+#define ABEL_ASCII_USE_AVX2
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ABEL_ASCII_USE_NEON
+#endif
+
+namespace abel {
+
+namespace strings_internal {
+
+namespace {
+
+// Each set of block operations below hands out comparison results as lane
+// masks, kLaneBits bits per lane, so that the generic loops can find the
+// first or last match with a bit scan.
+
+#if defined(ABEL_ASCII_USE_SSE2)
+
+struct sse2_ops {
+    typedef __m128i type;
+    static constexpr size_t kWidth = 16;
+    static constexpr unsigned kLaneBits = 1;
+    static constexpr uint64_t kAll = 0xFFFF;
+
+    static type load (const char *p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    }
+    static void store (char *p, type v) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+    }
+    // 0xFF in the lanes holding a byte in [lo, lo + count). Biasing by
+    // 0x80 - lo turns the unsigned range check into a signed compare.
+    static type in_range (type x, char lo, char count) {
+        const type biased = _mm_add_epi8(x, _mm_set1_epi8(static_cast<char>(0x80 - lo)));
+        return _mm_cmplt_epi8(biased, _mm_set1_epi8(static_cast<char>(0x80 + count)));
+    }
+    static type flip_case (type x, char lo) {
+        return _mm_xor_si128(x, _mm_and_si128(in_range(x, lo, 26), _mm_set1_epi8(0x20)));
+    }
+    static type is_space (type x) {
+        return _mm_or_si128(in_range(x, '\t', 5), _mm_cmpeq_epi8(x, _mm_set1_epi8(' ')));
+    }
+    static type equal (type a, type b) { return _mm_cmpeq_epi8(a, b); }
+    static type bit_or (type a, type b) { return _mm_or_si128(a, b); }
+    static uint64_t bits (type mask) {
+        return static_cast<uint32_t>(_mm_movemask_epi8(mask));
+    }
+    static uint64_t high_bits (type x) { return bits(x); }
+};
+
+#endif  // ABEL_ASCII_USE_SSE2
+
+#if defined(ABEL_ASCII_USE_AVX2)
+
+struct avx2_ops {
+    typedef __m256i type;
+    static constexpr size_t kWidth = 32;
+    static constexpr unsigned kLaneBits = 1;
+    static constexpr uint64_t kAll = 0xFFFFFFFF;
+
+    static type load (const char *p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    }
+    static void store (char *p, type v) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+    }
+    static type in_range (type x, char lo, char count) {
+        const type biased = _mm256_add_epi8(x, _mm256_set1_epi8(static_cast<char>(0x80 - lo)));
+        return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(0x80 + count)), biased);
+    }
+    static type flip_case (type x, char lo) {
+        return _mm256_xor_si256(x, _mm256_and_si256(in_range(x, lo, 26), _mm256_set1_epi8(0x20)));
+    }
+    static type is_space (type x) {
+        return _mm256_or_si256(in_range(x, '\t', 5), _mm256_cmpeq_epi8(x, _mm256_set1_epi8(' ')));
+    }
+    static type equal (type a, type b) { return _mm256_cmpeq_epi8(a, b); }
+    static type bit_or (type a, type b) { return _mm256_or_si256(a, b); }
+    static uint64_t bits (type mask) {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(mask));
+    }
+    static uint64_t high_bits (type x) { return bits(x); }
+};
+
+#endif  // ABEL_ASCII_USE_AVX2
+
+#if defined(ABEL_ASCII_USE_NEON)
+
+struct neon_ops {
+    typedef uint8x16_t type;
+    static constexpr size_t kWidth = 16;
+    // NEON has no movemask; narrowing by four bits leaves a nibble per lane.
+    static constexpr unsigned kLaneBits = 4;
+    static constexpr uint64_t kAll = ~uint64_t{0};
+
+    static type load (const char *p) { return vld1q_u8(reinterpret_cast<const uint8_t *>(p)); }
+    static void store (char *p, type v) { vst1q_u8(reinterpret_cast<uint8_t *>(p), v); }
+    static type in_range (type x, char lo, char count) {
+        return vcltq_u8(vsubq_u8(x, vdupq_n_u8(static_cast<uint8_t>(lo))),
+                        vdupq_n_u8(static_cast<uint8_t>(count)));
+    }
+    static type flip_case (type x, char lo) {
+        return veorq_u8(x, vandq_u8(in_range(x, lo, 26), vdupq_n_u8(0x20)));
+    }
+    static type is_space (type x) {
+        return vorrq_u8(in_range(x, '\t', 5), vceqq_u8(x, vdupq_n_u8(' ')));
+    }
+    static type equal (type a, type b) { return vceqq_u8(a, b); }
+    static type bit_or (type a, type b) { return vorrq_u8(a, b); }
+    static uint64_t bits (type mask) {
+        const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(mask), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+    }
+    static uint64_t high_bits (type x) { return bits(vtstq_u8(x, vdupq_n_u8(0x80))); }
+};
+
+#endif  // ABEL_ASCII_USE_NEON
+
+// The widest operations are tried first; the narrow ones pick up inputs too
+// short for them.
+#if defined(ABEL_ASCII_USE_AVX2)
+#define ABEL_ASCII_WIDE_OPS avx2_ops
+#define ABEL_ASCII_NARROW_OPS sse2_ops
+#define ABEL_ASCII_IMPLEMENTATION "avx2"
+#elif defined(ABEL_ASCII_USE_SSE2)
+#define ABEL_ASCII_NARROW_OPS sse2_ops
+#define ABEL_ASCII_IMPLEMENTATION "sse2"
+#elif defined(ABEL_ASCII_USE_NEON)
+#define ABEL_ASCII_NARROW_OPS neon_ops
+#define ABEL_ASCII_IMPLEMENTATION "neon"
+#else
+#define ABEL_ASCII_IMPLEMENTATION "scalar"
+#endif
+
+// The loops below need at least one full block. The last block is loaded
+// from `n - kWidth`, overlapping the one before, rather than being finished
+// a byte at a time.
+
+template <typename Ops>
+void flip_case_blocks (char *p, size_t n, char lo) {
+    size_t i = 0;
+    for (; i + Ops::kWidth <= n; i += Ops::kWidth) {
+        Ops::store(p + i, Ops::flip_case(Ops::load(p + i), lo));
+    }
+    // Converting the overlap twice is harmless: the case is already right.
+    if (i < n) {
+        i = n - Ops::kWidth;
+        Ops::store(p + i, Ops::flip_case(Ops::load(p + i), lo));
+    }
+}
+
+template <typename Ops>
+bool all_ascii_blocks (const char *p, size_t n) {
+    typename Ops::type acc = Ops::load(p + n - Ops::kWidth);
+    for (size_t i = 0; i + Ops::kWidth <= n; i += Ops::kWidth) {
+        acc = Ops::bit_or(acc, Ops::load(p + i));
+    }
+    return Ops::high_bits(acc) == 0;
+}
+
+template <typename Ops>
+size_t skip_space_blocks (const char *p, size_t n) {
+    size_t i = 0;
+    for (;;) {
+        const uint64_t rest = ~Ops::bits(Ops::is_space(Ops::load(p + i))) & Ops::kAll;
+        if (rest != 0) {
+            return i + abel::count_trailing_zeros(rest) / Ops::kLaneBits;
+        }
+        if (i + Ops::kWidth == n) {
+            return n;
+        }
+        i = std::min(i + Ops::kWidth, n - Ops::kWidth);
+    }
+}
+
+template <typename Ops>
+size_t skip_space_back_blocks (const char *p, size_t n) {
+    size_t end = n;
+    for (;;) {
+        const size_t i = end - Ops::kWidth;
+        const uint64_t rest = ~Ops::bits(Ops::is_space(Ops::load(p + i))) & Ops::kAll;
+        if (rest != 0) {
+            return i + (63 - abel::count_leading_zeros(rest)) / Ops::kLaneBits + 1;
+        }
+        if (i == 0) {
+            return 0;
+        }
+        end = i > Ops::kWidth ? i : Ops::kWidth;
+    }
+}
+
+template <typename Ops>
+size_t case_mismatch_blocks (const char *a, const char *b, size_t n) {
+    size_t i = 0;
+    for (;;) {
+        const typename Ops::type la = Ops::flip_case(Ops::load(a + i), 'A');
+        const typename Ops::type lb = Ops::flip_case(Ops::load(b + i), 'A');
+        const uint64_t diff = ~Ops::bits(Ops::equal(la, lb)) & Ops::kAll;
+        if (diff != 0) {
+            return i + abel::count_trailing_zeros(diff) / Ops::kLaneBits;
+        }
+        if (i + Ops::kWidth == n) {
+            return n;
+        }
+        i = std::min(i + Ops::kWidth, n - Ops::kWidth);
+    }
+}
+
+// Returns `fn<Ops> args` with the widest operations whose block fits `n`
+// bytes, falling through for shorter input.
+#if defined(ABEL_ASCII_WIDE_OPS)
+#define ABEL_ASCII_DISPATCH_WIDE(n, fn, args)      \
+    if ((n) >= ABEL_ASCII_WIDE_OPS::kWidth) {      \
+        return fn<ABEL_ASCII_WIDE_OPS> args;       \
+    }
+#else
+#define ABEL_ASCII_DISPATCH_WIDE(n, fn, args)
+#endif
+#if defined(ABEL_ASCII_NARROW_OPS)
+#define ABEL_ASCII_DISPATCH(n, fn, args)           \
+    ABEL_ASCII_DISPATCH_WIDE(n, fn, args)          \
+    if ((n) >= ABEL_ASCII_NARROW_OPS::kWidth) {    \
+        return fn<ABEL_ASCII_NARROW_OPS> args;     \
+    }
+#else
+#define ABEL_ASCII_DISPATCH(n, fn, args)
+#endif
+
+// Input to ascii_case_hash() is lowercased a chunk at a time on the stack.
+constexpr size_t kHashChunk = 256;
+
+}  // namespace
+
+void ascii_to_lower (char *p, size_t n) {
+    ABEL_ASCII_DISPATCH(n, flip_case_blocks, (p, n, 'A'))
+    for (size_t i = 0; i < n; ++i) {
+        p[i] = ascii::to_lower(p[i]);
+    }
+}
+
+void ascii_to_upper (char *p, size_t n) {
+    ABEL_ASCII_DISPATCH(n, flip_case_blocks, (p, n, 'a'))
+    for (size_t i = 0; i < n; ++i) {
+        p[i] = ascii::to_upper(p[i]);
+    }
+}
+
+bool ascii_all (const char *p, size_t n) {
+    ABEL_ASCII_DISPATCH(n, all_ascii_blocks, (p, n))
+    for (size_t i = 0; i < n; ++i) {
+        if (!ascii::is_ascii(p[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t ascii_skip_space (const char *p, size_t n) {
+    ABEL_ASCII_DISPATCH(n, skip_space_blocks, (p, n))
+    size_t i = 0;
+    while (i < n && ascii::is_space(p[i])) {
+        ++i;
+    }
+    return i;
+}
+
+size_t ascii_skip_space_back (const char *p, size_t n) {
+    ABEL_ASCII_DISPATCH(n, skip_space_back_blocks, (p, n))
+    while (n > 0 && ascii::is_space(p[n - 1])) {
+        --n;
+    }
+    return n;
+}
+
+size_t ascii_case_mismatch (const char *a, const char *b, size_t n) {
+    ABEL_ASCII_DISPATCH(n, case_mismatch_blocks, (a, b, n))
+    size_t i = 0;
+    while (i < n && ascii::to_lower(a[i]) == ascii::to_lower(b[i])) {
+        ++i;
+    }
+    return i;
+}
+
+uint64_t ascii_case_hash (const char *p, size_t n, uint64_t seed) {
+    char chunk[kHashChunk];
+    do {
+        const size_t len = std::min(n, kHashChunk);
+        memcpy(chunk, p, len);
+        ascii_to_lower(chunk, len);
+        seed = hash_internal::CityHash64WithSeed(chunk, len, seed);
+        p += len;
+        n -= len;
+    } while (n != 0);
+    return seed;
+}
+
+const char *ascii_simd_implementation () {
+    return ABEL_ASCII_IMPLEMENTATION;
+}
+
+}  // namespace strings_internal
+
+}  // namespace abel
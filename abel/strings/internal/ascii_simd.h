@@ -0,0 +1,48 @@
+//
+
+#ifndef ABEL_STRINGS_INTERNAL_ASCII_SIMD_H_
+#define ABEL_STRINGS_INTERNAL_ASCII_SIMD_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <abel/base/profile.h>
+
+namespace abel {
+
+namespace strings_internal {
+
+// Bulk ASCII kernels behind case_conv.h, trim.h and compare.h. They work 32
+// bytes at a time with AVX2, 16 with SSE2 or NEON, whichever the build
+// targets, and go through the ascii tables for inputs shorter than that.
+// Bytes past 0x7F are left alone, as by ascii::to_lower() and friends.
+
+// Lower- or uppercases the `n` bytes at `p` in place.
+void ascii_to_lower (char *p, size_t n);
+void ascii_to_upper (char *p, size_t n);
+
+// Whether none of the `n` bytes at `p` has its high bit set.
+bool ascii_all (const char *p, size_t n);
+
+// The offset of the first byte at `p` that is not ascii::is_space(), or `n`.
+size_t ascii_skip_space (const char *p, size_t n);
+
+// The length left after dropping the trailing ascii::is_space() bytes.
+size_t ascii_skip_space_back (const char *p, size_t n);
+
+// The offset of the first byte where `a` and `b` differ other than by
+// letter case, or `n`.
+size_t ascii_case_mismatch (const char *a, const char *b, size_t n);
+
+// A hash of the `n` bytes at `p` that ignores letter case, so that strings
+// equal under compare_case() hash alike. It does not depend on the kernels.
+uint64_t ascii_case_hash (const char *p, size_t n, uint64_t seed);
+
+// The name of the kernels compiled in: "avx2", "sse2", "neon" or "scalar".
+const char *ascii_simd_implementation ();
+
+}  // namespace strings_internal
+
+}  // namespace abel
+
+#endif  // ABEL_STRINGS_INTERNAL_ASCII_SIMD_H_
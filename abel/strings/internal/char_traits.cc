@@ -3,6 +3,7 @@
 //
 
 #include <abel/strings/internal/char_traits.h>
+#include <abel/strings/internal/ascii_simd.h>
 
 
 #include <cstdlib>
@@ -15,13 +16,10 @@ int char_case_cmp(const char* s1, const char* s2, size_t len) {
     const unsigned char* us1 = reinterpret_cast<const unsigned char*>(s1);
     const unsigned char* us2 = reinterpret_cast<const unsigned char*>(s2);
 
-    for (size_t i = 0; i < len; i++) {
-        const int diff =
-            int{static_cast<unsigned char>(abel::ascii::to_lower(us1[i]))} -
-                int{static_cast<unsigned char>(abel::ascii::to_lower(us2[i]))};
-        if (diff != 0) return diff;
-    }
-    return 0;
+    const size_t i = ascii_case_mismatch(s1, s2, len);
+    if (i == len) return 0;
+    return int{static_cast<unsigned char>(abel::ascii::to_lower(us1[i]))} -
+        int{static_cast<unsigned char>(abel::ascii::to_lower(us2[i]))};
 }
 
 char* char_dup(const char* s, size_t slen) {
@@ -75,27 +73,9 @@ char* char_pbrk(const char* s, size_t slen, const char* accept) {
     return nullptr;
 }
 
-// This is significantly faster for case-sensitive matches with very
-// few possible matches.  See unit test for benchmarks.
 const char* char_match(const char* phaystack, size_t haylen, const char* pneedle,
                      size_t neelen) {
-    if (0 == neelen) {
-        return phaystack;  // even if haylen is 0
-    }
-    if (haylen < neelen) return nullptr;
-
-    const char* match;
-    const char* hayend = phaystack + haylen - neelen + 1;
-    // A static cast is used here to work around the fact that memchr returns
-    // a void* on Posix-compliant systems and const void* on Windows.
-    while ((match = static_cast<const char*>(
-        memchr(phaystack, pneedle[0], hayend - phaystack)))) {
-        if (memcmp(match, pneedle, neelen) == 0)
-            return match;
-        else
-            phaystack = match + 1;
-    }
-    return nullptr;
+    return string_search(phaystack, haylen, pneedle, neelen);
 }
 
 }  // namespace strings_internal
@@ -7,6 +7,7 @@
 
 #include <abel/base/profile.h>  // disable some warnings on Windows
 #include <abel/strings/ascii.h>  // for abel::ascii_tolower
+#include <abel/strings/internal/string_search.h>
 #include <cstddef>
 #include <cstring>
 
@@ -26,7 +27,9 @@ size_t char_spn(const char* s, size_t slen, const char* accept);
 size_t char_cspn(const char* s, size_t slen, const char* reject);
 char* char_pbrk(const char* s, size_t slen, const char* accept);
 
-// This is for internal use only.  Don't call this directly
+// This is for internal use only.  Don't call this directly. The
+// case-sensitive searches below go through string_search() instead, which
+// this is kept as the byte-at-a-time reference for.
 template <bool case_sensitive>
 const char* int_char_match(const char* haystack, size_t haylen,
                          const char* needle, size_t neelen) {
@@ -60,7 +63,7 @@ const char* int_char_match(const char* haystack, size_t haylen,
 // These are the guys you can call directly
 ABEL_FORCE_INLINE const char* char_str(const char* phaystack, size_t haylen,
                                      const char* pneedle) {
-    return int_char_match<true>(phaystack, haylen, pneedle, strlen(pneedle));
+    return string_search(phaystack, haylen, pneedle, strlen(pneedle));
 }
 
 ABEL_FORCE_INLINE const char* char_case_str(const char* phaystack, size_t haylen,
@@ -70,7 +73,7 @@ ABEL_FORCE_INLINE const char* char_case_str(const char* phaystack, size_t haylen
 
 ABEL_FORCE_INLINE const char* char_mem(const char* phaystack, size_t haylen,
                                      const char* pneedle, size_t needlelen) {
-    return int_char_match<true>(phaystack, haylen, pneedle, needlelen);
+    return string_search(phaystack, haylen, pneedle, needlelen);
 }
 
 ABEL_FORCE_INLINE const char* char_case_mem(const char* phaystack, size_t haylen,
@@ -78,8 +81,9 @@ ABEL_FORCE_INLINE const char* char_case_mem(const char* phaystack, size_t haylen
     return int_char_match<false>(phaystack, haylen, pneedle, needlelen);
 }
 
-// This is significantly faster for case-sensitive matches with very
-// few possible matches.  See unit test for benchmarks.
+// The same as char_mem(); string_view::find() calls this one. See
+// internal/string_search.h for how it works and memutil_benchmark for
+// numbers.
 const char* char_match(const char* phaystack, size_t haylen, const char* pneedle,
                      size_t neelen);
 
@@ -0,0 +1,50 @@
+//
+
+#ifndef ABEL_STRINGS_INTERNAL_CHARCONV_POW10_H_
+#define ABEL_STRINGS_INTERNAL_CHARCONV_POW10_H_
+
+#include <cstdint>
+
+#include <abel/base/profile.h>
+
+namespace abel {
+
+namespace strings_internal {
+
+// Powers of ten to 128 bits, for from_chars()'s Eisel-Lemire fast path and
+// the shortest float formatting in numbers.cc.
+//
+// kPow10Table[e - kPow10TableMin] holds {high, low} such that
+//
+//   10**e ~= (high * 2**64 + low) * 2**(FloorLog2Pow10(e) - 127)
+//
+// truncated, so that the 128-bit value is at most 10**e and its top bit is
+// set. The range covers every power a double needs both ways: down to
+// 1e-342, which times 19 digits of mantissa is below the smallest subnormal,
+// and up to 1e324 for scaling the smallest subnormal up to its digits.
+constexpr int kPow10TableMin = -342;
+constexpr int kPow10TableMax = 324;
+
+extern const uint64_t kPow10Table[kPow10TableMax - kPow10TableMin + 1][2];
+
+// floor(log2(10**e)), exact for the table's range. Relies on `>>` of a
+// negative int shifting in ones, as it does on every supported compiler.
+ABEL_FORCE_INLINE constexpr int FloorLog2Pow10(int e) {
+  return (e * 1741647) >> 19;
+}
+
+// floor(log10(2**e)), exact for |e| <= 1650.
+ABEL_FORCE_INLINE constexpr int FloorLog10Pow2(int e) {
+  return (e * 1262611) >> 22;
+}
+
+// floor(log10(3/4 * 2**e)), exact for |e| <= 1650.
+ABEL_FORCE_INLINE constexpr int FloorLog10ThreeQuartersPow2(int e) {
+  return (e * 1262611 - 524031) >> 22;
+}
+
+}  // namespace strings_internal
+
+}  // namespace abel
+
+#endif  // ABEL_STRINGS_INTERNAL_CHARCONV_POW10_H_
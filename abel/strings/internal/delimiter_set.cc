@@ -0,0 +1,160 @@
+//
+
+#include <abel/strings/internal/delimiter_set.h>
+
+#include <cstring>
+
+#include <abel/base/math/ctz.h>
+
+#if ABEL_AVX2
+#include <immintrin.h>
+#define ABEL_DELIMITER_BLOCK 32
+#elif ABEL_SSSE3
+#include <tmmintrin.h>
+#define ABEL_DELIMITER_BLOCK 16
+#endif
+
+namespace abel {
+
+namespace strings_internal {
+
+namespace {
+
+// Gives each distinct `outer` nibble of `chars` a bucket bit of its own and
+// ORs it into the `inner` entry of every byte with that nibble, so that an
+// inner nibble only matches together with the outer nibbles it was seen
+// with. Returns the number of buckets wanted, which only fit up to 8.
+int fill_buckets (abel::string_view chars, int outer_shift, uint8_t *outer,
+                  uint8_t *inner) {
+    const int inner_shift = 4 - outer_shift;
+    int buckets = 0;
+    for (char c : chars) {
+        const uint8_t u = static_cast<uint8_t>(c);
+        uint8_t &bucket = outer[(u >> outer_shift) & 15];
+        if (bucket == 0) {
+            bucket = buckets < 8 ? static_cast<uint8_t>(1 << buckets) : 0;
+            ++buckets;
+        }
+        inner[(u >> inner_shift) & 15] |= bucket;
+    }
+    return buckets;
+}
+
+}  // namespace
+
+delimiter_set::delimiter_set (abel::string_view chars)
+    : _low(), _high(), _bitmap(), _single(chars.empty() ? '\0' : chars[0]),
+      _kind(chars.size() == 1 ? kind::kSingle : kind::kNibbles) {
+    if (fill_buckets(chars, 4, _high, _low) <= 8) {
+        return;
+    }
+    // Too many high nibbles; try the same with the nibbles swapped.
+    memset(_high, 0, sizeof(_high));
+    memset(_low, 0, sizeof(_low));
+    if (fill_buckets(chars, 0, _low, _high) <= 8) {
+        return;
+    }
+    _kind = kind::kTable;
+    for (char c : chars) {
+        const uint8_t u = static_cast<uint8_t>(c);
+        _bitmap[u >> 6] |= uint64_t{1} << (u & 63);
+    }
+}
+
+#if defined(ABEL_DELIMITER_BLOCK)
+
+// A bit per byte of the block at `p`, set for the delimiters.
+uint64_t delimiter_set::block_matches (const char *p) const {
+#if ABEL_DELIMITER_BLOCK == 32
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    if (_kind == kind::kSingle) {
+        return static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(_single))));
+    }
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i low = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(_low)));
+    const __m256i high = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(_high)));
+    const __m256i buckets = _mm256_and_si256(
+        _mm256_shuffle_epi8(low, _mm256_and_si256(x, nibble)),
+        _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble)));
+    const uint32_t none = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(buckets, _mm256_setzero_si256())));
+    return ~none;
+#else
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    if (_kind == kind::kSingle) {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8(_single))));
+    }
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_low));
+    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_high));
+    const __m128i buckets = _mm_and_si128(
+        _mm_shuffle_epi8(low, _mm_and_si128(x, nibble)),
+        _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(x, 4), nibble)));
+    const uint32_t none = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(buckets, _mm_setzero_si128())));
+    return ~none & 0xFFFF;
+#endif
+}
+
+#endif  // ABEL_DELIMITER_BLOCK
+
+size_t delimiter_set::find (abel::string_view text, size_t pos) const {
+    const char *p = text.data();
+    const size_t n = text.size();
+#if defined(ABEL_DELIMITER_BLOCK)
+    if (_kind != kind::kTable) {
+        for (; pos + ABEL_DELIMITER_BLOCK <= n; pos += ABEL_DELIMITER_BLOCK) {
+            const uint64_t matches = block_matches(p + pos);
+            if (matches != 0) {
+                return pos + abel::count_trailing_zeros(matches);
+            }
+        }
+    }
+#endif
+    for (; pos < n; ++pos) {
+        if (contains(p[pos])) {
+            return pos;
+        }
+    }
+    return abel::string_view::npos;
+}
+
+size_t delimiter_set::split (abel::string_view text, abel::string_view *out, size_t n) const {
+    const char *p = text.data();
+    const size_t size = text.size();
+    size_t used = 0;
+    size_t start = 0;
+    size_t pos = 0;
+    // Every delimiter of a block is taken from one bitmask.
+#if defined(ABEL_DELIMITER_BLOCK)
+    if (_kind != kind::kTable) {
+        for (; pos + ABEL_DELIMITER_BLOCK <= size; pos += ABEL_DELIMITER_BLOCK) {
+            for (uint64_t matches = block_matches(p + pos); matches != 0;
+                 matches &= matches - 1) {
+                if (used + 1 == n) {
+                    out[used++] = text.substr(start);
+                    return used;
+                }
+                const size_t at = pos + abel::count_trailing_zeros(matches);
+                out[used++] = abel::string_view(p + start, at - start);
+                start = at + 1;
+            }
+        }
+    }
+#endif
+    for (; pos < size && used + 1 < n; ++pos) {
+        if (contains(p[pos])) {
+            out[used++] = abel::string_view(p + start, pos - start);
+            start = pos + 1;
+        }
+    }
+    out[used++] = text.substr(start);
+    return used;
+}
+
+}  // namespace strings_internal
+
+}  // namespace abel
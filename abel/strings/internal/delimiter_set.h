@@ -0,0 +1,67 @@
+//
+
+#ifndef ABEL_STRINGS_INTERNAL_DELIMITER_SET_H_
+#define ABEL_STRINGS_INTERNAL_DELIMITER_SET_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <abel/base/profile.h>
+#include <abel/strings/string_view.h>
+
+namespace abel {
+
+namespace strings_internal {
+
+// A set of delimiter bytes that classifies a whole block of text at once:
+// 32 bytes with AVX2, 16 with SSSE3, a byte at a time otherwise. Each byte
+// is split into nibbles that index two 16-entry tables by pshufb; a byte is
+// a delimiter when the two entries share a bit. That is exact as long as the
+// delimiters have at most eight distinct high nibbles (or low nibbles), which
+// holds for any set of up to 8 bytes and for the punctuation and whitespace
+// that text formats split on. Other sets go through a 256-bit table.
+//
+// This class is NOT part of the public splitting API.
+class delimiter_set {
+  public:
+    explicit delimiter_set (abel::string_view chars);
+
+    bool contains (char c) const {
+        const uint8_t u = static_cast<uint8_t>(c);
+        if (_kind == kind::kTable) {
+            return (_bitmap[u >> 6] >> (u & 63)) & 1;
+        }
+        return (_low[u & 15] & _high[u >> 4]) != 0;
+    }
+
+    // The offset of the first delimiter in `text` at or after `pos`, or
+    // abel::string_view::npos.
+    size_t find (abel::string_view text, size_t pos) const;
+
+    // Splits `text` at every delimiter into the `n` slots at `out`, which
+    // must be at least one; if there are more pieces than that, the last slot
+    // holds the unsplit rest of `text`. Returns the number of slots used.
+    size_t split (abel::string_view text, abel::string_view *out, size_t n) const;
+
+  private:
+    enum class kind : uint8_t {
+        kSingle,   // one byte, compared directly
+        kNibbles,  // the nibble tables are exact
+        kTable,    // only the bitmap is
+    };
+
+    uint64_t block_matches (const char *p) const;
+
+    uint8_t _low[16];
+    uint8_t _high[16];
+    // Only set for kind::kTable.
+    uint64_t _bitmap[4];
+    char _single;
+    kind _kind;
+};
+
+}  // namespace strings_internal
+
+}  // namespace abel
+
+#endif  // ABEL_STRINGS_INTERNAL_DELIMITER_SET_H_
@@ -0,0 +1,226 @@
+//
+
+#include <abel/strings/internal/string_search.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <abel/base/math/ctz.h>
+
+#if ABEL_AVX2
+#include <immintrin.h>
+#define ABEL_SEARCH_BLOCK 32
+#elif ABEL_SSE2
+#include <emmintrin.h>
+#define ABEL_SEARCH_BLOCK 16
+#endif
+
+namespace abel {
+
+namespace strings_internal {
+
+namespace {
+
+// The filter gives up on bounded searches once it has compared this many
+// bytes more than twice what it scanned.
+constexpr size_t kFilterSlack = 1024;
+
+#if defined(ABEL_SEARCH_BLOCK)
+
+// A bit for each of the block of positions at `p` where the byte is `first`
+// and the one `last` bytes on is `back`.
+#if ABEL_SEARCH_BLOCK == 32
+typedef __m256i block;
+ABEL_FORCE_INLINE block splat (char c) { return _mm256_set1_epi8(c); }
+ABEL_FORCE_INLINE uint32_t candidates (const char *p, size_t last, block first, block back) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + last));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, back))));
+}
+#else
+typedef __m128i block;
+ABEL_FORCE_INLINE block splat (char c) { return _mm_set1_epi8(c); }
+ABEL_FORCE_INLINE uint32_t candidates (const char *p, size_t last, block first, block back) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + last));
+    return static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, back))));
+}
+#endif
+
+#endif  // ABEL_SEARCH_BLOCK
+
+// The end of the maximal suffix of `n` under the byte order, or the reverse
+// order with `reverse`, as a position one before its start (so possibly
+// SIZE_MAX), and its period.
+void maximal_suffix (const unsigned char *n, size_t m, bool reverse, size_t *start,
+                     size_t *period) {
+    size_t ip = static_cast<size_t>(-1);
+    size_t jp = 0;
+    size_t k = 1;
+    size_t p = 1;
+    while (jp + k < m) {
+        const unsigned char a = n[ip + k];
+        const unsigned char b = n[jp + k];
+        if (a == b) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else {
+                ++k;
+            }
+        } else if (reverse ? a < b : a > b) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    *start = ip;
+    *period = p;
+}
+
+}  // namespace
+
+void two_way_needle::init (const char *n, size_t m) {
+    needle = reinterpret_cast<const unsigned char *>(n);
+    length = m;
+    std::fill(shift, shift + 256, size_t{0});
+    for (size_t i = 0; i < m; ++i) {
+        shift[needle[i]] = i + 1;
+    }
+    // The critical factorization is the later of the two maximal suffixes.
+    size_t ms, p, ms_reverse, p_reverse;
+    maximal_suffix(needle, m, false, &ms, &p);
+    maximal_suffix(needle, m, true, &ms_reverse, &p_reverse);
+    if (ms_reverse + 1 > ms + 1) {
+        ms = ms_reverse;
+        p = p_reverse;
+    }
+    split = ms;
+    // A needle that is not periodic can shift past the longer of its two
+    // halves; a periodic one shifts by its period and remembers the overlap.
+    if (memcmp(needle, needle + p, ms + 1) != 0) {
+        period = std::max(ms, m - ms - 1) + 1;
+        memory = 0;
+    } else {
+        period = p;
+        memory = m - p;
+    }
+}
+
+const char *two_way_needle::search (const char *hay, size_t hl) const {
+    const unsigned char *h = reinterpret_cast<const unsigned char *>(hay);
+    const unsigned char *const end = h + hl;
+    const size_t m = length;
+    size_t mem = 0;
+    while (static_cast<size_t>(end - h) >= m) {
+        // Skip on the byte under the needle's last position first.
+        const size_t last = shift[h[m - 1]];
+        if (last != m) {
+            size_t k = last == 0 ? m : m - last;
+            if (k < mem) {
+                k = mem;
+            }
+            h += k;
+            mem = 0;
+            continue;
+        }
+        // Compare the right half, then the left.
+        size_t k = std::max(split + 1, mem);
+        while (k < m && needle[k] == h[k]) {
+            ++k;
+        }
+        if (k < m) {
+            h += k - split;
+            mem = 0;
+            continue;
+        }
+        k = split + 1;
+        while (k > mem && needle[k - 1] == h[k - 1]) {
+            --k;
+        }
+        if (k <= mem) {
+            return reinterpret_cast<const char *>(h);
+        }
+        h += period;
+        mem = memory;
+    }
+    return nullptr;
+}
+
+const char *filter_search (const char *h, size_t hl, const char *n, size_t m, bool bounded,
+                           const char **resume) {
+    *resume = h + hl;
+    if (m > hl) {
+        return nullptr;
+    }
+    const size_t last = m - 1;
+    // Matches can start at [0, positions).
+    const size_t positions = hl - last;
+    size_t i = 0;
+    size_t work = 0;
+#if defined(ABEL_SEARCH_BLOCK)
+    const block first = splat(n[0]);
+    const block back = splat(n[last]);
+    for (; i + ABEL_SEARCH_BLOCK <= positions; i += ABEL_SEARCH_BLOCK) {
+        for (uint32_t mask = candidates(h + i, last, first, back); mask != 0; mask &= mask - 1) {
+            const size_t at = i + abel::count_trailing_zeros(mask);
+            if (bounded && work > 2 * at + kFilterSlack) {
+                *resume = h + at;
+                return nullptr;
+            }
+            work += m;
+            if (memcmp(h + at + 1, n + 1, last) == 0) {
+                return h + at;
+            }
+        }
+    }
+#endif
+    while (i < positions) {
+        const char *p = static_cast<const char *>(memchr(h + i, n[0], positions - i));
+        if (p == nullptr) {
+            break;
+        }
+        const size_t at = p - h;
+        if (p[last] == n[last]) {
+            if (bounded && work > 2 * at + kFilterSlack) {
+                *resume = p;
+                return nullptr;
+            }
+            work += m;
+            if (memcmp(p + 1, n + 1, last) == 0) {
+                return p;
+            }
+        }
+        i = at + 1;
+    }
+    return nullptr;
+}
+
+const char *string_search (const char *h, size_t hl, const char *n, size_t m) {
+    if (m == 0) {
+        return h;
+    }
+    if (m > hl) {
+        return nullptr;
+    }
+    if (m == 1) {
+        return static_cast<const char *>(memchr(h, n[0], hl));
+    }
+    const char *resume;
+    const char *found = filter_search(h, hl, n, m, m > kShortNeedle, &resume);
+    if (found != nullptr || resume == h + hl) {
+        return found;
+    }
+    two_way_needle two_way;
+    two_way.init(n, m);
+    return two_way.search(resume, h + hl - resume);
+}
+
+}  // namespace strings_internal
+
+}  // namespace abel
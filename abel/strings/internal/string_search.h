@@ -0,0 +1,64 @@
+//
+
+#ifndef ABEL_STRINGS_INTERNAL_STRING_SEARCH_H_
+#define ABEL_STRINGS_INTERNAL_STRING_SEARCH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <abel/base/profile.h>
+
+namespace abel {
+
+namespace strings_internal {
+
+// Substring search behind string_view::find(), char_mem() and
+// abel::searcher.
+//
+// Needles are looked for by comparing a vector of haystack bytes against
+// the needle's first byte and another, `m - 1` bytes on, against its last,
+// 32 positions at a time with AVX2 or 16 with SSE2; only the positions where
+// both agree are compared in full. That is close to memchr() speed on most
+// text. Haystacks where most positions pass the filter (long runs of a
+// repeated byte, say) would make it quadratic, so once comparing costs more
+// than scanning, needles longer than kShortNeedle carry on with the Two-Way
+// algorithm, which is linear in the worst case.
+
+// Needles up to this long stay on the filter whatever the haystack.
+constexpr size_t kShortNeedle = 16;
+
+// The Two-Way factorization of a needle together with a Horspool table of
+// the last position of each byte, for skipping ahead on the haystack byte
+// under the needle's end.
+struct two_way_needle {
+    // Precomputes for the `m` bytes at `n`, which must outlive this object.
+    void init (const char *n, size_t m);
+
+    // The first occurrence of the needle in the `hl` bytes at `h`, or
+    // nullptr.
+    const char *search (const char *h, size_t hl) const;
+
+    const unsigned char *needle;
+    size_t length;
+    size_t split;   // the critical factorization is needle[0, split]
+    size_t period;
+    size_t memory;  // what a shift by `period` leaves known to match
+    size_t shift[256];  // one past the last position of each byte, or 0
+};
+
+// The first/last-byte filter. Returns the first match in the `hl` bytes at
+// `h`, or nullptr. With `bounded`, it may instead give up with nullptr and
+// set `*resume` to the position the Two-Way search has to pick up from; it
+// sets `*resume` to `h + hl` when the whole haystack was searched.
+const char *filter_search (const char *h, size_t hl, const char *n, size_t m, bool bounded,
+                           const char **resume);
+
+// The first occurrence of the `m` bytes at `n` in the `hl` bytes at `h`, or
+// nullptr. An empty needle is found at `h`.
+const char *string_search (const char *h, size_t hl, const char *n, size_t m);
+
+}  // namespace strings_internal
+
+}  // namespace abel
+
+#endif  // ABEL_STRINGS_INTERNAL_STRING_SEARCH_H_
@@ -0,0 +1,309 @@
+//
+// AVX2 UTF-8 kernels. The functions carry their own target attribute, so
+// that this file builds without -mavx2 and is only run after
+// cpu_supports_avx2().
+
+#include <abel/strings/internal/utf8_simd.h>
+
+#include <cstring>
+
+#if defined(ABEL_PROCESSOR_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#define ABEL_UTF8_HAVE_AVX2_KERNELS 1
+#include <immintrin.h>
+#include <abel/strings/internal/utf8_lookup.h>
+#endif
+
+namespace abel {
+
+namespace strings_internal {
+
+#if ABEL_UTF8_HAVE_AVX2_KERNELS
+
+namespace {
+
+#define ABEL_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+
+// The last N bytes of `prev` followed by all but the last N bytes of `cur`.
+template <int N>
+ABEL_TARGET_AVX2 inline __m256i prev_bytes (__m256i cur, __m256i prev) {
+    return _mm256_alignr_epi8(cur, _mm256_permute2x128_si256(prev, cur, 0x21), 16 - N);
+}
+
+ABEL_TARGET_AVX2 inline __m256i lookup16 (const uint8_t (&table)[16], __m256i index) {
+    const __m256i t = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(table)));
+    return _mm256_shuffle_epi8(t, index);
+}
+
+// The validation of utf8_lookup.h over 32-byte blocks.
+struct avx2_checker {
+    __m256i error;
+    __m256i prev_input;
+    __m256i prev_incomplete;
+
+    ABEL_TARGET_AVX2 avx2_checker ()
+        : error(_mm256_setzero_si256()),
+          prev_input(_mm256_setzero_si256()),
+          prev_incomplete(_mm256_setzero_si256()) { }
+
+    ABEL_TARGET_AVX2 void check (__m256i input) {
+        const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+        const __m256i prev1 = prev_bytes<1>(input, prev_input);
+        const __m256i special = _mm256_and_si256(
+            _mm256_and_si256(
+                lookup16(kUtf8Byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble)),
+                lookup16(kUtf8Byte1Low, _mm256_and_si256(prev1, low_nibble))),
+            lookup16(kUtf8Byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble)));
+        // The third and fourth bytes of 3- and 4-byte sequences must be
+        // continuations, the only pair of continuations that is allowed.
+        const __m256i third = _mm256_subs_epu8(prev_bytes<2>(input, prev_input),
+                                               _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+        const __m256i fourth = _mm256_subs_epu8(prev_bytes<3>(input, prev_input),
+                                                _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+        const __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth),
+                                                _mm256_set1_epi8(static_cast<char>(0x80)));
+        error = _mm256_or_si256(error, _mm256_xor_si256(must23, special));
+        // Lead bytes too close to the end of the block to be complete.
+        const __m256i max_value = _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+        prev_incomplete = _mm256_subs_epu8(input, max_value);
+        prev_input = input;
+    }
+
+    ABEL_TARGET_AVX2 void check_ascii (__m256i input) {
+        error = _mm256_or_si256(error, prev_incomplete);
+        prev_incomplete = _mm256_setzero_si256();
+        prev_input = input;
+    }
+
+    ABEL_TARGET_AVX2 bool finish () {
+        error = _mm256_or_si256(error, prev_incomplete);
+        return _mm256_testz_si256(error, error) != 0;
+    }
+};
+
+ABEL_TARGET_AVX2 bool avx2_validate (const char *p, size_t n) {
+    avx2_checker checker;
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i + 32));
+        if (_mm256_movemask_epi8(_mm256_or_si256(a, b)) == 0) {
+            checker.check_ascii(b);
+        } else {
+            checker.check(a);
+            checker.check(b);
+        }
+    }
+    for (; i < n; i += 32) {
+        // Zeros, being ASCII, pad the last block without changing the result.
+        alignas(32) char block[32] = {};
+        memcpy(block, p + i, n - i < 32 ? n - i : 32);
+        checker.check(_mm256_load_si256(reinterpret_cast<const __m256i *>(block)));
+    }
+    return checker.finish();
+}
+
+ABEL_TARGET_AVX2 size_t avx2_count_code_points (const char *p, size_t n) {
+    const __m256i threshold = _mm256_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        const uint32_t leads = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpgt_epi8(v, threshold)));
+        count += static_cast<size_t>(__builtin_popcount(leads));
+    }
+    for (; i < n; ++i) {
+        count += static_cast<int8_t>(p[i]) > -65;
+    }
+    return count;
+}
+
+ABEL_TARGET_AVX2 size_t avx2_count_utf16_units (const char *p, size_t n) {
+    const __m256i threshold = _mm256_set1_epi8(-65);
+    const __m256i four_byte = _mm256_set1_epi8(static_cast<char>(0xF0));
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        const uint32_t leads = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpgt_epi8(v, threshold)));
+        const uint32_t fours = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(v, four_byte), v)));
+        count += static_cast<size_t>(__builtin_popcount(leads) + __builtin_popcount(fours));
+    }
+    for (; i < n; ++i) {
+        count += (static_cast<int8_t>(p[i]) > -65) + (static_cast<uint8_t>(p[i]) >= 0xF0);
+    }
+    return count;
+}
+
+ABEL_TARGET_AVX2 size_t avx2_ascii_prefix (const char *p, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(v));
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+    while (i < n && static_cast<uint8_t>(p[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+// Decodes 16 bytes of ASCII and 2-byte characters into two halves of eight
+// 16-bit lanes, with `keep` marking the lanes that hold a character (the
+// lead byte's). Returns the number of bytes consumed, 15 if the block ends
+// with a lead byte, or 0 if it holds a 3- or 4-byte character.
+ABEL_TARGET_AVX2 inline size_t avx2_decode_two_byte (__m128i v, __m128i *lo, __m128i *hi, uint32_t *keep) {
+    if (!_mm_testz_si128(_mm_subs_epu8(v, _mm_set1_epi8(static_cast<char>(0xDF))),
+                         _mm_set1_epi8(-1))) {
+        return 0;
+    }
+    const uint32_t conts = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-64), v)));
+    const uint32_t leads = static_cast<uint32_t>(_mm_movemask_epi8(v)) & ~conts;
+    *keep = ~conts & 0xFFFF;
+    size_t consumed = 16;
+    if (leads & 0x8000) {
+        // The continuation is in the next block.
+        *keep &= 0x7FFF;
+        consumed = 15;
+    }
+    const __m128i next = _mm_srli_si128(v, 1);
+    const __m128i lead_min = _mm_set1_epi16(0xBF);
+    const __m128i b0 = _mm_cvtepu8_epi16(v);
+    const __m128i n0 = _mm_cvtepu8_epi16(next);
+    const __m128i b1 = _mm_cvtepu8_epi16(_mm_srli_si128(v, 8));
+    const __m128i n1 = _mm_cvtepu8_epi16(_mm_srli_si128(next, 8));
+    const __m128i c0 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b0, _mm_set1_epi16(0x1F)), 6),
+                                    _mm_and_si128(n0, _mm_set1_epi16(0x3F)));
+    const __m128i c1 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b1, _mm_set1_epi16(0x1F)), 6),
+                                    _mm_and_si128(n1, _mm_set1_epi16(0x3F)));
+    *lo = _mm_blendv_epi8(b0, c0, _mm_cmpgt_epi16(b0, lead_min));
+    *hi = _mm_blendv_epi8(b1, c1, _mm_cmpgt_epi16(b1, lead_min));
+    return consumed;
+}
+
+ABEL_TARGET_AVX2 inline size_t avx2_store_units (char16_t *out, __m128i units, uint32_t keep,
+                                      const uint8_t *shuffles) {
+    const __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffles + keep * 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(units, control));
+    return static_cast<size_t>(__builtin_popcount(keep));
+}
+
+ABEL_TARGET_AVX2 inline size_t avx2_store_units (char32_t *out, __m128i units, uint32_t keep,
+                                      const uint8_t *shuffles) {
+    const __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffles + keep * 16));
+    const __m128i packed = _mm_shuffle_epi8(units, control);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_cvtepu16_epi32(packed));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out) + 1, _mm_cvtepu16_epi32(_mm_srli_si128(packed, 8)));
+    return static_cast<size_t>(__builtin_popcount(keep));
+}
+
+ABEL_TARGET_AVX2 inline void avx2_widen_ascii (__m128i v, char16_t *out) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), _mm256_cvtepu8_epi16(v));
+}
+
+ABEL_TARGET_AVX2 inline void avx2_widen_ascii (__m128i v, char32_t *out) {
+    __m256i *dst = reinterpret_cast<__m256i *>(out);
+    _mm256_storeu_si256(dst, _mm256_cvtepu8_epi32(v));
+    _mm256_storeu_si256(dst + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+}
+
+template <typename Unit>
+ABEL_TARGET_AVX2 size_t avx2_utf8_to_wide (const char *p, size_t n, Unit *out, size_t *written) {
+    const uint8_t *shuffles = utf16_compress_shuffles();
+    size_t i = 0;
+    size_t units = 0;
+    while (i + 16 <= n) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        if (_mm_movemask_epi8(v) == 0) {
+            avx2_widen_ascii(v, out + units);
+            i += 16;
+            units += 16;
+            continue;
+        }
+        __m128i lo, hi;
+        uint32_t keep;
+        const size_t consumed = avx2_decode_two_byte(v, &lo, &hi, &keep);
+        if (consumed == 0) {
+            break;
+        }
+        units += avx2_store_units(out + units, lo, keep & 0xFF, shuffles);
+        units += avx2_store_units(out + units, hi, keep >> 8, shuffles);
+        i += consumed;
+    }
+    *written = units;
+    return i;
+}
+
+ABEL_TARGET_AVX2 size_t avx2_utf16_ascii_to_utf8 (const char16_t *p, size_t n, char *out) {
+    const __m256i non_ascii = _mm256_set1_epi16(static_cast<short>(0xFF80));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        if (!_mm256_testz_si256(v, non_ascii)) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                         _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+    }
+    for (; i < n && p[i] < 0x80; ++i) {
+        out[i] = static_cast<char>(p[i]);
+    }
+    return i;
+}
+
+ABEL_TARGET_AVX2 size_t avx2_utf32_ascii_to_utf8 (const char32_t *p, size_t n, char *out) {
+    const __m256i non_ascii = _mm256_set1_epi32(static_cast<int>(0xFFFFFF80));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        if (!_mm256_testz_si256(v, non_ascii)) {
+            break;
+        }
+        const __m128i units = _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(units, units));
+    }
+    for (; i < n && p[i] < 0x80; ++i) {
+        out[i] = static_cast<char>(p[i]);
+    }
+    return i;
+}
+
+#undef ABEL_TARGET_AVX2
+
+const utf8_kernels kAvx2Kernels = {
+    "avx2",
+    avx2_validate,
+    avx2_count_code_points,
+    avx2_count_utf16_units,
+    avx2_ascii_prefix,
+    avx2_utf8_to_wide<char16_t>,
+    avx2_utf8_to_wide<char32_t>,
+    avx2_utf16_ascii_to_utf8,
+    avx2_utf32_ascii_to_utf8,
+};
+
+}  // namespace
+
+const utf8_kernels *utf8_avx2_kernels () {
+    return &kAvx2Kernels;
+}
+
+#else
+
+const utf8_kernels *utf8_avx2_kernels () {
+    return nullptr;
+}
+
+#endif  // ABEL_UTF8_HAVE_AVX2_KERNELS
+
+}  // namespace strings_internal
+
+}  // namespace abel
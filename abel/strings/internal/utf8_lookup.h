@@ -0,0 +1,115 @@
+//
+// The nibble lookup tables of the vectorized UTF-8 validation, after
+// Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per
+// Byte" (2021).
+//
+// Each table maps a nibble of a byte pair (the high and low nibbles of the
+// first byte, the high nibble of the second) to the set of errors the pair
+// may be part of; a pair is in error when all three sets share a bit. The
+// one pair that is only sometimes an error, two continuation bytes, sets
+// kTwoConts, which the kernels cancel when the second byte must be a third
+// or fourth byte of a longer sequence.
+
+#ifndef ABEL_STRINGS_INTERNAL_UTF8_LOOKUP_H_
+#define ABEL_STRINGS_INTERNAL_UTF8_LOOKUP_H_
+
+#include <cstdint>
+
+namespace abel {
+
+namespace strings_internal {
+
+namespace utf8_error {
+
+// 11______ 0_______ or 11______ 11______
+constexpr uint8_t kTooShort = 1 << 0;
+// 0_______ 10______
+constexpr uint8_t kTooLong = 1 << 1;
+// 11100000 100_____
+constexpr uint8_t kOverlong3 = 1 << 2;
+// 11110100 1001____ and up, or 11110101+ 10______
+constexpr uint8_t kTooLarge = 1 << 3;
+// 11101101 101_____
+constexpr uint8_t kSurrogate = 1 << 4;
+// 1100000_ 10______
+constexpr uint8_t kOverlong2 = 1 << 5;
+// 11110101+ 1000____
+constexpr uint8_t kTooLarge1000 = 1 << 6;
+// 11110000 1000____
+constexpr uint8_t kOverlong4 = 1 << 6;
+// 10______ 10______
+constexpr uint8_t kTwoConts = 1 << 7;
+constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+}  // namespace utf8_error
+
+// Indexed by the high nibble of the first byte.
+alignas(16) constexpr uint8_t kUtf8Byte1High[16] = {
+    // 0_______ ________
+    utf8_error::kTooLong, utf8_error::kTooLong, utf8_error::kTooLong, utf8_error::kTooLong,
+    utf8_error::kTooLong, utf8_error::kTooLong, utf8_error::kTooLong, utf8_error::kTooLong,
+    // 10______ ________
+    utf8_error::kTwoConts, utf8_error::kTwoConts, utf8_error::kTwoConts, utf8_error::kTwoConts,
+    // 1100____ ________
+    utf8_error::kTooShort | utf8_error::kOverlong2,
+    // 1101____ ________
+    utf8_error::kTooShort,
+    // 1110____ ________
+    utf8_error::kTooShort | utf8_error::kOverlong3 | utf8_error::kSurrogate,
+    // 1111____ ________
+    utf8_error::kTooShort | utf8_error::kTooLarge | utf8_error::kTooLarge1000 |
+        utf8_error::kOverlong4,
+};
+
+// Indexed by the low nibble of the first byte.
+alignas(16) constexpr uint8_t kUtf8Byte1Low[16] = {
+    // ____0000 ________
+    utf8_error::kCarry | utf8_error::kOverlong3 | utf8_error::kOverlong2 | utf8_error::kOverlong4,
+    // ____0001 ________
+    utf8_error::kCarry | utf8_error::kOverlong2,
+    // ____001_ ________
+    utf8_error::kCarry,
+    utf8_error::kCarry,
+    // ____0100 ________
+    utf8_error::kCarry | utf8_error::kTooLarge,
+    // ____0101 ________ and up
+    utf8_error::kCarry | utf8_error::kTooLarge | utf8_error::kTooLarge1000,
+    utf8_error::kCarry | utf8_error::kTooLarge | utf8_error::kTooLarge1000,
+    utf8_error::kCarry | utf8_error::kTooLarge | utf8_error::kTooLarge1000,
+    utf8_error::kCarry | utf8_error::kTooLarge | utf8_error::kTooLarge1000,
+    utf8_error::kCarry | utf8_error::kTooLarge | utf8_error::kTooLarge1000,
+    utf8_error::kCarry | utf8_error::kTooLarge | utf8_error::kTooLarge1000,
+    utf8_error::kCarry | utf8_error::kTooLarge | utf8_error::kTooLarge1000,
+    utf8_error::kCarry | utf8_error::kTooLarge | utf8_error::kTooLarge1000,
+    // ____1101 ________
+    utf8_error::kCarry | utf8_error::kTooLarge | utf8_error::kTooLarge1000 |
+        utf8_error::kSurrogate,
+    utf8_error::kCarry | utf8_error::kTooLarge | utf8_error::kTooLarge1000,
+    utf8_error::kCarry | utf8_error::kTooLarge | utf8_error::kTooLarge1000,
+};
+
+// Indexed by the high nibble of the second byte.
+alignas(16) constexpr uint8_t kUtf8Byte2High[16] = {
+    // ________ 0_______
+    utf8_error::kTooShort, utf8_error::kTooShort, utf8_error::kTooShort, utf8_error::kTooShort,
+    utf8_error::kTooShort, utf8_error::kTooShort, utf8_error::kTooShort, utf8_error::kTooShort,
+    // ________ 1000____
+    utf8_error::kTooLong | utf8_error::kOverlong2 | utf8_error::kTwoConts | utf8_error::kOverlong3 |
+        utf8_error::kTooLarge1000 | utf8_error::kOverlong4,
+    // ________ 1001____
+    utf8_error::kTooLong | utf8_error::kOverlong2 | utf8_error::kTwoConts | utf8_error::kOverlong3 |
+        utf8_error::kTooLarge,
+    // ________ 101_____
+    utf8_error::kTooLong | utf8_error::kOverlong2 | utf8_error::kTwoConts | utf8_error::kSurrogate |
+        utf8_error::kTooLarge,
+    utf8_error::kTooLong | utf8_error::kOverlong2 | utf8_error::kTwoConts | utf8_error::kSurrogate |
+        utf8_error::kTooLarge,
+    // ________ 11______
+    utf8_error::kTooShort, utf8_error::kTooShort, utf8_error::kTooShort, utf8_error::kTooShort,
+};
+
+}  // namespace strings_internal
+
+}  // namespace abel
+
+#endif  // ABEL_STRINGS_INTERNAL_UTF8_LOOKUP_H_
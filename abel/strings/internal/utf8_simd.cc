@@ -0,0 +1,193 @@
+//
+
+#include <abel/strings/internal/utf8_simd.h>
+
+#include <cstring>
+
+#include <abel/base/internal/cpu_features.h>
+
+namespace abel {
+
+namespace strings_internal {
+
+namespace {
+
+constexpr uint64_t kHighBits = 0x8080808080808080ull;
+
+}  // namespace
+
+size_t utf8_valid_prefix (const char *p, size_t n) {
+    const uint8_t *s = reinterpret_cast<const uint8_t *>(p);
+    size_t i = 0;
+    while (i < n) {
+        if (i + 8 <= n) {
+            uint64_t w;
+            memcpy(&w, s + i, 8);
+            if ((w & kHighBits) == 0) {
+                i += 8;
+                continue;
+            }
+        }
+        const uint8_t c = s[i];
+        if (c < 0x80) {
+            ++i;
+            continue;
+        }
+        // The second byte has a narrower range after some lead bytes, which
+        // rules out overlong forms, surrogates and code points past U+10FFFF.
+        size_t len;
+        uint8_t lo = 0x80;
+        uint8_t hi = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF) {
+            len = 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            len = 3;
+            if (c == 0xE0) {
+                lo = 0xA0;
+            } else if (c == 0xED) {
+                hi = 0x9F;
+            }
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            len = 4;
+            if (c == 0xF0) {
+                lo = 0x90;
+            } else if (c == 0xF4) {
+                hi = 0x8F;
+            }
+        } else {
+            return i;
+        }
+        if (n - i < len || s[i + 1] < lo || s[i + 1] > hi) {
+            return i;
+        }
+        for (size_t k = 2; k < len; ++k) {
+            if ((s[i + k] & 0xC0) != 0x80) {
+                return i;
+            }
+        }
+        i += len;
+    }
+    return n;
+}
+
+namespace {
+
+bool scalar_validate (const char *p, size_t n) {
+    return utf8_valid_prefix(p, n) == n;
+}
+
+size_t scalar_count_code_points (const char *p, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        count += static_cast<int8_t>(p[i]) > -65;
+    }
+    return count;
+}
+
+size_t scalar_count_utf16_units (const char *p, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        count += (static_cast<int8_t>(p[i]) > -65) + (static_cast<uint8_t>(p[i]) >= 0xF0);
+    }
+    return count;
+}
+
+size_t scalar_ascii_prefix (const char *p, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        memcpy(&w, p + i, 8);
+        if ((w & kHighBits) != 0) {
+            break;
+        }
+    }
+    while (i < n && static_cast<uint8_t>(p[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+// Only widens the leading ASCII run; utf8.cc decodes the rest.
+template <typename Unit>
+size_t scalar_utf8_to_wide (const char *p, size_t n, Unit *out, size_t *written) {
+    size_t i = 0;
+    for (; i < n && static_cast<uint8_t>(p[i]) < 0x80; ++i) {
+        out[i] = static_cast<Unit>(p[i]);
+    }
+    *written = i;
+    return i;
+}
+
+template <typename Unit>
+size_t scalar_wide_ascii_to_utf8 (const Unit *p, size_t n, char *out) {
+    size_t i = 0;
+    for (; i < n && static_cast<uint32_t>(p[i]) < 0x80; ++i) {
+        out[i] = static_cast<char>(p[i]);
+    }
+    return i;
+}
+
+const utf8_kernels kScalarKernels = {
+    "scalar",
+    scalar_validate,
+    scalar_count_code_points,
+    scalar_count_utf16_units,
+    scalar_ascii_prefix,
+    scalar_utf8_to_wide<char16_t>,
+    scalar_utf8_to_wide<char32_t>,
+    scalar_wide_ascii_to_utf8<char16_t>,
+    scalar_wide_ascii_to_utf8<char32_t>,
+};
+
+}  // namespace
+
+const uint8_t *utf16_compress_shuffles () {
+    static const uint8_t *table = [] {
+        uint8_t *t = new uint8_t[256 * 16];
+        for (int mask = 0; mask < 256; ++mask) {
+            uint8_t *entry = t + mask * 16;
+            int k = 0;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (mask & (1 << lane)) {
+                    entry[k++] = static_cast<uint8_t>(2 * lane);
+                    entry[k++] = static_cast<uint8_t>(2 * lane + 1);
+                }
+            }
+            // 0x80 zeroes the rest.
+            while (k < 16) {
+                entry[k++] = 0x80;
+            }
+        }
+        return t;
+    }();
+    return table;
+}
+
+const utf8_kernels &utf8_scalar_kernels () {
+    return kScalarKernels;
+}
+
+bool cpu_supports_sse4 () {
+    return base_internal::GetCpuFeatures().sse4_1;
+}
+
+bool cpu_supports_avx2 () {
+    return base_internal::GetCpuFeatures().avx2;
+}
+
+const utf8_kernels &utf8_best_kernels () {
+    static const utf8_kernels *kernels = [] {
+        if (utf8_avx2_kernels() != nullptr && cpu_supports_avx2()) {
+            return utf8_avx2_kernels();
+        }
+        if (utf8_sse4_kernels() != nullptr && cpu_supports_sse4()) {
+            return utf8_sse4_kernels();
+        }
+        return &kScalarKernels;
+    }();
+    return *kernels;
+}
+
+}  // namespace strings_internal
+
+}  // namespace abel
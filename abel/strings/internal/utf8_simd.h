@@ -0,0 +1,67 @@
+//
+// The vectorized kernels behind abel/strings/utf8.h, one table per
+// instruction set, picked once at runtime by CPU feature.
+
+#ifndef ABEL_STRINGS_INTERNAL_UTF8_SIMD_H_
+#define ABEL_STRINGS_INTERNAL_UTF8_SIMD_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <abel/base/profile.h>
+
+namespace abel {
+
+namespace strings_internal {
+
+struct utf8_kernels {
+    const char *name;
+    // Whether [p, p + n) is well-formed UTF-8 (RFC 3629): no overlong forms,
+    // surrogates, code points above U+10FFFF or truncated sequences.
+    bool (*validate) (const char *p, size_t n);
+    // The number of bytes that are not continuation bytes, which for valid
+    // input is the number of code points.
+    size_t (*count_code_points) (const char *p, size_t n);
+    // As count_code_points(), adding one per 4-byte lead byte, which for
+    // valid input is the length in UTF-16 code units.
+    size_t (*count_utf16_units) (const char *p, size_t n);
+    // The length of the leading ASCII run of [p, p + n).
+    size_t (*ascii_prefix) (const char *p, size_t n);
+    // Transcode a prefix of valid UTF-8 [p, p + n) made of ASCII and 2-byte
+    // characters into `out`, setting `*written` to the number of units and
+    // returning the number of bytes. The prefix ends at a character
+    // boundary and may stop short, even be empty. Units of `out` past the
+    // last one written, up to the n-th, may be overwritten.
+    size_t (*utf8_to_utf16) (const char *p, size_t n, char16_t *out, size_t *written);
+    size_t (*utf8_to_utf32) (const char *p, size_t n, char32_t *out, size_t *written);
+    // Narrow the leading run of units below 0x80 into `out`, returning its
+    // length.
+    size_t (*utf16_ascii_to_utf8) (const char16_t *p, size_t n, char *out);
+    size_t (*utf32_ascii_to_utf8) (const char32_t *p, size_t n, char *out);
+};
+
+// The length of the longest valid UTF-8 prefix of [p, p + n).
+size_t utf8_valid_prefix (const char *p, size_t n);
+
+// For each 8-bit mask, a pshufb control that packs the 16-bit lanes whose
+// bit is set to the front: 256 entries of 16 bytes.
+const uint8_t *utf16_compress_shuffles ();
+
+// The portable kernels, always available.
+const utf8_kernels &utf8_scalar_kernels ();
+// nullptr unless built for x86-64.
+const utf8_kernels *utf8_sse4_kernels ();
+const utf8_kernels *utf8_avx2_kernels ();
+
+// Whether the running CPU supports SSE4.1 / AVX2, using CPUID.
+bool cpu_supports_sse4 ();
+bool cpu_supports_avx2 ();
+
+// The best kernels for the running CPU, chosen on first use.
+const utf8_kernels &utf8_best_kernels ();
+
+}  // namespace strings_internal
+
+}  // namespace abel
+
+#endif  // ABEL_STRINGS_INTERNAL_UTF8_SIMD_H_
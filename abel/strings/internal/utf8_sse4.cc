@@ -0,0 +1,305 @@
+//
+// SSE4.1 UTF-8 kernels, for CPUs without AVX2. Like the AVX2 kernels, the
+// functions carry their own target attribute.
+
+#include <abel/strings/internal/utf8_simd.h>
+
+#include <cstring>
+
+#if defined(ABEL_PROCESSOR_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#define ABEL_UTF8_HAVE_SSE4_KERNELS 1
+#include <immintrin.h>
+#include <abel/strings/internal/utf8_lookup.h>
+#endif
+
+namespace abel {
+
+namespace strings_internal {
+
+#if ABEL_UTF8_HAVE_SSE4_KERNELS
+
+namespace {
+
+#define ABEL_TARGET_SSE4 __attribute__((target("sse4.1,popcnt")))
+
+// The last N bytes of `prev` followed by all but the last N bytes of `cur`.
+template <int N>
+ABEL_TARGET_SSE4 inline __m128i prev_bytes (__m128i cur, __m128i prev) {
+    return _mm_alignr_epi8(cur, prev, 16 - N);
+}
+
+ABEL_TARGET_SSE4 inline __m128i lookup16 (const uint8_t (&table)[16], __m128i index) {
+    return _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(table)), index);
+}
+
+// The validation of utf8_lookup.h over 16-byte blocks.
+struct sse4_checker {
+    __m128i error;
+    __m128i prev_input;
+    __m128i prev_incomplete;
+
+    ABEL_TARGET_SSE4 sse4_checker ()
+        : error(_mm_setzero_si128()),
+          prev_input(_mm_setzero_si128()),
+          prev_incomplete(_mm_setzero_si128()) { }
+
+    ABEL_TARGET_SSE4 void check (__m128i input) {
+        const __m128i low_nibble = _mm_set1_epi8(0x0F);
+        const __m128i prev1 = prev_bytes<1>(input, prev_input);
+        const __m128i special = _mm_and_si128(
+            _mm_and_si128(
+                lookup16(kUtf8Byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble)),
+                lookup16(kUtf8Byte1Low, _mm_and_si128(prev1, low_nibble))),
+            lookup16(kUtf8Byte2High, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble)));
+        const __m128i third = _mm_subs_epu8(prev_bytes<2>(input, prev_input),
+                                            _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+        const __m128i fourth = _mm_subs_epu8(prev_bytes<3>(input, prev_input),
+                                             _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+        const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth),
+                                             _mm_set1_epi8(static_cast<char>(0x80)));
+        error = _mm_or_si128(error, _mm_xor_si128(must23, special));
+        const __m128i max_value = _mm_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+        prev_incomplete = _mm_subs_epu8(input, max_value);
+        prev_input = input;
+    }
+
+    ABEL_TARGET_SSE4 void check_ascii (__m128i input) {
+        error = _mm_or_si128(error, prev_incomplete);
+        prev_incomplete = _mm_setzero_si128();
+        prev_input = input;
+    }
+
+    ABEL_TARGET_SSE4 bool finish () {
+        error = _mm_or_si128(error, prev_incomplete);
+        return _mm_testz_si128(error, error) != 0;
+    }
+};
+
+ABEL_TARGET_SSE4 bool sse4_validate (const char *p, size_t n) {
+    sse4_checker checker;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 16));
+        if (_mm_movemask_epi8(_mm_or_si128(a, b)) == 0) {
+            checker.check_ascii(b);
+        } else {
+            checker.check(a);
+            checker.check(b);
+        }
+    }
+    for (; i < n; i += 16) {
+        alignas(16) char block[16] = {};
+        memcpy(block, p + i, n - i < 16 ? n - i : 16);
+        checker.check(_mm_load_si128(reinterpret_cast<const __m128i *>(block)));
+    }
+    return checker.finish();
+}
+
+ABEL_TARGET_SSE4 size_t sse4_count_code_points (const char *p, size_t n) {
+    const __m128i threshold = _mm_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        const uint32_t leads = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, threshold)));
+        count += static_cast<size_t>(__builtin_popcount(leads));
+    }
+    for (; i < n; ++i) {
+        count += static_cast<int8_t>(p[i]) > -65;
+    }
+    return count;
+}
+
+ABEL_TARGET_SSE4 size_t sse4_count_utf16_units (const char *p, size_t n) {
+    const __m128i threshold = _mm_set1_epi8(-65);
+    const __m128i four_byte = _mm_set1_epi8(static_cast<char>(0xF0));
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        const uint32_t leads = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(v, threshold)));
+        const uint32_t fours = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, four_byte), v)));
+        count += static_cast<size_t>(__builtin_popcount(leads) + __builtin_popcount(fours));
+    }
+    for (; i < n; ++i) {
+        count += (static_cast<int8_t>(p[i]) > -65) + (static_cast<uint8_t>(p[i]) >= 0xF0);
+    }
+    return count;
+}
+
+ABEL_TARGET_SSE4 size_t sse4_ascii_prefix (const char *p, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(v));
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+    while (i < n && static_cast<uint8_t>(p[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+// Decodes 16 bytes of ASCII and 2-byte characters into two halves of eight
+// 16-bit lanes, with `keep` marking the lanes that hold a character (the
+// lead byte's). Returns the number of bytes consumed, 15 if the block ends
+// with a lead byte, or 0 if it holds a 3- or 4-byte character.
+ABEL_TARGET_SSE4 inline size_t sse4_decode_two_byte (__m128i v, __m128i *lo, __m128i *hi, uint32_t *keep) {
+    if (!_mm_testz_si128(_mm_subs_epu8(v, _mm_set1_epi8(static_cast<char>(0xDF))),
+                         _mm_set1_epi8(-1))) {
+        return 0;
+    }
+    const uint32_t conts = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-64), v)));
+    const uint32_t leads = static_cast<uint32_t>(_mm_movemask_epi8(v)) & ~conts;
+    *keep = ~conts & 0xFFFF;
+    size_t consumed = 16;
+    if (leads & 0x8000) {
+        // The continuation is in the next block.
+        *keep &= 0x7FFF;
+        consumed = 15;
+    }
+    const __m128i next = _mm_srli_si128(v, 1);
+    const __m128i lead_min = _mm_set1_epi16(0xBF);
+    const __m128i b0 = _mm_cvtepu8_epi16(v);
+    const __m128i n0 = _mm_cvtepu8_epi16(next);
+    const __m128i b1 = _mm_cvtepu8_epi16(_mm_srli_si128(v, 8));
+    const __m128i n1 = _mm_cvtepu8_epi16(_mm_srli_si128(next, 8));
+    const __m128i c0 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b0, _mm_set1_epi16(0x1F)), 6),
+                                    _mm_and_si128(n0, _mm_set1_epi16(0x3F)));
+    const __m128i c1 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b1, _mm_set1_epi16(0x1F)), 6),
+                                    _mm_and_si128(n1, _mm_set1_epi16(0x3F)));
+    *lo = _mm_blendv_epi8(b0, c0, _mm_cmpgt_epi16(b0, lead_min));
+    *hi = _mm_blendv_epi8(b1, c1, _mm_cmpgt_epi16(b1, lead_min));
+    return consumed;
+}
+
+ABEL_TARGET_SSE4 inline size_t sse4_store_units (char16_t *out, __m128i units, uint32_t keep,
+                                      const uint8_t *shuffles) {
+    const __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffles + keep * 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(units, control));
+    return static_cast<size_t>(__builtin_popcount(keep));
+}
+
+ABEL_TARGET_SSE4 inline size_t sse4_store_units (char32_t *out, __m128i units, uint32_t keep,
+                                      const uint8_t *shuffles) {
+    const __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffles + keep * 16));
+    const __m128i packed = _mm_shuffle_epi8(units, control);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_cvtepu16_epi32(packed));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out) + 1, _mm_cvtepu16_epi32(_mm_srli_si128(packed, 8)));
+    return static_cast<size_t>(__builtin_popcount(keep));
+}
+
+ABEL_TARGET_SSE4 inline void sse4_widen_ascii (__m128i v, char16_t *out) {
+    __m128i *dst = reinterpret_cast<__m128i *>(out);
+    _mm_storeu_si128(dst, _mm_cvtepu8_epi16(v));
+    _mm_storeu_si128(dst + 1, _mm_cvtepu8_epi16(_mm_srli_si128(v, 8)));
+}
+
+ABEL_TARGET_SSE4 inline void sse4_widen_ascii (__m128i v, char32_t *out) {
+    __m128i *dst = reinterpret_cast<__m128i *>(out);
+    _mm_storeu_si128(dst, _mm_cvtepu8_epi32(v));
+    _mm_storeu_si128(dst + 1, _mm_cvtepu8_epi32(_mm_srli_si128(v, 4)));
+    _mm_storeu_si128(dst + 2, _mm_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+    _mm_storeu_si128(dst + 3, _mm_cvtepu8_epi32(_mm_srli_si128(v, 12)));
+}
+
+template <typename Unit>
+ABEL_TARGET_SSE4 size_t sse4_utf8_to_wide (const char *p, size_t n, Unit *out, size_t *written) {
+    const uint8_t *shuffles = utf16_compress_shuffles();
+    size_t i = 0;
+    size_t units = 0;
+    while (i + 16 <= n) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        if (_mm_movemask_epi8(v) == 0) {
+            sse4_widen_ascii(v, out + units);
+            i += 16;
+            units += 16;
+            continue;
+        }
+        __m128i lo, hi;
+        uint32_t keep;
+        const size_t consumed = sse4_decode_two_byte(v, &lo, &hi, &keep);
+        if (consumed == 0) {
+            break;
+        }
+        units += sse4_store_units(out + units, lo, keep & 0xFF, shuffles);
+        units += sse4_store_units(out + units, hi, keep >> 8, shuffles);
+        i += consumed;
+    }
+    *written = units;
+    return i;
+}
+
+ABEL_TARGET_SSE4 size_t sse4_utf16_ascii_to_utf8 (const char16_t *p, size_t n, char *out) {
+    const __m128i non_ascii = _mm_set1_epi16(static_cast<short>(0xFF80));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 8));
+        if (!_mm_testz_si128(_mm_or_si128(a, b), non_ascii)) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(a, b));
+    }
+    for (; i < n && p[i] < 0x80; ++i) {
+        out[i] = static_cast<char>(p[i]);
+    }
+    return i;
+}
+
+ABEL_TARGET_SSE4 size_t sse4_utf32_ascii_to_utf8 (const char32_t *p, size_t n, char *out) {
+    const __m128i non_ascii = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 4));
+        if (!_mm_testz_si128(_mm_or_si128(a, b), non_ascii)) {
+            break;
+        }
+        const __m128i units = _mm_packus_epi32(a, b);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(units, units));
+    }
+    for (; i < n && p[i] < 0x80; ++i) {
+        out[i] = static_cast<char>(p[i]);
+    }
+    return i;
+}
+
+#undef ABEL_TARGET_SSE4
+
+const utf8_kernels kSse4Kernels = {
+    "sse4",
+    sse4_validate,
+    sse4_count_code_points,
+    sse4_count_utf16_units,
+    sse4_ascii_prefix,
+    sse4_utf8_to_wide<char16_t>,
+    sse4_utf8_to_wide<char32_t>,
+    sse4_utf16_ascii_to_utf8,
+    sse4_utf32_ascii_to_utf8,
+};
+
+}  // namespace
+
+const utf8_kernels *utf8_sse4_kernels () {
+    return &kSse4Kernels;
+}
+
+#else
+
+const utf8_kernels *utf8_sse4_kernels () {
+    return nullptr;
+}
+
+#endif  // ABEL_UTF8_HAVE_SSE4_KERNELS
+
+}  // namespace strings_internal
+
+}  // namespace abel
@@ -18,12 +18,17 @@
 #include <memory>
 #include <utility>
 
+#if ABEL_SSSE3
+#include <tmmintrin.h>
+#endif
+
 #include <abel/base/math.h>
 #include <abel/log/raw_logging.h>
 #include <abel/strings/ascii.h>
 #include <abel/strings/char_conv.h>
 #include <abel/strings/escaping.h>
 #include <abel/strings/internal/char_traits.h>
+#include <abel/strings/internal/charconv_pow10.h>
 #include <abel/strings/str_cat.h>
 #include <abel/strings/trim.h>
 #include <abel/strings/compare.h>
@@ -253,6 +258,219 @@ char* numbers_internal::fast_int_to_buffer(int64_t i, char* buffer) {
   return numbers_internal::fast_int_to_buffer(u, buffer);
 }
 
+// ----------------------------------------------------------------------
+// parse_int_column() and format_ints()
+//
+// Both work on eight digits per 64-bit word, one ASCII byte each with the
+// first character in the low byte, so the word tricks need a little-endian
+// target; elsewhere they fall back to a digit at a time and to
+// fast_int_to_buffer().
+// ----------------------------------------------------------------------
+
+namespace {
+
+
+#if defined(ABEL_SYSTEM_LITTLE_ENDIAN)
+
+const uint32_t kPowersOf10[9] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+};
+
+// The number of leading digits among the eight characters in `chunk`.
+ABEL_FORCE_INLINE int leading_digits(uint64_t chunk) {
+  // A byte is a digit when its high nibble is 3 both as it is and with 6
+  // added. Carries out of a byte that is not a digit only reach later ones.
+  const uint64_t not_digits =
+      ((chunk & 0xF0F0F0F0F0F0F0F0) |
+       (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ^
+      0x3333333333333333;
+  if (not_digits == 0) return 8;
+  return static_cast<int>(abel::count_trailing_zeros(not_digits) / 8);
+}
+
+// The value of the first `n` characters of `chunk`, all digits, 0 < n <= 8.
+ABEL_FORCE_INLINE uint64_t parse_digits(uint64_t chunk, int n) {
+  // Shifting the digits to the top leaves zeros in front of them; then
+  // neighbouring bytes, pairs and quads are combined with one multiply each.
+  chunk = (chunk << (8 * (8 - n))) & 0x0F0F0F0F0F0F0F0F;
+  chunk = (chunk * (10 * 256 + 1)) >> 8;
+  chunk = ((chunk & 0x00FF00FF00FF00FF) * (100 * 65536 + 1)) >> 16;
+  return ((chunk & 0x0000FFFF0000FFFF) * (10000 * (uint64_t{1} << 32) + 1)) >>
+         32;
+}
+
+// The eight digits of `u` < 10**8 as byte values 0 to 9, leading zeros
+// included.
+ABEL_FORCE_INLINE uint64_t eight_digits(uint32_t u) {
+  // The two halves of four digits go in 32-bit lanes, then each is split
+  // into two 16-bit lanes of two digits and those into bytes, dividing every
+  // lane at once by multiplying with a scaled reciprocal.
+  const uint64_t quads = (u / 10000) | (uint64_t{u % 10000} << 32);
+  const uint64_t high_pairs = ((quads * 10486) >> 20) & 0x0000007F0000007F;
+  const uint64_t pairs = ((quads - 100 * high_pairs) << 16) | high_pairs;
+  const uint64_t tens = ((pairs * 103) >> 10) & 0x000F000F000F000F;
+  return ((pairs - 10 * tens) << 8) | tens;
+}
+
+// Writes the digits of 0 < u < 10**8 without leading zeros: all eight are
+// stored and the zeros shifted out first.
+ABEL_FORCE_INLINE char* put_eight_digits_trimmed(uint32_t u, char* out) {
+  const uint64_t digits = eight_digits(u);
+  const int zeros = static_cast<int>(abel::count_trailing_zeros(digits) & ~7u);
+  const uint64_t chars = (digits | 0x3030303030303030) >> zeros;
+  memcpy(out, &chars, 8);
+  return out + 8 - zeros / 8;
+}
+
+ABEL_FORCE_INLINE char* put_eight_digits(uint32_t u, char* out) {
+  const uint64_t chars = eight_digits(u) | 0x3030303030303030;
+  memcpy(out, &chars, 8);
+  return out + 8;
+}
+
+#endif  // ABEL_SYSTEM_LITTLE_ENDIAN
+
+#if ABEL_SSSE3
+
+// Whether the 16 characters at `p` are all digits, and if so their value.
+ABEL_FORCE_INLINE bool parse_sixteen_digits(const char* p, uint64_t* value) {
+  const __m128i digits =
+      _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)),
+                   _mm_set1_epi8('0'));
+  const __m128i nine = _mm_set1_epi8(9);
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(digits, nine), nine)) !=
+      0xFFFF) {
+    return false;
+  }
+  // Pairs of digits, then of pairs, then of quads, as 16- and 32-bit lanes.
+  const __m128i pairs = _mm_maddubs_epi16(
+      digits, _mm_set_epi8(1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1,
+                           10));
+  const __m128i quads =
+      _mm_madd_epi16(pairs, _mm_set_epi16(1, 100, 1, 100, 1, 100, 1, 100));
+  const __m128i eights =
+      _mm_madd_epi16(_mm_packs_epi32(quads, quads),
+                     _mm_set_epi16(1, 10000, 1, 10000, 1, 10000, 1, 10000));
+  *value = static_cast<uint64_t>(_mm_cvtsi128_si32(eights)) * 100000000 +
+           static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(eights, 4)));
+  return true;
+}
+
+#endif  // ABEL_SSSE3
+
+// Writes 0 <= u < 10000 from the table of digit pairs.
+ABEL_FORCE_INLINE char* put_small(uint32_t u, char* out) {
+  if (u < 100) {
+    if (u < 10) {
+      *out = static_cast<char>('0' + u);
+      return out + 1;
+    }
+    numbers_internal::put_two_digits(u, out);
+    return out + 2;
+  }
+  const uint32_t high = u / 100;
+  if (high < 10) {
+    *out++ = static_cast<char>('0' + high);
+  } else {
+    numbers_internal::put_two_digits(high, out);
+    out += 2;
+  }
+  numbers_internal::put_two_digits(u - high * 100, out);
+  return out + 2;
+}
+
+ABEL_FORCE_INLINE char* put_decimal(uint64_t u, char* out) {
+  if (u < 10000) return put_small(static_cast<uint32_t>(u), out);
+#if defined(ABEL_SYSTEM_LITTLE_ENDIAN)
+  if (u < 100000000) {
+    return put_eight_digits_trimmed(static_cast<uint32_t>(u), out);
+  }
+  uint64_t high = u / 100000000;
+  const uint32_t low = static_cast<uint32_t>(u - high * 100000000);
+  if (high < 100000000) {
+    out = put_eight_digits_trimmed(static_cast<uint32_t>(high), out);
+  } else {
+    const uint32_t top = static_cast<uint32_t>(high / 100000000);
+    out = put_small(top, out);
+    out = put_eight_digits(static_cast<uint32_t>(high - top * uint64_t{100000000}),
+                           out);
+  }
+  return put_eight_digits(low, out);
+#else
+  return numbers_internal::fast_int_to_buffer(u, out);
+#endif
+}
+
+}  // namespace
+
+size_t parse_int_column(abel::string_view text, char delimiter,
+                        abel::Span<int64_t> out) {
+  if (text.empty()) return 0;
+  const char* p = text.data();
+  const char* const end = p + text.size();
+  size_t count = 0;
+  while (count < out.size()) {
+    const char* const field = p;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+      negative = *p == '-';
+      ++p;
+    }
+    const char* const digits = p;
+    uint64_t value = 0;
+#if ABEL_SSSE3
+    if (end - p >= 16 && parse_sixteen_digits(p, &value)) p += 16;
+#endif
+#if defined(ABEL_SYSTEM_LITTLE_ENDIAN)
+    while (end - p >= 8) {
+      uint64_t chunk;
+      memcpy(&chunk, p, 8);
+      const int n = leading_digits(chunk);
+      if (n == 0) break;
+      value = value * kPowersOf10[n] + parse_digits(chunk, n);
+      p += n;
+      if (n < 8) break;
+    }
+#endif
+    while (p != end && static_cast<unsigned char>(*p - '0') < 10) {
+      value = value * 10 + (*p - '0');
+      ++p;
+    }
+    // Up to 19 digits cannot have wrapped around.
+    const size_t num_digits = p - digits;
+    if (num_digits != 0 && num_digits <= 19 && (p == end || *p == delimiter) &&
+        value <= uint64_t{std::numeric_limits<int64_t>::max()} + negative) {
+      out[count++] = static_cast<int64_t>(negative ? 0 - value : value);
+    } else {
+      // Whitespace, more digits or something else: leave the field to
+      // simple_atoi().
+      p = static_cast<const char*>(memchr(field, delimiter, end - field));
+      if (p == nullptr) p = end;
+      if (!simple_atoi(abel::string_view(field, p - field), &out[count])) {
+        return count;
+      }
+      ++count;
+    }
+    if (p == end) break;
+    ++p;
+  }
+  return count;
+}
+
+char* format_ints(abel::Span<const int64_t> values, char delimiter,
+                  char* out) {
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (i != 0) *out++ = delimiter;
+    uint64_t u = values[i];
+    if (values[i] < 0) {
+      *out++ = '-';
+      u = 0 - u;
+    }
+    out = put_decimal(u, out);
+  }
+  return out;
+}
+
 // Given a 128-bit number expressed as a pair of uint64_t, high half first,
 // return that number multiplied by the given 32-bit value.  If the result is
 // too large to fit in a 128-bit number, divide it by 2 until it fits.
@@ -586,6 +804,204 @@ size_t numbers_internal::six_digits_to_buffer(double d, char* const buffer) {
   return out - buffer;
 }
 
+// ----------------------------------------------------------------------
+// fast_double_to_buffer() and fast_float_to_buffer()
+//
+// The shortest digits that read back as the same value are found with
+// Raffaello Giulietti's Schubfach algorithm: the value and the two ends of
+// the interval that rounds to it are scaled by a power of ten with one
+// 128-bit multiplication each, and the answer is either the shorter of the
+// two candidates that divide out to one digit fewer, or the closer of the
+// two around the value. Unlike Ryu or Grisu, no search or fallback is
+// needed. The power of ten comes from the table from_chars() uses.
+// ----------------------------------------------------------------------
+
+namespace {
+
+// digits * 10**exponent.
+struct decimal_fp {
+  uint64_t digits;
+  int exponent;
+};
+
+// The integer part of g * cp / 2**128, with its low bit set if the
+// fraction is not zero ("round to odd"). g is 10**-k scaled to 128 bits and
+// rounded up, which overstates the fraction by less than what the algorithm
+// needs to tell apart from zero.
+uint64_t round_to_odd(uint64_t g_hi, uint64_t g_lo, uint64_t cp) {
+  const abel::uint128 x = abel::uint128(g_lo) * cp;
+  const abel::uint128 y = abel::uint128(g_hi) * cp;
+  const uint64_t z = abel::Uint128Low64(y) + abel::Uint128High64(x);
+  const uint64_t integer =
+      abel::Uint128High64(y) + (z < abel::Uint128Low64(y) ? 1 : 0);
+  return integer | (z > 1 ? 1 : 0);
+}
+
+// The shortest decimal in the rounding interval of c * 2**q, a double or a
+// float with `c` its significand including the hidden bit (none for
+// subnormals), and the closest to it if there are several. The interval is
+// closed when c is even, as round-to-even then reads its ends back as c.
+decimal_fp shortest_decimal(uint64_t c, int q, bool lower_boundary_is_closer) {
+  using strings_internal::kPow10Table;
+  using strings_internal::kPow10TableMin;
+  const bool is_even = (c & 1) == 0;
+  // The value and the interval's ends, in units of 2**(q-2).
+  const uint64_t cbl = 4 * c - 2 + (lower_boundary_is_closer ? 1 : 0);
+  const uint64_t cb = 4 * c;
+  const uint64_t cbr = 4 * c + 2;
+
+  const int k = lower_boundary_is_closer
+                    ? strings_internal::FloorLog10ThreeQuartersPow2(q)
+                    : strings_internal::FloorLog10Pow2(q);
+  const int h = q + strings_internal::FloorLog2Pow10(-k) + 1;
+  const uint64_t* pow10 = kPow10Table[-k - kPow10TableMin];
+  // The table is truncated; round it up.
+  const uint64_t g_lo = pow10[1] + 1;
+  const uint64_t g_hi = pow10[0] + (g_lo == 0 ? 1 : 0);
+
+  const uint64_t vbl = round_to_odd(g_hi, g_lo, cbl << h);
+  const uint64_t vb = round_to_odd(g_hi, g_lo, cb << h);
+  const uint64_t vbr = round_to_odd(g_hi, g_lo, cbr << h);
+  const uint64_t lower = vbl + (is_even ? 0 : 1);
+  const uint64_t upper = vbr - (is_even ? 0 : 1);
+
+  // One digit fewer, if one of its two candidates is in the interval.
+  const uint64_t s = vb / 4;
+  if (s >= 10) {
+    const uint64_t sp = s / 10;
+    const bool up_inside = lower <= 40 * sp;
+    const bool wp_inside = 40 * sp + 40 <= upper;
+    if (up_inside != wp_inside) {
+      return {sp + (wp_inside ? 1 : 0), k + 1};
+    }
+  }
+  // Otherwise s or s + 1, whichever is inside, or closer if both are.
+  const bool u_inside = lower <= 4 * s;
+  const bool w_inside = 4 * s + 4 <= upper;
+  if (u_inside != w_inside) {
+    return {s + (w_inside ? 1 : 0), k};
+  }
+  const uint64_t mid = 4 * s + 2;
+  const bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+  return {s + (round_up ? 1 : 0), k};
+}
+
+// Splits the finite, nonzero `bits` of a float type with `mantissa_bits`
+// stored significand bits and exponent `bias` into its shortest decimal,
+// without trailing zeros.
+decimal_fp to_shortest(uint64_t bits, int mantissa_bits, int bias) {
+  const uint64_t fraction = bits & ((uint64_t{1} << mantissa_bits) - 1);
+  const int biased_exponent = static_cast<int>(bits >> mantissa_bits);
+  decimal_fp result;
+  if (biased_exponent == 0) {
+    result = shortest_decimal(fraction, 1 - bias - mantissa_bits, false);
+  } else {
+    const uint64_t c = fraction | (uint64_t{1} << mantissa_bits);
+    const int q = biased_exponent - bias - mantissa_bits;
+    if (q <= 0 && q > -mantissa_bits - 1 &&
+        (c & ((uint64_t{1} << -q) - 1)) == 0) {
+      // An integer that fits in the significand is its own shortest form.
+      result = {c >> -q, 0};
+    } else {
+      result = shortest_decimal(c, q, fraction == 0 && biased_exponent > 1);
+    }
+  }
+  while (result.digits % 10 == 0) {
+    result.digits /= 10;
+    ++result.exponent;
+  }
+  return result;
+}
+
+// Writes `value` like printf's "%.<precision>g" would with just enough
+// digits: plain notation for decimal exponents from -5 to precision - 1,
+// scientific otherwise.
+char* format_shortest(bool negative, decimal_fp value, int precision,
+                      char* out) {
+  char digits[numbers_internal::kFastToBufferSize];
+  const int n = static_cast<int>(
+      numbers_internal::fast_int_to_buffer(value.digits, digits) - digits);
+  const int x = value.exponent + n - 1;  // of the first digit
+  if (negative) *out++ = '-';
+  if (x < -4 || x >= precision) {
+    *out++ = digits[0];
+    if (n > 1) {
+      *out++ = '.';
+      memcpy(out, digits + 1, n - 1);
+      out += n - 1;
+    }
+    *out++ = 'e';
+    int e = x;
+    if (e < 0) {
+      *out++ = '-';
+      e = -e;
+    } else {
+      *out++ = '+';
+    }
+    if (e >= 100) {
+      *out++ = '0' + e / 100;
+      e %= 100;
+    }
+    numbers_internal::put_two_digits(e, out);
+    out += 2;
+  } else if (x < 0) {
+    *out++ = '0';
+    *out++ = '.';
+    memset(out, '0', -x - 1);
+    out += -x - 1;
+    memcpy(out, digits, n);
+    out += n;
+  } else if (x >= n - 1) {
+    memcpy(out, digits, n);
+    out += n;
+    memset(out, '0', x - n + 1);
+    out += x - n + 1;
+  } else {
+    memcpy(out, digits, x + 1);
+    out += x + 1;
+    *out++ = '.';
+    memcpy(out, digits + x + 1, n - x - 1);
+    out += n - x - 1;
+  }
+  *out = '\0';
+  return out;
+}
+
+// inf, nan and zero, which need no digits.
+char* format_special(bool negative, bool zero, bool infinite, char* out) {
+  if (negative) *out++ = '-';
+  const char* text = zero ? "0" : infinite ? "inf" : "nan";
+  const size_t len = strlen(text);
+  memcpy(out, text, len + 1);
+  return out + len;
+}
+
+}  // namespace
+
+char* numbers_internal::fast_double_to_buffer(double d, char* buffer) {
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(bits));
+  const bool negative = (bits >> 63) != 0;
+  bits &= ~(uint64_t{1} << 63);
+  const uint64_t kExponentMask = uint64_t{0x7FF} << 52;
+  if (bits == 0 || (bits & kExponentMask) == kExponentMask) {
+    return format_special(negative, bits == 0, bits == kExponentMask, buffer);
+  }
+  return format_shortest(negative, to_shortest(bits, 52, 1023), 17, buffer);
+}
+
+char* numbers_internal::fast_float_to_buffer(float f, char* buffer) {
+  uint32_t bits;
+  memcpy(&bits, &f, sizeof(bits));
+  const bool negative = (bits >> 31) != 0;
+  bits &= ~(uint32_t{1} << 31);
+  const uint32_t kExponentMask = uint32_t{0xFF} << 23;
+  if (bits == 0 || (bits & kExponentMask) == kExponentMask) {
+    return format_special(negative, bits == 0, bits == kExponentMask, buffer);
+  }
+  return format_shortest(negative, to_shortest(bits, 23, 127), 9, buffer);
+}
+
 namespace {
 // Represents integer values of digits.
 // Uses 36 to indicate an invalid character since we support
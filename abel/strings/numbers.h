@@ -35,6 +35,7 @@
 #include <abel/base/profile.h>
 #include <abel/numeric/int128.h>
 #include <abel/strings/string_view.h>
+#include <abel/types/span.h>
 
 namespace abel {
 
@@ -82,6 +83,34 @@ ABEL_MUST_USE_RESULT bool simple_atod(abel::string_view str, double* out);
 // unspecified state.
 ABEL_MUST_USE_RESULT bool simple_atob(abel::string_view str, bool* out);
 
+// parse_int_column()
+//
+// Parses `text`, base-10 integers separated by `delimiter` such as a CSV
+// column or the values of a metrics line, into `out` and returns how many
+// were stored. Each field is read as `simple_atoi()` would read it, but plain
+// runs of digits are converted 8 or 16 at a time rather than one by one.
+// Parsing stops at the first field that is not a valid `int64_t`, or once
+// `out` is full; a column parsed to the end stores all of its fields. An
+// empty `text` has none.
+//
+// Example:
+//
+//   int64_t values[8];
+//   size_t n = abel::parse_int_column("17,-3,1577836800000000000", ',',
+//                                     abel::MakeSpan(values));  // n == 3
+size_t parse_int_column(abel::string_view text, char delimiter,
+                        abel::Span<int64_t> out);
+
+// format_ints()
+//
+// Writes `values` in base 10 to `out`, separated by `delimiter` (with none
+// after the last), and returns a pointer one past the last character. Values
+// of up to eight digits are emitted in a single store, so `out` must have
+// room for `kFormatIntsBytesPerValue` bytes per value; bytes past the
+// returned pointer may have been overwritten. Nothing is NUL-terminated.
+static const int kFormatIntsBytesPerValue = 28;
+char* format_ints(abel::Span<const int64_t> values, char delimiter, char* out);
+
 
 }  // namespace abel
 
@@ -126,6 +155,16 @@ static const int kSixDigitsToBufferSize = 16;
 // Required buffer size is `kSixDigitsToBufferSize`.
 size_t six_digits_to_buffer(double d, char* buffer);
 
+// Formats `d` or `f` with the fewest significant digits that parse back to
+// exactly the same value, like "%.17g" and "%.9g" otherwise would: plain
+// notation for decimal exponents from -5 to 16 (8 for floats), scientific
+// beyond, with trailing zeros removed. So 0.1 is "0.1", 1e21 is "1e+21" and
+// the largest double is "1.7976931348623157e+308". Infinities and NaNs are
+// "inf", "-inf", "nan" and "-nan". Returns a pointer to the terminating
+// '\0'; at most `kFastToBufferSize` bytes are written.
+char* fast_double_to_buffer(double d, char* buffer);
+char* fast_float_to_buffer(float f, char* buffer);
+
 // These functions are intended for speed. All functions take an output buffer
 // as an argument and return a pointer to the last byte they wrote, which is the
 // terminating '\0'. At most `kFastToBufferSize` bytes are written.
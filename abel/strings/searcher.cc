@@ -0,0 +1,42 @@
+//
+
+#include <abel/strings/searcher.h>
+
+#include <cstring>
+
+namespace abel {
+
+searcher::searcher (abel::string_view needle) : _needle(needle), _two_way() {
+    if (needle.size() > strings_internal::kShortNeedle) {
+        _two_way.init(needle.data(), needle.size());
+    }
+}
+
+size_t searcher::find (abel::string_view haystack, size_t pos) const {
+    if (pos > haystack.size()) {
+        return abel::string_view::npos;
+    }
+    const char *h = haystack.data() + pos;
+    const size_t hl = haystack.size() - pos;
+    const size_t m = _needle.size();
+    const char *found;
+    if (m == 0) {
+        found = h;
+    } else if (m > hl) {
+        found = nullptr;
+    } else if (m == 1) {
+        found = static_cast<const char *>(memchr(h, _needle[0], hl));
+    } else if (m <= strings_internal::kShortNeedle) {
+        const char *resume;
+        found = strings_internal::filter_search(h, hl, _needle.data(), m, false, &resume);
+    } else {
+        const char *resume;
+        found = strings_internal::filter_search(h, hl, _needle.data(), m, true, &resume);
+        if (found == nullptr && resume != h + hl) {
+            found = _two_way.search(resume, h + hl - resume);
+        }
+    }
+    return found == nullptr ? abel::string_view::npos : found - haystack.data();
+}
+
+}  // namespace abel
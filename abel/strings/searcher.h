@@ -0,0 +1,50 @@
+//
+
+#ifndef ABEL_STRINGS_SEARCHER_H_
+#define ABEL_STRINGS_SEARCHER_H_
+
+#include <cstddef>
+
+#include <abel/base/profile.h>
+#include <abel/strings/internal/string_search.h>
+#include <abel/strings/string_view.h>
+
+namespace abel {
+
+// abel::searcher
+//
+// Looks for one needle in many haystacks, doing the needle's preprocessing
+// once rather than on every call:
+//
+//   const abel::searcher marker("-----BEGIN CERTIFICATE-----");
+//   for (abel::string_view file : files) {
+//       size_t at = marker.find(file);
+//       ...
+//   }
+//
+// Finds the same positions as abel::string_view::find(), and as quickly on
+// short needles, which need no preprocessing. On long ones it also keeps the
+// linear worst case of the Two-Way algorithm without building its tables
+// each time. The needle is not copied and must outlive the searcher.
+class searcher {
+  public:
+    explicit searcher (abel::string_view needle);
+
+    // The offset of the first occurrence of the needle in `haystack` at or
+    // after `pos`, or abel::string_view::npos. An empty needle is found at
+    // `pos` as long as that is no further than the end of `haystack`.
+    size_t find (abel::string_view haystack, size_t pos = 0) const;
+
+    abel::string_view needle () const {
+        return _needle;
+    }
+
+  private:
+    abel::string_view _needle;
+    // Only set up for needles longer than strings_internal::kShortNeedle.
+    strings_internal::two_way_needle _two_way;
+};
+
+}  // namespace abel
+
+#endif  // ABEL_STRINGS_SEARCHER_H_
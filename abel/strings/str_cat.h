@@ -47,6 +47,7 @@
 #include <vector>
 #include <abel/base/profile.h>
 #include <abel/strings/numbers.h>
+#include <abel/strings/string_sink.h>
 #include <abel/strings/string_view.h>
 
 namespace abel {
@@ -377,6 +378,28 @@ ABEL_FORCE_INLINE void string_append(std::string* dest, const alpha_num& a, cons
              static_cast<const alpha_num&>(args).Piece()...});
 }
 
+// string_cat_to()
+//
+// Appends the concatenation of the arguments to `sink`, which may be a
+// `std::string`, a `fmt::memory_buffer`, an `abel::char_array_sink` or any
+// other target `abel::string_sink` accepts (see string_sink.h). Nothing is
+// allocated beyond what the target itself needs to grow, so reusing one
+// buffer across calls allocates nothing in the steady state. As with
+// `string_append()`, no argument may refer into the target.
+//
+// Example:
+//
+//   char buf[64];
+//   abel::char_array_sink out(buf);
+//   abel::string_cat_to(out, "shard ", id, " lagging by ", lag_ms, "ms");
+ABEL_FORCE_INLINE void string_cat_to(string_sink) {}
+
+template <typename... AV>
+ABEL_FORCE_INLINE void string_cat_to(string_sink sink, const alpha_num& a,
+                                     const AV&... args) {
+  sink.append({a.Piece(), static_cast<const alpha_num&>(args).Piece()...});
+}
+
 // Helper function for the future string_cat default floating-point format, %.6g
 // This is fast.
 ABEL_FORCE_INLINE strings_internal::alpha_num_buffer<
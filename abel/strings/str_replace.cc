@@ -2,6 +2,9 @@
 
 #include <abel/strings/str_replace.h>
 
+#include <algorithm>
+#include <cstring>
+
 #include <abel/strings/str_cat.h>
 
 namespace abel {
@@ -48,6 +51,272 @@ int apply_substitutions(
 
 }  // namespace strings_internal
 
+namespace {
+
+// The dense table is used up to this many entries (4 MiB).
+constexpr size_t kMaxDenseEntries = size_t{1} << 20;
+
+// Set on dense table entries for states where a pattern ends.
+constexpr uint32_t kMatchFlag = uint32_t{1} << 31;
+
+// Patterns starting with up to this many distinct bytes are skipped to with
+// a delimiter_set, which classifies these exactly a block at a time.
+constexpr size_t kMaxSkipStarts = 8;
+
+// How string_replacer::scan() moves between states, and tells which ones to
+// stop at, for each of the two representations.
+struct dense_steps {
+  const uint32_t* table;
+  const uint16_t* classes;
+  uint32_t shift;
+
+  uint32_t next(uint32_t id, uint8_t c) const {
+    return table[(id & ~kMatchFlag) + classes[c]];
+  }
+  bool matched(uint32_t id) const { return (id & kMatchFlag) != 0; }
+  uint32_t state(uint32_t id) const { return (id & ~kMatchFlag) >> shift; }
+};
+
+struct sparse_steps {
+  const uint32_t* root;
+  const uint32_t* edge_begin;
+  const uint8_t* edge_byte;
+  const uint32_t* edge_target;
+  const uint32_t* fail;
+  const int32_t* match;
+
+  uint32_t next(uint32_t state, uint8_t c) const {
+    for (;;) {
+      if (state == 0) return root[c];
+      for (uint32_t e = edge_begin[state]; e != edge_begin[state + 1]; ++e) {
+        if (edge_byte[e] == c) return edge_target[e];
+      }
+      state = fail[state];
+    }
+  }
+  bool matched(uint32_t state) const { return match[state] >= 0; }
+  uint32_t state(uint32_t state) const { return state; }
+};
+
+}  // namespace
+
+string_replacer::string_replacer(
+    std::initializer_list<std::pair<abel::string_view, abel::string_view>>
+        replacements)
+    : starts_(abel::string_view()) {
+  build(std::vector<std::pair<abel::string_view, abel::string_view>>(
+      replacements.begin(), replacements.end()));
+}
+
+void string_replacer::build(
+    const std::vector<std::pair<abel::string_view, abel::string_view>>&
+        replacements) {
+  // The trie, with the children of each state in a list of its own while it
+  // is being built.
+  size_t max_states = 1;
+  for (const auto& rep : replacements) max_states += rep.first.size();
+  std::vector<std::vector<std::pair<uint8_t, uint32_t>>> children(1);
+  children.reserve(max_states);
+  match_.reserve(max_states);
+  depth_.reserve(max_states);
+  match_.assign(1, -1);
+  depth_.assign(1, 0);
+  entries_.reserve(replacements.size());
+  auto child = [&children](uint32_t state, uint8_t c) -> uint32_t {
+    for (const auto& edge : children[state]) {
+      if (edge.first == c) return edge.second;
+    }
+    return 0;
+  };
+  for (const auto& rep : replacements) {
+    const abel::string_view old = rep.first;
+    if (old.empty()) continue;
+    uint32_t state = 0;
+    for (char ch : old) {
+      const uint8_t c = static_cast<uint8_t>(ch);
+      uint32_t next = child(state, c);
+      if (next == 0) {
+        next = static_cast<uint32_t>(children.size());
+        children[state].emplace_back(c, next);
+        children.emplace_back();
+        match_.push_back(-1);
+        depth_.push_back(depth_[state] + 1);
+      }
+      state = next;
+    }
+    // A repeated pattern keeps its first replacement, as in
+    // string_replace_all().
+    if (match_[state] >= 0) continue;
+    match_[state] = static_cast<int32_t>(entries_.size());
+    entries_.push_back(entry());
+    entry& e = entries_.back();
+    e.replacement_offset = text_.size();
+    e.replacement_size = static_cast<uint32_t>(rep.second.size());
+    e.old_size = static_cast<uint32_t>(old.size());
+    text_.append(rep.second.data(), rep.second.size());
+  }
+
+  std::string starts;
+  for (const auto& edge : children[0]) starts.push_back(static_cast<char>(edge.first));
+  skip_to_starts_ = !starts.empty() && starts.size() <= kMaxSkipStarts;
+  if (skip_to_starts_) starts_ = strings_internal::delimiter_set(starts);
+
+  // Failure links, breadth first so that a state's link is done before its
+  // children's. A state with no pattern of its own takes the longest one
+  // that is a suffix of it from its link.
+  const size_t num_states = children.size();
+  std::vector<uint32_t> order;
+  order.reserve(num_states);
+  fail_.assign(num_states, 0);
+  for (const auto& edge : children[0]) order.push_back(edge.second);
+  for (size_t i = 0; i < order.size(); ++i) {
+    const uint32_t state = order[i];
+    for (const auto& edge : children[state]) {
+      uint32_t f = fail_[state];
+      while (f != 0 && child(f, edge.first) == 0) f = fail_[f];
+      fail_[edge.second] = child(f, edge.first);
+      if (match_[edge.second] < 0) {
+        match_[edge.second] = match_[fail_[edge.second]];
+      }
+      order.push_back(edge.second);
+    }
+  }
+
+  // Bytes that start no edge all behave alike and share class 0.
+  memset(classes_, 0, sizeof(classes_));
+  uint32_t num_classes = 1;
+  for (const auto& edges : children) {
+    for (const auto& edge : edges) {
+      if (classes_[edge.first] == 0) {
+        classes_[edge.first] = static_cast<uint16_t>(num_classes++);
+      }
+    }
+  }
+  class_shift_ = 0;
+  while ((uint32_t{1} << class_shift_) < num_classes) ++class_shift_;
+
+  if ((num_states << class_shift_) <= kMaxDenseEntries) {
+    // Built with plain state numbers, which are shifted and flagged at the
+    // end.
+    const uint32_t width = uint32_t{1} << class_shift_;
+    dense_.assign(num_states << class_shift_, 0);
+    for (const auto& edge : children[0]) {
+      dense_[classes_[edge.first]] = edge.second;
+    }
+    for (uint32_t state : order) {
+      uint32_t* row = &dense_[state << class_shift_];
+      std::copy_n(&dense_[fail_[state] << class_shift_], width, row);
+      for (const auto& edge : children[state]) {
+        row[classes_[edge.first]] = edge.second;
+      }
+    }
+    for (uint32_t& next : dense_) {
+      next = (next << class_shift_) | (match_[next] >= 0 ? kMatchFlag : 0);
+    }
+    fail_.clear();
+    return;
+  }
+
+  root_.assign(256, 0);
+  for (const auto& edge : children[0]) root_[edge.first] = edge.second;
+  edge_begin_.reserve(num_states + 1);
+  edge_byte_.reserve(num_states);
+  edge_target_.reserve(num_states);
+  for (const auto& edges : children) {
+    edge_begin_.push_back(static_cast<uint32_t>(edge_byte_.size()));
+    for (const auto& edge : edges) {
+      edge_byte_.push_back(edge.first);
+      edge_target_.push_back(edge.second);
+    }
+  }
+  edge_begin_.push_back(static_cast<uint32_t>(edge_byte_.size()));
+}
+
+// Finds the leftmost match, and the longest of those starting there, like
+// string_replace_all(). A match is only final once no partial match that
+// began at or before it is still going, which is when the state (the
+// longest suffix of the text read that a pattern starts with) begins after
+// it. Scanning then restarts right after the match, going over again what
+// was read past it.
+template <typename Steps>
+int string_replacer::scan(abel::string_view s, std::string* out,
+                          const Steps& steps) const {
+  const char* p = s.data();
+  const size_t n = s.size();
+  int substitutions = 0;
+  size_t copied = 0;
+  size_t i = 0;
+  uint32_t id = 0;
+  int32_t best = -1;
+  size_t best_start = 0;
+  for (;;) {
+    if (i < n) {
+      if (best < 0) {
+        if (id == 0 && skip_to_starts_) {
+          i = starts_.find(s, i);
+          if (i == abel::string_view::npos) {
+            i = n;
+            continue;
+          }
+        }
+        id = steps.next(id, static_cast<uint8_t>(p[i++]));
+        if (!steps.matched(id)) continue;
+      } else {
+        id = steps.next(id, static_cast<uint8_t>(p[i++]));
+      }
+      const uint32_t state = steps.state(id);
+      const int32_t m = match_[state];
+      if (m >= 0) {
+        const size_t start = i - entries_[m].old_size;
+        if (best < 0 || start <= best_start) {
+          best = m;
+          best_start = start;
+        }
+      }
+      if (i - depth_[state] <= best_start) continue;
+    } else if (best < 0) {
+      break;
+    }
+    const entry& e = entries_[best];
+    out->append(p + copied, best_start - copied);
+    out->append(text_, e.replacement_offset, e.replacement_size);
+    ++substitutions;
+    copied = i = best_start + e.old_size;
+    id = 0;
+    best = -1;
+  }
+  out->append(p + copied, n - copied);
+  return substitutions;
+}
+
+int string_replacer::replace_all(abel::string_view s, std::string* out) const {
+  if (entries_.empty()) {
+    out->append(s.data(), s.size());
+    return 0;
+  }
+  if (!dense_.empty()) {
+    return scan(s, out, dense_steps{dense_.data(), classes_, class_shift_});
+  }
+  return scan(s, out,
+              sparse_steps{root_.data(), edge_begin_.data(), edge_byte_.data(),
+                           edge_target_.data(), fail_.data(), match_.data()});
+}
+
+std::string string_replacer::replace_all(abel::string_view s) const {
+  std::string result;
+  result.reserve(s.size());
+  replace_all(s, &result);
+  return result;
+}
+
+int string_replacer::replace_all(std::string* target) const {
+  std::string result;
+  result.reserve(target->size());
+  const int substitutions = replace_all(*target, &result);
+  if (substitutions != 0) target->swap(result);
+  return substitutions;
+}
+
 // We can implement this in terms of the generic string_replace_all, but
 // we must specify the template overload because C++ cannot deduce the type
 // of an initializer_list parameter to a function, and also if we don't specify
@@ -25,11 +25,13 @@
 #ifndef ABEL_STRINGS_STR_REPLACE_H_
 #define ABEL_STRINGS_STR_REPLACE_H_
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include <abel/base/profile.h>
+#include <abel/strings/internal/delimiter_set.h>
 #include <abel/strings/string_view.h>
 
 namespace abel {
@@ -42,7 +44,8 @@ namespace abel {
 // considered in order as they occur within the string, with earlier matches
 // taking precedence, and longer matches taking precedence for candidates
 // starting at the same position in the string. Once a substitution is made, the
-// replaced text is not considered for any further substitutions.
+// replaced text is not considered for any further substitutions. If a pattern
+// appears more than once, its first replacement is used.
 //
 // Example:
 //
@@ -117,9 +120,102 @@ int string_replace_all(
 template <typename StrToStrMapping>
 int string_replace_all(const StrToStrMapping& replacements, std::string* target);
 
+// string_replacer
+//
+// A set of replacements compiled once into an Aho-Corasick automaton, for
+// applying the same replacements to many strings. The result is the same as
+// string_replace_all() with the same replacements, but every string is
+// scanned once whatever the number of patterns, where string_replace_all()
+// searches for each pattern in turn. That makes it the better choice for
+// large sets (sanitizers, template variables), and string_replace_all() uses
+// one itself for more than strings_internal::kReplacerThreshold of them.
+//
+// The replacer keeps its own copy of the patterns and replacements. Empty
+// patterns are ignored; if a pattern appears more than once, the first of its
+// replacements is used, as string_replace_all() does.
+//
+// Example:
+//
+//   const abel::string_replacer escape_html({{"&", "&amp;"},
+//                                           {"<", "&lt;"},
+//                                           {">", "&gt;"}});
+//   for (std::string& line : lines) {
+//     escape_html.replace_all(&line);
+//   }
+class string_replacer {
+ public:
+  string_replacer(
+      std::initializer_list<std::pair<abel::string_view, abel::string_view>>
+          replacements);
+
+  template <typename StrToStrMapping>
+  explicit string_replacer(const StrToStrMapping& replacements);
+
+  // Returns `s` with the replacements made.
+  ABEL_MUST_USE_RESULT std::string replace_all(abel::string_view s) const;
+
+  // Appends `s` with the replacements made to `*out`, returning the number
+  // of substitutions that occurred.
+  int replace_all(abel::string_view s, std::string* out) const;
+
+  // Makes the replacements in `*target` in place, returning the number of
+  // substitutions that occurred.
+  int replace_all(std::string* target) const;
+
+  // The number of distinct, non-empty patterns.
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct entry {
+    size_t replacement_offset;  // into text_
+    uint32_t replacement_size;
+    uint32_t old_size;
+  };
+
+  void build(const std::vector<std::pair<abel::string_view, abel::string_view>>&
+                 replacements);
+
+  template <typename Steps>
+  int scan(abel::string_view s, std::string* out, const Steps& steps) const;
+
+  // The replacements, back to back.
+  std::string text_;
+  std::vector<entry> entries_;
+
+  // Per state: the longest pattern that ends there (an index into
+  // entries_, or -1), and the length of the text it stands for.
+  std::vector<int32_t> match_;
+  std::vector<uint32_t> depth_;
+
+  // With few enough states and byte classes, every transition is in one
+  // table: dense_[(state << class_shift_) + classes_[byte]] is the next state,
+  // shifted the same way and flagged if a pattern ends there. Otherwise the
+  // trie edges of each state are edge_byte_/edge_target_[edge_begin_[state],
+  // edge_begin_[state + 1]), followed with fail_ links, and root_ holds the
+  // root's transitions for every byte.
+  uint16_t classes_[256];
+  uint32_t class_shift_;
+  std::vector<uint32_t> dense_;
+  std::vector<uint32_t> edge_begin_;
+  std::vector<uint8_t> edge_byte_;
+  std::vector<uint32_t> edge_target_;
+  std::vector<uint32_t> fail_;
+  std::vector<uint32_t> root_;
+
+  // The bytes that patterns start with, for skipping a block at a time to
+  // the next one from the root when there are few of them.
+  strings_internal::delimiter_set starts_;
+  bool skip_to_starts_;
+};
+
 // Implementation details only, past this point.
 namespace strings_internal {
 
+// string_replace_all() compiles a string_replacer for more replacements
+// than this; below it, searching for each one in turn is cheaper than
+// building the automaton.
+constexpr size_t kReplacerThreshold = 16;
+
 struct viable_substitution {
   abel::string_view old;
   abel::string_view replacement;
@@ -159,6 +255,16 @@ std::vector<viable_substitution> find_substitutions(
     // now and not before.
     if (old.empty()) continue;
 
+    // A repeated pattern keeps its first replacement.
+    bool repeated = false;
+    for (const viable_substitution& sub : subs) {
+      if (sub.old == old) {
+        repeated = true;
+        break;
+      }
+    }
+    if (repeated) continue;
+
     subs.emplace_back(old, get<1>(rep), pos);
 
     // Insertion sort to ensure the last viable_substitution comes before
@@ -177,9 +283,24 @@ int apply_substitutions(abel::string_view s,
 
 }  // namespace strings_internal
 
+template <typename StrToStrMapping>
+string_replacer::string_replacer(const StrToStrMapping& replacements)
+    : starts_(abel::string_view()) {
+  std::vector<std::pair<abel::string_view, abel::string_view>> pairs;
+  pairs.reserve(replacements.size());
+  for (const auto& rep : replacements) {
+    using std::get;
+    pairs.emplace_back(get<0>(rep), get<1>(rep));
+  }
+  build(pairs);
+}
+
 template <typename StrToStrMapping>
 std::string string_replace_all(abel::string_view s,
                           const StrToStrMapping& replacements) {
+  if (replacements.size() > strings_internal::kReplacerThreshold) {
+    return string_replacer(replacements).replace_all(s);
+  }
   auto subs = strings_internal::find_substitutions(s, replacements);
   std::string result;
   result.reserve(s.size());
@@ -189,6 +310,9 @@ std::string string_replace_all(abel::string_view s,
 
 template <typename StrToStrMapping>
 int string_replace_all(const StrToStrMapping& replacements, std::string* target) {
+  if (replacements.size() > strings_internal::kReplacerThreshold) {
+    return string_replacer(replacements).replace_all(target);
+  }
   auto subs = strings_internal::find_substitutions(*target, replacements);
   if (subs.empty()) return 0;
 
@@ -98,10 +98,17 @@ abel::string_view ByChar::Find(abel::string_view text, size_t pos) const {
 // by_any_char
 //
 
-by_any_char::by_any_char(abel::string_view sp) : delimiters_(sp) {}
+by_any_char::by_any_char(abel::string_view sp)
+    : delimiters_(sp), set_(sp) {}
 
 abel::string_view by_any_char::Find(abel::string_view text, size_t pos) const {
-  return GenericFind(text, delimiters_, pos, AnyOfPolicy());
+  if (delimiters_.empty()) {
+    return GenericFind(text, delimiters_, pos, AnyOfPolicy());
+  }
+  size_t found_pos = set_.find(text, pos);
+  if (found_pos == abel::string_view::npos)
+    return abel::string_view(text.data() + text.size(), 0);
+  return text.substr(found_pos, 1);
 }
 
 //
@@ -123,5 +130,25 @@ abel::string_view  by_length::Find(abel::string_view text,
   return abel::string_view(substr.data() + length_, 0);
 }
 
+namespace strings_internal {
+
+size_t split_into_impl(abel::string_view text, const ByChar& d,
+                       abel::Span<abel::string_view> out) {
+  if (text.data() == nullptr || out.empty()) return 0;
+  const char c = d.delimiter();
+  return delimiter_set(abel::string_view(&c, 1))
+      .split(text, out.data(), out.size());
+}
+
+size_t split_into_impl(abel::string_view text, const by_any_char& d,
+                       abel::Span<abel::string_view> out) {
+  if (d.empty()) {
+    return split_into_impl<by_any_char>(text, d, out);
+  }
+  if (text.data() == nullptr || out.empty()) return 0;
+  return d.delimiters().split(text, out.data(), out.size());
+}
+
+}  // namespace strings_internal
 
 }  // namespace abel
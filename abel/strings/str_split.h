@@ -31,10 +31,12 @@
 #include <vector>
 
 #include <abel/log/raw_logging.h>
+#include <abel/strings/internal/delimiter_set.h>
 #include <abel/strings/internal/str_split_internal.h>
 #include <abel/strings/string_view.h>
 #include <abel/strings/strip.h>
 #include <abel/strings/trim.h>
+#include <abel/types/span.h>
 
 namespace abel {
 
@@ -145,6 +147,8 @@ class ByChar {
   explicit ByChar(char c) : c_(c) {}
   abel::string_view Find(abel::string_view text, size_t pos) const;
 
+  char delimiter() const { return c_; }
+
  private:
   char c_;
 };
@@ -166,13 +170,20 @@ class ByChar {
 // If `by_any_char` is given the empty string, it behaves exactly like
 // `by_string` and matches each individual character in the input string.
 //
+// The text is scanned a vector register at a time, with every delimiter of
+// a block found by one nibble lookup, so the cost does not grow with the
+// number of delimiters.
 class by_any_char {
  public:
   explicit by_any_char(abel::string_view sp);
   abel::string_view Find(abel::string_view text, size_t pos) const;
 
+  const strings_internal::delimiter_set& delimiters() const { return set_; }
+  bool empty() const { return delimiters_.empty(); }
+
  private:
   const std::string delimiters_;
+  strings_internal::delimiter_set set_;
 };
 
 //  by_length
@@ -261,6 +272,34 @@ class  max_splits_impl {
   int count_;
 };
 
+// Fills `out` from `d.Find()` the way Splitter iterates, with the last slot
+// taking the rest of `text` once the others are used up.
+template <typename Delimiter>
+size_t split_into_impl(abel::string_view text, Delimiter d,
+                       abel::Span<abel::string_view> out) {
+  if (text.data() == nullptr || out.empty()) return 0;
+  size_t used = 0;
+  size_t pos = 0;
+  for (;;) {
+    if (used + 1 == out.size()) {
+      out[used++] = text.substr(pos);
+      return used;
+    }
+    const abel::string_view found = d.Find(text, pos);
+    const size_t end = found.data() - text.data();
+    out[used++] = text.substr(pos, end - pos);
+    if (end == text.size()) return used;
+    pos = end + found.size();
+  }
+}
+
+// The block-at-a-time delimiters, which find a whole block of delimiters per
+// lookup rather than one per Find() call.
+size_t split_into_impl(abel::string_view text, const ByChar& d,
+                       abel::Span<abel::string_view> out);
+size_t split_into_impl(abel::string_view text, const by_any_char& d,
+                       abel::Span<abel::string_view> out);
+
 }  // namespace strings_internal
 
 //  max_splits()
@@ -495,6 +534,29 @@ strings_internal::Splitter<
       std::move(text), DelimiterType(d), std::move(p));
 }
 
+//  split_into()
+//
+// Splits `text` like `string_split()` with no predicate, but into the
+// caller's array rather than a container, without allocating. Returns the
+// number of elements of `out` filled. If `text` has more pieces than `out`
+// has room for, the last element holds the unsplit rest of `text`, as with
+// `max_splits(d, out.size() - 1)`.
+//
+// Example:
+//
+//   abel::string_view fields[8];
+//   size_t n = abel::split_into("ts=1\tlevel=info\tmsg=hi", '\t', fields);
+//   // n == 3, fields[0] == "ts=1", fields[1] == "level=info", ...
+//
+// `ByChar` and `by_any_char` scan the text a block at a time; other delimiters
+// go through their `Find()`.
+template <typename Delimiter>
+size_t split_into(abel::string_view text, Delimiter d,
+                  abel::Span<abel::string_view> out) {
+  using DelimiterType =
+      typename strings_internal::select_delimiter<Delimiter>::type;
+  return strings_internal::split_into_impl(text, DelimiterType(d), out);
+}
 
 }  // namespace abel
 
@@ -0,0 +1,181 @@
+//
+
+#include <abel/strings/string_pool.h>
+
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include <abel/hash/hash.h>
+#include <abel/log/raw_logging.h>
+
+namespace abel {
+
+namespace strings_internal {
+
+const empty_interned_entry kEmptyInternedEntry = {{0, 0, 0}, '\0'};
+
+}  // namespace strings_internal
+
+namespace {
+
+using strings_internal::interned_entry;
+
+constexpr size_t kInitialCapacity = 1024;
+// Strings are carved from blocks of this size; longer ones get a block each.
+constexpr size_t kBlockSize = 64 << 10;
+constexpr size_t kMaxSharedBlockEntry = kBlockSize / 8;
+
+size_t entry_bytes(size_t size) {
+  // The header, the bytes and their '\0', rounded up to keep headers aligned.
+  const size_t align = alignof(interned_entry);
+  return (sizeof(interned_entry) + size + 1 + align - 1) & ~(align - 1);
+}
+
+}  // namespace
+
+string_pool::string_pool()
+    : table_(nullptr),
+      size_(0),
+      block_next_(nullptr),
+      block_left_(0),
+      arena_bytes_(0) {
+  table* t = new_table(kInitialCapacity);
+  tables_.push_back(t);
+  table_.store(t, std::memory_order_release);
+}
+
+string_pool::~string_pool() {
+  for (table* t : tables_) {
+    delete[] t->slots;
+    delete t;
+  }
+  for (char* block : blocks_) ::operator delete(block);
+}
+
+string_pool& string_pool::default_pool() {
+  static string_pool* pool = new string_pool;
+  return *pool;
+}
+
+size_t string_pool::hash_of(abel::string_view s) {
+  return abel::Hash<abel::string_view>()(s);
+}
+
+string_pool::table* string_pool::new_table(size_t capacity) {
+  table* t = new table;
+  t->mask = capacity - 1;
+  t->slots = new slot[capacity];
+  for (size_t i = 0; i < capacity; ++i) {
+    t->slots[i].entry.store(nullptr, std::memory_order_relaxed);
+    t->slots[i].hash = 0;
+  }
+  return t;
+}
+
+const interned_entry* string_pool::lookup(const table* t, abel::string_view s,
+                                          size_t hash) {
+  for (size_t i = hash & t->mask;; i = (i + 1) & t->mask) {
+    const interned_entry* e = t->slots[i].entry.load(std::memory_order_acquire);
+    if (e == nullptr) return nullptr;
+    if (t->slots[i].hash == hash && e->size == s.size() &&
+        memcmp(e->data(), s.data(), s.size()) == 0) {
+      return e;
+    }
+  }
+}
+
+abel::optional<interned_string> string_pool::find(abel::string_view s) const {
+  if (s.empty()) return interned_string();
+  const interned_entry* e =
+      lookup(table_.load(std::memory_order_acquire), s, hash_of(s));
+  if (e == nullptr) return abel::nullopt;
+  return interned_string(e);
+}
+
+interned_string string_pool::intern(abel::string_view s) {
+  if (s.empty()) return interned_string();
+  const size_t hash = hash_of(s);
+  const interned_entry* e =
+      lookup(table_.load(std::memory_order_acquire), s, hash);
+  if (e != nullptr) return interned_string(e);
+
+  abel::mutex_lock lock(&mu_);
+  // Another thread may have added it, or grown the table, since.
+  table* t = tables_.back();
+  e = lookup(t, s, hash);
+  if (e != nullptr) return interned_string(e);
+
+  // Keeps the table at most half full, so probes stay short.
+  if ((size() + 1) * 2 > t->mask + 1) {
+    grow();
+    t = tables_.back();
+  }
+  e = new_entry(s, hash);
+  size_t i = hash & t->mask;
+  while (t->slots[i].entry.load(std::memory_order_relaxed) != nullptr) {
+    i = (i + 1) & t->mask;
+  }
+  t->slots[i].hash = hash;
+  t->slots[i].entry.store(e, std::memory_order_release);
+  size_.fetch_add(1, std::memory_order_relaxed);
+  return interned_string(e);
+}
+
+const interned_entry* string_pool::new_entry(abel::string_view s,
+                                             size_t hash) {
+  ABEL_RAW_CHECK(size() < std::numeric_limits<uint32_t>::max(),
+                 "string_pool ids exhausted");
+  const size_t bytes = entry_bytes(s.size());
+  char* memory;
+  if (bytes > kMaxSharedBlockEntry) {
+    memory = static_cast<char*>(::operator new(bytes));
+    blocks_.push_back(memory);
+    arena_bytes_ += bytes;
+  } else {
+    if (bytes > block_left_) {
+      block_next_ = static_cast<char*>(::operator new(kBlockSize));
+      block_left_ = kBlockSize;
+      blocks_.push_back(block_next_);
+      arena_bytes_ += kBlockSize;
+    }
+    memory = block_next_;
+    block_next_ += bytes;
+    block_left_ -= bytes;
+  }
+  interned_entry* e = new (memory) interned_entry;
+  e->hash = hash;
+  e->size = s.size();
+  e->id = static_cast<uint32_t>(size() + 1);
+  char* data = reinterpret_cast<char*>(e + 1);
+  memcpy(data, s.data(), s.size());
+  data[s.size()] = '\0';
+  return e;
+}
+
+void string_pool::grow() {
+  const table* old = tables_.back();
+  table* t = new_table((old->mask + 1) * 2);
+  for (size_t i = 0; i <= old->mask; ++i) {
+    const interned_entry* e = old->slots[i].entry.load(std::memory_order_relaxed);
+    if (e == nullptr) continue;
+    size_t j = e->hash & t->mask;
+    while (t->slots[j].entry.load(std::memory_order_relaxed) != nullptr) {
+      j = (j + 1) & t->mask;
+    }
+    t->slots[j].hash = e->hash;
+    t->slots[j].entry.store(e, std::memory_order_relaxed);
+  }
+  tables_.push_back(t);
+  // Readers that pick up the new table see it filled in.
+  table_.store(t, std::memory_order_release);
+}
+
+size_t string_pool::memory_usage() const {
+  abel::mutex_lock lock(&mu_);
+  size_t bytes = arena_bytes_;
+  for (const table* t : tables_) bytes += (t->mask + 1) * sizeof(slot);
+  return bytes;
+}
+
+}  // namespace abel
@@ -0,0 +1,192 @@
+//
+//
+// -----------------------------------------------------------------------------
+// File: string_pool.h
+// -----------------------------------------------------------------------------
+//
+// This file defines `abel::string_pool`, which interns strings: each distinct
+// string is stored once, and every request for it returns the same pointer-
+// sized `abel::interned_string` handle. Handles compare and hash in O(1) by
+// address, and stay valid for as long as the pool that returned them.
+//
+// Looking up a string that is already interned takes no lock and writes no
+// shared memory, so interning on hot paths scales across threads. Only the
+// first request for a new string takes the pool's mutex.
+//
+// Example:
+//
+//   abel::string_pool& pool = abel::string_pool::default_pool();
+//   abel::interned_string name = pool.intern(metric.name());
+//   counters[name] += 1;  // hashes a pointer, not the name
+
+#ifndef ABEL_STRINGS_STRING_POOL_H_
+#define ABEL_STRINGS_STRING_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <abel/base/profile.h>
+#include <abel/strings/string_view.h>
+#include <abel/synchronization/mutex.h>
+#include <abel/threading/thread_annotations.h>
+#include <abel/types/optional.h>
+
+namespace abel {
+
+namespace strings_internal {
+
+// The bytes of an interned string follow this header in the pool's arena,
+// with a terminating '\0'.
+struct interned_entry {
+  const char* data() const {
+    return reinterpret_cast<const char*>(this + 1);
+  }
+
+  size_t hash;
+  size_t size;
+  uint32_t id;
+};
+
+// The entry of the empty string, shared by every pool.
+struct empty_interned_entry {
+  interned_entry header;
+  char terminator;
+};
+extern const empty_interned_entry kEmptyInternedEntry;
+
+}  // namespace strings_internal
+
+// interned_string
+//
+// A handle to a string in a `string_pool`. Two handles from the same pool are
+// equal exactly when their strings are; handles from different pools are
+// only equal for the empty string. A default-constructed handle is the empty
+// string.
+class interned_string {
+ public:
+  interned_string() : entry_(&strings_internal::kEmptyInternedEntry.header) {}
+
+  abel::string_view view() const {
+    return abel::string_view(entry_->data(), entry_->size);
+  }
+  operator abel::string_view() const { return view(); }  // NOLINT
+  std::string str() const { return std::string(entry_->data(), entry_->size); }
+
+  // NUL-terminated.
+  const char* data() const { return entry_->data(); }
+  const char* c_str() const { return entry_->data(); }
+  size_t size() const { return entry_->size; }
+  bool empty() const { return entry_->size == 0; }
+
+  // A dense number for the string within its pool: strings are numbered
+  // from 1 in the order they were first interned, and the empty string is 0.
+  // Suits indexing side tables.
+  uint32_t id() const { return entry_->id; }
+
+  friend bool operator==(interned_string a, interned_string b) {
+    return a.entry_ == b.entry_;
+  }
+  friend bool operator!=(interned_string a, interned_string b) {
+    return a.entry_ != b.entry_;
+  }
+
+  template <typename H>
+  friend H AbelHashValue(H h, interned_string s) {
+    return H::combine(std::move(h), s.entry_);
+  }
+
+ private:
+  friend class string_pool;
+  explicit interned_string(const strings_internal::interned_entry* e)
+      : entry_(e) {}
+
+  const strings_internal::interned_entry* entry_;
+};
+
+// string_pool
+//
+// Strings are copied into blocks of an arena and never moved or freed until
+// the pool is destroyed. They are indexed by an open-addressing hash table
+// that is only ever added to: a reader probes whatever table is current
+// without a lock, and a writer fills a slot's hash before publishing its
+// entry with a release store. When the table grows, the new one is
+// published the same way and the old ones are kept until the pool goes, so a
+// reader never needs to be protected from their reclamation; as each table
+// is twice the size of the last, they take less memory than the current
+// one.
+class string_pool {
+ public:
+  string_pool();
+  string_pool(const string_pool&) = delete;
+  string_pool& operator=(const string_pool&) = delete;
+  ~string_pool();
+
+  // A pool that is never destroyed.
+  static string_pool& default_pool();
+
+  // The handle of `s`, adding it to the pool if it is not there yet.
+  interned_string intern(abel::string_view s);
+
+  // The handle of `s` if it has been interned, without adding it.
+  abel::optional<interned_string> find(abel::string_view s) const;
+
+  // The number of strings interned, not counting the empty string.
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  // Bytes taken by the arena and the tables.
+  size_t memory_usage() const;
+
+ private:
+  struct slot {
+    std::atomic<const strings_internal::interned_entry*> entry;
+    // Written before `entry` is published and never changed after.
+    size_t hash;
+  };
+  struct table {
+    size_t mask;
+    slot* slots;
+  };
+
+  static size_t hash_of(abel::string_view s);
+  static const strings_internal::interned_entry* lookup(const table* t,
+                                                        abel::string_view s,
+                                                        size_t hash);
+  static table* new_table(size_t capacity);
+
+  // Copies `s` into the arena behind a new entry.
+  const strings_internal::interned_entry* new_entry(abel::string_view s,
+                                                    size_t hash)
+      ABEL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void grow() ABEL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  std::atomic<table*> table_;
+  std::atomic<size_t> size_;
+
+  mutable abel::mutex mu_;
+  // Every table made, the current one last.
+  std::vector<table*> tables_ ABEL_GUARDED_BY(mu_);
+  std::vector<char*> blocks_ ABEL_GUARDED_BY(mu_);
+  char* block_next_ ABEL_GUARDED_BY(mu_);
+  size_t block_left_ ABEL_GUARDED_BY(mu_);
+  size_t arena_bytes_ ABEL_GUARDED_BY(mu_);
+};
+
+}  // namespace abel
+
+namespace std {
+
+template <>
+struct hash<abel::interned_string> {
+  size_t operator()(abel::interned_string s) const {
+    return std::hash<const char*>()(s.data());
+  }
+};
+
+}  // namespace std
+
+#endif  // ABEL_STRINGS_STRING_POOL_H_
@@ -0,0 +1,228 @@
+//
+//
+// -----------------------------------------------------------------------------
+// File: string_sink.h
+// -----------------------------------------------------------------------------
+//
+// This file defines `abel::string_sink`, the output parameter of the `*_to()`
+// functions of the strings library (`string_cat_to()`, `substitute_to()`,
+// `hex_dump_to()`, `escape_to()` and friends). Those write their result into
+// a buffer the caller already has instead of returning a new `std::string`,
+// so logging and serialization paths that reuse a buffer allocate nothing
+// per call.
+//
+// A `string_sink` is a non-owning reference to any of:
+//
+//   * a `std::string`, which is appended to;
+//   * a `fmt::memory_buffer` (or any `fmt::basic_memory_buffer<char, N>`),
+//     which is appended to;
+//   * an `abel::char_array_sink`, which fills a fixed `char` array and
+//     truncates what does not fit;
+//   * any other type with an `append(const char* data, size_t size)` member,
+//     such as a buffer carved from an arena.
+//
+// Example:
+//
+//   fmt::memory_buffer line;
+//   for (const request& r : requests) {
+//     line.resize(0);
+//     abel::string_cat_to(line, r.method, " ", r.path, " ", r.status, "\n");
+//     write(fd, line.data(), line.size());
+//   }
+//
+//   char scratch[128];
+//   abel::char_array_sink out(scratch);
+//   abel::substitute_to(out, "$0 of $1 shards ready", ready, total);
+//   ABEL_RAW_LOG(INFO, "%.*s", static_cast<int>(out.size()), out.data());
+
+#ifndef ABEL_STRINGS_STRING_SINK_H_
+#define ABEL_STRINGS_STRING_SINK_H_
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+
+#include <abel/base/profile.h>
+#include <abel/strings/string_view.h>
+
+namespace abel {
+
+namespace strings_internal {
+
+// Overloads picked by how a target appends, preferring
+// `append(data, size)` (std::string, user types) to
+// `append(begin, end)` (fmt buffers).
+struct sink_fallback {};
+struct sink_preferred : sink_fallback {};
+
+template <typename T>
+auto sink_append(T& target, abel::string_view s, sink_preferred)
+    -> decltype(target.append(s.data(), s.size()), void()) {
+  target.append(s.data(), s.size());
+}
+
+template <typename T>
+auto sink_append(T& target, abel::string_view s, sink_fallback)
+    -> decltype(target.append(s.data(), s.data() + s.size()), void()) {
+  target.append(s.data(), s.data() + s.size());
+}
+
+template <typename T>
+auto sink_reserve(T& target, size_t n, sink_preferred)
+    -> decltype(target.reserve(target.size() + n), void()) {
+  target.reserve(target.size() + n);
+}
+
+template <typename T>
+void sink_reserve(T&, size_t, sink_fallback) {}
+
+}  // namespace strings_internal
+
+// string_sink
+//
+// Passed by value; it is two pointers. Appending several pieces at once lets
+// a growable target reserve room for all of them first.
+class string_sink {
+ public:
+  template <typename T,
+            typename = decltype(strings_internal::sink_append(
+                std::declval<T&>(), abel::string_view(),
+                strings_internal::sink_preferred()))>
+  string_sink(T& target)  // NOLINT(runtime/explicit)
+      : target_(&target), append_(&append_to<T>) {}
+
+  void append(abel::string_view s) const { append_(target_, &s, 1); }
+  void append(std::initializer_list<abel::string_view> pieces) const {
+    append_(target_, pieces.begin(), pieces.size());
+  }
+  void append(const abel::string_view* pieces, size_t n) const {
+    append_(target_, pieces, n);
+  }
+
+ private:
+  template <typename T>
+  static void append_to(void* target, const abel::string_view* pieces,
+                        size_t n) {
+    T& t = *static_cast<T*>(target);
+    if (n > 1) {
+      size_t total = 0;
+      for (size_t i = 0; i < n; ++i) total += pieces[i].size();
+      strings_internal::sink_reserve(t, total,
+                                     strings_internal::sink_preferred());
+    }
+    for (size_t i = 0; i < n; ++i) {
+      strings_internal::sink_append(t, pieces[i],
+                                    strings_internal::sink_preferred());
+    }
+  }
+
+  void* target_;
+  void (*append_)(void*, const abel::string_view*, size_t);
+};
+
+// char_array_sink
+//
+// Fills a fixed buffer owned by the caller, typically a `char` array on the
+// stack. Bytes past its capacity are dropped and `truncated()` turns true.
+// Nothing is NUL-terminated.
+class char_array_sink {
+ public:
+  char_array_sink(char* buffer, size_t capacity)
+      : begin_(buffer), end_(buffer), limit_(buffer + capacity),
+        truncated_(false) {}
+  template <size_t N>
+  explicit char_array_sink(char (&buffer)[N]) : char_array_sink(buffer, N) {}
+
+  char_array_sink(const char_array_sink&) = delete;
+  char_array_sink& operator=(const char_array_sink&) = delete;
+
+  // Copies as much of the `size` bytes at `data` as fits.
+  void append(const char* data, size_t size) {
+    const size_t room = static_cast<size_t>(limit_ - end_);
+    if (size > room) {
+      size = room;
+      truncated_ = true;
+    }
+    if (size != 0) {
+      memcpy(end_, data, size);
+      end_ += size;
+    }
+  }
+
+  const char* data() const { return begin_; }
+  size_t size() const { return static_cast<size_t>(end_ - begin_); }
+  size_t capacity() const { return static_cast<size_t>(limit_ - begin_); }
+  abel::string_view view() const { return abel::string_view(begin_, size()); }
+  bool truncated() const { return truncated_; }
+
+  void clear() {
+    end_ = begin_;
+    truncated_ = false;
+  }
+
+ private:
+  char* begin_;
+  char* end_;
+  char* limit_;
+  bool truncated_;
+};
+
+namespace strings_internal {
+
+// Gathers output produced a few bytes at a time into a stack buffer and
+// hands it to a sink in large pieces, so encoders pay one indirect call per
+// buffer rather than per byte. Flushes on destruction.
+class sink_writer {
+ public:
+  explicit sink_writer(string_sink sink) : sink_(sink), next_(buffer_) {}
+  sink_writer(const sink_writer&) = delete;
+  sink_writer& operator=(const sink_writer&) = delete;
+  ~sink_writer() { flush(); }
+
+  void put(char c) {
+    if (next_ == buffer_ + sizeof(buffer_)) flush();
+    *next_++ = c;
+  }
+
+  // Room for `n` contiguous bytes, at most sizeof(buffer_); the caller
+  // writes exactly `n`.
+  char* extend(size_t n) {
+    if (n > static_cast<size_t>(buffer_ + sizeof(buffer_) - next_)) flush();
+    char* p = next_;
+    next_ += n;
+    return p;
+  }
+
+  void write(abel::string_view s) {
+    if (s.size() > static_cast<size_t>(buffer_ + sizeof(buffer_) - next_)) {
+      flush();
+      if (s.size() >= sizeof(buffer_)) {
+        sink_.append(s);
+        return;
+      }
+    }
+    if (!s.empty()) {
+      memcpy(next_, s.data(), s.size());
+      next_ += s.size();
+    }
+  }
+
+  void flush() {
+    if (next_ != buffer_) {
+      sink_.append(abel::string_view(buffer_, next_ - buffer_));
+      next_ = buffer_;
+    }
+  }
+
+ private:
+  string_sink sink_;
+  char* next_;
+  char buffer_[512];
+};
+
+}  // namespace strings_internal
+
+}  // namespace abel
+
+#endif  // ABEL_STRINGS_STRING_SINK_H_
@@ -13,10 +13,13 @@ namespace abel {
 
 namespace substitute_internal {
 
-void SubstituteAndAppendArray(std::string* output, abel::string_view format,
-                              const abel::string_view* args_array,
-                              size_t num_args) {
-  // Determine total size needed.
+namespace {
+
+// Checks `format` against the arguments and sets `*result_size` to the size
+// of the substituted string. Returns false for an invalid format.
+bool SubstitutedSize(abel::string_view format,
+                     const abel::string_view* args_array, size_t num_args,
+                     size_t* result_size) {
   size_t size = 0;
   for (size_t i = 0; i < format.size(); i++) {
     if (format[i] == '$') {
@@ -26,7 +29,7 @@ void SubstituteAndAppendArray(std::string* output, abel::string_view format,
                      "Invalid abel::Substitute() format std::string: \"%s\".",
                      abel::escape(format).c_str());
 #endif
-        return;
+        return false;
       } else if (abel::ascii::is_digit(format[i + 1])) {
         int index = format[i + 1] - '0';
         if (static_cast<size_t>(index) >= num_args) {
@@ -38,7 +41,7 @@ void SubstituteAndAppendArray(std::string* output, abel::string_view format,
               "\"%s\".",
               index, static_cast<int>(num_args), abel::escape(format).c_str());
 #endif
-          return;
+          return false;
         }
         size += args_array[index].size();
         ++i;  // Skip next char.
@@ -51,14 +54,26 @@ void SubstituteAndAppendArray(std::string* output, abel::string_view format,
                      "Invalid abel::Substitute() format std::string: \"%s\".",
                      abel::escape(format).c_str());
 #endif
-        return;
+        return false;
       }
     } else {
       ++size;
     }
   }
 
-  if (size == 0) return;
+  *result_size = size;
+  return true;
+}
+
+}  // namespace
+
+void SubstituteAndAppendArray(std::string* output, abel::string_view format,
+                              const abel::string_view* args_array,
+                              size_t num_args) {
+  size_t size;
+  if (!SubstitutedSize(format, args_array, num_args, &size) || size == 0) {
+    return;
+  }
 
   // Build the std::string.
   size_t original_size = output->size();
@@ -82,6 +97,44 @@ void SubstituteAndAppendArray(std::string* output, abel::string_view format,
   assert(target == output->data() + output->size());
 }
 
+void SubstituteToArray(string_sink sink, abel::string_view format,
+                       const abel::string_view* args_array, size_t num_args) {
+  size_t size;
+  if (!SubstitutedSize(format, args_array, num_args, &size) || size == 0) {
+    return;
+  }
+
+  // Hands the sink runs of the format and arguments, a batch at a time.
+  constexpr size_t kBatch = 16;
+  abel::string_view pieces[kBatch];
+  size_t n = 0;
+  size_t literal = 0;  // start of the pending run of format text
+  for (size_t i = 0; i < format.size(); i++) {
+    if (format[i] != '$') continue;
+    if (n + 2 > kBatch) {
+      sink.append(pieces, n);
+      n = 0;
+    }
+    if (literal < i) pieces[n++] = format.substr(literal, i - literal);
+    if (abel::ascii::is_digit(format[i + 1])) {
+      pieces[n++] = args_array[format[i + 1] - '0'];
+      literal = i + 2;
+    } else {
+      // "$$": the second '$' starts the next run.
+      literal = i + 1;
+    }
+    ++i;  // Skip next char.
+  }
+  if (literal < format.size()) {
+    if (n == kBatch) {
+      sink.append(pieces, n);
+      n = 0;
+    }
+    pieces[n++] = format.substr(literal);
+  }
+  sink.append(pieces, n);
+}
+
 Arg::Arg(const void* value) {
   static_assert(sizeof(scratch_) >= sizeof(value) * 2 + 2,
                 "fix sizeof(scratch_)");
@@ -58,6 +58,7 @@
 #define ABEL_STRINGS_SUBSTITUTE_H_
 
 #include <cstring>
+#include <initializer_list>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -67,6 +68,7 @@
 #include <abel/strings/numbers.h>
 #include <abel/strings/str_cat.h>
 #include <abel/strings/str_split.h>
+#include <abel/strings/string_sink.h>
 #include <abel/strings/string_view.h>
 #include <abel/strings/strip.h>
 
@@ -173,6 +175,16 @@ void SubstituteAndAppendArray(std::string* output, abel::string_view format,
                               const abel::string_view* args_array,
                               size_t num_args);
 
+// The same for `substitute_to()`.
+void SubstituteToArray(string_sink sink, abel::string_view format,
+                       const abel::string_view* args_array, size_t num_args);
+
+ABEL_FORCE_INLINE void SubstituteToList(
+    string_sink sink, abel::string_view format,
+    std::initializer_list<abel::string_view> args) {
+  SubstituteToArray(sink, format, args.begin(), args.size());
+}
+
 #if defined(ABEL_BAD_CALL_IF)
 constexpr int CalculateOneBit(const char* format) {
   // Returns:
@@ -672,6 +684,27 @@ std::string Substitute(
                      "format std::string doesn't contain all of $0 through $9");
 #endif  // ABEL_BAD_CALL_IF
 
+// substitute_to()
+//
+// Substitutes variables into a format string like `Substitute()`, appending
+// the result to `sink`: a `std::string`, a `fmt::memory_buffer`, an
+// `abel::char_array_sink` or any other target `abel::string_sink` accepts.
+// Arguments are converted on the stack, so appending to a reused buffer
+// allocates nothing. An invalid format string appends nothing.
+//
+// Example:
+//
+//   fmt::memory_buffer buf;
+//   abel::substitute_to(buf, "$0 -> $1 ($2 bytes)", src, dst, n);
+template <typename... Args>
+ABEL_FORCE_INLINE void substitute_to(string_sink sink, abel::string_view format,
+                                     const Args&... args) {
+  static_assert(sizeof...(Args) <= 10,
+                "substitute_to() takes at most 10 arguments");
+  // The Arg temporaries live until the call returns.
+  substitute_internal::SubstituteToList(
+      sink, format, {substitute_internal::Arg(args).piece()...});
+}
 
 }  // namespace abel
 
@@ -48,8 +48,7 @@ abel::string_view trim_all (abel::string_view str,  abel::string_view drop) {
 /******************************************************************************/
 
 std::string &trim_right (std::string *str) {
-    auto it = std::find_if_not(str->rbegin(), str->rend(), abel::ascii::is_space);
-    str->erase(str->rend() - it);
+    str->erase(strings_internal::ascii_skip_space_back(str->data(), str->size()));
     return *str;
 }
 
@@ -69,8 +68,7 @@ abel::string_view trim_right (abel::string_view str, abel::string_view drop) {
 /******************************************************************************/
 
 std::string &trim_left (std::string *str) {
-    auto it = std::find_if_not(str->begin(), str->end(), abel::ascii::is_space);
-    str->erase(str->begin(), it);
+    str->erase(0, strings_internal::ascii_skip_space(str->data(), str->size()));
     return *str;
 }
 
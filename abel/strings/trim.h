@@ -7,6 +7,7 @@
 
 #include <abel/base/profile.h>
 #include <abel/strings/ascii.h>
+#include <abel/strings/internal/ascii_simd.h>
 #include <abel/strings/string_view.h>
 #include <string>
 
@@ -48,8 +49,7 @@ abel::string_view trim_right (abel::string_view str, abel::string_view drop);
 
 
 ABEL_MUST_USE_RESULT ABEL_FORCE_INLINE abel::string_view trim_right (abel::string_view str) {
-    auto it = std::find_if_not(str.rbegin(), str.rend(), abel::ascii::is_space);
-    return str.substr(0, str.rend() - it);
+    return str.substr(0, strings_internal::ascii_skip_space_back(str.data(), str.size()));
 }
 
 /******************************************************************************/
@@ -90,8 +90,7 @@ abel::string_view trim_left (abel::string_view str, abel::string_view drop);
  */
 ABEL_MUST_USE_RESULT ABEL_FORCE_INLINE abel::string_view trim_left (
     abel::string_view str) {
-    auto it = std::find_if_not(str.begin(), str.end(), abel::ascii::is_space);
-    return str.substr(it - str.begin());
+    return str.substr(strings_internal::ascii_skip_space(str.data(), str.size()));
 }
 
 /*!
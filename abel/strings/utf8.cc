@@ -0,0 +1,205 @@
+//
+
+#include <abel/strings/utf8.h>
+
+#include <abel/meta/uninitialized.h>
+#include <abel/strings/internal/utf8_simd.h>
+
+namespace abel {
+
+namespace utf8 {
+
+namespace {
+
+using strings_internal::utf8_best_kernels;
+
+// Decodes the code point of valid UTF-8 at `s`, advancing `s` past it.
+inline char32_t decode (const uint8_t *&s) {
+    const uint32_t c = s[0];
+    if (c < 0x80) {
+        ++s;
+        return c;
+    }
+    if (c < 0xE0) {
+        const char32_t cp = ((c & 0x1F) << 6) | (s[1] & 0x3F);
+        s += 2;
+        return cp;
+    }
+    if (c < 0xF0) {
+        const char32_t cp = ((c & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+        s += 3;
+        return cp;
+    }
+    const char32_t cp = ((c & 0x07) << 18) | ((s[1] & 0x3F) << 12) | ((s[2] & 0x3F) << 6) |
+                        (s[3] & 0x3F);
+    s += 4;
+    return cp;
+}
+
+// The bytes decoded one character at a time before handing back to the
+// kernels, more if they made no progress.
+inline const uint8_t *segment_end (const uint8_t *s, const uint8_t *end, size_t consumed) {
+    const ptrdiff_t len = consumed == 0 ? 64 : 16;
+    return end - s > len ? s + len : end;
+}
+
+// Encodes code point `cp`, at least 0x80, at `out`, returning its length.
+inline size_t encode_non_ascii (char32_t cp, char *out) {
+    if (cp < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (cp >> 6));
+        out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (cp >> 12));
+        out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (cp >> 18));
+    out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+}  // namespace
+
+bool is_valid (abel::string_view s) {
+    return utf8_best_kernels().validate(s.data(), s.size());
+}
+
+size_t valid_prefix (abel::string_view s) {
+    if (is_valid(s)) {
+        return s.size();
+    }
+    return strings_internal::utf8_valid_prefix(s.data(), s.size());
+}
+
+size_t count_code_points (abel::string_view s) {
+    return utf8_best_kernels().count_code_points(s.data(), s.size());
+}
+
+size_t utf16_length (abel::string_view s) {
+    return utf8_best_kernels().count_utf16_units(s.data(), s.size());
+}
+
+size_t convert_valid_to_utf16 (abel::string_view src, char16_t *out) {
+    const strings_internal::utf8_kernels &k = utf8_best_kernels();
+    const uint8_t *s = reinterpret_cast<const uint8_t *>(src.data());
+    const uint8_t *end = s + src.size();
+    char16_t *const begin = out;
+    while (s != end) {
+        size_t written;
+        const size_t consumed =
+            k.utf8_to_utf16(reinterpret_cast<const char *>(s), end - s, out, &written);
+        s += consumed;
+        out += written;
+        // Decode what the kernel stopped at, a block at a time.
+        const uint8_t *stop = segment_end(s, end, consumed);
+        while (s < stop) {
+            const char32_t cp = decode(s);
+            if (cp < 0x10000) {
+                *out++ = static_cast<char16_t>(cp);
+            } else {
+                *out++ = static_cast<char16_t>(0xD800 + ((cp - 0x10000) >> 10));
+                *out++ = static_cast<char16_t>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+            }
+        }
+    }
+    return out - begin;
+}
+
+size_t convert_valid_to_utf32 (abel::string_view src, char32_t *out) {
+    const strings_internal::utf8_kernels &k = utf8_best_kernels();
+    const uint8_t *s = reinterpret_cast<const uint8_t *>(src.data());
+    const uint8_t *end = s + src.size();
+    char32_t *const begin = out;
+    while (s != end) {
+        size_t written;
+        const size_t consumed =
+            k.utf8_to_utf32(reinterpret_cast<const char *>(s), end - s, out, &written);
+        s += consumed;
+        out += written;
+        const uint8_t *stop = segment_end(s, end, consumed);
+        while (s < stop) {
+            *out++ = decode(s);
+        }
+    }
+    return out - begin;
+}
+
+bool to_utf16 (abel::string_view src, std::u16string *dest) {
+    if (!is_valid(src)) {
+        return false;
+    }
+    // Never more code units than bytes.
+    dest->resize(src.size());
+    dest->resize(convert_valid_to_utf16(src, &(*dest)[0]));
+    return true;
+}
+
+bool to_utf32 (abel::string_view src, std::u32string *dest) {
+    if (!is_valid(src)) {
+        return false;
+    }
+    dest->resize(src.size());
+    dest->resize(convert_valid_to_utf32(src, &(*dest)[0]));
+    return true;
+}
+
+bool from_utf16 (const char16_t *src, size_t n, std::string *dest) {
+    const strings_internal::utf8_kernels &k = utf8_best_kernels();
+    // At most three bytes per code unit.
+    abel::string_resize_uninitialized(dest, n * 3);
+    char *const begin = &(*dest)[0];
+    char *out = begin;
+    size_t i = 0;
+    while (i < n) {
+        const size_t ascii = k.utf16_ascii_to_utf8(src + i, n - i, out);
+        i += ascii;
+        out += ascii;
+        while (i < n && src[i] >= 0x80) {
+            char32_t cp = src[i++];
+            if (cp >= 0xD800 && cp <= 0xDFFF) {
+                if (cp >= 0xDC00 || i == n || src[i] < 0xDC00 || src[i] > 0xDFFF) {
+                    return false;
+                }
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (src[i++] - 0xDC00);
+            }
+            out += encode_non_ascii(cp, out);
+        }
+    }
+    dest->resize(out - begin);
+    return true;
+}
+
+bool from_utf32 (const char32_t *src, size_t n, std::string *dest) {
+    const strings_internal::utf8_kernels &k = utf8_best_kernels();
+    abel::string_resize_uninitialized(dest, n * 4);
+    char *const begin = &(*dest)[0];
+    char *out = begin;
+    size_t i = 0;
+    while (i < n) {
+        const size_t ascii = k.utf32_ascii_to_utf8(src + i, n - i, out);
+        i += ascii;
+        out += ascii;
+        while (i < n && src[i] >= 0x80) {
+            const char32_t cp = src[i++];
+            if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+                return false;
+            }
+            out += encode_non_ascii(cp, out);
+        }
+    }
+    dest->resize(out - begin);
+    return true;
+}
+
+const char *implementation () {
+    return utf8_best_kernels().name;
+}
+
+}  // namespace utf8
+
+}  // namespace abel
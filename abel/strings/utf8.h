@@ -0,0 +1,73 @@
+//
+
+#ifndef ABEL_STRINGS_UTF8_H_
+#define ABEL_STRINGS_UTF8_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <abel/base/profile.h>
+#include <abel/strings/string_view.h>
+
+namespace abel {
+
+// abel::utf8
+//
+// Validation and transcoding of UTF-8 text:
+//
+//   if (!abel::utf8::is_valid(body)) { ... }
+//   std::u16string wide;
+//   abel::utf8::to_utf16(body, &wide);
+//
+// The work is done 16 or 32 bytes at a time with SSE4.1 or AVX2, whichever
+// the running CPU supports, and by portable code otherwise. Validation
+// follows RFC 3629: overlong forms, surrogates (U+D800 to U+DFFF), code
+// points past U+10FFFF and truncated sequences are all rejected.
+namespace utf8 {
+
+// Whether `s` is valid UTF-8.
+bool is_valid (abel::string_view s);
+
+// The length of the longest valid prefix of `s`, which is the offset of the
+// first invalid sequence, or `s.size()` if `s` is valid.
+size_t valid_prefix (abel::string_view s);
+
+// The number of code points of valid UTF-8 `s`.
+size_t count_code_points (abel::string_view s);
+
+// The number of UTF-16 code units that valid UTF-8 `s` transcodes to.
+size_t utf16_length (abel::string_view s);
+
+// Transcodes `src` into `dest`, replacing its contents. Returns false,
+// leaving `dest` unspecified, if `src` is not valid UTF-8.
+bool to_utf16 (abel::string_view src, std::u16string *dest);
+bool to_utf32 (abel::string_view src, std::u32string *dest);
+
+// Transcodes the `n` units at `src` to UTF-8 into `dest`, replacing its
+// contents. Returns false, leaving `dest` unspecified, on unpaired
+// surrogates and, for UTF-32, code points past U+10FFFF.
+bool from_utf16 (const char16_t *src, size_t n, std::string *dest);
+bool from_utf32 (const char32_t *src, size_t n, std::string *dest);
+inline bool from_utf16 (const std::u16string &src, std::string *dest) {
+    return from_utf16(src.data(), src.size(), dest);
+}
+inline bool from_utf32 (const std::u32string &src, std::string *dest) {
+    return from_utf32(src.data(), src.size(), dest);
+}
+
+// Transcodes `src`, which must be valid UTF-8, into `out`, which has room
+// for `src.size()` units, and returns the number of units written, which is
+// utf16_length(src), or count_code_points(src) for UTF-32. These skip
+// validation, for text already known to be valid.
+size_t convert_valid_to_utf16 (abel::string_view src, char16_t *out);
+size_t convert_valid_to_utf32 (abel::string_view src, char32_t *out);
+
+// The name of the kernels in use: "avx2", "sse4" or "scalar".
+const char *implementation ();
+
+}  // namespace utf8
+
+}  // namespace abel
+
+#endif  // ABEL_STRINGS_UTF8_H_
@@ -0,0 +1,101 @@
+//
+
+#include <abel/synchronization/epoch.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace abel {
+
+namespace {
+
+// Retired objects a thread keeps before collecting.
+constexpr size_t kRetireBatch = 64;
+
+}  // namespace
+
+epoch_domain::epoch_domain() : epoch_(0) {}
+
+epoch_domain::~epoch_domain() { Shutdown(); }
+
+epoch_domain& epoch_domain::default_domain() {
+  static epoch_domain* domain = new epoch_domain;
+  return *domain;
+}
+
+synchronization_internal::ReclamationRecord* epoch_domain::NewRecord() {
+  record* r = new record;
+  r->pinned.store(0, std::memory_order_relaxed);
+  r->nesting = 0;
+  r->collecting = false;
+  r->collect_at = kRetireBatch;
+  return r;
+}
+
+void epoch_domain::ResetRecord(
+    synchronization_internal::ReclamationRecord* rec) {
+  record* r = static_cast<record*>(rec);
+  r->pinned.store(0, std::memory_order_release);
+  r->nesting = 0;
+  r->collecting = false;
+  r->collect_at = kRetireBatch;
+}
+
+void epoch_domain::retire(void* p, void (*deleter)(void*)) {
+  record* r = current_record();
+  // Read after the object was unlinked, so any guard that could still reach
+  // it entered in this epoch or earlier.
+  r->retired.push_back({p, deleter, epoch_.load(std::memory_order_seq_cst)});
+  if (r->retired.size() >= r->collect_at) {
+    collect(r);
+  }
+}
+
+void epoch_domain::reclaim() {
+  collect(current_record());
+}
+
+void epoch_domain::try_advance() {
+  uint64_t current = epoch_.load(std::memory_order_relaxed);
+  // Pairs with the fence in the epoch_guard constructor.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const uint64_t in_current = (current << 1) | 1;
+  for (synchronization_internal::ReclamationRecord* rec = records();
+       rec != nullptr; rec = rec->domain_next) {
+    uint64_t pinned =
+        static_cast<record*>(rec)->pinned.load(std::memory_order_relaxed);
+    if (pinned != 0 && pinned != in_current) {
+      return;
+    }
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  epoch_.compare_exchange_strong(current, current + 1,
+                                 std::memory_order_acq_rel,
+                                 std::memory_order_relaxed);
+}
+
+void epoch_domain::collect(record* r) {
+  // A deleter may retire more objects; they wait for the next collection.
+  if (r->collecting) {
+    return;
+  }
+  r->collecting = true;
+  try_advance();
+  const uint64_t current = epoch_.load(std::memory_order_acquire);
+  std::vector<synchronization_internal::RetiredObject> candidates;
+  candidates.swap(r->retired);
+  AdoptOrphans(&candidates);
+  for (const synchronization_internal::RetiredObject& obj : candidates) {
+    if (obj.tag + 2 <= current) {
+      obj.deleter(obj.ptr);
+    } else {
+      r->retired.push_back(obj);
+    }
+  }
+  // While a stalled guard holds the epoch back, collecting on every retire
+  // would make retiring quadratic.
+  r->collect_at = std::max(kRetireBatch, 2 * r->retired.size());
+  r->collecting = false;
+}
+
+}  // namespace abel
@@ -0,0 +1,152 @@
+//
+// -----------------------------------------------------------------------------
+// epoch.h
+// -----------------------------------------------------------------------------
+//
+// Epoch-based reclamation, an alternative to hazard_pointer.h for lock-free
+// data structures. Readers enter a critical section with an `epoch_guard`
+// instead of protecting each pointer, which makes traversals cheap: one store
+// and one fence per critical section rather than per node. The price is that
+// a thread stalled inside a critical section holds back the reclamation of
+// every object retired after it entered.
+//
+// The domain keeps a global epoch. A guard publishes the epoch it entered in;
+// a retired object is tagged with the epoch at which it was retired and is
+// deleted once the global epoch has moved two steps past that tag, which can
+// only happen after every guard that might still see it has been left. The
+// epoch advances when a thread collects its retire list, which it does in
+// batches. Per-thread state is attached to the thread's ThreadIdentity; when
+// a thread exits, its unreclaimed objects are handed to the thread that
+// collects next.
+//
+// Example:
+//
+//   abel::epoch_domain& domain = abel::epoch_domain::default_domain();
+//   {
+//     abel::epoch_guard guard(domain);
+//     Node* node = head.load(std::memory_order_acquire);
+//     while (node != nullptr &&
+//            !head.compare_exchange_weak(node, node->next)) {
+//     }
+//     if (node != nullptr) {
+//       domain.retire(node);
+//     }
+//   }
+
+#ifndef ABEL_SYNCHRONIZATION_EPOCH_H_
+#define ABEL_SYNCHRONIZATION_EPOCH_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <abel/base/profile.h>
+#include <abel/synchronization/internal/reclamation.h>
+
+namespace abel {
+
+class epoch_guard;
+
+// -----------------------------------------------------------------------------
+// epoch_domain
+// -----------------------------------------------------------------------------
+//
+// A global epoch and the objects retired against it. A domain must outlive
+// every thread's use of it; the default domain is never destroyed.
+class epoch_domain : private synchronization_internal::ReclamationDomain {
+ public:
+  epoch_domain();
+  // Deletes all retired objects. No thread may use the domain any more.
+  ~epoch_domain() override;
+
+  static epoch_domain& default_domain();
+
+  // Deletes `p` with `delete` once no critical section can still reach it.
+  // May be called inside or outside a critical section.
+  template <typename T>
+  void retire(T* p) {
+    retire(p, &delete_object<T>);
+  }
+  // Calls `deleter(p)` once no critical section can still reach `p`.
+  void retire(void* p, void (*deleter)(void*));
+
+  // Tries to advance the epoch and reclaims the calling thread's objects that
+  // are old enough, without waiting for the batch threshold. Reclaiming
+  // everything the thread retired takes two calls outside any critical
+  // section, provided no other thread stays in one.
+  void reclaim();
+
+  // The current global epoch.
+  uint64_t epoch() const { return epoch_.load(std::memory_order_relaxed); }
+
+ private:
+  friend class epoch_guard;
+
+  struct record : synchronization_internal::ReclamationRecord {
+    // (entered epoch << 1) | 1 inside a critical section, 0 outside.
+    std::atomic<uint64_t> pinned;
+    unsigned nesting;
+    bool collecting;
+    // The retire list size that triggers the next collection.
+    size_t collect_at;
+  };
+
+  template <typename T>
+  static void delete_object(void* p) {
+    delete static_cast<T*>(p);
+  }
+
+  record* current_record() {
+    return static_cast<record*>(CurrentRecord());
+  }
+  // Advances the epoch if every thread in a critical section has entered it
+  // in the current epoch.
+  void try_advance();
+  void collect(record* r);
+
+  synchronization_internal::ReclamationRecord* NewRecord() override;
+  void ResetRecord(synchronization_internal::ReclamationRecord* r) override;
+
+  std::atomic<uint64_t> epoch_;
+};
+
+// -----------------------------------------------------------------------------
+// epoch_guard
+// -----------------------------------------------------------------------------
+//
+// Scoped critical section: objects reachable when it is entered are not
+// reclaimed before it is left. Guards nest and must be destroyed on the
+// thread that created them.
+class epoch_guard {
+ public:
+  explicit epoch_guard(
+      epoch_domain& domain = epoch_domain::default_domain());
+  epoch_guard(const epoch_guard&) = delete;
+  epoch_guard& operator=(const epoch_guard&) = delete;
+  ~epoch_guard();
+
+ private:
+  epoch_domain::record* record_;
+};
+
+inline epoch_guard::epoch_guard(epoch_domain& domain)
+    : record_(domain.current_record()) {
+  if (record_->nesting++ == 0) {
+    record_->pinned.store(
+        (domain.epoch_.load(std::memory_order_relaxed) << 1) | 1,
+        std::memory_order_relaxed);
+    // Orders the publication before the reads of the critical section; pairs
+    // with the fence in epoch_domain::try_advance().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+inline epoch_guard::~epoch_guard() {
+  if (--record_->nesting == 0) {
+    record_->pinned.store(0, std::memory_order_release);
+  }
+}
+
+}  // namespace abel
+
+#endif  // ABEL_SYNCHRONIZATION_EPOCH_H_
@@ -0,0 +1,149 @@
+//
+
+#include <abel/synchronization/hazard_pointer.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace abel {
+
+constexpr int hazard_pointer_domain::kSlotsPerThread;
+
+namespace {
+
+// Retired objects a thread keeps before scanning, on top of twice the number
+// of hazard pointers, which bounds the share of a scan that survives it.
+constexpr size_t kRetireBatch = 64;
+
+}  // namespace
+
+hazard_pointer_domain::hazard_pointer_domain()
+    : overflow_(nullptr), overflow_count_(0) {}
+
+hazard_pointer_domain::~hazard_pointer_domain() {
+  Shutdown();
+  overflow_slot* slot = overflow_.load(std::memory_order_relaxed);
+  while (slot != nullptr) {
+    overflow_slot* next = slot->next;
+    delete slot;
+    slot = next;
+  }
+}
+
+hazard_pointer_domain& hazard_pointer_domain::default_domain() {
+  static hazard_pointer_domain* domain = new hazard_pointer_domain;
+  return *domain;
+}
+
+synchronization_internal::ReclamationRecord* hazard_pointer_domain::NewRecord() {
+  record* r = new record;
+  for (std::atomic<const void*>& slot : r->slots) {
+    slot.store(nullptr, std::memory_order_relaxed);
+  }
+  r->free_slots = (uint32_t(1) << kSlotsPerThread) - 1;
+  r->scanning = false;
+  return r;
+}
+
+void hazard_pointer_domain::ResetRecord(
+    synchronization_internal::ReclamationRecord* rec) {
+  record* r = static_cast<record*>(rec);
+  for (std::atomic<const void*>& slot : r->slots) {
+    slot.store(nullptr, std::memory_order_release);
+  }
+  r->free_slots = (uint32_t(1) << kSlotsPerThread) - 1;
+  r->scanning = false;
+  r->hazards.clear();
+  r->hazards.shrink_to_fit();
+}
+
+std::atomic<const void*>* hazard_pointer_domain::acquire_overflow_slot() {
+  for (overflow_slot* slot = overflow_.load(std::memory_order_acquire);
+       slot != nullptr; slot = slot->next) {
+    bool expected = false;
+    if (!slot->in_use.load(std::memory_order_relaxed) &&
+        slot->in_use.compare_exchange_strong(expected, true,
+                                             std::memory_order_acquire)) {
+      return &slot->ptr;
+    }
+  }
+  overflow_slot* slot = new overflow_slot;
+  slot->ptr.store(nullptr, std::memory_order_relaxed);
+  slot->in_use.store(true, std::memory_order_relaxed);
+  overflow_slot* head = overflow_.load(std::memory_order_relaxed);
+  do {
+    slot->next = head;
+  } while (!overflow_.compare_exchange_weak(head, slot,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed));
+  overflow_count_.fetch_add(1, std::memory_order_relaxed);
+  return &slot->ptr;
+}
+
+void hazard_pointer_domain::release_overflow_slot(
+    std::atomic<const void*>* slot) {
+  // `ptr` is the first member.
+  reinterpret_cast<overflow_slot*>(slot)->in_use.store(
+      false, std::memory_order_release);
+}
+
+void hazard_pointer_domain::retire(void* p, void (*deleter)(void*)) {
+  record* r = current_record();
+  r->retired.push_back({p, deleter, 0});
+  const size_t hazards =
+      record_count() * kSlotsPerThread +
+      overflow_count_.load(std::memory_order_relaxed);
+  if (r->retired.size() >= kRetireBatch + 2 * hazards) {
+    scan(r);
+  }
+}
+
+void hazard_pointer_domain::reclaim() {
+  scan(current_record());
+}
+
+void hazard_pointer_domain::scan(record* r) {
+  // A deleter may retire more objects; they wait for the next scan.
+  if (r->scanning) {
+    return;
+  }
+  r->scanning = true;
+  std::vector<synchronization_internal::RetiredObject> candidates;
+  candidates.swap(r->retired);
+  AdoptOrphans(&candidates);
+
+  // Pairs with the fence in hazard_pointer::try_protect(): a reader either
+  // sees the object unlinked, or its hazard pointer is seen here.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::vector<const void*>& hazards = r->hazards;
+  hazards.clear();
+  for (synchronization_internal::ReclamationRecord* rec = records();
+       rec != nullptr; rec = rec->domain_next) {
+    for (const std::atomic<const void*>& slot :
+         static_cast<record*>(rec)->slots) {
+      const void* p = slot.load(std::memory_order_acquire);
+      if (p != nullptr) {
+        hazards.push_back(p);
+      }
+    }
+  }
+  for (overflow_slot* slot = overflow_.load(std::memory_order_acquire);
+       slot != nullptr; slot = slot->next) {
+    const void* p = slot->ptr.load(std::memory_order_acquire);
+    if (p != nullptr) {
+      hazards.push_back(p);
+    }
+  }
+  std::sort(hazards.begin(), hazards.end());
+
+  for (const synchronization_internal::RetiredObject& obj : candidates) {
+    if (std::binary_search(hazards.begin(), hazards.end(), obj.ptr)) {
+      r->retired.push_back(obj);
+    } else {
+      obj.deleter(obj.ptr);
+    }
+  }
+  r->scanning = false;
+}
+
+}  // namespace abel
@@ -0,0 +1,207 @@
+//
+// -----------------------------------------------------------------------------
+// hazard_pointer.h
+// -----------------------------------------------------------------------------
+//
+// Hazard pointers let lock-free data structures free nodes that other threads
+// may still be reading. A reader publishes the pointer it is about to
+// dereference in a `hazard_pointer`; a writer that unlinks a node hands it to
+// `hazard_pointer_domain::retire()` instead of deleting it, and the node is
+// deleted once no hazard pointer protects it.
+//
+// Retired objects are kept in a per-thread list and reclaimed in batches: when
+// the list grows past a threshold proportional to the number of hazard
+// pointers, the thread collects all published pointers once and deletes every
+// retired object that is not among them, so the cost per retired object stays
+// constant. Per-thread state is attached to the thread's ThreadIdentity; when
+// a thread exits, its unreclaimed objects are handed to the thread that scans
+// next.
+//
+// Example:
+//
+//   Node* pop(std::atomic<Node*>& head) {
+//     abel::hazard_pointer hp;
+//     Node* node = hp.protect(head);
+//     while (node != nullptr &&
+//            !head.compare_exchange_weak(node, node->next)) {
+//       node = hp.protect(head);
+//     }
+//     hp.reset_protection();
+//     if (node != nullptr) {
+//       abel::hazard_pointer_domain::default_domain().retire(node);
+//     }
+//     return node;
+//   }
+//
+// Each thread has kSlotsPerThread hazard pointers per domain that are cheap to
+// construct; any more are taken from a shared pool.
+
+#ifndef ABEL_SYNCHRONIZATION_HAZARD_POINTER_H_
+#define ABEL_SYNCHRONIZATION_HAZARD_POINTER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <abel/base/math/ctz.h>
+#include <abel/base/profile.h>
+#include <abel/synchronization/internal/reclamation.h>
+
+namespace abel {
+
+class hazard_pointer;
+
+// -----------------------------------------------------------------------------
+// hazard_pointer_domain
+// -----------------------------------------------------------------------------
+//
+// A set of hazard pointers and the objects they guard. Objects retired to a
+// domain are only checked against the hazard pointers of the same domain. A
+// domain must outlive every thread's use of it; the default domain is never
+// destroyed.
+class hazard_pointer_domain : private synchronization_internal::ReclamationDomain {
+ public:
+  static constexpr int kSlotsPerThread = 8;
+
+  hazard_pointer_domain();
+  // Deletes all retired objects. No thread may use the domain any more.
+  ~hazard_pointer_domain() override;
+
+  static hazard_pointer_domain& default_domain();
+
+  // Deletes `p` with `delete` once no hazard pointer protects it.
+  template <typename T>
+  void retire(T* p) {
+    retire(p, &delete_object<T>);
+  }
+  // Calls `deleter(p)` once no hazard pointer protects `p`.
+  void retire(void* p, void (*deleter)(void*));
+
+  // Reclaims the calling thread's retired objects that are not protected,
+  // without waiting for the batch threshold.
+  void reclaim();
+
+ private:
+  friend class hazard_pointer;
+
+  struct record : synchronization_internal::ReclamationRecord {
+    std::atomic<const void*> slots[kSlotsPerThread];
+    uint32_t free_slots;
+    bool scanning;
+    // Reused by scan().
+    std::vector<const void*> hazards;
+  };
+
+  struct overflow_slot {
+    std::atomic<const void*> ptr;
+    std::atomic<bool> in_use;
+    overflow_slot* next;
+  };
+
+  template <typename T>
+  static void delete_object(void* p) {
+    delete static_cast<T*>(p);
+  }
+
+  record* current_record() {
+    return static_cast<record*>(CurrentRecord());
+  }
+  std::atomic<const void*>* acquire_overflow_slot();
+  static void release_overflow_slot(std::atomic<const void*>* slot);
+  void scan(record* r);
+
+  synchronization_internal::ReclamationRecord* NewRecord() override;
+  void ResetRecord(synchronization_internal::ReclamationRecord* r) override;
+
+  std::atomic<overflow_slot*> overflow_;
+  std::atomic<size_t> overflow_count_;
+};
+
+// -----------------------------------------------------------------------------
+// hazard_pointer
+// -----------------------------------------------------------------------------
+//
+// A single hazard pointer, owned by the thread that created it. It must be
+// destroyed on that thread.
+class hazard_pointer {
+ public:
+  explicit hazard_pointer(
+      hazard_pointer_domain& domain = hazard_pointer_domain::default_domain());
+  hazard_pointer(const hazard_pointer&) = delete;
+  hazard_pointer& operator=(const hazard_pointer&) = delete;
+  ~hazard_pointer();
+
+  // hazard_pointer::protect()
+  //
+  // Loads `src` and protects the loaded pointer, retrying until the pointer
+  // is still in `src` after being published. The result may be dereferenced
+  // until the protection is reset, as long as the writers retire objects only
+  // after unlinking them from `src`.
+  template <typename T>
+  T* protect(const std::atomic<T*>& src) {
+    T* p = src.load(std::memory_order_relaxed);
+    while (!try_protect(p, src)) {
+    }
+    return p;
+  }
+
+  // hazard_pointer::try_protect()
+  //
+  // Protects `ptr`, a value previously loaded from `src`, and returns true if
+  // `src` still holds it. Otherwise sets `ptr` to the current value of `src`
+  // and returns false; `ptr` is then not protected.
+  template <typename T>
+  bool try_protect(T*& ptr, const std::atomic<T*>& src) {
+    T* expected = ptr;
+    slot_->store(expected, std::memory_order_relaxed);
+    // Orders the publication before the validating load; pairs with the
+    // fence in hazard_pointer_domain::scan().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    ptr = src.load(std::memory_order_acquire);
+    if (ABEL_LIKELY(ptr == expected)) {
+      return true;
+    }
+    slot_->store(nullptr, std::memory_order_release);
+    return false;
+  }
+
+  // Protects `p` without validation; the caller knows it is not reclaimed yet.
+  void reset_protection(const void* p) {
+    slot_->store(p, std::memory_order_release);
+  }
+  void reset_protection(std::nullptr_t = nullptr) {
+    slot_->store(nullptr, std::memory_order_release);
+  }
+
+ private:
+  std::atomic<const void*>* slot_;
+  // The owning record, or nullptr for a slot from the shared pool.
+  hazard_pointer_domain::record* record_;
+};
+
+inline hazard_pointer::hazard_pointer(hazard_pointer_domain& domain) {
+  hazard_pointer_domain::record* r = domain.current_record();
+  if (ABEL_LIKELY(r->free_slots != 0)) {
+    unsigned i = count_trailing_zeros(r->free_slots);
+    r->free_slots &= ~(uint32_t(1) << i);
+    slot_ = &r->slots[i];
+    record_ = r;
+  } else {
+    slot_ = domain.acquire_overflow_slot();
+    record_ = nullptr;
+  }
+}
+
+inline hazard_pointer::~hazard_pointer() {
+  slot_->store(nullptr, std::memory_order_release);
+  if (ABEL_LIKELY(record_ != nullptr)) {
+    record_->free_slots |= uint32_t(1) << (slot_ - record_->slots);
+  } else {
+    hazard_pointer_domain::release_overflow_slot(slot_);
+  }
+}
+
+}  // namespace abel
+
+#endif  // ABEL_SYNCHRONIZATION_HAZARD_POINTER_H_
@@ -8,6 +8,7 @@
 #ifndef ABEL_LOW_LEVEL_ALLOC_MISSING
 
 #include <string.h>
+#include <thread>
 
 #include <abel/base/profile.h>
 #include <abel/threading/internal/spinlock.h>
@@ -24,12 +25,140 @@ static threading_internal::SpinLock freelist_lock(
     base_internal::kLinkerInitialized);
 static threading_internal::ThreadIdentity* thread_identity_freelist;
 
+// Guards the exit hook lists of all threads, and running_exit_hooks.
+static threading_internal::SpinLock exit_hooks_lock(
+    base_internal::kLinkerInitialized);
+
+// A hook whose on_exit() is running, on the stack of the exiting thread.
+struct RunningExitHook {
+  threading_internal::ThreadExitHook* hook;
+  threading_internal::ThreadIdentity* identity;
+  RunningExitHook* next;
+};
+static RunningExitHook* running_exit_hooks;
+
+// The identity whose hooks the calling thread is running. Depending on the
+// identity mode the thread may no longer see it as its current one.
+static thread_local threading_internal::ThreadIdentity* exiting_identity;
+
+static threading_internal::ThreadIdentity* CallerIdentityIfPresent() {
+  if (exiting_identity != nullptr) {
+    return exiting_identity;
+  }
+  return threading_internal::CurrentThreadIdentityIfPresent();
+}
+
+// Runs and unlinks the hooks registered by the thread owning `identity`,
+// including any registered by the hooks themselves. Each hook is unlinked
+// under the lock and run after releasing it, so that a slow hook does not
+// hold up other threads and a hook may register or unregister hooks.
+static void RunThreadExitHooks(threading_internal::ThreadIdentity* identity) {
+  exiting_identity = identity;
+  for (;;) {
+    RunningExitHook running;
+    {
+      threading_internal::SpinLockHolder l(&exit_hooks_lock);
+      threading_internal::ThreadExitHook* hook = identity->exit_hooks;
+      if (hook == nullptr) {
+        break;
+      }
+      identity->exit_hooks = hook->next;
+      if (hook->next != nullptr) {
+        hook->next->prev = nullptr;
+      }
+      hook->identity = nullptr;
+      hook->prev = hook->next = nullptr;
+      running = {hook, identity, running_exit_hooks};
+      running_exit_hooks = &running;
+    }
+    // The hook may free itself, so it is not touched afterwards.
+    running.hook->on_exit(running.hook);
+    threading_internal::SpinLockHolder l(&exit_hooks_lock);
+    RunningExitHook** link = &running_exit_hooks;
+    while (*link != &running) {
+      link = &(*link)->next;
+    }
+    *link = running.next;
+  }
+  exiting_identity = nullptr;
+}
+
+void RegisterThreadExitHook(threading_internal::ThreadExitHook* hook) {
+  threading_internal::ThreadIdentity* identity = exiting_identity;
+  if (identity == nullptr) {
+    identity = GetOrCreateCurrentThreadIdentity();
+  }
+  threading_internal::SpinLockHolder l(&exit_hooks_lock);
+  hook->identity = identity;
+  hook->prev = nullptr;
+  hook->next = identity->exit_hooks;
+  if (hook->next != nullptr) {
+    hook->next->prev = hook;
+  }
+  identity->exit_hooks = hook;
+}
+
+// Returns true if `hook` is running on a thread other than the caller.
+static bool RunningElsewhere(threading_internal::ThreadExitHook* hook) {
+  for (RunningExitHook* r = running_exit_hooks; r != nullptr; r = r->next) {
+    if (r->hook == hook) {
+      return r->identity != CallerIdentityIfPresent();
+    }
+  }
+  return false;
+}
+
+void UnregisterThreadExitHook(threading_internal::ThreadExitHook* hook) {
+  for (;;) {
+    {
+      threading_internal::SpinLockHolder l(&exit_hooks_lock);
+      if (hook->identity != nullptr) {
+        if (hook->prev != nullptr) {
+          hook->prev->next = hook->next;
+        } else {
+          hook->identity->exit_hooks = hook->next;
+        }
+        if (hook->next != nullptr) {
+          hook->next->prev = hook->prev;
+        }
+        hook->identity = nullptr;
+        hook->prev = hook->next = nullptr;
+        return;
+      }
+      // Wait for an exiting thread to finish with the hook, after which
+      // the caller may free it.
+      if (!RunningElsewhere(hook)) {
+        return;
+      }
+    }
+    std::this_thread::yield();
+  }
+}
+
+threading_internal::ThreadExitHook* FindThreadExitHook(const void* owner) {
+  threading_internal::ThreadIdentity* identity = CallerIdentityIfPresent();
+  if (identity == nullptr) {
+    return nullptr;
+  }
+  threading_internal::SpinLockHolder l(&exit_hooks_lock);
+  for (threading_internal::ThreadExitHook* hook = identity->exit_hooks;
+       hook != nullptr; hook = hook->next) {
+    if (hook->owner == owner) {
+      return hook;
+    }
+  }
+  return nullptr;
+}
+
 // A per-thread destructor for reclaiming associated ThreadIdentity objects.
 // Since we must preserve their storage we cache them for re-use.
 void ReclaimThreadIdentity(void* v) {
     threading_internal::ThreadIdentity* identity =
       static_cast<threading_internal::ThreadIdentity*>(v);
 
+  // Exit hooks may still need the identity, so they run first.
+  RunThreadExitHooks(identity);
+
   // all_locks might have been allocated by the mutex implementation.
   // We free it here when we are notified that our thread is dying.
   if (identity->per_thread_synch.all_locks != nullptr) {
@@ -79,6 +208,7 @@ static void ResetThreadIdentity(threading_internal::ThreadIdentity* identity) {
   identity->ticker.store(0, std::memory_order_relaxed);
   identity->wait_start.store(0, std::memory_order_relaxed);
   identity->is_idle.store(false, std::memory_order_relaxed);
+  identity->exit_hooks = nullptr;
   identity->next = nullptr;
 }
 
@@ -40,6 +40,22 @@ threading_internal::ThreadIdentity* CreateThreadIdentity();
 // For private use only.
 void ReclaimThreadIdentity(void* v);
 
+// Arranges for `hook->on_exit(hook)` to run when the calling thread exits.
+// The hook must stay valid until it has run or has been unregistered.
+// `on_exit` runs without the hook registry locked; it may register and
+// unregister hooks, and hooks it registers run too. Hooks do not run for the
+// main thread.
+void RegisterThreadExitHook(threading_internal::ThreadExitHook* hook);
+
+// Removes `hook` if it has not run yet. May be called from any thread. If
+// the hook is running on an exiting thread, waits for it to finish, so the
+// hook may be freed once this returns.
+void UnregisterThreadExitHook(threading_internal::ThreadExitHook* hook);
+
+// Returns the calling thread's registered hook with the given `owner`, or
+// nullptr if there is none.
+threading_internal::ThreadExitHook* FindThreadExitHook(const void* owner);
+
 // Returns the ThreadIdentity object representing the calling thread; guaranteed
 // to be unique for its lifetime.  The returned object will remain valid for the
 // program's lifetime; although it may be re-assigned to a subsequent thread.
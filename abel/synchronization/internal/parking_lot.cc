@@ -0,0 +1,124 @@
+//
+
+#include <abel/synchronization/internal/parking_lot.h>
+
+#include <cassert>
+
+#include <abel/synchronization/internal/create_thread_identity.h>
+#include <abel/synchronization/internal/per_thread_sem.h>
+
+namespace abel {
+
+namespace synchronization_internal {
+
+ParkingLot::ParkingLot() : head_(nullptr), tail_(nullptr), waiters_(0) {}
+
+ParkingLot::~ParkingLot() { assert(head_ == nullptr); }
+
+void ParkingLot::Enqueue(Waiter *w) {
+  w->identity = GetOrCreateCurrentThreadIdentity();
+  w->next = nullptr;
+  w->notified = false;
+  {
+    threading_internal::SpinLockHolder l(&lock_);
+    w->prev = tail_;
+    if (tail_ != nullptr) {
+      tail_->next = w;
+    } else {
+      head_ = w;
+    }
+    tail_ = w;
+    waiters_.fetch_add(1, std::memory_order_relaxed);
+  }
+  // Pairs with the fence in NotifyOne(): either the waiter's re-check sees
+  // the notifier's state change, or the notifier sees the waiter.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+bool ParkingLot::Sleep(Waiter *w, KernelTimeout t) {
+  while (true) {
+    const bool posted = PerThreadSem::wait(t);
+    {
+      threading_internal::SpinLockHolder l(&lock_);
+      if (!w->notified) {
+        if (!posted) {
+          // Timed out while still linked.
+          UnlinkLocked(w);
+          return false;
+        }
+        // A post left over from another user of the semaphore; keep
+        // sleeping.
+        continue;
+      }
+    }
+    if (!posted) {
+      // A notifier unlinked `w` after the wait timed out. Absorb its post,
+      // which may not have been made yet, so that it cannot wake an
+      // unrelated wait later.
+      PerThreadSem::wait(KernelTimeout::Never());
+    }
+    return true;
+  }
+}
+
+void ParkingLot::Cancel(Waiter *w) {
+  {
+    threading_internal::SpinLockHolder l(&lock_);
+    if (!w->notified) {
+      UnlinkLocked(w);
+      return;
+    }
+  }
+  PerThreadSem::wait(KernelTimeout::Never());
+}
+
+void ParkingLot::UnlinkLocked(Waiter *w) {
+  if (w->prev != nullptr) {
+    w->prev->next = w->next;
+  } else {
+    head_ = w->next;
+  }
+  if (w->next != nullptr) {
+    w->next->prev = w->prev;
+  } else {
+    tail_ = w->prev;
+  }
+  waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+threading_internal::ThreadIdentity *ParkingLot::PopLocked() {
+  Waiter *w = head_;
+  assert(w != nullptr);
+  UnlinkLocked(w);
+  w->notified = true;
+  // `w` lives on the waiter's stack and may be gone once lock_ is released.
+  return w->identity;
+}
+
+void ParkingLot::NotifyOne() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiters_.load(std::memory_order_relaxed) == 0) return;
+  threading_internal::ThreadIdentity *identity = nullptr;
+  {
+    threading_internal::SpinLockHolder l(&lock_);
+    if (head_ != nullptr) identity = PopLocked();
+  }
+  if (identity != nullptr) PerThreadSem::Post(identity);
+}
+
+void ParkingLot::NotifyAll() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  while (waiters_.load(std::memory_order_relaxed) != 0) {
+    threading_internal::ThreadIdentity *identity = nullptr;
+    {
+      threading_internal::SpinLockHolder l(&lock_);
+      if (head_ == nullptr) return;
+      identity = PopLocked();
+    }
+    PerThreadSem::Post(identity);
+  }
+}
+
+}  // namespace synchronization_internal
+
+}  // namespace abel
@@ -0,0 +1,112 @@
+//
+
+// ParkingLot is a list of threads blocked on a condition that is published
+// through atomics rather than under a mutex, such as the fullness of a
+// lock-free queue. Threads sleep on their PerThreadSem, so a waiter costs no
+// allocation and a notifier that finds no waiters does a single load.
+//
+// The waiting side registers itself before re-checking its condition and the
+// notifying side publishes its state change before looking for waiters, so a
+// wakeup cannot be lost between the check and the sleep:
+//
+//   // Waiter                          // Notifier
+//   lot.WaitUntil([&] {                publish();  // e.g. a release store
+//     return condition(); });          lot.NotifyOne();
+//
+// This is NOT a general-purpose synchronization mechanism. Applications should
+// use mutex and cond_var.
+
+#ifndef ABEL_SYNCHRONIZATION_INTERNAL_PARKING_LOT_H_
+#define ABEL_SYNCHRONIZATION_INTERNAL_PARKING_LOT_H_
+
+#include <atomic>
+
+#include <abel/base/profile.h>
+#include <abel/threading/internal/spinlock.h>
+#include <abel/threading/internal/thread_identity.h>
+#include <abel/synchronization/internal/kernel_timeout.h>
+
+namespace abel {
+
+namespace synchronization_internal {
+
+class ParkingLot {
+ public:
+  ParkingLot();
+  ParkingLot(const ParkingLot &) = delete;
+  ParkingLot &operator=(const ParkingLot &) = delete;
+  ~ParkingLot();
+
+  // Blocks the calling thread until `ready()` returns true or `t` expires.
+  // `ready()` is re-evaluated after every wakeup, which may be spurious.
+  // Returns the last value of `ready()`.
+  template <typename Predicate>
+  bool WaitUntil(Predicate ready, KernelTimeout t = KernelTimeout::Never());
+
+  // Wakes one blocked thread, if there is any. The caller must have published
+  // the state change that the waiters check for before calling this.
+  void NotifyOne();
+
+  // Wakes all blocked threads.
+  void NotifyAll();
+
+  // Returns true if a thread may be blocked. Intended for tests.
+  bool HasWaiters() const {
+    return waiters_.load(std::memory_order_relaxed) != 0;
+  }
+
+ private:
+  struct Waiter {
+    threading_internal::ThreadIdentity *identity;
+    Waiter *prev;
+    Waiter *next;
+    // Set under `lock_` when the waiter is unlinked by a notifier, which
+    // posts to `identity` once.
+    bool notified;
+  };
+
+  // Links `w` to the list on behalf of the calling thread.
+  void Enqueue(Waiter *w);
+
+  // Sleeps until `w` is notified or `t` expires. Returns false on timeout,
+  // in which case `w` has been unlinked. A notification that races with the
+  // timeout wins, and its post is consumed before returning.
+  bool Sleep(Waiter *w, KernelTimeout t);
+
+  // Unlinks `w` if no notifier did. Otherwise absorbs the post that the
+  // notifier made, so that it cannot wake an unrelated wait later.
+  void Cancel(Waiter *w);
+
+  // Removes `w` from the list. REQUIRES: lock_ held.
+  void UnlinkLocked(Waiter *w);
+
+  // Unlinks the oldest waiter. REQUIRES: lock_ held and a waiter exists.
+  threading_internal::ThreadIdentity *PopLocked();
+
+  threading_internal::SpinLock lock_;
+  Waiter *head_;
+  Waiter *tail_;
+  std::atomic<int> waiters_;
+};
+
+template <typename Predicate>
+bool ParkingLot::WaitUntil(Predicate ready, KernelTimeout t) {
+  while (!ready()) {
+    Waiter w;
+    Enqueue(&w);
+    if (ready()) {
+      Cancel(&w);
+      return true;
+    }
+    if (!Sleep(&w, t)) {
+      return ready();
+    }
+  }
+  return true;
+}
+
+}  // namespace synchronization_internal
+
+}  // namespace abel
+
+#endif  // ABEL_SYNCHRONIZATION_INTERNAL_PARKING_LOT_H_
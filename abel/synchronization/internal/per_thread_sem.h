@@ -67,6 +67,7 @@ class PerThreadSem {
 
   // White-listed callers.
   friend class PerThreadSemTest;
+  friend class ParkingLot;
   friend class abel::mutex;
   friend abel::threading_internal::ThreadIdentity* CreateThreadIdentity();
   friend void ReclaimThreadIdentity(void* v);
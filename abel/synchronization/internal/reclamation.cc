@@ -0,0 +1,138 @@
+//
+
+#include <abel/synchronization/internal/reclamation.h>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include <abel/synchronization/internal/create_thread_identity.h>
+
+namespace abel {
+
+namespace synchronization_internal {
+
+namespace {
+
+std::atomic<uint64_t> next_domain_id(1);
+
+}  // namespace
+
+void FreeRetired(std::vector<RetiredObject>* objects) {
+  for (const RetiredObject& r : *objects) {
+    r.deleter(r.ptr);
+  }
+  objects->clear();
+}
+
+ReclamationDomain::ReclamationDomain()
+    : id_(next_domain_id.fetch_add(1, std::memory_order_relaxed)),
+      records_(nullptr),
+      record_count_(0),
+      has_orphans_(false) {}
+
+ReclamationDomain::~ReclamationDomain() {
+  ReclamationRecord* record = records_.load(std::memory_order_relaxed);
+  while (record != nullptr) {
+    ReclamationRecord* next = record->domain_next;
+    delete record;
+    record = next;
+  }
+}
+
+void ReclamationDomain::Shutdown() {
+  for (ReclamationRecord* record = records(); record != nullptr;
+       record = record->domain_next) {
+    UnregisterThreadExitHook(record);
+    FreeRetired(&record->retired);
+  }
+  threading_internal::SpinLockHolder l(&orphans_lock_);
+  FreeRetired(&orphans_);
+}
+
+ReclamationRecord* ReclamationDomain::CurrentRecordSlow() {
+  CachedRecord* cached = Cached();
+  int hit = 1;
+  while (hit < kCachedRecords && cached[hit].domain_id != id_) {
+    ++hit;
+  }
+  if (hit < kCachedRecords) {
+    const CachedRecord entry = cached[hit];
+    std::copy_backward(cached, cached + hit, cached + hit + 1);
+    cached[0] = entry;
+    return entry.record;
+  }
+
+  ReclamationRecord* record =
+      static_cast<ReclamationRecord*>(FindThreadExitHook(this));
+  if (record == nullptr) {
+    for (ReclamationRecord* r = records(); r != nullptr; r = r->domain_next) {
+      bool expected = false;
+      if (!r->in_use.load(std::memory_order_relaxed) &&
+          r->in_use.compare_exchange_strong(expected, true,
+                                            std::memory_order_acquire)) {
+        record = r;
+        break;
+      }
+    }
+    if (record == nullptr) {
+      record = NewRecord();
+      record->domain = this;
+      record->in_use.store(true, std::memory_order_relaxed);
+      ReclamationRecord* head = records_.load(std::memory_order_relaxed);
+      do {
+        record->domain_next = head;
+      } while (!records_.compare_exchange_weak(head, record,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+      record_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    record->on_exit = &ReclamationDomain::OnThreadExit;
+    record->owner = this;
+    RegisterThreadExitHook(record);
+  }
+  // Evict the least recently used entry.
+  std::copy_backward(cached, cached + kCachedRecords - 1,
+                     cached + kCachedRecords);
+  cached[0] = {id_, record};
+  return record;
+}
+
+void ReclamationDomain::OnThreadExit(threading_internal::ThreadExitHook* hook) {
+  ReclamationRecord* record = static_cast<ReclamationRecord*>(hook);
+  // Hooks run on the exiting thread.
+  CachedRecord* cached = Cached();
+  for (int i = 0; i < kCachedRecords; ++i) {
+    if (cached[i].record == record) {
+      cached[i] = {0, nullptr};
+    }
+  }
+  record->domain->Release(record);
+}
+
+void ReclamationDomain::Release(ReclamationRecord* record) {
+  if (!record->retired.empty()) {
+    threading_internal::SpinLockHolder l(&orphans_lock_);
+    orphans_.insert(orphans_.end(), record->retired.begin(),
+                    record->retired.end());
+    has_orphans_.store(true, std::memory_order_relaxed);
+  }
+  record->retired.clear();
+  record->retired.shrink_to_fit();
+  ResetRecord(record);
+  record->in_use.store(false, std::memory_order_release);
+}
+
+void ReclamationDomain::AdoptOrphans(std::vector<RetiredObject>* out) {
+  if (!has_orphans_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  threading_internal::SpinLockHolder l(&orphans_lock_);
+  out->insert(out->end(), orphans_.begin(), orphans_.end());
+  orphans_.clear();
+  has_orphans_.store(false, std::memory_order_relaxed);
+}
+
+}  // namespace synchronization_internal
+
+}  // namespace abel
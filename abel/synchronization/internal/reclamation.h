@@ -0,0 +1,124 @@
+//
+// Shared machinery of the memory reclamation domains in hazard_pointer.h and
+// epoch.h: per-thread records, retire lists, and hand-over of the retire list
+// of an exiting thread.
+
+#ifndef ABEL_SYNCHRONIZATION_INTERNAL_RECLAMATION_H_
+#define ABEL_SYNCHRONIZATION_INTERNAL_RECLAMATION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <abel/base/profile.h>
+#include <abel/threading/internal/spinlock.h>
+#include <abel/threading/internal/thread_identity.h>
+
+namespace abel {
+
+namespace synchronization_internal {
+
+class ReclamationDomain;
+
+// An object waiting to be reclaimed.
+struct RetiredObject {
+  void* ptr;
+  void (*deleter)(void*);
+  // Domain specific; the epoch at which it was retired for epoch domains.
+  uint64_t tag;
+};
+
+// A thread's state in one domain. Records are allocated on a thread's first
+// use of a domain, taken back when it exits, and reused by later threads.
+// They are freed with the domain. The hook is registered while a thread holds
+// the record.
+struct ReclamationRecord : threading_internal::ThreadExitHook {
+  ReclamationRecord() : threading_internal::ThreadExitHook() {}
+  ReclamationRecord(const ReclamationRecord&) = delete;
+  ReclamationRecord& operator=(const ReclamationRecord&) = delete;
+  virtual ~ReclamationRecord() = default;
+
+  ReclamationDomain* domain = nullptr;
+  std::atomic<bool> in_use{false};
+  // Link in the domain's list; set before the record is published.
+  ReclamationRecord* domain_next = nullptr;
+  // Only accessed by the thread holding the record.
+  std::vector<RetiredObject> retired;
+};
+
+class ReclamationDomain {
+ public:
+  ReclamationDomain(const ReclamationDomain&) = delete;
+  ReclamationDomain& operator=(const ReclamationDomain&) = delete;
+
+ protected:
+  ReclamationDomain();
+  // Frees the records. Derived destructors must call Shutdown() first.
+  virtual ~ReclamationDomain();
+
+  // Returns the calling thread's record, acquiring one on first use. A
+  // thread caches its records of the kCachedRecords domains it used last,
+  // so code alternating between a few domains stays off the hook registry.
+  ABEL_FORCE_INLINE ReclamationRecord* CurrentRecord() {
+    CachedRecord* cached = Cached();
+    if (ABEL_LIKELY(cached[0].domain_id == id_)) {
+      return cached[0].record;
+    }
+    return CurrentRecordSlow();
+  }
+
+  virtual ReclamationRecord* NewRecord() = 0;
+  // Called when a record is given back, on the exiting thread or by the
+  // destructor. The retired list has already been moved to the orphans.
+  virtual void ResetRecord(ReclamationRecord* record) = 0;
+
+  // Appends the retired objects of exited threads to `out`.
+  void AdoptOrphans(std::vector<RetiredObject>* out);
+
+  // Records are never unlinked, so the list may be walked at any time.
+  ReclamationRecord* records() const {
+    return records_.load(std::memory_order_acquire);
+  }
+  size_t record_count() const {
+    return record_count_.load(std::memory_order_relaxed);
+  }
+
+  // Takes the records back from the threads still holding them and frees
+  // every retired object. No thread may use the domain any more.
+  void Shutdown();
+
+ private:
+  friend class ReclamationDomainPeer;
+
+  struct CachedRecord {
+    uint64_t domain_id;
+    ReclamationRecord* record;
+  };
+  enum { kCachedRecords = 4 };
+  // Most recently used first.
+  static CachedRecord* Cached() {
+    static thread_local CachedRecord cached[kCachedRecords] = {};
+    return cached;
+  }
+
+  ReclamationRecord* CurrentRecordSlow();
+  static void OnThreadExit(threading_internal::ThreadExitHook* hook);
+  void Release(ReclamationRecord* record);
+
+  // Never reused, unlike addresses, so stale thread caches cannot match.
+  const uint64_t id_;
+  std::atomic<ReclamationRecord*> records_;
+  std::atomic<size_t> record_count_;
+  threading_internal::SpinLock orphans_lock_;
+  std::vector<RetiredObject> orphans_;
+  std::atomic<bool> has_orphans_;
+};
+
+// Calls the deleter of every object in `objects` and clears it.
+void FreeRetired(std::vector<RetiredObject>* objects);
+
+}  // namespace synchronization_internal
+
+}  // namespace abel
+
+#endif  // ABEL_SYNCHRONIZATION_INTERNAL_RECLAMATION_H_
@@ -121,6 +121,20 @@ struct PerThreadSynch {
   SynchLocksHeld *all_locks;
 };
 
+// A callback that runs on a thread when it exits, from the reclaimer of its
+// ThreadIdentity. Facilities that keep per-thread records use it to give them
+// back. See RegisterThreadExitHook() in create_thread_identity.h.
+struct ThreadExitHook {
+  void (*on_exit)(ThreadExitHook* hook);
+  // Identifies the facility that registered the hook.
+  const void* owner;
+
+  // Private: maintained by the hook registry.
+  ThreadIdentity* identity;
+  ThreadExitHook* prev;
+  ThreadExitHook* next;
+};
+
 struct ThreadIdentity {
   // Must be the first member.  The mutex implementation requires that
   // the PerThreadSynch object associated with each thread is
@@ -143,6 +157,9 @@ struct ThreadIdentity {
   std::atomic<int> wait_start;  // Ticker value when thread started waiting.
   std::atomic<bool> is_idle;    // Has thread become idle yet?
 
+  // Hooks to run when the thread exits; guarded by the hook registry lock.
+  ThreadExitHook* exit_hooks;
+
   ThreadIdentity* next;
 };
 
@@ -0,0 +1,170 @@
+//
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <abel/container/blocking_queue.h>
+#include <abel/container/mpmc_queue.h>
+#include <abel/container/spsc_queue.h>
+#include <abel/log/details/mpmc_blocking_q.h>
+#include <benchmark/benchmark.h>
+
+namespace {
+
+constexpr int64_t kStop = -1;
+
+template <typename Queue>
+void SpinPush(Queue* q, int64_t v) {
+  while (!q->try_push(v)) {
+  }
+}
+
+template <typename Queue>
+int64_t SpinPop(Queue* q) {
+  int64_t v;
+  while (!q->try_pop(v)) {
+  }
+  return v;
+}
+
+// One producer streams `state.range(0)` sized batches to one consumer thread.
+template <typename Queue>
+void BM_Throughput(benchmark::State& state) {
+  const size_t batch = state.range(0);
+  Queue q(1024);
+  std::thread consumer([&] {
+    std::vector<int64_t> out(batch);
+    while (true) {
+      const size_t n = q.try_pop_n(out.begin(), batch);
+      for (size_t i = 0; i < n; ++i) {
+        if (out[i] == kStop) return;
+      }
+    }
+  });
+  std::vector<int64_t> in(batch, 1);
+  for (auto _ : state) {
+    size_t pushed = 0;
+    while (pushed < batch) {
+      pushed += q.try_push_n(in.begin() + pushed, batch - pushed);
+    }
+  }
+  SpinPush(&q, kStop);
+  consumer.join();
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK_TEMPLATE(BM_Throughput, abel::spsc_queue<int64_t>)
+    ->UseRealTime()
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(256);
+BENCHMARK_TEMPLATE(BM_Throughput, abel::mpmc_queue<int64_t>)
+    ->UseRealTime()
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(256);
+
+// Every thread pushes and then pops one element, so all threads contend on
+// both ends of the queue.
+void BM_MpmcContended(benchmark::State& state) {
+  static auto* q = new abel::mpmc_queue<int64_t>(1024);
+  for (auto _ : state) {
+    SpinPush(q, 1);
+    benchmark::DoNotOptimize(SpinPop(q));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MpmcContended)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->ThreadPerCpu();
+
+// Round trip of one element through a pair of queues and an echo thread,
+// with both sides spinning.
+template <typename Queue>
+void BM_PingPongSpin(benchmark::State& state) {
+  Queue ping(16);
+  Queue pong(16);
+  std::thread echo([&] {
+    int64_t v;
+    do {
+      v = SpinPop(&ping);
+      SpinPush(&pong, v);
+    } while (v != kStop);
+  });
+  for (auto _ : state) {
+    SpinPush(&ping, 1);
+    benchmark::DoNotOptimize(SpinPop(&pong));
+  }
+  SpinPush(&ping, kStop);
+  SpinPop(&pong);
+  echo.join();
+}
+BENCHMARK_TEMPLATE(BM_PingPongSpin, abel::spsc_queue<int64_t>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PingPongSpin, abel::mpmc_queue<int64_t>)->UseRealTime();
+
+// The same round trip through blocking queues, where an idle side parks after
+// `state.range(0)` failed attempts.
+template <typename Queue>
+void BM_PingPongBlocking(benchmark::State& state) {
+  const int spins = state.range(0);
+  abel::blocking_queue<Queue> ping(16, spins);
+  abel::blocking_queue<Queue> pong(16, spins);
+  std::thread echo([&] {
+    int64_t v;
+    do {
+      v = ping.pop();
+      pong.push(v);
+    } while (v != kStop);
+  });
+  for (auto _ : state) {
+    ping.push(1);
+    benchmark::DoNotOptimize(pong.pop());
+  }
+  ping.push(kStop);
+  pong.pop();
+  echo.join();
+}
+BENCHMARK_TEMPLATE(BM_PingPongBlocking, abel::spsc_queue<int64_t>)
+    ->UseRealTime()
+    ->Arg(0)
+    ->Arg(128);
+BENCHMARK_TEMPLATE(BM_PingPongBlocking, abel::mpmc_queue<int64_t>)
+    ->UseRealTime()
+    ->Arg(0)
+    ->Arg(128);
+
+// Baseline: the mutex and condition variable queue used by the logger.
+void BM_PingPongLogQueue(benchmark::State& state) {
+  using Queue = abel::log::details::mpmc_blocking_queue<int64_t>;
+  Queue ping(16);
+  Queue pong(16);
+  const std::chrono::milliseconds wait(100);
+  std::thread echo([&] {
+    int64_t v = 0;
+    do {
+      while (!ping.dequeue_for(v, wait)) {
+      }
+      int64_t copy = v;
+      pong.enqueue(std::move(copy));
+    } while (v != kStop);
+  });
+  int64_t v = 0;
+  for (auto _ : state) {
+    ping.enqueue(1);
+    while (!pong.dequeue_for(v, wait)) {
+    }
+    benchmark::DoNotOptimize(v);
+  }
+  ping.enqueue(int64_t(kStop));
+  while (!pong.dequeue_for(v, wait)) {
+  }
+  echo.join();
+}
+BENCHMARK(BM_PingPongLogQueue)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,106 @@
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <abel/container/delta_packed_vector.h>
+#include <abel/container/packed_int_vector.h>
+
+namespace {
+
+// Sorted ids with gaps uniform in [1, max_gap].
+std::vector<uint64_t> SortedIds(size_t n, uint64_t max_gap, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<uint64_t> v(n);
+  uint64_t x = 0;
+  for (auto& e : v) {
+    x += 1 + rng() % max_gap;
+    e = x;
+  }
+  return v;
+}
+
+// Decode speed and compression for a range of gaps.
+void BM_DeltaPackedDecode(benchmark::State& state) {
+  const std::vector<uint64_t> ids = SortedIds(1 << 20, state.range(0), 1);
+  const abel::delta_packed_vector v(ids);
+  std::vector<uint64_t> out(ids.size());
+  for (auto _ : state) {
+    v.decode(out.data());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+  state.counters["bits_per_int"] = 8.0 * v.memory_bytes() / ids.size();
+  state.counters["ratio"] = static_cast<double>(ids.size() * sizeof(uint64_t)) / v.memory_bytes();
+}
+BENCHMARK(BM_DeltaPackedDecode)->Arg(2)->Arg(16)->Arg(256)->Arg(1 << 16);
+
+// The baseline: copying the uncompressed ids.
+void BM_VectorCopy(benchmark::State& state) {
+  const std::vector<uint64_t> ids = SortedIds(1 << 20, 16, 1);
+  std::vector<uint64_t> out(ids.size());
+  for (auto _ : state) {
+    std::copy(ids.begin(), ids.end(), out.begin());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_VectorCopy);
+
+void BM_DeltaPackedScan(benchmark::State& state) {
+  const std::vector<uint64_t> ids = SortedIds(1 << 20, 16, 1);
+  const abel::delta_packed_vector v(ids);
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    for (abel::delta_packed_vector::cursor c(v); c.valid(); c.next()) {
+      sum += c.value();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_DeltaPackedScan);
+
+void BM_DeltaPackedIntersect(benchmark::State& state) {
+  // A long and a short list, as with a common and a rare term.
+  const abel::delta_packed_vector a(SortedIds(1 << 20, 4, 1));
+  const abel::delta_packed_vector b(SortedIds(1 << 20 >> state.range(0), 4 << state.range(0), 2));
+  std::vector<uint64_t> out;
+  for (auto _ : state) {
+    out.clear();
+    abel::intersect(a, b, &out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.counters["matches"] = out.size();
+}
+BENCHMARK(BM_DeltaPackedIntersect)->Arg(0)->Arg(4)->Arg(10);
+
+void BM_VectorIntersect(benchmark::State& state) {
+  const std::vector<uint64_t> a = SortedIds(1 << 20, 4, 1);
+  const std::vector<uint64_t> b = SortedIds(1 << 20 >> state.range(0), 4 << state.range(0), 2);
+  std::vector<uint64_t> out;
+  for (auto _ : state) {
+    out.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    benchmark::DoNotOptimize(out.data());
+  }
+}
+BENCHMARK(BM_VectorIntersect)->Arg(0)->Arg(4)->Arg(10);
+
+void BM_PackedIntVectorGet(benchmark::State& state) {
+  std::mt19937_64 rng(3);
+  abel::packed_int_vector v(1 << 20, state.range(0));
+  for (size_t i = 0; i < v.size(); ++i) v.set(i, rng() & v.max_value());
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v.get(i));
+    i = (i + 7919) & (v.size() - 1);
+  }
+}
+BENCHMARK(BM_PackedIntVectorGet)->Arg(7)->Arg(33);
+
+}  // namespace
@@ -0,0 +1,79 @@
+//
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <abel/container/dynamic_bitset.h>
+#include <abel/container/rank_select.h>
+
+namespace {
+
+abel::dynamic_bitset RandomBits(size_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  abel::dynamic_bitset bits(n);
+  for (size_t i = 0; i < n; ++i) bits.set(i, rng() & 1);
+  return bits;
+}
+
+void BM_BitsetCount(benchmark::State& state) {
+  const abel::dynamic_bitset bits = RandomBits(state.range(0), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(bits.count());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+BENCHMARK(BM_BitsetCount)->Range(1 << 10, 1 << 22);
+
+void BM_BitsetAnd(benchmark::State& state) {
+  abel::dynamic_bitset a = RandomBits(state.range(0), 1);
+  const abel::dynamic_bitset b = RandomBits(state.range(0), 2);
+  for (auto _ : state) {
+    a &= b;
+    benchmark::DoNotOptimize(a.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+BENCHMARK(BM_BitsetAnd)->Range(1 << 10, 1 << 22);
+
+void BM_VectorBoolCount(benchmark::State& state) {
+  const abel::dynamic_bitset bits = RandomBits(state.range(0), 1);
+  std::vector<bool> v(bits.size());
+  for (size_t i = 0; i < bits.size(); ++i) v[i] = bits[i];
+  for (auto _ : state) {
+    size_t n = 0;
+    for (bool b : v) n += b;
+    benchmark::DoNotOptimize(n);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+BENCHMARK(BM_VectorBoolCount)->Range(1 << 10, 1 << 22);
+
+void BM_Rank(benchmark::State& state) {
+  const abel::dynamic_bitset bits = RandomBits(1 << 24, 1);
+  const abel::rank_select index(bits);
+  std::mt19937_64 rng(3);
+  std::vector<size_t> positions(4096);
+  for (auto& p : positions) p = rng() % bits.size();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index.rank1(positions[i++ & 4095]));
+  }
+}
+BENCHMARK(BM_Rank);
+
+void BM_Select(benchmark::State& state) {
+  const abel::dynamic_bitset bits = RandomBits(1 << 24, 1);
+  const abel::rank_select index(bits);
+  std::mt19937_64 rng(3);
+  std::vector<size_t> ranks(4096);
+  for (auto& r : ranks) r = rng() % index.num_ones();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index.select1(ranks[i++ & 4095]));
+  }
+}
+BENCHMARK(BM_Select);
+
+}  // namespace
@@ -1,7 +1,9 @@
 //
 
 #include <array>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <benchmark/benchmark.h>
@@ -793,3 +795,95 @@ ABEL_INTERNAL_BENCHMARK_TWO_SIZE(BM_Swap, TrivialType);
 ABEL_INTERNAL_BENCHMARK_TWO_SIZE(BM_Swap, NontrivialType);
 
 }  // namespace
+
+namespace {
+
+// A string-like type that owns a heap buffer. Only HeapString<true> opts in to
+// relocation with memcpy(); HeapString<false> is moved element by element.
+template <bool kRelocatable>
+class HeapString {
+ public:
+  HeapString() : data_(nullptr), size_(0) {}
+  HeapString(HeapString&& other) noexcept
+      : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+  HeapString& operator=(HeapString&& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+  ~HeapString() { delete[] data_; }
+
+ private:
+  char* data_;
+  size_t size_;
+};
+
+}  // namespace
+
+namespace abel {
+template <>
+struct is_trivially_relocatable<HeapString<true>> : std::true_type {};
+}  // namespace abel
+
+namespace {
+
+// Grows a vector element by element; every reallocation relocates the
+// elements.
+template <typename T>
+void BM_RelocateFill(benchmark::State& state) {
+  const int len = state.range(0);
+  for (auto _ : state) {
+    abel::InlinedVector<T, 8> v;
+    for (int i = 0; i < len; ++i) {
+      v.emplace_back();
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * len);
+}
+BENCHMARK_TEMPLATE(BM_RelocateFill, std::string)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_RelocateFill, std::unique_ptr<int>)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_RelocateFill, HeapString<false>)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_RelocateFill, HeapString<true>)->Range(8, 4096);
+
+// Erases the front element and appends it again, which shifts every other
+// element down by one.
+template <typename T>
+void BM_RelocateEraseFront(benchmark::State& state) {
+  const int len = state.range(0);
+  abel::InlinedVector<T, 8> v(len);
+  for (auto _ : state) {
+    T front = std::move(v.front());
+    v.erase(v.begin());
+    v.push_back(std::move(front));
+    benchmark::DoNotOptimize(v.data());
+  }
+}
+BENCHMARK_TEMPLATE(BM_RelocateEraseFront, std::string)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_RelocateEraseFront, std::unique_ptr<int>)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_RelocateEraseFront, HeapString<false>)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_RelocateEraseFront, HeapString<true>)->Range(8, 4096);
+
+// Moves the back element to the front, which shifts every other element up
+// by one.
+template <typename T>
+void BM_RelocateInsertFront(benchmark::State& state) {
+  const int len = state.range(0);
+  abel::InlinedVector<T, 8> v(len);
+  for (auto _ : state) {
+    T back = std::move(v.back());
+    v.pop_back();
+    v.insert(v.begin(), std::move(back));
+    benchmark::DoNotOptimize(v.data());
+  }
+}
+BENCHMARK_TEMPLATE(BM_RelocateInsertFront, std::string)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_RelocateInsertFront, std::unique_ptr<int>)
+    ->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_RelocateInsertFront, HeapString<false>)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_RelocateInsertFront, HeapString<true>)->Range(8, 4096);
+
+}  // namespace
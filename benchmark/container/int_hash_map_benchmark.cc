@@ -0,0 +1,101 @@
+//
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <abel/container/flat_hash_map.h>
+#include <abel/container/int_hash_map.h>
+
+namespace {
+
+// Dense keys are 0..n-1; sparse keys are random 64-bit integers.
+std::vector<uint64_t> MakeKeys(size_t n, bool dense, uint64_t seed) {
+  std::vector<uint64_t> keys(n);
+  std::mt19937_64 gen(seed);
+  for (size_t i = 0; i < n; ++i) {
+    keys[i] = dense ? i + seed * n : gen();
+  }
+  if (dense) {
+    // Look up in a random order.
+    for (size_t i = n; i > 1; --i) {
+      std::swap(keys[i - 1], keys[gen() % i]);
+    }
+  }
+  return keys;
+}
+
+template <class Map>
+void BM_Insert(benchmark::State& state) {
+  const auto keys = MakeKeys(state.range(0), state.range(1) != 0, 0);
+  for (auto _ : state) {
+    Map m;
+    for (uint64_t k : keys) m[k] = k;
+    benchmark::DoNotOptimize(m);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <class Map>
+void BM_LookupHit(benchmark::State& state) {
+  const auto keys = MakeKeys(state.range(0), state.range(1) != 0, 0);
+  Map m;
+  for (uint64_t k : keys) m[k] = k;
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    for (uint64_t k : keys) sum += m.find(k)->second;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <class Map>
+void BM_LookupMiss(benchmark::State& state) {
+  const auto keys = MakeKeys(state.range(0), state.range(1) != 0, 0);
+  const auto missing = MakeKeys(state.range(0), state.range(1) != 0, 1);
+  Map m;
+  for (uint64_t k : keys) m[k] = k;
+  for (auto _ : state) {
+    size_t found = 0;
+    for (uint64_t k : missing) found += m.count(k);
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * missing.size());
+}
+
+template <class Map>
+void BM_EraseInsert(benchmark::State& state) {
+  const auto keys = MakeKeys(state.range(0), state.range(1) != 0, 0);
+  Map m;
+  for (uint64_t k : keys) m[k] = k;
+  for (auto _ : state) {
+    for (uint64_t k : keys) {
+      m.erase(k);
+      m[k] = k;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+using IntMap = abel::int_hash_map<uint64_t, uint64_t>;
+using FlatMap = abel::flat_hash_map<uint64_t, uint64_t>;
+
+// {size, dense}
+void Args(benchmark::internal::Benchmark* b) {
+  for (int dense : {1, 0}) {
+    for (int n : {1 << 10, 1 << 16, 1 << 20}) b->Args({n, dense});
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Insert, IntMap)->Apply(Args);
+BENCHMARK_TEMPLATE(BM_Insert, FlatMap)->Apply(Args);
+BENCHMARK_TEMPLATE(BM_LookupHit, IntMap)->Apply(Args);
+BENCHMARK_TEMPLATE(BM_LookupHit, FlatMap)->Apply(Args);
+BENCHMARK_TEMPLATE(BM_LookupMiss, IntMap)->Apply(Args);
+BENCHMARK_TEMPLATE(BM_LookupMiss, FlatMap)->Apply(Args);
+BENCHMARK_TEMPLATE(BM_EraseInsert, IntMap)->Apply(Args);
+BENCHMARK_TEMPLATE(BM_EraseInsert, FlatMap)->Apply(Args);
+
+}  // namespace
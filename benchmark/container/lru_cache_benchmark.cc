@@ -0,0 +1,119 @@
+//
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <abel/container/concurrent_cache.h>
+#include <abel/container/lru_cache.h>
+#include <abel/random/random.h>
+#include <abel/random/zipf_distribution.h>
+
+namespace {
+
+constexpr size_t kKeySpace = 1 << 20;
+constexpr size_t kCapacity = 1 << 14;
+
+// Keys with a Zipfian popularity, as seen by most caches.
+const std::vector<uint64_t> &ZipfKeys() {
+  static const std::vector<uint64_t> *keys = [] {
+    abel::InsecureBitGen gen;
+    abel::zipf_distribution<uint64_t> zipf(kKeySpace, 1.1);
+    auto *v = new std::vector<uint64_t>(1 << 16);
+    for (auto &k : *v) k = zipf(gen);
+    return v;
+  }();
+  return *keys;
+}
+
+// The usual hand-rolled LRU, for comparison.
+class ListLru {
+ public:
+  explicit ListLru(size_t capacity) : capacity_(capacity) {}
+
+  const uint64_t* Get(uint64_t key) {
+    std::lock_guard<std::mutex> l(mu_);
+    auto it = map_.find(key);
+    if (it == map_.end()) return nullptr;
+    list_.splice(list_.begin(), list_, it->second);
+    return &it->second->second;
+  }
+
+  void Put(uint64_t key, uint64_t value) {
+    std::lock_guard<std::mutex> l(mu_);
+    list_.emplace_front(key, value);
+    map_[key] = list_.begin();
+    if (map_.size() > capacity_) {
+      map_.erase(list_.back().first);
+      list_.pop_back();
+    }
+  }
+
+ private:
+  using List = std::list<std::pair<uint64_t, uint64_t>>;
+  std::mutex mu_;
+  size_t capacity_;
+  List list_;
+  std::unordered_map<uint64_t, List::iterator> map_;
+};
+
+void BM_ListLruZipf(benchmark::State& state) {
+  const std::vector<uint64_t>& keys = ZipfKeys();
+  ListLru cache(kCapacity);
+  size_t i = 0, hits = 0, lookups = 0;
+  for (auto _ : state) {
+    const uint64_t key = keys[i++ & (keys.size() - 1)];
+    if (const uint64_t* v = cache.Get(key)) {
+      benchmark::DoNotOptimize(*v);
+      ++hits;
+    } else {
+      cache.Put(key, key);
+    }
+    ++lookups;
+  }
+  state.counters["hit_rate"] = static_cast<double>(hits) / lookups;
+}
+BENCHMARK(BM_ListLruZipf);
+
+void BM_LruCacheZipf(benchmark::State& state) {
+  const std::vector<uint64_t>& keys = ZipfKeys();
+  abel::lru_cache<uint64_t, uint64_t> cache(kCapacity);
+  size_t i = 0;
+  for (auto _ : state) {
+    const uint64_t key = keys[i++ & (keys.size() - 1)];
+    if (const uint64_t* v = cache.get(key)) {
+      benchmark::DoNotOptimize(*v);
+    } else {
+      cache.put(key, key);
+    }
+  }
+  state.counters["hit_rate"] = cache.stats().hit_rate();
+}
+BENCHMARK(BM_LruCacheZipf);
+
+abel::concurrent_cache<uint64_t, uint64_t>* shared_cache = nullptr;
+
+void BM_ConcurrentCacheZipf(benchmark::State& state) {
+  if (state.thread_index == 0) {
+    shared_cache = new abel::concurrent_cache<uint64_t, uint64_t>(kCapacity);
+  }
+  const std::vector<uint64_t>& keys = ZipfKeys();
+  size_t i = static_cast<size_t>(state.thread_index) * 7919;
+  for (auto _ : state) {
+    const uint64_t key = keys[i++ & (keys.size() - 1)];
+    benchmark::DoNotOptimize(
+        shared_cache->get_or_load(key, [key] { return key; }));
+  }
+  if (state.thread_index == 0) {
+    state.counters["hit_rate"] = shared_cache->stats().hit_rate();
+    delete shared_cache;
+    shared_cache = nullptr;
+  }
+}
+BENCHMARK(BM_ConcurrentCacheZipf)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace
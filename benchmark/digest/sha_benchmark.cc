@@ -0,0 +1,187 @@
+//
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+#include <abel/digest/digest_file.h>
+#include <abel/digest/internal/sha_simd.h>
+#include <abel/digest/sha1.h>
+#include <abel/digest/sha256.h>
+
+namespace {
+
+std::string random_bytes (size_t size) {
+    std::mt19937 rng(static_cast<unsigned>(size));
+    std::string s(size, '\0');
+    for (char &c : s) {
+        c = static_cast<char>(rng());
+    }
+    return s;
+}
+
+const uint8_t *bytes (const std::string &s) {
+    return reinterpret_cast<const uint8_t *>(s.data());
+}
+
+void MessageSizes (benchmark::internal::Benchmark *b) {
+    for (int size : {64, 256, 1024, 8 << 10, 1 << 20}) {
+        b->Arg(size);
+    }
+}
+
+// The block functions alone, over whole blocks.
+void BM_Sha1Blocks (benchmark::State &state, const abel::digest_detail::sha_kernels *kernels) {
+    if (kernels == nullptr) {
+        state.SkipWithError("not supported on this CPU");
+        return;
+    }
+    const std::string data = random_bytes(state.range(0));
+    uint32_t s[5] = {};
+    for (auto _ : state) {
+        kernels->sha1_blocks(s, bytes(data), data.size() / 64);
+        benchmark::DoNotOptimize(s);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+void BM_Sha256Blocks (benchmark::State &state, const abel::digest_detail::sha_kernels *kernels) {
+    if (kernels == nullptr) {
+        state.SkipWithError("not supported on this CPU");
+        return;
+    }
+    const std::string data = random_bytes(state.range(0));
+    uint32_t s[8] = {};
+    for (auto _ : state) {
+        kernels->sha256_blocks(s, bytes(data), data.size() / 64);
+        benchmark::DoNotOptimize(s);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+const abel::digest_detail::sha_kernels *scalar_kernels () {
+    return &abel::digest_detail::sha_scalar_kernels();
+}
+
+const abel::digest_detail::sha_kernels *ni_kernels () {
+    return abel::digest_detail::cpu_supports_sha_ni() ? abel::digest_detail::sha_ni_kernels()
+                                                      : nullptr;
+}
+
+BENCHMARK_CAPTURE(BM_Sha1Blocks, scalar, scalar_kernels())->Apply(MessageSizes);
+BENCHMARK_CAPTURE(BM_Sha1Blocks, sha_ni, ni_kernels())->Apply(MessageSizes);
+BENCHMARK_CAPTURE(BM_Sha256Blocks, scalar, scalar_kernels())->Apply(MessageSizes);
+BENCHMARK_CAPTURE(BM_Sha256Blocks, sha_ni, ni_kernels())->Apply(MessageSizes);
+
+// The public classes, which pick the best block functions.
+void BM_Sha1 (benchmark::State &state) {
+    const std::string data = random_bytes(state.range(0));
+    char digest[abel::SHA1::kDigestLength];
+    for (auto _ : state) {
+        abel::SHA1 h(data);
+        h.finalize(digest);
+        benchmark::DoNotOptimize(digest);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_Sha1)->Apply(MessageSizes);
+
+void BM_Sha256 (benchmark::State &state) {
+    const std::string data = random_bytes(state.range(0));
+    char digest[abel::SHA256::kDigestLength];
+    for (auto _ : state) {
+        abel::SHA256 h(data);
+        h.finalize(digest);
+        benchmark::DoNotOptimize(digest);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_Sha256)->Apply(MessageSizes);
+
+// A batch of 1024 messages of range(0) bytes.
+struct batch {
+    explicit batch (size_t size) : storage(1024, random_bytes(size)),
+                                   views(storage.begin(), storage.end()),
+                                   digests(32 * storage.size()) {}
+    size_t total () const { return storage.size() * storage[0].size(); }
+
+    std::vector<std::string> storage;
+    std::vector<abel::string_view> views;
+    std::vector<uint8_t> digests;
+};
+
+void BatchSizes (benchmark::internal::Benchmark *b) {
+    for (int size : {64, 256, 1024}) {
+        b->Arg(size);
+    }
+}
+
+void BM_Sha256Batch_OneByOne (benchmark::State &state) {
+    batch b(state.range(0));
+    for (auto _ : state) {
+        for (size_t i = 0; i < b.storage.size(); ++i) {
+            abel::SHA256(b.storage[i]).finalize(&b.digests[32 * i]);
+        }
+        benchmark::DoNotOptimize(b.digests.data());
+    }
+    state.SetBytesProcessed(state.iterations() * b.total());
+}
+BENCHMARK(BM_Sha256Batch_OneByOne)->Apply(BatchSizes);
+
+void BM_Sha256Batch_Many (benchmark::State &state) {
+    batch b(state.range(0));
+    for (auto _ : state) {
+        abel::sha256_many(b.views, b.digests.data());
+        benchmark::DoNotOptimize(b.digests.data());
+    }
+    state.SetBytesProcessed(state.iterations() * b.total());
+}
+BENCHMARK(BM_Sha256Batch_Many)->Apply(BatchSizes);
+
+// The AVX2 lanes whether or not sha256_many() would pick them.
+void BM_Sha256Batch_Avx2Lanes (benchmark::State &state) {
+    abel::digest_detail::sha256_x8_kernel kernel = abel::digest_detail::sha256_x8_avx2_kernel();
+    if (kernel == nullptr || !abel::digest_detail::cpu_supports_avx2()) {
+        state.SkipWithError("not supported on this CPU");
+        return;
+    }
+    batch b(state.range(0));
+    for (auto _ : state) {
+        abel::digest_detail::sha256_many_x8(kernel, b.views, b.digests.data());
+        benchmark::DoNotOptimize(b.digests.data());
+    }
+    state.SetBytesProcessed(state.iterations() * b.total());
+}
+BENCHMARK(BM_Sha256Batch_Avx2Lanes)->Apply(BatchSizes);
+
+// A file in the page cache, against the same bytes in memory.
+void BM_Sha256File (benchmark::State &state) {
+    const std::string data = random_bytes(state.range(0));
+    char path[] = "/tmp/sha_benchmark.XXXXXX";
+    const int fd = ::mkstemp(path);
+    if (fd < 0 || ::write(fd, data.data(), data.size()) != ssize_t(data.size())) {
+        state.SkipWithError("cannot write the file");
+        return;
+    }
+    for (auto _ : state) {
+        abel::SHA256 h;
+        std::error_code ec;
+        ::lseek(fd, 0, SEEK_SET);
+        abel::digest_fd(h, fd, ec);
+        char digest[abel::SHA256::kDigestLength];
+        h.finalize(digest);
+        benchmark::DoNotOptimize(digest);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    ::close(fd);
+    ::unlink(path);
+}
+BENCHMARK(BM_Sha256File)->Arg(64 << 20);
+BENCHMARK(BM_Sha256)->Arg(64 << 20);
+
+}  // namespace
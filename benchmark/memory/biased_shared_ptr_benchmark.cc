@@ -0,0 +1,95 @@
+//
+
+#include <memory>
+#include <vector>
+
+#include <abel/memory/biased_shared_ptr.h>
+#include <abel/memory/shared_ptr.h>
+#include <benchmark/benchmark.h>
+
+namespace {
+
+template <typename Ptr>
+Ptr Make(int v);
+
+template <>
+std::shared_ptr<int> Make(int v) {
+  return std::make_shared<int>(v);
+}
+
+template <>
+abel::lw_shared_ptr<int> Make(int v) {
+  return abel::make_lw_shared<int>(v);
+}
+
+template <>
+abel::biased_shared_ptr<int> Make(int v) {
+  return abel::make_biased_shared<int>(v);
+}
+
+// Copies and drops a pointer on the thread that created the object, the
+// common case that biased counting is built for.
+template <typename Ptr>
+void BM_CopyOwner(benchmark::State& state) {
+  Ptr p = Make<Ptr>(1);
+  for (auto _ : state) {
+    Ptr q = p;
+    benchmark::DoNotOptimize(q);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_CopyOwner, std::shared_ptr<int>);
+BENCHMARK_TEMPLATE(BM_CopyOwner, abel::lw_shared_ptr<int>);
+BENCHMARK_TEMPLATE(BM_CopyOwner, abel::biased_shared_ptr<int>);
+
+// Creates an object, copies it a few times and drops all references.
+template <typename Ptr>
+void BM_MakeCopyDrop(benchmark::State& state) {
+  const int copies = state.range(0);
+  std::vector<Ptr> v;
+  v.reserve(copies);
+  for (auto _ : state) {
+    Ptr p = Make<Ptr>(1);
+    for (int i = 0; i < copies; ++i) {
+      v.push_back(p);
+    }
+    v.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * copies);
+}
+BENCHMARK_TEMPLATE(BM_MakeCopyDrop, std::shared_ptr<int>)->Arg(1)->Arg(16);
+BENCHMARK_TEMPLATE(BM_MakeCopyDrop, abel::lw_shared_ptr<int>)->Arg(1)->Arg(16);
+BENCHMARK_TEMPLATE(BM_MakeCopyDrop, abel::biased_shared_ptr<int>)
+    ->Arg(1)
+    ->Arg(16);
+
+// All threads copy one pointer created by the first of them. The others are
+// the worst case for biased counting, which then behaves like std::shared_ptr.
+template <typename Ptr>
+void BM_CopyShared(benchmark::State& state) {
+  static Ptr* p = nullptr;
+  if (state.thread_index == 0) {
+    p = new Ptr(Make<Ptr>(1));
+  }
+  // The benchmark library starts timing once all threads are set up.
+  for (auto _ : state) {
+    Ptr q = *p;
+    benchmark::DoNotOptimize(q);
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index == 0) {
+    delete p;
+  }
+}
+BENCHMARK_TEMPLATE(BM_CopyShared, std::shared_ptr<int>)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4);
+BENCHMARK_TEMPLATE(BM_CopyShared, abel::biased_shared_ptr<int>)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4);
+
+}  // namespace
@@ -0,0 +1,101 @@
+//
+
+#include <list>
+#include <vector>
+
+#include <abel/memory/object_pool.h>
+#include <abel/memory/pool_allocator.h>
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Allocates a window of objects and frees them in order, as a message queue
+// would.
+void BM_PoolChurn(benchmark::State& state) {
+  const size_t size = state.range(0);
+  std::vector<void*> window(64);
+  for (auto _ : state) {
+    for (void*& p : window) {
+      p = abel::pool_allocate(size);
+    }
+    benchmark::DoNotOptimize(window.data());
+    for (void* p : window) {
+      abel::pool_deallocate(p, size);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * window.size());
+}
+BENCHMARK(BM_PoolChurn)->Arg(16)->Arg(64)->Arg(256)->Arg(1024)
+    ->ThreadRange(1, 4);
+
+void BM_NewChurn(benchmark::State& state) {
+  const size_t size = state.range(0);
+  std::vector<void*> window(64);
+  for (auto _ : state) {
+    for (void*& p : window) {
+      p = ::operator new(size);
+    }
+    benchmark::DoNotOptimize(window.data());
+    for (void* p : window) {
+      ::operator delete(p);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * window.size());
+}
+BENCHMARK(BM_NewChurn)->Arg(16)->Arg(64)->Arg(256)->Arg(1024)
+    ->ThreadRange(1, 4);
+
+template <typename Alloc>
+void BM_ListPushPop(benchmark::State& state) {
+  std::list<int, Alloc> list;
+  for (auto _ : state) {
+    for (int i = 0; i < 256; ++i) {
+      list.push_back(i);
+    }
+    while (!list.empty()) {
+      list.pop_front();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK_TEMPLATE(BM_ListPushPop, std::allocator<int>);
+BENCHMARK_TEMPLATE(BM_ListPushPop, abel::pool_allocator<int>);
+
+struct message {
+  int id;
+  char payload[60];
+
+  explicit message(int i) : id(i) {}
+};
+
+void BM_ObjectPool(benchmark::State& state) {
+  std::vector<message*> window(64);
+  for (auto _ : state) {
+    for (size_t i = 0; i < window.size(); ++i) {
+      window[i] = abel::object_pool<message>::create(static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(window.data());
+    for (message* m : window) {
+      abel::object_pool<message>::destroy(m);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * window.size());
+}
+BENCHMARK(BM_ObjectPool)->ThreadRange(1, 4);
+
+void BM_NewDelete(benchmark::State& state) {
+  std::vector<message*> window(64);
+  for (auto _ : state) {
+    for (size_t i = 0; i < window.size(); ++i) {
+      window[i] = new message(static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(window.data());
+    for (message* m : window) {
+      delete m;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * window.size());
+}
+BENCHMARK(BM_NewDelete)->ThreadRange(1, 4);
+
+}  // namespace
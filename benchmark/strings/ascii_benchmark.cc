@@ -2,6 +2,9 @@
 
 #include <abel/strings/ascii.h>
 #include <abel/strings/case_conv.h>
+#include <abel/strings/compare.h>
+#include <abel/strings/trim.h>
+#include <algorithm>
 #include <cctype>
 #include <string>
 #include <array>
@@ -105,4 +108,101 @@ static void BM_StrToUpper(benchmark::State& state) {
 }
 BENCHMARK(BM_StrToUpper)->Range(1, 1 << 20);
 
+// The bulk kernels against the byte-at-a-time table loops they replaced,
+// over 16 bytes to 64 KiB of mixed-case text.
+
+std::string MixedCase(size_t size) {
+  std::string s(size, ' ');
+  for (size_t i = 0; i < size; ++i) s[i] = "The Quick Brown Fox, 42!"[i % 24];
+  return s;
+}
+
+template <bool kBulk>
+void BM_ToLowerBulk(benchmark::State& state) {
+  const std::string text = MixedCase(state.range(0));
+  std::string s;
+  for (auto _ : state) {
+    s = text;
+    if (kBulk) {
+      abel::string_to_lower(&s);
+    } else {
+      std::transform(s.begin(), s.end(), s.begin(),
+                     [](char c) { return abel::ascii::to_lower(c); });
+    }
+    benchmark::DoNotOptimize(s.data());
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK_TEMPLATE(BM_ToLowerBulk, true)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_ToLowerBulk, false)->Range(16, 64 << 10);
+
+template <bool kBulk>
+void BM_IsAsciiBulk(benchmark::State& state) {
+  const std::string s = MixedCase(state.range(0));
+  for (auto _ : state) {
+    if (kBulk) {
+      benchmark::DoNotOptimize(abel::string_is_ascii(s));
+    } else {
+      benchmark::DoNotOptimize(
+          std::all_of(s.begin(), s.end(),
+                      [](char c) { return abel::ascii::is_ascii(c); }));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * s.size());
+}
+BENCHMARK_TEMPLATE(BM_IsAsciiBulk, true)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_IsAsciiBulk, false)->Range(16, 64 << 10);
+
+// A word padded on both sides by whitespace runs of half the size each.
+template <bool kBulk>
+void BM_TrimAllBulk(benchmark::State& state) {
+  const size_t pad = state.range(0) / 2;
+  const std::string s = std::string(pad, ' ') + "word" + std::string(pad, '\t');
+  const abel::string_view view(s);
+  for (auto _ : state) {
+    if (kBulk) {
+      benchmark::DoNotOptimize(abel::trim_all(view));
+    } else {
+      auto first = std::find_if_not(view.begin(), view.end(), abel::ascii::is_space);
+      auto last = std::find_if_not(view.rbegin(), view.rend(), abel::ascii::is_space);
+      benchmark::DoNotOptimize(
+          view.substr(first - view.begin(), (view.rend() - last) - (first - view.begin())));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * s.size());
+}
+BENCHMARK_TEMPLATE(BM_TrimAllBulk, true)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_TrimAllBulk, false)->Range(16, 64 << 10);
+
+int CompareCaseTable(abel::string_view a, abel::string_view b) {
+  for (size_t i = 0; i < std::min(a.size(), b.size()); ++i) {
+    const int ca = abel::ascii::to_lower(a[i]);
+    const int cb = abel::ascii::to_lower(b[i]);
+    if (ca != cb) return ca < cb ? -1 : +1;
+  }
+  return a.size() == b.size() ? 0 : (a.size() < b.size() ? +1 : -1);
+}
+
+// Equal strings, which compare all the way to the end.
+template <bool kBulk>
+void BM_CompareCaseBulk(benchmark::State& state) {
+  const std::string a = MixedCase(state.range(0));
+  const std::string b = abel::string_to_upper(a);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kBulk ? abel::compare_case(a, b) : CompareCaseTable(a, b));
+  }
+  state.SetBytesProcessed(state.iterations() * a.size());
+}
+BENCHMARK_TEMPLATE(BM_CompareCaseBulk, true)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_CompareCaseBulk, false)->Range(16, 64 << 10);
+
+void BM_HashCase(benchmark::State& state) {
+  const std::string s = MixedCase(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(abel::hash_case(s));
+  }
+  state.SetBytesProcessed(state.iterations() * s.size());
+}
+BENCHMARK(BM_HashCase)->Range(16, 64 << 10);
+
 }  // namespace
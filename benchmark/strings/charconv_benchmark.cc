@@ -2,9 +2,12 @@
 
 #include <abel/strings/char_conv.h>
 
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <random>
 #include <string>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -163,6 +166,64 @@ void BM_Abel_Big_And_Difficult(benchmark::State& state) {
 }
 BENCHMARK(BM_Abel_Big_And_Difficult)->Range(3, 5000);
 
+// A JSON-like payload of numbers as services print them: prices with two
+// decimals, coordinates with up to 17 significant digits and a few in
+// scientific notation, separated by commas.
+std::string MakeNumericPayload(int count) {
+  std::mt19937_64 rng(7);
+  std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+  std::string payload;
+  char buf[32];
+  for (int i = 0; i < count; ++i) {
+    const double d = dist(rng);
+    switch (i % 4) {
+      case 0:
+        snprintf(buf, sizeof(buf), "%.2f", d);
+        break;
+      case 1:
+      case 2:
+        snprintf(buf, sizeof(buf), "%.17g", d);
+        break;
+      default:
+        snprintf(buf, sizeof(buf), "%.6e", d * 1e-20);
+        break;
+    }
+    payload += buf;
+    payload += ',';
+  }
+  return payload;
+}
+
+void BM_Strtod_Payload(benchmark::State& state) {
+  const std::string payload = MakeNumericPayload(state.range(0));
+  for (auto s : state) {
+    const char* p = payload.c_str();
+    const char* end = p + payload.size();
+    while (p < end) {
+      char* next;
+      benchmark::DoNotOptimize(strtod(p, &next));
+      p = next + 1;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_Strtod_Payload)->Arg(1000);
+
+void BM_Abel_Payload(benchmark::State& state) {
+  const std::string payload = MakeNumericPayload(state.range(0));
+  for (auto s : state) {
+    const char* p = payload.data();
+    const char* end = p + payload.size();
+    while (p < end) {
+      double v;
+      p = abel::from_chars(p, end, v).ptr + 1;
+      benchmark::DoNotOptimize(v);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_Abel_Payload)->Arg(1000);
+
 }  // namespace
 
 // ------------------------------------------------------------------------
@@ -0,0 +1,114 @@
+//
+
+#include <abel/strings/cord.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <abel/strings/str_cat.h>
+
+namespace {
+
+// A response assembled in layers, as servers do: `range(0)` body fragments of
+// `range(1)` bytes are gathered into sections, the sections into a body, and
+// the body behind a header. A flat string copies every byte at each layer.
+std::vector<std::string> MakeFragments(int count, int size) {
+  std::vector<std::string> fragments;
+  for (int i = 0; i < count; ++i) {
+    fragments.push_back(std::string(size, static_cast<char>('a' + i % 26)));
+  }
+  return fragments;
+}
+
+void BM_AssembleString(benchmark::State& state) {
+  const std::vector<std::string> fragments =
+      MakeFragments(state.range(0), state.range(1));
+  for (auto _ : state) {
+    std::string body;
+    for (size_t i = 0; i < fragments.size(); i += 8) {
+      std::string section;
+      for (size_t j = i; j < i + 8 && j < fragments.size(); ++j) {
+        abel::string_append(&section, "<div>", fragments[j], "</div>");
+      }
+      abel::string_append(&body, section);
+    }
+    std::string response = abel::string_cat(
+        "HTTP/1.1 200 OK\r\nContent-Length: ", body.size(), "\r\n\r\n", body);
+    benchmark::DoNotOptimize(response);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          state.range(1));
+}
+BENCHMARK(BM_AssembleString)
+    ->ArgPair(64, 64)
+    ->ArgPair(64, 4096)
+    ->ArgPair(256, 16384);
+
+void BM_AssembleCord(benchmark::State& state) {
+  std::vector<abel::cord> fragments;
+  for (std::string& s : MakeFragments(state.range(0), state.range(1))) {
+    fragments.push_back(abel::cord(std::move(s)));
+  }
+  for (auto _ : state) {
+    abel::cord body;
+    for (size_t i = 0; i < fragments.size(); i += 8) {
+      abel::cord section;
+      for (size_t j = i; j < i + 8 && j < fragments.size(); ++j) {
+        section.append("<div>");
+        section.append(fragments[j]);
+        section.append("</div>");
+      }
+      body.append(section);
+    }
+    abel::cord response;
+    abel::string_append(&response, "HTTP/1.1 200 OK\r\nContent-Length: ",
+                        body.size(), "\r\n\r\n");
+    response.append(body);
+    benchmark::DoNotOptimize(response);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          state.range(1));
+}
+BENCHMARK(BM_AssembleCord)
+    ->ArgPair(64, 64)
+    ->ArgPair(64, 4096)
+    ->ArgPair(256, 16384);
+
+// Many short formatted fields, where a cord has to keep up with a string.
+void BM_SmallAppendsString(benchmark::State& state) {
+  for (auto _ : state) {
+    std::string s;
+    for (int i = 0; i < state.range(0); ++i) {
+      abel::string_append(&s, "key", i, "=", i * 7, ";");
+    }
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SmallAppendsString)->Arg(1000);
+
+void BM_SmallAppendsCord(benchmark::State& state) {
+  for (auto _ : state) {
+    abel::cord c;
+    for (int i = 0; i < state.range(0); ++i) {
+      abel::string_append(&c, "key", i, "=", i * 7, ";");
+    }
+    benchmark::DoNotOptimize(c);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SmallAppendsCord)->Arg(1000);
+
+void BM_Subcord(benchmark::State& state) {
+  abel::cord c;
+  for (int i = 0; i < 64; ++i) c.append(std::string(16384, 'x'));
+  size_t pos = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(c.subcord(pos, 100000));
+    pos = (pos + 4099) % c.size();
+  }
+}
+BENCHMARK(BM_Subcord);
+
+}  // namespace
@@ -4,9 +4,12 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <random>
+#include <string>
 
 #include <benchmark/benchmark.h>
 #include <abel/strings/ascii.h>
+#include <abel/strings/searcher.h>
 
 // We fill the haystack with aaaaaaaaaaaaaaaaaa...aaaab.
 // That gives us:
@@ -18,6 +21,10 @@
 // - char_mem() from memutil.h
 // - search() from STL
 // - char_match(), a custom implementation using memchr and memcmp.
+// Both char_mem() and char_match() are now string_search() (see
+// internal/string_search.h); the sample results below predate that, and the
+// benchmarks at the end compare it with the byte-at-a-time search char_mem()
+// used to be and with abel::searcher on typical text too.
 // Here are sample results:
 //
 // Run on (12 X 3800 MHz CPU s)
@@ -308,4 +315,118 @@ void BM_MemmatchStartup(benchmark::State& state) {
 }
 BENCHMARK(BM_MemmatchStartup);
 
+// The byte-at-a-time search char_mem() used before string_search().
+void BM_MemmemNaiveMedium(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(abel::strings_internal::int_char_match<true>(
+        kHaystack, kHaystackSize, "ab", 2));
+  }
+  state.SetBytesProcessed(kHaystackSize64 * state.iterations());
+}
+BENCHMARK(BM_MemmemNaiveMedium);
+
+void BM_MemmemNaivePathological(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(abel::strings_internal::int_char_match<true>(
+        kHaystack, kHaystackSize, kHaystack + kHaystackSize / 2,
+        kHaystackSize - kHaystackSize / 2));
+  }
+  state.SetBytesProcessed(kHaystackSize64 * state.iterations());
+}
+BENCHMARK(BM_MemmemNaivePathological);
+
+void BM_SearcherPathological(benchmark::State& state) {
+  const abel::searcher s(abel::string_view(kHaystack + kHaystackSize / 2,
+                                           kHaystackSize - kHaystackSize / 2));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        s.find(abel::string_view(kHaystack, kHaystackSize)));
+  }
+  state.SetBytesProcessed(kHaystackSize64 * state.iterations());
+}
+BENCHMARK(BM_SearcherPathological);
+
+// 64KiB of words from a small vocabulary, with the needles only at the end.
+const std::string& Text() {
+  static const std::string* text = [] {
+    static const char* const kWords[] = {
+        "the",  "of",    "and",    "to",      "in",     "is",   "that",
+        "for",  "it",    "as",     "was",     "with",   "be",   "by",
+        "on",   "not",   "he",     "this",    "are",    "or",   "his",
+        "from", "at",    "which",  "but",     "have",   "an",   "had",
+        "they", "you",   "were",   "their",   "one",    "all",  "we",
+        "can",  "her",   "has",    "there",   "been",   "if",   "more",
+        "when", "will",  "would",  "who",     "so",     "no",   "search",
+        "text", "needle", "string", "haystack", "pattern"};
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<size_t> word(
+        0, sizeof(kWords) / sizeof(kWords[0]) - 1);
+    std::string* s = new std::string;
+    while (s->size() < 65536) {
+      *s += kWords[word(rng)];
+      *s += ' ';
+    }
+    *s += "quixotic zephyrs, then a pattern that is periodic periodic "
+          "periodic periodic periodic periodic periodic end";
+    return s;
+  }();
+  return *text;
+}
+
+// range(0) picks the needle: a short word, a long sentence, and a long
+// periodic one that shares most of its prefix with the text around it.
+abel::string_view TextNeedle(int which) {
+  switch (which) {
+    case 0:
+      return "zephyr";
+    case 1:
+      return "quixotic zephyrs, then a pattern";
+    default:
+      return "periodic periodic periodic periodic periodic end";
+  }
+}
+
+void BM_TextCharMem(benchmark::State& state) {
+  const std::string& text = Text();
+  const abel::string_view needle = TextNeedle(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(abel::strings_internal::char_mem(
+        text.data(), text.size(), needle.data(), needle.size()));
+  }
+  state.SetBytesProcessed(text.size() * state.iterations());
+}
+BENCHMARK(BM_TextCharMem)->DenseRange(0, 2);
+
+void BM_TextSearcher(benchmark::State& state) {
+  const std::string& text = Text();
+  const abel::searcher s(TextNeedle(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.find(text));
+  }
+  state.SetBytesProcessed(text.size() * state.iterations());
+}
+BENCHMARK(BM_TextSearcher)->DenseRange(0, 2);
+
+void BM_TextStdSearch(benchmark::State& state) {
+  const std::string& text = Text();
+  const abel::string_view needle = TextNeedle(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::search(text.begin(), text.end(),
+                                         needle.begin(), needle.end()));
+  }
+  state.SetBytesProcessed(text.size() * state.iterations());
+}
+BENCHMARK(BM_TextStdSearch)->DenseRange(0, 2);
+
+void BM_TextNaive(benchmark::State& state) {
+  const std::string& text = Text();
+  const abel::string_view needle = TextNeedle(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(abel::strings_internal::int_char_match<true>(
+        text.data(), text.size(), needle.data(), needle.size()));
+  }
+  state.SetBytesProcessed(text.size() * state.iterations());
+}
+BENCHMARK(BM_TextNaive)->DenseRange(0, 2);
+
 }  // namespace
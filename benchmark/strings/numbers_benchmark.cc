@@ -1,6 +1,7 @@
 //
 
 #include <cstdint>
+#include <cstdio>
 #include <random>
 #include <string>
 #include <type_traits>
@@ -11,6 +12,7 @@
 #include <abel/random/distributions.h>
 #include <abel/random/random.h>
 #include <abel/strings/numbers.h>
+#include <abel/strings/str_split.h>
 
 namespace {
 
@@ -271,4 +273,146 @@ void BM_FastHexToBufferZeroPad16(benchmark::State& state) {
 }
 BENCHMARK(BM_FastHexToBufferZeroPad16);
 
+std::vector<double> MakeDoubles() {
+  abel::BitGen rng;
+  std::vector<double> nums(1000);
+  for (auto& num : nums) {
+    num = abel::Uniform(rng, -1e6, 1e6);
+  }
+  return nums;
+}
+
+// Shortest round-trip digits, against printf's fixed 17 and the six digits
+// of six_digits_to_buffer().
+void BM_FastDoubleToBuffer(benchmark::State& state) {
+  const std::vector<double> nums = MakeDoubles();
+  char buf[abel::numbers_internal::kFastToBufferSize];
+  while (state.KeepRunningBatch(nums.size())) {
+    for (double num : nums) {
+      benchmark::DoNotOptimize(
+          abel::numbers_internal::fast_double_to_buffer(num, buf));
+      benchmark::DoNotOptimize(buf);
+    }
+  }
+}
+BENCHMARK(BM_FastDoubleToBuffer);
+
+void BM_FastFloatToBuffer(benchmark::State& state) {
+  const std::vector<double> nums = MakeDoubles();
+  char buf[abel::numbers_internal::kFastToBufferSize];
+  while (state.KeepRunningBatch(nums.size())) {
+    for (double num : nums) {
+      benchmark::DoNotOptimize(abel::numbers_internal::fast_float_to_buffer(
+          static_cast<float>(num), buf));
+      benchmark::DoNotOptimize(buf);
+    }
+  }
+}
+BENCHMARK(BM_FastFloatToBuffer);
+
+void BM_SnprintfDouble17(benchmark::State& state) {
+  const std::vector<double> nums = MakeDoubles();
+  char buf[abel::numbers_internal::kFastToBufferSize];
+  while (state.KeepRunningBatch(nums.size())) {
+    for (double num : nums) {
+      benchmark::DoNotOptimize(snprintf(buf, sizeof(buf), "%.17g", num));
+      benchmark::DoNotOptimize(buf);
+    }
+  }
+}
+BENCHMARK(BM_SnprintfDouble17);
+
+void BM_SixDigitsToBuffer(benchmark::State& state) {
+  const std::vector<double> nums = MakeDoubles();
+  char buf[abel::numbers_internal::kSixDigitsToBufferSize];
+  while (state.KeepRunningBatch(nums.size())) {
+    for (double num : nums) {
+      benchmark::DoNotOptimize(
+          abel::numbers_internal::six_digits_to_buffer(num, buf));
+      benchmark::DoNotOptimize(buf);
+    }
+  }
+}
+BENCHMARK(BM_SixDigitsToBuffer);
+
+// A column of `count` integers of `state.range(0)` digits or, for 0, of
+// every width from 1 to 19 digits as counters and timestamps mix them.
+std::vector<int64_t> MakeIntColumn(int digits, int count) {
+  abel::BitGen rng;
+  std::vector<int64_t> values(count);
+  for (int64_t& v : values) {
+    const int width = digits != 0 ? digits : abel::Uniform(rng, 1, 20);
+    int64_t low = 1;
+    for (int i = 1; i < width; ++i) low *= 10;
+    const int64_t high =
+        width == 19 ? std::numeric_limits<int64_t>::max() : low * 10 - 1;
+    v = abel::Uniform(abel::IntervalClosed, rng, low, high);
+    if (abel::Bernoulli(rng, 0.25)) v = -v;
+  }
+  return values;
+}
+
+std::string MakeIntColumnText(int digits, int count) {
+  const std::vector<int64_t> values = MakeIntColumn(digits, count);
+  std::string text(values.size() * abel::kFormatIntsBytesPerValue, '\0');
+  text.resize(abel::format_ints(values, ',', &text[0]) - text.data());
+  return text;
+}
+
+void BM_ParseIntColumn(benchmark::State& state) {
+  const std::string text = MakeIntColumnText(state.range(0), 1000);
+  std::vector<int64_t> values(1000);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        abel::parse_int_column(text, ',', abel::MakeSpan(values)));
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ParseIntColumn)->Arg(0)->Arg(3)->Arg(8)->Arg(19);
+
+// The same column a field at a time, as callers did without the batch API.
+void BM_SimpleAtoiColumn(benchmark::State& state) {
+  const std::string text = MakeIntColumnText(state.range(0), 1000);
+  std::vector<int64_t> values(1000);
+  for (auto _ : state) {
+    size_t i = 0;
+    for (abel::string_view field : abel::string_split(text, ',')) {
+      benchmark::DoNotOptimize(abel::simple_atoi(field, &values[i++]));
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_SimpleAtoiColumn)->Arg(0)->Arg(3)->Arg(8)->Arg(19);
+
+void BM_FormatInts(benchmark::State& state) {
+  const std::vector<int64_t> values = MakeIntColumn(state.range(0), 1000);
+  std::vector<char> buf(values.size() * abel::kFormatIntsBytesPerValue);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(abel::format_ints(values, ',', buf.data()));
+    benchmark::DoNotOptimize(buf.data());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_FormatInts)->Arg(0)->Arg(3)->Arg(8)->Arg(19);
+
+void BM_FastIntToBufferColumn(benchmark::State& state) {
+  const std::vector<int64_t> values = MakeIntColumn(state.range(0), 1000);
+  std::vector<char> buf(values.size() * abel::kFormatIntsBytesPerValue);
+  for (auto _ : state) {
+    char* out = buf.data();
+    for (int64_t v : values) {
+      out = abel::numbers_internal::fast_int_to_buffer(v, out);
+      *out++ = ',';
+    }
+    benchmark::DoNotOptimize(out);
+    benchmark::DoNotOptimize(buf.data());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_FastIntToBufferColumn)->Arg(0)->Arg(3)->Arg(8)->Arg(19);
+
 }  // namespace
@@ -2,14 +2,40 @@
 
 #include <abel/strings/str_cat.h>
 
+#include <atomic>
 #include <cstdint>
+#include <cstdlib>
+#include <new>
 #include <string>
 
 #include <benchmark/benchmark.h>
+#include <abel/format/format.h>
+#include <abel/strings/escaping.h>
+#include <abel/strings/hex_dump.h>
 #include <abel/strings/substitute.h>
 
+// Counts heap allocations so the benchmarks below can report them per
+// iteration alongside throughput.
+static std::atomic<int64_t> g_allocations(0);
+
+void* operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
 namespace {
 
+// Sets the "allocs" counter of `state` to the allocations per iteration
+// since `start`.
+void ReportAllocations(benchmark::State& state, int64_t start) {
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(g_allocations.load() - start),
+      benchmark::Counter::kAvgIterations);
+}
+
 const char kStringOne[] = "Once Upon A abel_time, ";
 const char kStringTwo[] = "There was a std::string benchmark";
 
@@ -125,4 +151,135 @@ void BM_DoubleToString_By_SixDigits(benchmark::State& state) {
 }
 BENCHMARK(BM_DoubleToString_By_SixDigits);
 
+// A log line built per iteration as a new string, then into reused sinks.
+void BM_LogLine_By_StrCat(benchmark::State& state) {
+  int i = 0;
+  const int64_t start = g_allocations.load();
+  for (auto _ : state) {
+    std::string line = abel::string_cat(kStringOne, " shard=", i, " lag=",
+                                        i * 0.5, "ms ", kStringTwo, "\n");
+    benchmark::DoNotOptimize(line);
+    i = IncrementAlternatingSign(i);
+  }
+  ReportAllocations(state, start);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogLine_By_StrCat);
+
+void BM_LogLine_By_StrCatToMemoryBuffer(benchmark::State& state) {
+  int i = 0;
+  fmt::memory_buffer line;
+  const int64_t start = g_allocations.load();
+  for (auto _ : state) {
+    line.resize(0);
+    abel::string_cat_to(line, kStringOne, " shard=", i, " lag=", i * 0.5,
+                        "ms ", kStringTwo, "\n");
+    benchmark::DoNotOptimize(line.data());
+    i = IncrementAlternatingSign(i);
+  }
+  ReportAllocations(state, start);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogLine_By_StrCatToMemoryBuffer);
+
+void BM_LogLine_By_StrCatToCharArray(benchmark::State& state) {
+  int i = 0;
+  char storage[256];
+  const int64_t start = g_allocations.load();
+  for (auto _ : state) {
+    abel::char_array_sink line(storage);
+    abel::string_cat_to(line, kStringOne, " shard=", i, " lag=", i * 0.5,
+                        "ms ", kStringTwo, "\n");
+    benchmark::DoNotOptimize(line.data());
+    i = IncrementAlternatingSign(i);
+  }
+  ReportAllocations(state, start);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogLine_By_StrCatToCharArray);
+
+void BM_LogLine_By_Substitute(benchmark::State& state) {
+  int i = 0;
+  const int64_t start = g_allocations.load();
+  for (auto _ : state) {
+    std::string line = abel::Substitute("$0 shard=$1 lag=$2ms $3\n",
+                                        kStringOne, i, i * 0.5, kStringTwo);
+    benchmark::DoNotOptimize(line);
+    i = IncrementAlternatingSign(i);
+  }
+  ReportAllocations(state, start);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogLine_By_Substitute);
+
+void BM_LogLine_By_SubstituteTo(benchmark::State& state) {
+  int i = 0;
+  fmt::memory_buffer line;
+  const int64_t start = g_allocations.load();
+  for (auto _ : state) {
+    line.resize(0);
+    abel::substitute_to(line, "$0 shard=$1 lag=$2ms $3\n", kStringOne, i,
+                        i * 0.5, kStringTwo);
+    benchmark::DoNotOptimize(line.data());
+    i = IncrementAlternatingSign(i);
+  }
+  ReportAllocations(state, start);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogLine_By_SubstituteTo);
+
+// A 64-byte key, hex-dumped and escaped as a serializer would.
+const char kBinaryKey[] =
+    "user\x01\x02profile\tname\n\x7f\x80\xff-0123456789abcdef0123456789ab";
+
+void BM_HexDump(benchmark::State& state) {
+  const int64_t start = g_allocations.load();
+  for (auto _ : state) {
+    std::string out = abel::hex_dump(kBinaryKey, sizeof(kBinaryKey) - 1);
+    benchmark::DoNotOptimize(out);
+  }
+  ReportAllocations(state, start);
+  state.SetBytesProcessed(state.iterations() * (sizeof(kBinaryKey) - 1));
+}
+BENCHMARK(BM_HexDump);
+
+void BM_HexDumpTo(benchmark::State& state) {
+  fmt::memory_buffer out;
+  const int64_t start = g_allocations.load();
+  for (auto _ : state) {
+    out.resize(0);
+    abel::hex_dump_to(out, kBinaryKey, sizeof(kBinaryKey) - 1);
+    benchmark::DoNotOptimize(out.data());
+  }
+  ReportAllocations(state, start);
+  state.SetBytesProcessed(state.iterations() * (sizeof(kBinaryKey) - 1));
+}
+BENCHMARK(BM_HexDumpTo);
+
+void BM_Escape(benchmark::State& state) {
+  const abel::string_view key(kBinaryKey, sizeof(kBinaryKey) - 1);
+  const int64_t start = g_allocations.load();
+  for (auto _ : state) {
+    std::string out = abel::hex_escape(key);
+    benchmark::DoNotOptimize(out);
+  }
+  ReportAllocations(state, start);
+  state.SetBytesProcessed(state.iterations() * key.size());
+}
+BENCHMARK(BM_Escape);
+
+void BM_EscapeTo(benchmark::State& state) {
+  const abel::string_view key(kBinaryKey, sizeof(kBinaryKey) - 1);
+  fmt::memory_buffer out;
+  const int64_t start = g_allocations.load();
+  for (auto _ : state) {
+    out.resize(0);
+    abel::hex_escape_to(out, key);
+    benchmark::DoNotOptimize(out.data());
+  }
+  ReportAllocations(state, start);
+  state.SetBytesProcessed(state.iterations() * key.size());
+}
+BENCHMARK(BM_EscapeTo);
+
 }  // namespace
@@ -4,9 +4,12 @@
 
 #include <cstring>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 #include <abel/log/raw_logging.h>
+#include <abel/strings/str_cat.h>
 
 namespace {
 
@@ -107,4 +110,81 @@ void BM_StrReplaceAll(benchmark::State& state) {
 }
 BENCHMARK(BM_StrReplaceAll);
 
+// A template with state.range(0) variables, "${name17}" and the like, that
+// make up a quarter of its 64KiB of words.
+struct Template {
+  std::vector<std::pair<std::string, std::string>> replacements;
+  std::string text;
+};
+
+const Template& MakeTemplate(int variables) {
+  static std::vector<Template*>* cache = new std::vector<Template*>(1024);
+  Template*& t = (*cache)[variables];
+  if (t == nullptr) {
+    t = new Template;
+    for (int i = 0; i < variables; ++i) {
+      t->replacements.emplace_back(abel::string_cat("${name", i, "}"),
+                                   abel::string_cat("value", i * 7));
+    }
+    size_t r = 0;
+    while (t->text.size() < 65536) {
+      r = r * 237 + 41;  // not very random.
+      if (r % 4 == 0) {
+        t->text += t->replacements[(r >> 8) % variables].first;
+      } else {
+        t->text += "lorem";
+      }
+      t->text += ' ';
+    }
+  }
+  return *t;
+}
+
+// Searching for each variable in turn, which string_replace_all() does below
+// strings_internal::kReplacerThreshold.
+void BM_StrReplaceAllOneByOne(benchmark::State& state) {
+  const Template& t = MakeTemplate(state.range(0));
+  for (auto _ : state) {
+    auto subs =
+        abel::strings_internal::find_substitutions(t.text, t.replacements);
+    std::string dest;
+    dest.reserve(t.text.size());
+    abel::strings_internal::apply_substitutions(t.text, &subs, &dest);
+    benchmark::DoNotOptimize(dest);
+  }
+  state.SetBytesProcessed(state.iterations() * t.text.size());
+}
+BENCHMARK(BM_StrReplaceAllOneByOne)->Arg(4)->Arg(16)->Arg(64)->Arg(500);
+
+// string_replace_all() as it is, building a string_replacer per call above
+// the threshold.
+void BM_StrReplaceAllMany(benchmark::State& state) {
+  const Template& t = MakeTemplate(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(abel::string_replace_all(t.text, t.replacements));
+  }
+  state.SetBytesProcessed(state.iterations() * t.text.size());
+}
+BENCHMARK(BM_StrReplaceAllMany)->Arg(4)->Arg(16)->Arg(64)->Arg(500);
+
+// A string_replacer built once and reused.
+void BM_StringReplacer(benchmark::State& state) {
+  const Template& t = MakeTemplate(state.range(0));
+  const abel::string_replacer replacer(t.replacements);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(replacer.replace_all(t.text));
+  }
+  state.SetBytesProcessed(state.iterations() * t.text.size());
+}
+BENCHMARK(BM_StringReplacer)->Arg(4)->Arg(16)->Arg(64)->Arg(500);
+
+void BM_StringReplacerBuild(benchmark::State& state) {
+  const Template& t = MakeTemplate(state.range(0));
+  for (auto _ : state) {
+    abel::string_replacer replacer(t.replacements);
+    benchmark::DoNotOptimize(&replacer);
+  }
+}
+BENCHMARK(BM_StringReplacerBuild)->Arg(4)->Arg(16)->Arg(64)->Arg(500);
+
 }  // namespace
@@ -55,6 +55,71 @@ void BM_Split2StringViewByAnyChar(benchmark::State& state) {
 }
 BENCHMARK_RANGE(BM_Split2StringViewByAnyChar, 0, 1 << 20);
 
+// The same split with find_first_of() per token, which is what by_any_char
+// did before it classified whole blocks.
+void BM_Split2StringViewFindFirstOf(benchmark::State& state) {
+  std::string test = MakeMultiDelimiterTestString(state.range(0));
+  const abel::string_view text(test);
+  for (auto _ : state) {
+    std::vector<abel::string_view> result;
+    size_t pos = 0;
+    for (;;) {
+      size_t found = text.find_first_of(kDelimiters, pos);
+      result.push_back(text.substr(pos, found - pos));
+      if (found == abel::string_view::npos) break;
+      pos = found + 1;
+    }
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK_RANGE(BM_Split2StringViewFindFirstOf, 0, 1 << 20);
+
+// split_into() a buffer sized once up front, with no allocation per split.
+void BM_SplitIntoByAnyChar(benchmark::State& state) {
+  std::string test = MakeMultiDelimiterTestString(state.range(0));
+  std::vector<abel::string_view> fields(state.range(0) + 2);
+  const abel::by_any_char delimiters(kDelimiters);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        abel::split_into(test, delimiters, abel::MakeSpan(fields)));
+  }
+  state.SetBytesProcessed(state.iterations() * test.size());
+}
+BENCHMARK_RANGE(BM_SplitIntoByAnyChar, 0, 1 << 20);
+
+void BM_SplitIntoByChar(benchmark::State& state) {
+  std::string test = MakeTestString(state.range(0));
+  std::vector<abel::string_view> fields(state.range(0) + 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        abel::split_into(test, ';', abel::MakeSpan(fields)));
+  }
+  state.SetBytesProcessed(state.iterations() * test.size());
+}
+BENCHMARK_RANGE(BM_SplitIntoByChar, 0, 1 << 20);
+
+// A log line of short tab-, comma- and space-separated fields, split on all
+// of them at once.
+const char kLogLine[] =
+    "2020-03-01 12:00:01,203\tINFO\tworker-7\trequest done,"
+    "path=/api/v1/items,status=200,bytes=5123,elapsed=12ms\n";
+
+void BM_SplitLogLine(benchmark::State& state) {
+  const abel::by_any_char delimiters(" \t,=\n");
+  abel::string_view fields[32];
+  for (auto _ : state) {
+    if (state.range(0) == 0) {
+      std::vector<abel::string_view> v = abel::string_split(kLogLine, delimiters);
+      benchmark::DoNotOptimize(v);
+    } else {
+      benchmark::DoNotOptimize(abel::split_into(kLogLine, delimiters, fields));
+    }
+  }
+  state.SetLabel(state.range(0) == 0 ? "string_split" : "split_into");
+  state.SetBytesProcessed(state.iterations() * (sizeof(kLogLine) - 1));
+}
+BENCHMARK(BM_SplitLogLine)->Arg(0)->Arg(1);
+
 void BM_Split2StringViewLifted(benchmark::State& state) {
   std::string test = MakeTestString(state.range(0));
   std::vector<abel::string_view> result;
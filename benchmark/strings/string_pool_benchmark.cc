@@ -0,0 +1,74 @@
+//
+
+#include <abel/strings/string_pool.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <abel/container/flat_hash_set.h>
+#include <abel/strings/str_cat.h>
+#include <abel/synchronization/mutex.h>
+
+namespace {
+
+// Metric-name-like keys, all interned up front so each lookup is a hit.
+std::vector<std::string> MakeKeys() {
+  std::vector<std::string> keys;
+  for (int i = 0; i < 4096; ++i) {
+    keys.push_back(abel::string_cat("service.requests.", i, ".latency_ms"));
+  }
+  return keys;
+}
+
+void BM_StringPoolIntern(benchmark::State& state) {
+  static abel::string_pool* pool = new abel::string_pool;
+  static const std::vector<std::string>* keys = new std::vector<std::string>(MakeKeys());
+  if (state.thread_index == 0) {
+    for (const std::string& key : *keys) pool->intern(key);
+  }
+  size_t i = state.thread_index * 97;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pool->intern((*keys)[i++ & 4095]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StringPoolIntern)->ThreadRange(1, 8)->UseRealTime();
+
+// The usual alternative: a set of strings behind a mutex.
+template <typename Set>
+void BM_MutexSetIntern(benchmark::State& state) {
+  static abel::mutex* mu = new abel::mutex;
+  static Set* set = new Set;
+  static const std::vector<std::string>* keys = new std::vector<std::string>(MakeKeys());
+  if (state.thread_index == 0) {
+    abel::mutex_lock lock(mu);
+    for (const std::string& key : *keys) set->insert(key);
+  }
+  size_t i = state.thread_index * 97;
+  for (auto _ : state) {
+    abel::mutex_lock lock(mu);
+    benchmark::DoNotOptimize(set->insert((*keys)[i++ & 4095]).first->data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_MutexSetIntern, abel::flat_hash_set<std::string>)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MutexSetIntern, std::unordered_set<std::string>)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+// First-time interning, which takes the mutex and copies into the arena.
+void BM_StringPoolInternNew(benchmark::State& state) {
+  const std::vector<std::string> keys = MakeKeys();
+  for (auto _ : state) {
+    abel::string_pool pool;
+    for (const std::string& key : keys) benchmark::DoNotOptimize(pool.intern(key));
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_StringPoolInternNew);
+
+}  // namespace
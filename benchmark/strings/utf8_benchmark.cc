@@ -0,0 +1,133 @@
+//
+
+#include <abel/strings/utf8.h>
+
+#include <random>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <abel/strings/escaping.h>
+#include <abel/strings/internal/utf8.h>
+#include <abel/strings/internal/utf8_simd.h>
+
+namespace {
+
+enum Text { kAscii, kLatin, kCjk, kEmoji };
+
+// About 64 KiB of text: plain ASCII, mostly ASCII with accented letters,
+// 3-byte CJK characters, or 4-byte emoji mixed with ASCII.
+const std::string& Sample(int text) {
+  static std::string* samples = [] {
+    auto* s = new std::string[4];
+    std::mt19937 gen(3);
+    char buf[abel::strings_internal::kMaxEncodedUTF8Size];
+    for (int t = 0; t < 4; ++t) {
+      while (s[t].size() < 64 * 1024) {
+        char32_t cp = 'a' + gen() % 26;
+        if (t == kLatin && gen() % 8 == 0) cp = 0xC0 + gen() % 0x40;
+        if (t == kCjk) cp = 0x4E00 + gen() % 0x5000;
+        if (t == kEmoji && gen() % 4 == 0) cp = 0x1F600 + gen() % 0x50;
+        s[t].append(buf, abel::strings_internal::EncodeUTF8Char(buf, cp));
+      }
+    }
+    return s;
+  }();
+  return samples[text];
+}
+
+void SetBytes(benchmark::State& state, size_t bytes) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+const abel::strings_internal::utf8_kernels* Kernels(int index) {
+  using namespace abel::strings_internal;
+  switch (index) {
+    case 0: return &utf8_scalar_kernels();
+    case 1: return cpu_supports_sse4() ? utf8_sse4_kernels() : nullptr;
+    default: return cpu_supports_avx2() ? utf8_avx2_kernels() : nullptr;
+  }
+}
+
+// {text, kernels: 0 scalar, 1 sse4, 2 avx2}
+void KernelArgs(benchmark::internal::Benchmark* b) {
+  for (int text = kAscii; text <= kEmoji; ++text) {
+    for (int kernels = 0; kernels < 3; ++kernels) b->Args({text, kernels});
+  }
+}
+
+void BM_Validate(benchmark::State& state) {
+  const std::string& s = Sample(state.range(0));
+  const auto* kernels = Kernels(state.range(1));
+  if (kernels == nullptr) {
+    state.SkipWithError("not supported by this CPU");
+    return;
+  }
+  state.SetLabel(kernels->name);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kernels->validate(s.data(), s.size()));
+  }
+  SetBytes(state, s.size());
+}
+BENCHMARK(BM_Validate)->Apply(KernelArgs);
+
+void BM_CountCodePoints(benchmark::State& state) {
+  const std::string& s = Sample(state.range(0));
+  const auto* kernels = Kernels(state.range(1));
+  if (kernels == nullptr) {
+    state.SkipWithError("not supported by this CPU");
+    return;
+  }
+  state.SetLabel(kernels->name);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kernels->count_code_points(s.data(), s.size()));
+  }
+  SetBytes(state, s.size());
+}
+BENCHMARK(BM_CountCodePoints)->Apply(KernelArgs);
+
+void BM_ToUtf16(benchmark::State& state) {
+  const std::string& s = Sample(state.range(0));
+  std::u16string out;
+  for (auto _ : state) {
+    abel::utf8::to_utf16(s, &out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  SetBytes(state, s.size());
+}
+BENCHMARK(BM_ToUtf16)->DenseRange(kAscii, kEmoji);
+
+void BM_FromUtf16(benchmark::State& state) {
+  const std::string& s = Sample(state.range(0));
+  std::u16string wide;
+  abel::utf8::to_utf16(s, &wide);
+  std::string out;
+  for (auto _ : state) {
+    abel::utf8::from_utf16(wide, &out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  SetBytes(state, s.size());
+}
+BENCHMARK(BM_FromUtf16)->DenseRange(kAscii, kEmoji);
+
+void BM_ToUtf32(benchmark::State& state) {
+  const std::string& s = Sample(state.range(0));
+  std::u32string out;
+  for (auto _ : state) {
+    abel::utf8::to_utf32(s, &out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  SetBytes(state, s.size());
+}
+BENCHMARK(BM_ToUtf32)->DenseRange(kAscii, kEmoji);
+
+// The existing byte-at-a-time walk over the same text, for reference.
+void BM_Utf8SafeEscape(benchmark::State& state) {
+  const std::string& s = Sample(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(abel::utf8_safe_escape(s));
+  }
+  SetBytes(state, s.size());
+}
+BENCHMARK(BM_Utf8SafeEscape)->DenseRange(kAscii, kEmoji);
+
+}  // namespace
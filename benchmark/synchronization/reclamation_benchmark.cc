@@ -0,0 +1,152 @@
+//
+
+#include <atomic>
+#include <mutex>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <abel/synchronization/epoch.h>
+#include <abel/synchronization/hazard_pointer.h>
+#include <benchmark/benchmark.h>
+
+namespace {
+
+struct Node {
+  int64_t value;
+  Node* next;
+};
+
+// Treiber stack; `Reclaimer` decides how popped nodes are freed.
+template <typename Reclaimer>
+class Stack {
+ public:
+  Stack() : head_(nullptr) {}
+  ~Stack() {
+    Node* node = head_.load();
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  void Push(int64_t v) {
+    Node* node = new Node{v, head_.load(std::memory_order_relaxed)};
+    while (!head_.compare_exchange_weak(node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  bool Pop(int64_t* v) { return Reclaimer::Pop(&head_, v); }
+
+ private:
+  std::atomic<Node*> head_;
+};
+
+struct HazardPointers {
+  static bool Pop(std::atomic<Node*>* head, int64_t* v) {
+    abel::hazard_pointer hp;
+    Node* node = hp.protect(*head);
+    while (node != nullptr &&
+           !head->compare_exchange_weak(node, node->next,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+      node = hp.protect(*head);
+    }
+    hp.reset_protection();
+    if (node == nullptr) return false;
+    *v = node->value;
+    abel::hazard_pointer_domain::default_domain().retire(node);
+    return true;
+  }
+};
+
+struct Epochs {
+  static bool Pop(std::atomic<Node*>* head, int64_t* v) {
+    abel::epoch_guard guard;
+    Node* node = head->load(std::memory_order_acquire);
+    while (node != nullptr &&
+           !head->compare_exchange_weak(node, node->next,
+                                        std::memory_order_acquire,
+                                        std::memory_order_acquire)) {
+    }
+    if (node == nullptr) return false;
+    *v = node->value;
+    abel::epoch_domain::default_domain().retire(node);
+    return true;
+  }
+};
+
+// Push and pop one node per iteration on a shared stack. The difference to
+// BM_MutexStack is the cost of lock-free popping including reclamation.
+template <typename Reclaimer>
+void BM_StackPushPop(benchmark::State& state) {
+  static Stack<Reclaimer>* stack = new Stack<Reclaimer>;
+  int64_t v = 0;
+  for (auto _ : state) {
+    stack->Push(1);
+    stack->Pop(&v);
+    benchmark::DoNotOptimize(v);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_StackPushPop, HazardPointers)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4);
+BENCHMARK_TEMPLATE(BM_StackPushPop, Epochs)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4);
+
+// Baseline: a vector guarded by a mutex, allocating as the others do.
+void BM_MutexStack(benchmark::State& state) {
+  struct Shared {
+    std::mutex mu;
+    std::vector<Node*> nodes;
+  };
+  static Shared* shared = new Shared;
+  int64_t v = 0;
+  for (auto _ : state) {
+    {
+      std::lock_guard<std::mutex> l(shared->mu);
+      shared->nodes.push_back(new Node{1, nullptr});
+    }
+    Node* node;
+    {
+      std::lock_guard<std::mutex> l(shared->mu);
+      node = shared->nodes.back();
+      shared->nodes.pop_back();
+    }
+    v = node->value;
+    delete node;
+    benchmark::DoNotOptimize(v);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MutexStack)->UseRealTime()->Threads(1)->Threads(2)->Threads(4);
+
+// The read-side cost alone: protecting a pointer versus entering an epoch.
+void BM_HazardPointerProtect(benchmark::State& state) {
+  std::atomic<Node*> src(new Node{1, nullptr});
+  for (auto _ : state) {
+    abel::hazard_pointer hp;
+    benchmark::DoNotOptimize(hp.protect(src));
+  }
+  delete src.load();
+}
+BENCHMARK(BM_HazardPointerProtect);
+
+void BM_EpochGuard(benchmark::State& state) {
+  std::atomic<Node*> src(new Node{1, nullptr});
+  for (auto _ : state) {
+    abel::epoch_guard guard;
+    benchmark::DoNotOptimize(src.load(std::memory_order_acquire));
+  }
+  delete src.load();
+}
+BENCHMARK(BM_EpochGuard);
+
+}  // namespace
@@ -8,6 +8,8 @@
 #include <abel/container/array_list.h>
 #include <abel/algorithm/algorithm.h>
 #include <deque>
+#include <string>
+#include <vector>
 
 using namespace abel;
 
@@ -209,3 +211,51 @@ TEST(array_list, chunked_fifo_iterator) {
         EXPECT_TRUE(abel::equal(fifo.begin(), fifo.end(), reference.begin(), reference.end()));
     }
 }
+
+TEST(array_list, chunked_fifo_bulk_trivial) {
+    // Bulk operations on ints go through memcpy; pop a few first so that the
+    // single chunk wraps around.
+    constexpr size_t N = 8;
+    array_list<int, N> fifo;
+    auto reference = std::deque<int> {};
+    for (int i = 0; i < 5; ++i) {
+        fifo.push_back(i);
+        reference.push_back(i);
+    }
+    for (int i = 0; i < 3; ++i) {
+        fifo.pop_front();
+        reference.pop_front();
+    }
+    std::vector<int> in(30);
+    for (int i = 0; i < 30; ++i) {
+        in[i] = 100 + i;
+    }
+    fifo.push_back(in.data(), in.data() + in.size());
+    reference.insert(reference.end(), in.begin(), in.end());
+    EXPECT_EQ(fifo.size(), reference.size());
+    EXPECT_TRUE(abel::equal(fifo.begin(), fifo.end(), reference.begin(), reference.end()));
+
+    std::vector<int> out(40, -1);
+    EXPECT_EQ(fifo.pop_front(11, out.data()), 11u);
+    EXPECT_TRUE(abel::equal(out.begin(), out.begin() + 11, reference.begin(), reference.begin() + 11));
+    EXPECT_EQ(fifo.pop_front(40, out.data() + 11), 21u);
+    EXPECT_TRUE(abel::equal(out.begin(), out.begin() + 32, reference.begin(), reference.end()));
+    EXPECT_TRUE(fifo.empty());
+    EXPECT_EQ(fifo.pop_front(1, out.data()), 0u);
+}
+
+TEST(array_list, chunked_fifo_bulk_nontrivial) {
+    constexpr size_t N = 4;
+    array_list<std::string, N> fifo;
+    std::deque<std::string> in;
+    for (int i = 0; i < 13; ++i) {
+        in.push_back(std::to_string(i));
+    }
+    fifo.push_back(in.begin(), in.end());
+    EXPECT_EQ(fifo.size(), in.size());
+    std::vector<std::string> out;
+    EXPECT_EQ(fifo.pop_front(5, std::back_inserter(out)), 5u);
+    EXPECT_EQ(fifo.pop_front(100, std::back_inserter(out)), 8u);
+    EXPECT_TRUE(abel::equal(out.begin(), out.end(), in.begin(), in.end()));
+    EXPECT_TRUE(fifo.empty());
+}
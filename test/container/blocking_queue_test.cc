@@ -0,0 +1,106 @@
+//
+
+#include <gtest/gtest.h>
+#include <abel/container/blocking_queue.h>
+#include <abel/container/mpmc_queue.h>
+#include <abel/container/spsc_queue.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(blocking_queue, spsc_blocks_both_ways) {
+    const int kCount = 50000;
+    // No spinning, so that both sides really park.
+    abel::blocking_queue<abel::spsc_queue<int>> q(4, 0);
+    std::thread producer([&] {
+        for (int i = 0; i < kCount; i += 2) {
+            if (i % 4 == 0) {
+                q.push(i);
+                q.push(i + 1);
+            } else {
+                int v[2] = {i, i + 1};
+                q.push_n(v, 2);
+            }
+        }
+    });
+    int expected = 0;
+    while (expected < kCount) {
+        int v[3];
+        size_t n = expected % 5 == 0 ? (v[0] = q.pop(), 1) : q.pop_n(v, 3);
+        for (size_t j = 0; j < n; ++j) {
+            ASSERT_EQ(v[j], expected++);
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(blocking_queue, mpmc_many_threads) {
+    const int kThreads = 3;
+    const int kPerThread = 20000;
+    abel::blocking_queue<abel::mpmc_queue<int>> q(8, 16);
+    std::atomic<long> sum(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                q.push(t * kPerThread + i);
+            }
+        });
+        threads.emplace_back([&] {
+            for (int i = 0; i < kPerThread; ++i) {
+                sum += q.pop();
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    const long total = static_cast<long>(kThreads) * kPerThread;
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+}
+
+TEST(blocking_queue, pop_for_times_out) {
+    abel::blocking_queue<abel::mpmc_queue<int>> q(4);
+    int v = 0;
+    EXPECT_FALSE(q.pop_for(v, abel::milliseconds(10)));
+    q.push(7);
+    EXPECT_TRUE(q.pop_for(v, abel::milliseconds(10)));
+    EXPECT_EQ(v, 7);
+
+    std::thread producer([&] {
+        abel::sleep_for(abel::milliseconds(20));
+        q.push(8);
+    });
+    EXPECT_TRUE(q.pop_for(v, abel::seconds(10)));
+    EXPECT_EQ(v, 8);
+    producer.join();
+}
+
+TEST(blocking_queue, try_ops) {
+    abel::blocking_queue<abel::spsc_queue<int>> q(2);
+    EXPECT_TRUE(q.try_push(1));
+    EXPECT_TRUE(q.try_push(2));
+    EXPECT_FALSE(q.try_push(3));
+    int v = 0;
+    EXPECT_TRUE(q.try_pop(v));
+    EXPECT_EQ(v, 1);
+    EXPECT_EQ(q.size(), 1u);
+}
+
+TEST(blocking_queue, pop_without_default_constructor) {
+    struct ticket {
+        explicit ticket (int n) : number(n) { }
+        int number;
+    };
+    abel::blocking_queue<abel::mpmc_queue<ticket>> mq(4);
+    mq.push(ticket(1));
+    EXPECT_EQ(mq.pop().number, 1);
+    abel::blocking_queue<abel::spsc_queue<ticket>> sq(4);
+    std::thread producer([&] {
+        abel::sleep_for(abel::milliseconds(20));
+        sq.emplace(2);
+    });
+    EXPECT_EQ(sq.pop().number, 2);
+    producer.join();
+}
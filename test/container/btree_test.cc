@@ -4,6 +4,8 @@
 
 #include <cstdint>
 #include <map>
+#include <numeric>
+#include <set>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -1336,6 +1338,12 @@ public:
     constexpr static size_t GetNumValuesPerNode () {
         return btree_node<typename Set::params_type>::kNodeValues;
     }
+
+    // Yields the fraction of the node capacity of this set that is in use.
+    template<typename Set>
+    static double GetFullness (const Set &set) {
+        return set.tree_.fullness();
+    }
 };
 
 namespace {
@@ -2297,6 +2305,242 @@ TEST(Btree, MoveAssignmentAllocatorPropagation) {
     }
 }
 
+TEST(Btree, BulkLoadSortedRange) {
+    std::vector<int> values;
+    for (int i = 0; i < 10000; ++i) {
+        values.push_back(i);
+        if (i % 7 == 0) values.push_back(i);
+    }
+    std::vector<int> unique_values(values.begin(),
+                                   std::unique(values.begin(), values.end()));
+
+    for (int n : {0, 1, 2, 3, 61, 62, 63, 200, 3782, 10000}) {
+        SCOPED_TRACE(n);
+        std::vector<int> expected(unique_values.begin(), unique_values.begin() + n);
+        abel::btree_set<int> set = {-1, 20000};
+        set.bulk_load(expected.begin(), expected.end());
+        set.verify();
+        EXPECT_THAT(set, ElementsAreArray(expected));
+
+        abel::btree_multiset<int> multiset;
+        multiset.bulk_load(values.begin(), values.begin() + n);
+        multiset.verify();
+        EXPECT_THAT(multiset, ElementsAreArray(values.begin(), values.begin() + n));
+    }
+
+    // Runs of equivalent values collapse to their first element.
+    abel::btree_set<int> set;
+    set.bulk_load(values.begin(), values.end());
+    set.verify();
+    EXPECT_THAT(set, ElementsAreArray(unique_values));
+}
+
+TEST(Btree, BulkLoadFillFactor) {
+    std::vector<int> values(100000);
+    std::iota(values.begin(), values.end(), 0);
+
+    abel::btree_set<int> full;
+    full.bulk_load(values.begin(), values.end());
+    full.verify();
+    EXPECT_GT(BtreeNodePeer::GetFullness(full), 0.99);
+
+    abel::btree_set<int> half;
+    half.bulk_load(values.begin(), values.end(), 0.5);
+    half.verify();
+    EXPECT_GT(BtreeNodePeer::GetFullness(half), 0.45);
+    EXPECT_LT(BtreeNodePeer::GetFullness(half), 0.55);
+
+    // The half-full tree absorbs inserts and erases like any other tree.
+    for (int i = 0; i < 100000; i += 2) {
+        half.insert(-i - 1);
+        half.erase(i);
+    }
+    half.verify();
+    EXPECT_EQ(half.size(), 100000);
+}
+
+TEST(Btree, BulkLoadUnsortedRangeFallsBack) {
+    std::vector<int> values = GenerateValuesWithSeed<int>(5000, 1 << 20, 7);
+    std::set<int> expected(values.begin(), values.end());
+
+    abel::btree_set<int> set;
+    set.bulk_load(values.begin(), values.end());
+    set.verify();
+    EXPECT_THAT(set, ElementsAreArray(expected));
+
+    abel::btree_map<int, int> map;
+    std::vector<std::pair<int, int>> pairs;
+    for (int v : values) pairs.emplace_back(v, -v);
+    map.bulk_load(pairs.begin(), pairs.end());
+    map.verify();
+    EXPECT_EQ(map.size(), expected.size());
+}
+
+TEST(Btree, BulkLoadMovesFromMoveIterators) {
+    std::vector<std::pair<std::string, std::unique_ptr<int>>> values;
+    for (int i = 0; i < 500; ++i) {
+        values.emplace_back(abel::string_cat(10000 + i), abel::make_unique<int>(i));
+    }
+    abel::btree_map<std::string, std::unique_ptr<int>> map;
+    map.bulk_load(std::make_move_iterator(values.begin()),
+                  std::make_move_iterator(values.end()));
+    map.verify();
+    ASSERT_EQ(map.size(), 500);
+    EXPECT_EQ(*map["10250"], 250);
+}
+
+TEST(Btree, InsertSortedRange) {
+    std::vector<int> base = GenerateValuesWithSeed<int>(20000, 1 << 20, 11);
+    std::vector<int> extra = GenerateValuesWithSeed<int>(20000, 1 << 20, 12);
+    std::sort(extra.begin(), extra.end());
+
+    // Both the linear rebuild (large batch) and the hinted insertion (small
+    // batch) must agree with std::set.
+    for (size_t n : {size_t{10}, size_t{500}, extra.size()}) {
+        SCOPED_TRACE(n);
+        abel::btree_set<int> set(base.begin(), base.end());
+        std::set<int> expected(base.begin(), base.end());
+        set.insert_sorted_range(extra.begin(), extra.begin() + n);
+        expected.insert(extra.begin(), extra.begin() + n);
+        set.verify();
+        EXPECT_THAT(set, ElementsAreArray(expected));
+
+        abel::btree_multiset<int> multiset(base.begin(), base.end());
+        std::multiset<int> multi_expected(base.begin(), base.end());
+        multiset.insert_sorted_range(extra.begin(), extra.begin() + n);
+        multi_expected.insert(extra.begin(), extra.begin() + n);
+        multiset.verify();
+        EXPECT_THAT(multiset, ElementsAreArray(multi_expected));
+    }
+
+    // Existing values win over equivalent values in the range.
+    abel::btree_map<int, int> map = {{1, 1}, {3, 3}};
+    std::vector<std::pair<int, int>> pairs = {{0, 0}, {1, -1}, {2, 2}, {3, -3}};
+    map.insert_sorted_range(pairs.begin(), pairs.end());
+    EXPECT_THAT(map, ElementsAre(Pair(0, 0), Pair(1, 1), Pair(2, 2), Pair(3, 3)));
+}
+
+TEST(Btree, MergeLargeContainers) {
+    std::vector<int> a = GenerateValuesWithSeed<int>(10000, 1 << 16, 21);
+    std::vector<int> b = GenerateValuesWithSeed<int>(10000, 1 << 16, 22);
+
+    abel::btree_set<int> dst(a.begin(), a.end());
+    abel::btree_multiset<int> src(b.begin(), b.end());
+    std::set<int> expected_dst(a.begin(), a.end());
+    std::multiset<int> expected_src;
+    for (int v : std::multiset<int>(b.begin(), b.end())) {
+        if (!expected_dst.insert(v).second) expected_src.insert(v);
+    }
+
+    dst.merge(src);
+    dst.verify();
+    src.verify();
+    EXPECT_THAT(dst, ElementsAreArray(expected_dst));
+    EXPECT_THAT(src, ElementsAreArray(expected_src));
+
+    abel::btree_multimap<int, int> multi_dst;
+    abel::btree_multimap<int, int> multi_src;
+    for (int i = 0; i < 5000; ++i) {
+        multi_dst.insert({i / 3, i});
+        multi_src.insert({i / 5, -i});
+    }
+    std::multimap<int, int> expected(multi_dst.begin(), multi_dst.end());
+    expected.insert(multi_src.begin(), multi_src.end());
+    multi_dst.merge(multi_src);
+    multi_dst.verify();
+    EXPECT_TRUE(multi_src.empty());
+    EXPECT_THAT(multi_dst, ElementsAreArray(expected));
+}
+
+TEST(Btree, MergeMoveOnlyValues) {
+    abel::btree_map<int, std::unique_ptr<int>> dst;
+    abel::btree_map<int, std::unique_ptr<int>> src;
+    for (int i = 0; i < 1000; ++i) {
+        dst.emplace(2 * i, abel::make_unique<int>(2 * i));
+        src.emplace(2 * i + i % 2, abel::make_unique<int>(-i));
+    }
+    dst.merge(src);
+    dst.verify();
+    src.verify();
+    EXPECT_EQ(dst.size(), 1500);
+    EXPECT_EQ(src.size(), 500);
+    EXPECT_EQ(*dst[4], 4);
+    EXPECT_EQ(*dst[3], -1);
+    EXPECT_EQ(*src[4], -2);
+}
+
+#ifdef ABEL_HAVE_EXCEPTIONS
+// An int that throws on its `copies_left`th copy, and is -1 once moved from.
+struct ThrowingCopy {
+    static int copies_left;
+    explicit ThrowingCopy (int v) : value(v) {}
+    ThrowingCopy (const ThrowingCopy &other) : value(other.value) {
+        if (--copies_left == 0) throw std::runtime_error("copy");
+    }
+    ThrowingCopy (ThrowingCopy &&other) noexcept : value(other.value) { other.value = -1; }
+    ThrowingCopy &operator= (const ThrowingCopy &) = default;
+    ThrowingCopy &operator= (ThrowingCopy &&other) noexcept {
+        value = other.value;
+        other.value = -1;
+        return *this;
+    }
+    bool operator< (const ThrowingCopy &other) const { return value < other.value; }
+    int value;
+};
+int ThrowingCopy::copies_left = 0;
+
+// A failed linear merge leaves both trees as they were.
+TEST(Btree, LinearMergeIsExceptionSafe) {
+    std::vector<int> expected_dst;
+    std::vector<int> expected_src;
+    abel::btree_set<ThrowingCopy> dst;
+    abel::btree_set<ThrowingCopy> src;
+    std::vector<ThrowingCopy> range;
+    for (int i = 0; i < 2000; ++i) {
+        dst.insert(ThrowingCopy(2 * i));
+        src.insert(ThrowingCopy(2 * i + 1));
+        range.push_back(ThrowingCopy(2 * i + 1));
+        expected_dst.push_back(2 * i);
+        expected_src.push_back(2 * i + 1);
+    }
+    auto values = [](const abel::btree_set<ThrowingCopy> &set) {
+        std::vector<int> out;
+        for (const ThrowingCopy &v : set) out.push_back(v.value);
+        return out;
+    };
+
+    ThrowingCopy::copies_left = 3000;
+    EXPECT_THROW(dst.insert_sorted_range(range.begin(), range.end()),
+                 std::runtime_error);
+    dst.verify();
+    EXPECT_EQ(values(dst), expected_dst);
+
+    ThrowingCopy::copies_left = 3000;
+    EXPECT_THROW(dst.merge(src), std::runtime_error);
+    dst.verify();
+    src.verify();
+    EXPECT_EQ(values(dst), expected_dst);
+    EXPECT_EQ(values(src), expected_src);
+
+    ThrowingCopy::copies_left = 0;
+    dst.merge(src);
+    dst.verify();
+    EXPECT_EQ(dst.size(), 4000);
+    EXPECT_TRUE(src.empty());
+}
+#endif  // ABEL_HAVE_EXCEPTIONS
+
+TEST(Btree, CopyBuildsFullNodes) {
+    abel::btree_set<int> set;
+    for (int i = 0; i < 10000; ++i) set.insert(i * 7 % 10000);
+    abel::btree_set<int> copy(set);
+    copy.verify();
+    EXPECT_EQ(copy, set);
+    EXPECT_GT(BtreeNodePeer::GetFullness(copy), 0.95);
+    EXPECT_GT(BtreeNodePeer::GetFullness(copy),
+              BtreeNodePeer::GetFullness(set));
+}
+
 TEST(Btree, EmptyTree) {
     abel::btree_set<int> s;
     EXPECT_TRUE(s.empty());
@@ -4,6 +4,12 @@
 
 #include <gtest/gtest.h>
 #include <abel/container/circular_buffer.h>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/uio.h>
+#include <unistd.h>
 
 TEST(circular, erase) {
     abel::circular_buffer<int> buf;
@@ -80,3 +86,147 @@ TEST(circular, iterator) {
 
     EXPECT_TRUE(buf.size() == 1);
 }
+
+TEST(circular, relocate) {
+    // unique_ptr is moved between slots with memcpy().
+    abel::circular_buffer<std::unique_ptr<int>> buf;
+    std::deque<int> model;
+    for (int i = 0; i < 20; ++i) {
+        buf.push_back(std::unique_ptr<int>(new int(i)));
+        model.push_back(i);
+        buf.push_front(std::unique_ptr<int>(new int(-i)));
+        model.push_front(-i);
+    }
+    buf.erase(buf.begin() + 3, buf.begin() + 7);
+    model.erase(model.begin() + 3, model.begin() + 7);
+    buf.erase(buf.end() - 9, buf.end() - 2);
+    model.erase(model.end() - 9, model.end() - 2);
+    buf.reserve(200);
+    ASSERT_EQ(buf.size(), model.size());
+    for (size_t i = 0; i < model.size(); ++i) {
+        EXPECT_EQ(*buf[i], model[i]);
+    }
+}
+
+namespace {
+
+std::string contents(const abel::circular_buffer<char>& buf) {
+    std::string s;
+    for (auto span : buf.readable_spans()) {
+        s.append(span.data(), span.size());
+    }
+    return s;
+}
+
+}  // namespace
+
+TEST(circular, spans) {
+    abel::circular_buffer<char> buf;
+    auto data = buf.readable_spans();
+    EXPECT_TRUE(data[0].empty());
+    EXPECT_TRUE(data[1].empty());
+
+    buf.push_back(abel::Span<const char>("abcdef", 6));
+    EXPECT_EQ(buf.capacity(), 8u);
+    EXPECT_EQ(contents(buf), "abcdef");
+    buf.consume(4);
+    EXPECT_EQ(contents(buf), "ef");
+
+    // The free space wraps around the end of the storage.
+    auto free = buf.writable_spans();
+    ASSERT_EQ(free[0].size(), 2u);
+    ASSERT_EQ(free[1].size(), 4u);
+    free[0][0] = 'g';
+    free[0][1] = 'h';
+    free[1][0] = 'i';
+    buf.commit(3);
+    EXPECT_EQ(buf.size(), 5u);
+    data = buf.readable_spans();
+    EXPECT_EQ(data[0].size(), 4u);
+    EXPECT_EQ(data[1].size(), 1u);
+    EXPECT_EQ(contents(buf), "efghi");
+
+    // Bulk appends wrap, and grow the buffer when needed.
+    buf.push_back(abel::Span<const char>("jkl", 3));
+    EXPECT_EQ(buf.capacity(), 8u);
+    EXPECT_EQ(contents(buf), "efghijkl");
+    buf.push_back(abel::Span<const char>("mnopqrstuvwxyz", 14));
+    EXPECT_EQ(buf.capacity(), 32u);
+    EXPECT_EQ(contents(buf), "efghijklmnopqrstuvwxyz");
+    EXPECT_EQ(buf.front(), 'e');
+    EXPECT_EQ(buf.back(), 'z');
+
+    free = buf.writable_spans(100);
+    EXPECT_GE(free[0].size() + free[1].size(), 100u);
+    EXPECT_EQ(contents(buf), "efghijklmnopqrstuvwxyz");
+    buf.consume(buf.size());
+    EXPECT_TRUE(buf.empty());
+}
+
+TEST(circular, bulk_push_non_trivial) {
+    abel::circular_buffer<std::string> buf;
+    buf.push_back("x");
+    std::vector<std::string> v = {"a", "b", "c"};
+    buf.push_back(abel::Span<const std::string>(v));
+    ASSERT_EQ(buf.size(), 4u);
+    EXPECT_EQ(buf[3], "c");
+    buf.consume(2);
+    ASSERT_EQ(buf.size(), 2u);
+    EXPECT_EQ(buf.front(), "b");
+    auto data = buf.readable_spans();
+    EXPECT_EQ(data[0].size() + data[1].size(), 2u);
+}
+
+TEST(circular, readv_writev) {
+    int in[2];
+    int out[2];
+    ASSERT_EQ(::pipe(in), 0);
+    ASSERT_EQ(::pipe(out), 0);
+    std::string expected;
+    for (int i = 0; i < 1000; ++i) {
+        expected += std::to_string(i) + ",";
+    }
+
+    abel::circular_buffer<char> buf;
+    size_t written = 0;
+    size_t filled = 0;
+    std::string received;
+    while (received.size() < expected.size()) {
+        // Feed the input pipe in uneven pieces.
+        if (written < expected.size()) {
+            size_t n = std::min<size_t>(777, expected.size() - written);
+            ASSERT_EQ(::write(in[1], expected.data() + written, n), static_cast<ssize_t>(n));
+            written += n;
+        }
+        if (filled < written) {
+            auto free = buf.writable_spans(512);
+            iovec iov[2] = {{free[0].data(), free[0].size()}, {free[1].data(), free[1].size()}};
+            ssize_t n = ::readv(in[0], iov, 2);
+            ASSERT_GT(n, 0);
+            buf.commit(n);
+            filled += n;
+        }
+
+        // Drain only part of it, so that the contents wrap.
+        auto data = buf.readable_spans();
+        iovec ov[2] = {{data[0].data(), data[0].size()}, {data[1].data(), data[1].size()}};
+        ov[0].iov_len = std::min<size_t>(ov[0].iov_len, 300);
+        ov[1].iov_len = std::min<size_t>(ov[1].iov_len, 300 - ov[0].iov_len);
+        ssize_t n = ::writev(out[1], ov, 2);
+        ASSERT_GE(n, 0);
+        buf.consume(n);
+        char tmp[1024];
+        while (n > 0) {
+            ssize_t r = ::read(out[0], tmp, std::min<size_t>(n, sizeof(tmp)));
+            ASSERT_GT(r, 0);
+            received.append(tmp, r);
+            n -= r;
+        }
+    }
+    EXPECT_EQ(received, expected);
+    EXPECT_LE(buf.capacity(), 8192u);
+    ::close(in[0]);
+    ::close(in[1]);
+    ::close(out[0]);
+    ::close(out[1]);
+}
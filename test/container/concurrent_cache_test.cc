@@ -0,0 +1,106 @@
+//
+
+#include <abel/container/concurrent_cache.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <abel/chrono/clock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(concurrent_cache, basic) {
+    abel::concurrent_cache<std::string, int> cache(100, 3);
+    EXPECT_EQ(cache.num_shards(), 4u);
+    EXPECT_FALSE(cache.get("a"));
+    EXPECT_TRUE(cache.put("a", 1));
+    EXPECT_EQ(*cache.get("a"), 1);
+    EXPECT_TRUE(cache.contains("a"));
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_TRUE(cache.erase("a"));
+    EXPECT_EQ(cache.size(), 0u);
+    const abel::cache_stats s = cache.stats();
+    EXPECT_EQ(s.hits, 1u);
+    EXPECT_EQ(s.misses, 1u);
+}
+
+TEST(concurrent_cache, capacity) {
+    abel::concurrent_cache<int, int> cache(64, 4);
+    for (int i = 0; i < 1000; ++i) {
+        cache.put(i, i);
+    }
+    EXPECT_LE(cache.size(), 64u);
+    EXPECT_LE(cache.weight(), cache.capacity());
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(concurrent_cache, coalesces_loads) {
+    abel::concurrent_cache<int, int> cache(100);
+    std::atomic<int> loads(0);
+    std::atomic<bool> release(false);
+    std::vector<std::thread> threads;
+    std::atomic<int> sum(0);
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            sum += cache.get_or_load(7, [&] {
+                ++loads;
+                while (!release) {
+                    std::this_thread::yield();
+                }
+                return 42;
+            });
+        });
+    }
+    abel::sleep_for(abel::milliseconds(50));
+    release = true;
+    for (auto &t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(loads, 1);
+    EXPECT_EQ(sum, 8 * 42);
+    // The loading thread missed; the others either waited for it or came
+    // late and hit, and each counts once.
+    const abel::cache_stats s = cache.stats();
+    EXPECT_EQ(s.misses, 1u);
+    EXPECT_EQ(s.hits + s.coalesced, 7u);
+}
+
+#ifdef ABEL_HAVE_EXCEPTIONS
+TEST(concurrent_cache, failed_load) {
+    abel::concurrent_cache<int, int> cache(100);
+    EXPECT_THROW(cache.get_or_load(1, []() -> int { throw std::runtime_error("no"); }),
+                 std::runtime_error);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_EQ(cache.get_or_load(1, [] { return 1; }), 1);
+}
+#endif
+
+TEST(concurrent_cache, threads) {
+    abel::concurrent_cache<int, int> cache(256, 8);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t] {
+            for (int i = 0; i < 10000; ++i) {
+                const int key = (i * 7 + t) % 512;
+                if (i % 3 == 0) {
+                    cache.put(key, key);
+                } else if (auto v = cache.get(key)) {
+                    EXPECT_EQ(*v, key);
+                }
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    EXPECT_LE(cache.size(), 256u);
+    const abel::cache_stats s = cache.stats();
+    EXPECT_EQ(s.hits + s.misses, 4u * 6666);
+}
+
+}  // namespace
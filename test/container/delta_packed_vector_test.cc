@@ -0,0 +1,94 @@
+//
+
+#include <abel/container/delta_packed_vector.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+std::vector<uint64_t> random_sorted (size_t n, uint64_t max_gap, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<uint64_t> v(n);
+    uint64_t x = rng() % 1000;
+    for (auto &e : v) {
+        x += rng() % (max_gap + 1);
+        e = x;
+    }
+    return v;
+}
+
+TEST(delta_packed_vector, round_trip) {
+    for (size_t n : {0, 1, 255, 256, 257, 1000, 5000}) {
+        for (uint64_t gap : {0ull, 1ull, 100ull, 1ull << 20, 1ull << 40}) {
+            const std::vector<uint64_t> values = random_sorted(n, gap, n + gap);
+            abel::delta_packed_vector v(values);
+            ASSERT_EQ(v.size(), n);
+            EXPECT_EQ(v.decode(), values) << n << " " << gap;
+            for (size_t i = 0; i < n; i += 97) {
+                ASSERT_EQ(v[i], values[i]);
+            }
+            if (n != 0) {
+                EXPECT_EQ(v.back(), values.back());
+            }
+        }
+    }
+}
+
+TEST(delta_packed_vector, compresses) {
+    const std::vector<uint64_t> values = random_sorted(100000, 100, 1);
+    abel::delta_packed_vector v(values);
+    // Gaps below 128 take 7 bits, plus a skip entry per block.
+    EXPECT_LT(v.memory_bytes(), values.size());
+}
+
+TEST(delta_packed_vector, lookup) {
+    const std::vector<uint64_t> values = random_sorted(3000, 50, 3);
+    abel::delta_packed_vector v(values);
+    std::mt19937_64 rng(4);
+    for (int i = 0; i < 2000; ++i) {
+        const uint64_t x = rng() % (values.back() + 10);
+        const size_t expect = std::lower_bound(values.begin(), values.end(), x) - values.begin();
+        ASSERT_EQ(v.lower_bound(x), expect) << x;
+        ASSERT_EQ(v.contains(x), std::binary_search(values.begin(), values.end(), x));
+    }
+}
+
+TEST(delta_packed_vector, cursor) {
+    const std::vector<uint64_t> values = random_sorted(5000, 1000, 5);
+    abel::delta_packed_vector v(values);
+    abel::delta_packed_vector::cursor c(v);
+    std::vector<uint64_t> seen;
+    for (; c.valid(); c.next()) {
+        seen.push_back(c.value());
+    }
+    EXPECT_EQ(seen, values);
+
+    abel::delta_packed_vector::cursor s(v);
+    uint64_t x = 0;
+    while (s.valid()) {
+        const size_t expect = std::lower_bound(values.begin(), values.end(), x) - values.begin();
+        ASSERT_EQ(s.index(), expect);
+        ASSERT_GE(s.value(), x);
+        x = s.value() + 1 + x % 100000;
+        s.skip_to(x);
+    }
+    EXPECT_GT(x, values.back());
+}
+
+TEST(delta_packed_vector, intersect) {
+    const std::vector<uint64_t> a = random_sorted(20000, 20, 6);
+    const std::vector<uint64_t> b = random_sorted(700, 600, 7);
+    std::vector<uint64_t> expect;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+    ASSERT_FALSE(expect.empty());
+    std::vector<uint64_t> out;
+    abel::intersect(abel::delta_packed_vector(a), abel::delta_packed_vector(b), &out);
+    EXPECT_EQ(out, expect);
+}
+
+}  // namespace
@@ -0,0 +1,113 @@
+//
+
+#include <abel/container/dynamic_bitset.h>
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(dynamic_bitset, basic) {
+    abel::dynamic_bitset b(100);
+    EXPECT_EQ(b.size(), 100u);
+    EXPECT_EQ(b.num_words(), 2u);
+    EXPECT_TRUE(b.none());
+    b.set(3).set(64).set(99);
+    EXPECT_TRUE(b.test(3));
+    EXPECT_TRUE(b[64]);
+    EXPECT_FALSE(b[65]);
+    EXPECT_EQ(b.count(), 3u);
+    b.reset(3);
+    b.flip(4);
+    b.set(5, true);
+    b.set(64, false);
+    EXPECT_EQ(b.count(), 3u);
+    EXPECT_EQ(b.find_first(), 4u);
+    EXPECT_EQ(b.find_next(4), 5u);
+    EXPECT_EQ(b.find_next(5), 99u);
+    EXPECT_EQ(b.find_next(99), abel::dynamic_bitset::npos);
+
+    // Bits past the size stay clear.
+    b.flip();
+    EXPECT_EQ(b.count(), 97u);
+    b.set();
+    EXPECT_TRUE(b.all());
+    EXPECT_EQ(b.count(), 100u);
+    b.reset();
+    EXPECT_TRUE(b.none());
+    EXPECT_EQ(b.find_first(), abel::dynamic_bitset::npos);
+}
+
+TEST(dynamic_bitset, resize) {
+    abel::dynamic_bitset b(10, true);
+    EXPECT_EQ(b.count(), 10u);
+    b.resize(70, true);
+    EXPECT_EQ(b.count(), 70u);
+    b.resize(200);
+    EXPECT_EQ(b.count(), 70u);
+    b.resize(5);
+    EXPECT_EQ(b.count(), 5u);
+    b.resize(64);
+    EXPECT_EQ(b.count(), 5u);
+    for (int i = 0; i < 100; ++i) {
+        b.push_back(i % 3 == 0);
+    }
+    EXPECT_EQ(b.size(), 164u);
+    EXPECT_EQ(b.count(), 5u + 34u);
+    EXPECT_TRUE(b[64]);
+    EXPECT_FALSE(b[65]);
+}
+
+TEST(dynamic_bitset, bitwise) {
+    std::mt19937_64 rng(42);
+    for (size_t n : {0, 1, 63, 64, 65, 255, 256, 1000, 4097}) {
+        abel::dynamic_bitset a(n), b(n);
+        std::vector<bool> va(n), vb(n);
+        for (size_t i = 0; i < n; ++i) {
+            va[i] = rng() & 1;
+            vb[i] = rng() & 1;
+            a.set(i, va[i]);
+            b.set(i, vb[i]);
+        }
+        size_t both = 0;
+        for (size_t i = 0; i < n; ++i) {
+            both += va[i] && vb[i];
+        }
+        EXPECT_EQ(a.count_and(b), both) << n;
+        EXPECT_EQ((a & b).count(), both) << n;
+
+        const abel::dynamic_bitset o = a | b, x = a ^ b, d = a - b;
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(o[i], va[i] || vb[i]) << n << " " << i;
+            ASSERT_EQ(x[i], va[i] != vb[i]) << n << " " << i;
+            ASSERT_EQ(d[i], va[i] && !vb[i]) << n << " " << i;
+        }
+        EXPECT_EQ(x, (a - b) | (b - a));
+        if (n != 0) {
+            abel::dynamic_bitset c = a;
+            EXPECT_NE(c.flip(n - 1), a);
+        }
+    }
+}
+
+TEST(dynamic_bitset, serialize) {
+    abel::dynamic_bitset b(1000);
+    for (size_t i = 0; i < 1000; i += 7) {
+        b.set(i);
+    }
+    std::vector<uint64_t> buf(b.serialized_size() / sizeof(uint64_t));
+    b.serialize(buf.data());
+    abel::bitset_view v;
+    ASSERT_TRUE(abel::bitset_view::map(buf.data(), b.serialized_size(), &v));
+    EXPECT_EQ(v.size(), 1000u);
+    EXPECT_EQ(v, b);
+    EXPECT_EQ(v.count(), b.count());
+    EXPECT_EQ(abel::dynamic_bitset(v), b);
+    EXPECT_FALSE(abel::bitset_view::map(buf.data(), b.serialized_size() - 8, &v));
+    buf[0] = 0;
+    EXPECT_FALSE(abel::bitset_view::map(buf.data(), b.serialized_size(), &v));
+}
+
+}  // namespace
@@ -1786,4 +1786,140 @@ TEST(InlinedVectorTest, AbelHashValueWorks) {
     EXPECT_TRUE(abel::VerifyTypeImplementsAbelHashCorrectly(cases));
 }
 
+// Owns a heap allocation, counts live instances and moves, and opts in to
+// relocation with memcpy() below.
+class RelocatableValue {
+ public:
+  static int live;
+  static int moves;
+
+  explicit RelocatableValue(int v) : p_(new int(v)) { ++live; }
+  RelocatableValue(const RelocatableValue& other) : p_(new int(*other.p_)) {
+    ++live;
+  }
+  RelocatableValue(RelocatableValue&& other) noexcept : p_(other.p_) {
+    other.p_ = nullptr;
+    ++live;
+    ++moves;
+  }
+  RelocatableValue& operator=(const RelocatableValue& other) {
+    RelocatableValue copy(other);
+    std::swap(p_, copy.p_);
+    return *this;
+  }
+  RelocatableValue& operator=(RelocatableValue&& other) noexcept {
+    std::swap(p_, other.p_);
+    ++moves;
+    return *this;
+  }
+  ~RelocatableValue() {
+    delete p_;
+    --live;
+  }
+
+  int value() const { return *p_; }
+
+ private:
+  int* p_;
+};
+
+int RelocatableValue::live = 0;
+int RelocatableValue::moves = 0;
+
+}  // anonymous namespace
+
+namespace abel {
+template <>
+struct is_trivially_relocatable<RelocatableValue> : std::true_type {};
+}  // namespace abel
+
+namespace {
+
+std::vector<int> Values(const abel::InlinedVector<RelocatableValue, 4>& v) {
+  std::vector<int> values;
+  for (const RelocatableValue& r : v) values.push_back(r.value());
+  return values;
+}
+
+TEST(InlinedVectorTest, RelocatesTriviallyRelocatableTypes) {
+  {
+    abel::InlinedVector<RelocatableValue, 4> v;
+    std::vector<int> model;
+    RelocatableValue::moves = 0;
+    // Growing out of the inlined storage and reallocating relocate the
+    // elements instead of moving them.
+    for (int i = 0; i < 100; ++i) {
+      v.emplace_back(i);
+      model.push_back(i);
+    }
+    v.reserve(1000);
+    EXPECT_EQ(RelocatableValue::moves, 0);
+    EXPECT_EQ(Values(v), model);
+
+    v.erase(v.begin() + 10, v.begin() + 20);
+    model.erase(model.begin() + 10, model.begin() + 20);
+    v.erase(v.begin());
+    model.erase(model.begin());
+    EXPECT_EQ(RelocatableValue::moves, 0);
+    EXPECT_EQ(Values(v), model);
+
+    v.insert(v.begin() + 5, 3, RelocatableValue(-1));
+    model.insert(model.begin() + 5, 3, -1);
+    v.insert(v.begin() + 7, RelocatableValue(-2));
+    model.insert(model.begin() + 7, -2);
+    EXPECT_EQ(Values(v), model);
+
+    v.shrink_to_fit();
+    v.resize(150, RelocatableValue(-3));
+    model.resize(150, -3);
+    EXPECT_EQ(Values(v), model);
+
+    v.erase(v.begin() + 3, v.end());
+    model.resize(3);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 4u);
+    EXPECT_EQ(Values(v), model);
+
+    abel::InlinedVector<RelocatableValue, 4> inlined;
+    inlined.emplace_back(42);
+    abel::InlinedVector<RelocatableValue, 4> allocated;
+    for (int i = 0; i < 10; ++i) allocated.emplace_back(i);
+    RelocatableValue::moves = 0;
+    inlined.swap(v);
+    EXPECT_EQ(Values(inlined), model);
+    EXPECT_EQ(Values(v), std::vector<int>{42});
+    v.swap(allocated);
+    EXPECT_EQ(Values(allocated), std::vector<int>{42});
+    EXPECT_EQ(v.size(), 10u);
+    abel::InlinedVector<RelocatableValue, 4> moved(std::move(inlined));
+    EXPECT_EQ(Values(moved), model);
+    EXPECT_TRUE(inlined.empty());
+    inlined = std::move(moved);
+    EXPECT_EQ(Values(inlined), model);
+    EXPECT_EQ(RelocatableValue::moves, 0);
+  }
+  EXPECT_EQ(RelocatableValue::live, 0);
+}
+
+#ifdef ABEL_HAVE_EXCEPTIONS
+struct ThrowingSource {
+  bool fail;
+
+  operator std::unique_ptr<int>() const {
+    if (fail) throw std::runtime_error("fail");
+    return abel::make_unique<int>(-1);
+  }
+};
+
+TEST(InlinedVectorTest, RelocatingInsertIsExceptionSafe) {
+  abel::InlinedVector<std::unique_ptr<int>, 8> v;
+  for (int i = 0; i < 4; ++i) v.push_back(abel::make_unique<int>(i));
+  const ThrowingSource sources[] = {{false}, {true}};
+  EXPECT_THROW(v.insert(v.begin() + 1, std::begin(sources), std::end(sources)),
+               std::runtime_error);
+  ASSERT_EQ(v.size(), 4u);
+  for (int i = 0; i < 4; ++i) EXPECT_EQ(*v[i], i);
+}
+#endif  // ABEL_HAVE_EXCEPTIONS
+
 }  // anonymous namespace
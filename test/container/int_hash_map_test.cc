@@ -0,0 +1,158 @@
+//
+
+#include <abel/container/int_hash_map.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+template <class Map>
+std::vector<std::pair<typename Map::key_type, typename Map::mapped_type>> Items(
+    const Map& m) {
+  std::vector<std::pair<typename Map::key_type, typename Map::mapped_type>> v;
+  for (const auto& kv : m) v.emplace_back(kv.first, kv.second);
+  return v;
+}
+
+TEST(IntHashMap, Basic) {
+  abel::int_hash_map<uint64_t, int> m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.capacity(), 0u);
+  EXPECT_TRUE(m.begin() == m.end());
+  EXPECT_TRUE(m.find(1) == m.end());
+
+  EXPECT_TRUE(m.insert({1, 10}).second);
+  EXPECT_FALSE(m.insert({1, 11}).second);
+  EXPECT_TRUE(m.try_emplace(2, 20).second);
+  EXPECT_TRUE(m.emplace(3, 30).second);
+  m[4] = 40;
+  EXPECT_FALSE(m.insert_or_assign(4, 41).second);
+  EXPECT_EQ(m.size(), 4u);
+  EXPECT_EQ(m.at(1), 10);
+  EXPECT_EQ(m[4], 41);
+  EXPECT_EQ(m.find(2)->second, 20);
+  EXPECT_EQ(m.count(3), 1u);
+  EXPECT_FALSE(m.contains(5));
+  (*m.find(3)).second = 31;
+  EXPECT_EQ(m.at(3), 31);
+
+  EXPECT_EQ(m.erase(2), 1u);
+  EXPECT_EQ(m.erase(2), 0u);
+  m.erase(m.find(1));
+  EXPECT_THAT(Items(m), UnorderedElementsAre(Pair(3, 31), Pair(4, 41)));
+
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.begin() == m.end());
+#ifdef ABEL_HAVE_EXCEPTIONS
+  EXPECT_THROW(m.at(1), std::out_of_range);
+#endif
+}
+
+TEST(IntHashMap, EmptyKey) {
+  // The key with all bits set is stored apart from the table.
+  abel::int_hash_map<int64_t, std::string> m;
+  EXPECT_FALSE(m.contains(-1));
+  m[-1] = "minus one";
+  m[0] = "zero";
+  EXPECT_EQ(m.size(), 2u);
+  EXPECT_TRUE(m.contains(-1));
+  EXPECT_EQ(m.find(-1)->first, -1);
+  EXPECT_THAT(Items(m), UnorderedElementsAre(Pair(-1, "minus one"), Pair(0, "zero")));
+  for (int64_t i = 1; i < 100; ++i) m[i] = std::to_string(i);
+  EXPECT_EQ(m.at(-1), "minus one");
+  EXPECT_EQ(m.erase(-1), 1u);
+  EXPECT_FALSE(m.contains(-1));
+  EXPECT_EQ(m.size(), 100u);
+
+  abel::int_hash_map<uint32_t, int> u;
+  u[std::numeric_limits<uint32_t>::max()] = 1;
+  EXPECT_EQ(u.size(), 1u);
+  EXPECT_EQ(u.begin()->first, std::numeric_limits<uint32_t>::max());
+}
+
+TEST(IntHashMap, MatchesUnorderedMap) {
+  // Random inserts and erases over a small key range exercise the backward
+  // shift of erase().
+  std::mt19937_64 gen(42);
+  abel::int_hash_map<uint32_t, uint32_t> m;
+  std::unordered_map<uint32_t, uint32_t> model;
+  for (int i = 0; i < 200000; ++i) {
+    const uint32_t key = static_cast<uint32_t>(gen() % 2000);
+    switch (gen() % 3) {
+      case 0:
+        m[key] = static_cast<uint32_t>(i);
+        model[key] = static_cast<uint32_t>(i);
+        break;
+      case 1:
+        EXPECT_EQ(m.erase(key), model.erase(key));
+        break;
+      default: {
+        auto it = m.find(key);
+        auto mit = model.find(key);
+        ASSERT_EQ(it == m.end(), mit == model.end());
+        if (mit != model.end()) {
+          EXPECT_EQ(it->second, mit->second);
+        }
+      }
+    }
+    ASSERT_EQ(m.size(), model.size());
+  }
+  EXPECT_LE(m.load_factor(), m.max_load_factor());
+  size_t n = 0;
+  for (auto kv : m) {
+    EXPECT_EQ(model.at(kv.first), kv.second);
+    ++n;
+  }
+  EXPECT_EQ(n, model.size());
+}
+
+TEST(IntHashMap, CopyMoveSwap) {
+  abel::int_hash_map<int, std::string> a = {{1, "a"}, {2, "b"}, {-1, "c"}};
+  abel::int_hash_map<int, std::string> b(a);
+  EXPECT_TRUE(a == b);
+  b[3] = "d";
+  EXPECT_TRUE(a != b);
+
+  abel::int_hash_map<int, std::string> c(std::move(b));
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(c.size(), 4u);
+  b = c;
+  EXPECT_TRUE(b == c);
+  c.swap(a);
+  EXPECT_EQ(a.size(), 4u);
+  EXPECT_EQ(c.size(), 3u);
+  a = std::move(c);
+  EXPECT_EQ(a.size(), 3u);
+  EXPECT_EQ(a.at(-1), "c");
+}
+
+TEST(IntHashMap, ReserveAndRehash) {
+  abel::int_hash_map<uint64_t, uint64_t> m;
+  m.reserve(1000);
+  const size_t capacity = m.capacity();
+  EXPECT_GE(capacity * 3, 1000u * 4);
+  for (uint64_t i = 0; i < 1000; ++i) m[i * 1000003] = i;
+  EXPECT_EQ(m.capacity(), capacity);
+  for (uint64_t i = 0; i < 990; ++i) m.erase(i * 1000003);
+  m.rehash(0);
+  EXPECT_LT(m.capacity(), capacity);
+  EXPECT_EQ(m.size(), 10u);
+  for (uint64_t i = 990; i < 1000; ++i) EXPECT_EQ(m.at(i * 1000003), i);
+
+  abel::int_hash_map<uint64_t, uint64_t>::const_iterator it = m.begin();
+  EXPECT_TRUE(it != m.cend());
+}
+
+}  // namespace
@@ -0,0 +1,195 @@
+//
+
+#include <abel/container/intrusive_hash_set.h>
+
+#include <iterator>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <abel/container/intrusive_list.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+struct entry : abel::intrusive_hash_node, abel::intrusive_list_node {
+    int key;
+    std::string value;
+
+    explicit entry (int k, std::string v = std::string()) : key(k), value(std::move(v)) { }
+};
+
+// Hashes and compares entries and plain keys alike.
+struct entry_hash {
+    size_t operator () (const entry &e) const { return std::hash<int>()(e.key); }
+    size_t operator () (int key) const { return std::hash<int>()(key); }
+};
+
+struct entry_equal {
+    bool operator () (const entry &a, const entry &b) const { return a.key == b.key; }
+    bool operator () (const entry &e, int key) const { return e.key == key; }
+};
+
+using entry_set = abel::intrusive_hash_set<entry, entry_hash, entry_equal>;
+
+TEST(intrusive_hash_set, basic) {
+    entry_set set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.begin(), set.end());
+
+    entry a(1, "a"), b(2, "b"), a2(1, "a2");
+    EXPECT_TRUE(set.insert(a).second);
+    EXPECT_TRUE(set.insert(b).second);
+    auto r = set.insert(a2);
+    EXPECT_FALSE(r.second);
+    EXPECT_EQ(&*r.first, &a);
+    EXPECT_EQ(set.size(), 2u);
+
+    EXPECT_EQ(&*set.find(1), &a);
+    EXPECT_EQ(set.find(2)->value, "b");
+    EXPECT_EQ(set.find(3), set.end());
+    EXPECT_EQ(set.find(a2), set.find(1));
+    EXPECT_TRUE(set.contains(2));
+    EXPECT_EQ(set.count(3), 0u);
+
+    const entry_set &cset = set;
+    EXPECT_EQ(cset.find(2)->value, "b");
+
+    EXPECT_EQ(set.erase(1), 1u);
+    EXPECT_EQ(set.erase(1), 0u);
+    EXPECT_FALSE(set.contains(1));
+    set.remove(b);
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.insert(a2).second);
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(a2.hash_next, nullptr);
+}
+
+TEST(intrusive_hash_set, incremental_rehash) {
+    std::vector<std::unique_ptr<entry>> entries;
+    entry_set set;
+    bool saw_rehash = false;
+    for (int i = 0; i < 10000; ++i) {
+        entries.emplace_back(new entry(i));
+        ASSERT_TRUE(set.insert(*entries.back()).second);
+        saw_rehash |= set.rehashing();
+        // Every element is found while buckets are being moved.
+        if (set.rehashing() && i % 97 == 0) {
+            for (int j = 0; j <= i; ++j) {
+                ASSERT_EQ(&*set.find(j), entries[j].get()) << i;
+            }
+        }
+    }
+    EXPECT_TRUE(saw_rehash);
+    EXPECT_LE(set.size(), set.bucket_count());
+
+    // Iteration visits every element once, also in the middle of a rehash.
+    while (!set.rehashing()) {
+        entries.emplace_back(new entry(static_cast<int>(entries.size())));
+        set.insert(*entries.back());
+    }
+    std::set<int> seen;
+    size_t visited = 0;
+    for (const entry &e : set) {
+        seen.insert(e.key);
+        ++visited;
+    }
+    EXPECT_EQ(visited, entries.size());
+    EXPECT_EQ(seen.size(), entries.size());
+
+    // Erase every other element through iterators.
+    for (auto it = set.begin(); it != set.end();) {
+        it = it->key % 2 == 0 ? set.erase(it) : std::next(it);
+    }
+    EXPECT_EQ(set.size(), entries.size() / 2);
+    for (const auto &e : entries) {
+        EXPECT_EQ(set.contains(e->key), e->key % 2 == 1);
+    }
+    set.clear();
+}
+
+TEST(intrusive_hash_set, reserve) {
+    entry_set set;
+    set.reserve(1000);
+    EXPECT_GE(set.bucket_count(), 1000u);
+    EXPECT_FALSE(set.rehashing());
+    std::vector<entry> entries;
+    entries.reserve(1000);
+    const size_t buckets = set.bucket_count();
+    for (int i = 0; i < 1000; ++i) {
+        entries.emplace_back(i);
+        set.insert(entries.back());
+    }
+    EXPECT_EQ(set.bucket_count(), buckets);
+    EXPECT_FALSE(set.rehashing());
+    set.clear();
+}
+
+// An LRU cache over elements that are on a list and in a set at once, with
+// no allocation per element.
+class lru_cache {
+public:
+    explicit lru_cache (size_t capacity) : _capacity(capacity) { }
+    ~lru_cache () {
+        _set.clear();
+        _list.clear();
+    }
+
+    entry *get (int key) {
+        auto it = _set.find(key);
+        if (it == _set.end()) {
+            return nullptr;
+        }
+        abel::intrusive_list<entry>::remove(*it);
+        _list.push_front(*it);
+        return &*it;
+    }
+
+    // Returns the evicted entry, if any.
+    entry *put (entry &e) {
+        _set.insert(e);
+        _list.push_front(e);
+        if (_set.size() <= _capacity) {
+            return nullptr;
+        }
+        entry &victim = _list.back();
+        _list.pop_back();
+        _set.remove(victim);
+        return &victim;
+    }
+
+private:
+    size_t _capacity;
+    abel::intrusive_list<entry> _list;
+    entry_set _set;
+};
+
+TEST(intrusive_hash_set, lru) {
+    std::vector<entry> entries;
+    for (int i = 0; i < 100; ++i) {
+        entries.emplace_back(i, std::to_string(i));
+    }
+    {
+        lru_cache cache(10);
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_EQ(cache.put(entries[i]), nullptr);
+        }
+        ASSERT_NE(cache.get(0), nullptr);
+        EXPECT_EQ(cache.put(entries[10]), &entries[1]);
+        EXPECT_EQ(cache.get(1), nullptr);
+        EXPECT_EQ(cache.get(0)->value, "0");
+        for (int i = 11; i < 100; ++i) {
+            entry *evicted = cache.put(entries[i]);
+            ASSERT_NE(evicted, nullptr);
+            EXPECT_EQ(evicted->hash_next, nullptr);
+        }
+        for (int i = 90; i < 100; ++i) {
+            EXPECT_EQ(cache.get(i), &entries[i]);
+        }
+        EXPECT_EQ(cache.get(0), nullptr);
+    }
+}
+
+}  // namespace
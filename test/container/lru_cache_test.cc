@@ -0,0 +1,145 @@
+//
+
+#include <abel/container/lru_cache.h>
+
+#include <memory>
+#include <string>
+
+#include <abel/chrono/clock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(lru_cache, basic) {
+    abel::lru_cache<int, std::string> cache(3);
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.get(1), nullptr);
+    EXPECT_TRUE(cache.put(1, "one"));
+    EXPECT_TRUE(cache.put(2, "two"));
+    ASSERT_NE(cache.get(1), nullptr);
+    EXPECT_EQ(*cache.get(1), "one");
+    EXPECT_TRUE(cache.put(1, "uno"));
+    EXPECT_EQ(*cache.get(1), "uno");
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.weight(), 2u);
+    EXPECT_TRUE(cache.contains(2));
+    EXPECT_TRUE(cache.erase(2));
+    EXPECT_FALSE(cache.erase(2));
+    EXPECT_FALSE(cache.contains(2));
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.weight(), 0u);
+}
+
+TEST(lru_cache, evicts_least_recently_used) {
+    abel::lru_cache<int, int> cache(4);
+    for (int i = 0; i < 4; ++i) {
+        cache.put(i, i);
+    }
+    // 0 is used again, so 1 is the oldest.
+    cache.get(0);
+    cache.put(4, 4);
+    EXPECT_EQ(cache.size(), 4u);
+    EXPECT_TRUE(cache.contains(0));
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_EQ(cache.stats().evictions, 1u);
+}
+
+TEST(lru_cache, scan_resistance) {
+    abel::lru_cache<int, int> cache(10);
+    // A hot set that is hit twice, then a scan over many cold keys.
+    for (int i = 0; i < 5; ++i) {
+        cache.put(i, i);
+        cache.get(i);
+    }
+    for (int i = 100; i < 1000; ++i) {
+        cache.put(i, i);
+    }
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(cache.contains(i)) << i;
+    }
+    EXPECT_EQ(cache.size(), 10u);
+}
+
+TEST(lru_cache, weight) {
+    struct length_weigher {
+        size_t operator () (int, const std::string &v) const {
+            return v.size();
+        }
+    };
+    abel::lru_cache<int, std::string, length_weigher> cache(10);
+    EXPECT_TRUE(cache.put(1, "aaaa"));
+    EXPECT_TRUE(cache.put(2, "bbbb"));
+    EXPECT_EQ(cache.weight(), 8u);
+    EXPECT_TRUE(cache.put(3, "cccc"));
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_EQ(cache.weight(), 8u);
+    // Growing a value in place evicts others.
+    EXPECT_TRUE(cache.put(3, "cccccccc"));
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_EQ(cache.weight(), 8u);
+    // Too heavy to cache at all.
+    EXPECT_FALSE(cache.put(3, std::string(11, 'c')));
+    EXPECT_FALSE(cache.contains(3));
+    EXPECT_EQ(cache.weight(), 0u);
+}
+
+TEST(lru_cache, growing_protected_entry_demotes) {
+    struct length_weigher {
+        size_t operator () (int, const std::string &v) const {
+            return v.size();
+        }
+    };
+    abel::lru_cache<int, std::string, length_weigher> cache(10);
+    cache.put(1, "aaaa");
+    cache.get(1);
+    cache.put(2, "bbb");
+    cache.get(2);
+    // 1 and 2 are protected. Growing 1 takes the protected list over its 80%
+    // share, so 2 goes back to probation and is the next to be evicted.
+    EXPECT_TRUE(cache.put(1, "aaaaaa"));
+    cache.put(3, "c");
+    cache.put(4, "d");
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(3));
+    EXPECT_TRUE(cache.contains(4));
+    EXPECT_EQ(cache.weight(), 8u);
+}
+
+TEST(lru_cache, ttl) {
+    abel::lru_cache<int, int> cache(10, abel::milliseconds(50));
+    cache.put(1, 1);
+    cache.put(2, 2);
+    EXPECT_NE(cache.get(1), nullptr);
+    abel::sleep_for(abel::milliseconds(100));
+    cache.put(3, 3);
+    EXPECT_EQ(cache.get(1), nullptr);
+    EXPECT_EQ(cache.stats().expirations, 1u);
+    EXPECT_EQ(cache.purge_expired(), 1u);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_NE(cache.get(3), nullptr);
+}
+
+TEST(lru_cache, stats_and_load) {
+    abel::lru_cache<int, std::unique_ptr<int>> owning(2);
+    owning.put(1, std::unique_ptr<int>(new int(1)));
+    EXPECT_EQ(**owning.get(1), 1);
+
+    abel::lru_cache<int, int> cache(2);
+    int loads = 0;
+    auto loader = [&] { return ++loads * 10; };
+    EXPECT_EQ(cache.get_or_load(1, loader), 10);
+    EXPECT_EQ(cache.get_or_load(1, loader), 10);
+    EXPECT_EQ(loads, 1);
+    const abel::cache_stats &s = cache.stats();
+    EXPECT_EQ(s.hits, 1u);
+    EXPECT_EQ(s.misses, 1u);
+    EXPECT_DOUBLE_EQ(s.hit_rate(), 0.5);
+    EXPECT_EQ(*cache.peek(1), 10);
+    EXPECT_EQ(s.hits, 1u);
+    cache.reset_stats();
+    EXPECT_EQ(cache.stats().misses, 0u);
+}
+
+}  // namespace
@@ -0,0 +1,127 @@
+//
+
+#include <gtest/gtest.h>
+#include <abel/container/mpmc_queue.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(mpmc_queue, push_pop_fifo) {
+    abel::mpmc_queue<int> q(4);
+    EXPECT_EQ(q.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(q.try_push(i));
+    }
+    EXPECT_FALSE(q.try_push(4));
+    EXPECT_EQ(q.size(), 4u);
+    int v = -1;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(q.try_pop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(q.try_pop(v));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(mpmc_queue, wraps_around) {
+    abel::mpmc_queue<std::string> q(2);
+    std::string v;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(q.try_emplace(2, static_cast<char>('a' + i % 26)));
+        EXPECT_TRUE(q.try_pop(v));
+        EXPECT_EQ(v, std::string(2, static_cast<char>('a' + i % 26)));
+    }
+}
+
+TEST(mpmc_queue, failed_push_keeps_argument) {
+    abel::mpmc_queue<std::unique_ptr<int>> q(2);
+    EXPECT_TRUE(q.try_push(std::unique_ptr<int>(new int(1))));
+    EXPECT_TRUE(q.try_push(std::unique_ptr<int>(new int(2))));
+    std::unique_ptr<int> p(new int(3));
+    EXPECT_FALSE(q.try_push(std::move(p)));
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(*p, 3);
+}
+
+TEST(mpmc_queue, bulk) {
+    abel::mpmc_queue<std::string> q(8);
+    std::vector<std::string> in;
+    for (int i = 0; i < 10; ++i) {
+        in.push_back(std::to_string(i));
+    }
+    // Copying a string may throw, so this takes the element-wise path.
+    EXPECT_EQ(q.try_push_n(in.begin(), in.size()), 8u);
+    std::vector<std::string> out(10);
+    EXPECT_EQ(q.try_pop_n(out.begin(), 3), 3u);
+    EXPECT_EQ(q.try_push_n(std::make_move_iterator(in.begin() + 8), 2), 2u);
+    EXPECT_EQ(q.try_pop_n(out.begin() + 3, 10), 7u);
+    EXPECT_EQ(out[9], "9");
+    EXPECT_EQ(out[0], "0");
+    EXPECT_EQ(q.try_pop_n(out.begin(), 10), 0u);
+
+    abel::mpmc_queue<int> ints(4);
+    int values[] = {1, 2, 3, 4, 5};
+    EXPECT_EQ(ints.try_push_n(values, 5), 4u);
+    int got[5] = {0};
+    EXPECT_EQ(ints.try_pop_n(got, 5), 4u);
+    EXPECT_EQ(got[3], 4);
+}
+
+TEST(mpmc_queue, destroys_remaining) {
+    auto counter = std::make_shared<int>(0);
+    {
+        abel::mpmc_queue<std::shared_ptr<int>> q(4);
+        q.try_push(counter);
+        q.try_push(counter);
+        EXPECT_EQ(counter.use_count(), 3);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(mpmc_queue, many_threads) {
+    const int kThreads = 3;
+    const int kPerThread = 30000;
+    abel::mpmc_queue<int> q(32);
+    std::atomic<long> sum(0);
+    std::atomic<int> consumed(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            int i = 0;
+            while (i < kPerThread) {
+                int v[2] = {t * kPerThread + i, t * kPerThread + i + 1};
+                size_t n;
+                if (i % 2 == 0 && i + 1 < kPerThread) {
+                    n = q.try_push_n(v, 2);
+                } else {
+                    n = q.try_push(v[0]) ? 1 : 0;
+                }
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                i += static_cast<int>(n);
+            }
+        });
+        threads.emplace_back([&] {
+            int v[4];
+            while (consumed.load() < kThreads * kPerThread) {
+                size_t n = q.try_pop_n(v, 4);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                for (size_t j = 0; j < n; ++j) {
+                    sum += v[j];
+                }
+                consumed += static_cast<int>(n);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    const long total = static_cast<long>(kThreads) * kPerThread;
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+    EXPECT_TRUE(q.empty());
+}
@@ -0,0 +1,72 @@
+//
+
+#include <abel/container/packed_int_vector.h>
+
+#include <random>
+#include <vector>
+
+#include <abel/container/internal/bit_packing.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(packed_int_vector, widths) {
+    std::mt19937_64 rng(1);
+    for (unsigned bits = 1; bits <= 64; ++bits) {
+        const uint64_t mask = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+        std::vector<uint64_t> expect(300);
+        abel::packed_int_vector v(expect.size(), bits);
+        EXPECT_EQ(v.max_value(), mask);
+        for (size_t i = 0; i < expect.size(); ++i) {
+            expect[i] = rng() & mask;
+            v.set(i, expect[i]);
+        }
+        // Overwrite every third value to check that neighbours are kept.
+        for (size_t i = 0; i < expect.size(); i += 3) {
+            expect[i] = ~expect[i] & mask;
+            v.set(i, expect[i]);
+        }
+        for (size_t i = 0; i < expect.size(); ++i) {
+            ASSERT_EQ(v[i], expect[i]) << bits << " " << i;
+        }
+        EXPECT_LE(v.memory_bytes(), (expect.size() * bits + 63) / 64 * 8 + 8);
+    }
+}
+
+TEST(packed_int_vector, from_and_resize) {
+    const std::vector<uint64_t> values = {3, 1, 4, 1, 5, 9, 2, 6};
+    abel::packed_int_vector v = abel::packed_int_vector::from(values.data(), values.size());
+    EXPECT_EQ(v.bits(), 4u);
+    EXPECT_EQ(v.size(), values.size());
+    std::vector<uint64_t> out(values.size());
+    v.decode(0, values.size(), out.data());
+    EXPECT_EQ(out, values);
+
+    v.push_back(15);
+    EXPECT_EQ(v.size(), 9u);
+    EXPECT_EQ(v.get(8), 15u);
+    v.resize(2);
+    v.resize(9);
+    EXPECT_EQ(v.get(5), 0u);
+    EXPECT_EQ(v.get(1), 1u);
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(bit_packing, round_trip) {
+    std::mt19937 rng(2);
+    for (unsigned bits = 0; bits <= 32; ++bits) {
+        std::vector<uint32_t> in(abel::container_internal::kPackedBlockSize);
+        for (auto &x : in) {
+            x = bits == 0 ? 0 : static_cast<uint32_t>(rng()) >> (32 - bits);
+        }
+        std::vector<uint32_t> packed(abel::container_internal::packed_block_words(bits) + 1, 0xdeadbeef);
+        abel::container_internal::pack_block(in.data(), bits, packed.data());
+        EXPECT_EQ(packed.back(), 0xdeadbeef) << bits;
+        std::vector<uint32_t> out(in.size(), 7);
+        abel::container_internal::unpack_block(packed.data(), bits, out.data());
+        EXPECT_EQ(out, in) << bits;
+    }
+}
+
+}  // namespace
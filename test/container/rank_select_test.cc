@@ -0,0 +1,92 @@
+//
+
+#include <abel/container/rank_select.h>
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+// Checks rank and select at every position against a plain scan.
+void check (const abel::rank_select &index, const abel::dynamic_bitset &bits) {
+    ASSERT_EQ(index.size(), bits.size());
+    size_t ones = 0;
+    size_t zeros = 0;
+    for (size_t i = 0; i < bits.size(); ++i) {
+        ASSERT_EQ(index.rank1(i), ones) << i;
+        ASSERT_EQ(index.rank0(i), zeros) << i;
+        if (bits[i]) {
+            ASSERT_EQ(index.select1(ones), i) << ones;
+            ++ones;
+        } else {
+            ASSERT_EQ(index.select0(zeros), i) << zeros;
+            ++zeros;
+        }
+    }
+    EXPECT_EQ(index.rank1(bits.size()), ones);
+    EXPECT_EQ(index.num_ones(), ones);
+    EXPECT_EQ(index.num_zeros(), zeros);
+    EXPECT_EQ(index.select1(ones), abel::rank_select::npos);
+    EXPECT_EQ(index.select0(zeros), abel::rank_select::npos);
+}
+
+TEST(rank_select, densities) {
+    std::mt19937_64 rng(7);
+    for (size_t n : {0, 1, 64, 511, 512, 513, 4096, 100000}) {
+        for (int density : {0, 1, 50, 99, 100}) {
+            abel::dynamic_bitset bits(n);
+            for (size_t i = 0; i < n; ++i) {
+                bits.set(i, static_cast<int>(rng() % 100) < density);
+            }
+            abel::rank_select index(bits);
+            check(index, bits);
+        }
+    }
+}
+
+TEST(rank_select, sparse) {
+    // Large gaps between set bits cross many blocks between select hints.
+    abel::dynamic_bitset bits(1 << 20);
+    for (size_t i = 0; i < bits.size(); i += 4099) {
+        bits.set(i);
+    }
+    abel::rank_select index(bits);
+    check(index, bits);
+}
+
+TEST(rank_select, default_constructed) {
+    const abel::dynamic_bitset empty;
+    abel::rank_select index;
+    check(index, empty);
+    // It serializes like an index over an empty bitset.
+    std::vector<uint64_t> buf(index.serialized_size() / sizeof(uint64_t));
+    index.serialize(buf.data());
+    abel::rank_select mapped;
+    ASSERT_TRUE(abel::rank_select::map(buf.data(), index.serialized_size(), &mapped));
+    check(mapped, empty);
+}
+
+TEST(rank_select, serialize) {
+    std::mt19937_64 rng(9);
+    abel::dynamic_bitset bits(50000);
+    for (size_t i = 0; i < bits.size(); ++i) {
+        bits.set(i, rng() % 3 == 0);
+    }
+    abel::rank_select index(bits);
+    std::vector<uint64_t> buf(index.serialized_size() / sizeof(uint64_t));
+    index.serialize(buf.data());
+
+    abel::rank_select mapped;
+    ASSERT_TRUE(abel::rank_select::map(buf.data(), index.serialized_size(), &mapped));
+    EXPECT_EQ(mapped.bits(), bits);
+    EXPECT_NE(mapped.bits().data(), bits.data());
+    check(mapped, bits);
+
+    abel::rank_select moved(std::move(mapped));
+    EXPECT_EQ(moved.select1(100), index.select1(100));
+    EXPECT_FALSE(abel::rank_select::map(buf.data(), index.serialized_size() - 8, &mapped));
+}
+
+}  // namespace
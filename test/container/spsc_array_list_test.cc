@@ -0,0 +1,100 @@
+//
+
+#include <gtest/gtest.h>
+#include <abel/container/spsc_array_list.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(spsc_array_list, push_pop) {
+    abel::spsc_array_list<std::string, 4> list;
+    EXPECT_TRUE(list.empty());
+    std::string v;
+    EXPECT_FALSE(list.try_pop_front(v));
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(std::to_string(i));
+    }
+    EXPECT_FALSE(list.empty());
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(list.try_pop_front(v));
+        EXPECT_EQ(v, std::to_string(i));
+    }
+    EXPECT_TRUE(list.empty());
+    EXPECT_FALSE(list.try_pop_front(v));
+    // Drained chunks are reused.
+    list.emplace_back(3, 'x');
+    ASSERT_TRUE(list.try_pop_front(v));
+    EXPECT_EQ(v, "xxx");
+}
+
+TEST(spsc_array_list, bulk) {
+    abel::spsc_array_list<int, 8> list;
+    std::vector<int> in(21);
+    for (int i = 0; i < 21; ++i) {
+        in[i] = i;
+    }
+    list.push_back(in.data(), in.data() + 5);
+    list.push_back(in.begin() + 5, in.end());
+    std::vector<int> out(21, -1);
+    EXPECT_EQ(list.pop_front(9, out.data()), 9u);
+    EXPECT_EQ(list.pop_front(100, out.begin() + 9), 12u);
+    EXPECT_EQ(out, in);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.pop_front(1, out.data()), 0u);
+}
+
+TEST(spsc_array_list, destroys_remaining) {
+    auto counter = std::make_shared<int>(0);
+    {
+        abel::spsc_array_list<std::shared_ptr<int>, 2> list;
+        for (int i = 0; i < 5; ++i) {
+            list.push_back(counter);
+        }
+        std::shared_ptr<int> p;
+        list.try_pop_front(p);
+        list.try_pop_front(p);
+        list.try_pop_front(p);
+        p.reset();
+        EXPECT_EQ(counter.use_count(), 3);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(spsc_array_list, two_threads) {
+    const int kCount = 300000;
+    abel::spsc_array_list<int, 16> list;
+    std::thread producer([&] {
+        int batch[5];
+        for (int i = 0; i < kCount;) {
+            if (i % 3 == 0) {
+                list.push_back(i++);
+            } else {
+                int n = kCount - i < 5 ? kCount - i : 5;
+                for (int j = 0; j < n; ++j) {
+                    batch[j] = i + j;
+                }
+                list.push_back(batch, batch + n);
+                i += n;
+            }
+        }
+    });
+    int expected = 0;
+    int out[7];
+    while (expected < kCount) {
+        size_t n;
+        if (expected % 2 == 0) {
+            n = list.try_pop_front(out[0]) ? 1 : 0;
+        } else {
+            n = list.pop_front(7, out);
+        }
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (size_t j = 0; j < n; ++j) {
+            ASSERT_EQ(out[j], expected++);
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(list.empty());
+}
@@ -0,0 +1,113 @@
+//
+
+#include <gtest/gtest.h>
+#include <abel/container/spsc_queue.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(spsc_queue, capacity_rounds_up) {
+    abel::spsc_queue<int> q(5);
+    EXPECT_EQ(q.capacity(), 8u);
+    EXPECT_TRUE(q.empty());
+    abel::spsc_queue<int> one(1);
+    EXPECT_EQ(one.capacity(), 2u);
+}
+
+TEST(spsc_queue, push_pop_fifo) {
+    abel::spsc_queue<int> q(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(q.try_push(i));
+    }
+    EXPECT_FALSE(q.try_push(4));
+    EXPECT_EQ(q.size(), 4u);
+    int v = -1;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(q.try_pop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(q.try_pop(v));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(spsc_queue, wraps_around) {
+    abel::spsc_queue<std::string> q(4);
+    std::string v;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(q.try_emplace(3, static_cast<char>('a' + i % 26)));
+        EXPECT_TRUE(q.try_pop(v));
+        EXPECT_EQ(v, std::string(3, static_cast<char>('a' + i % 26)));
+    }
+}
+
+TEST(spsc_queue, failed_push_keeps_argument) {
+    abel::spsc_queue<std::unique_ptr<int>> q(2);
+    EXPECT_TRUE(q.try_push(std::unique_ptr<int>(new int(1))));
+    EXPECT_TRUE(q.try_push(std::unique_ptr<int>(new int(2))));
+    std::unique_ptr<int> p(new int(3));
+    EXPECT_FALSE(q.try_push(std::move(p)));
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(*p, 3);
+}
+
+TEST(spsc_queue, bulk) {
+    abel::spsc_queue<int> q(8);
+    std::vector<int> in = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(q.try_push_n(in.begin(), in.size()), 8u);
+    EXPECT_EQ(q.try_push_n(in.begin(), in.size()), 0u);
+    std::vector<int> out(10, -1);
+    EXPECT_EQ(q.try_pop_n(out.begin(), 3), 3u);
+    EXPECT_EQ(q.try_push_n(in.begin() + 8, 2), 2u);
+    EXPECT_EQ(q.try_pop_n(out.begin() + 3, 10), 7u);
+    EXPECT_EQ(out, in);
+    EXPECT_EQ(q.try_pop_n(out.begin(), 10), 0u);
+}
+
+TEST(spsc_queue, destroys_remaining) {
+    auto counter = std::make_shared<int>(0);
+    {
+        abel::spsc_queue<std::shared_ptr<int>> q(4);
+        q.try_push(counter);
+        q.try_push(counter);
+        EXPECT_EQ(counter.use_count(), 3);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(spsc_queue, two_threads) {
+    const int kCount = 200000;
+    abel::spsc_queue<int> q(64);
+    std::thread producer([&] {
+        int i = 0;
+        while (i < kCount) {
+            int batch[7];
+            for (int j = 0; j < 7; ++j) {
+                batch[j] = i + j;
+            }
+            size_t n = kCount - i < 7 ? kCount - i : 7;
+            if (i % 3 == 0) {
+                n = q.try_push(i) ? 1 : 0;
+            } else {
+                n = q.try_push_n(batch, n);
+            }
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+            i += static_cast<int>(n);
+        }
+    });
+    int expected = 0;
+    int out[5];
+    while (expected < kCount) {
+        size_t n = q.try_pop_n(out, 5);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (size_t j = 0; j < n; ++j) {
+            ASSERT_EQ(out[j], expected++);
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(q.empty());
+}
@@ -0,0 +1,133 @@
+//
+
+#include <abel/digest/digest_file.h>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <abel/digest/md5.h>
+#include <abel/digest/sha1.h>
+#include <abel/digest/sha256.h>
+#include <abel/digest/sha512.h>
+
+namespace {
+
+std::string random_bytes (size_t size) {
+    std::string s(size, '\0');
+    uint64_t x = size * 0x9e3779b97f4a7c15ULL + 1;
+    for (char &c : s) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        c = static_cast<char>(x);
+    }
+    return s;
+}
+
+class temp_file {
+public:
+    explicit temp_file (const std::string &contents) {
+        char name[] = "/tmp/digest_file_test.XXXXXX";
+        _fd = ::mkstemp(name);
+        _path = name;
+        EXPECT_EQ(ssize_t(contents.size()), ::write(_fd, contents.data(), contents.size()));
+        ::lseek(_fd, 0, SEEK_SET);
+    }
+    ~temp_file () {
+        ::close(_fd);
+        ::unlink(_path.c_str());
+    }
+    int fd () const { return _fd; }
+    const std::string &path () const { return _path; }
+
+private:
+    int _fd;
+    std::string _path;
+};
+
+TEST(DigestFile, MatchesInMemory) {
+    // Sizes around the read block, the read-ahead window and a map window.
+    for (size_t size : {0, 1, 1000, (1 << 20) - 1, (1 << 20) + 37, (64 << 20) + 4099}) {
+        const std::string data = random_bytes(size);
+        temp_file file(data);
+
+        abel::SHA256 from_fd;
+        std::error_code ec;
+        ASSERT_TRUE(abel::digest_fd(from_fd, file.fd(), ec)) << ec.message();
+        EXPECT_EQ(abel::sha256_hex(data), from_fd.digest_hex()) << size;
+        EXPECT_EQ(off_t(size), ::lseek(file.fd(), 0, SEEK_CUR));
+
+        if (size > (2 << 20)) {
+            continue;
+        }
+        abel::MD5 md5;
+        abel::SHA1 sha1;
+        abel::SHA512 sha512;
+        ASSERT_TRUE(abel::digest_file(md5, file.path(), ec));
+        ASSERT_TRUE(abel::digest_file(sha1, file.path(), ec));
+        ASSERT_TRUE(abel::digest_file(sha512, file.path(), ec));
+        EXPECT_EQ(abel::md5_hex(data), md5.digest_hex());
+        EXPECT_EQ(abel::sha1_hex(data), sha1.digest_hex());
+        EXPECT_EQ(abel::sha512_hex(data), sha512.digest_hex());
+    }
+}
+
+TEST(DigestFile, FromCurrentOffset) {
+    const std::string data = random_bytes(5000);
+    temp_file file(data);
+    ASSERT_EQ(123, ::lseek(file.fd(), 123, SEEK_SET));
+    abel::SHA1 h;
+    h.process(data.data(), 123);
+    std::error_code ec;
+    ASSERT_TRUE(abel::digest_fd(h, file.fd(), ec));
+    EXPECT_EQ(abel::sha1_hex(data), h.digest_hex());
+}
+
+TEST(DigestFile, Pipe) {
+    const std::string data = random_bytes(300000);
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    std::thread writer([&] {
+        EXPECT_EQ(ssize_t(data.size()), ::write(fds[1], data.data(), data.size()));
+        ::close(fds[1]);
+    });
+    abel::SHA256 h;
+    std::error_code ec;
+    EXPECT_TRUE(abel::digest_fd(h, fds[0], ec));
+    writer.join();
+    ::close(fds[0]);
+    EXPECT_EQ(abel::sha256_hex(data), h.digest_hex());
+}
+
+TEST(DigestFile, Errors) {
+    abel::SHA256 h;
+    std::error_code ec;
+    EXPECT_FALSE(abel::digest_file(h, "/nonexistent/digest_file_test", ec));
+    EXPECT_EQ(std::errc::no_such_file_or_directory, ec);
+    EXPECT_FALSE(abel::digest_fd(h, -1, ec));
+    EXPECT_EQ(std::errc::bad_file_descriptor, ec);
+}
+
+TEST(DigestFile, SpanAndSinkOutput) {
+    const std::string data = random_bytes(777);
+    const abel::Span<const uint8_t> bytes(reinterpret_cast<const uint8_t *>(data.data()),
+                                          data.size());
+    abel::SHA512 h;
+    h.process(bytes);
+    std::string out = "sha512:";
+    h.digest_hex_to(out);
+    EXPECT_EQ("sha512:" + abel::sha512_hex(data), out);
+
+    abel::MD5 md5;
+    md5.process(bytes);
+    char hex[2 * abel::MD5::kDigestLength];
+    abel::char_array_sink sink(hex);
+    md5.digest_hex_uc_to(sink);
+    EXPECT_EQ(abel::md5_hex_uc(data), sink.view());
+}
+
+}  // namespace
@@ -2,6 +2,7 @@
 // Created by liyinbin on 2020/1/25.
 //
 #include <abel/digest/sha256.h>
+#include <abel/strings/cord.h>
 #include <abel/strings/hex_dump.h>
 #include <gtest/gtest.h>
 
@@ -196,3 +197,46 @@ TEST(Sha256, all) {
         EXPECT_EQ(abel::sha256_hex(abel::parse_hex_dump(p.first)), p.second);
     }
 }
+
+TEST(Sha256, cord) {
+    abel::cord c;
+    std::string flat;
+    for (int i = 0; i < 100; ++i) {
+        std::string piece(i * 37, static_cast<char>('a' + i % 26));
+        flat += piece;
+        if (i % 2 == 0) {
+            c.append(std::move(piece));
+        } else {
+            c.append(piece);
+        }
+    }
+    ASSERT_GT(c.chunk_count(), 1u);
+    abel::SHA256 chunked;
+    chunked.process(c);
+    EXPECT_EQ(abel::sha256_hex(flat), chunked.digest_hex());
+}
+
+TEST(Sha256, many) {
+    std::vector<std::string> storage;
+    for (size_t size : {0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 300, 1000, 4096, 3, 200}) {
+        storage.push_back(std::string(size, static_cast<char>('a' + size % 26)));
+    }
+    std::vector<abel::string_view> views(storage.begin(), storage.end());
+    std::vector<abel::Span<const uint8_t>> spans;
+    for (const std::string &s : storage) {
+        spans.push_back(abel::Span<const uint8_t>(
+            reinterpret_cast<const uint8_t *>(s.data()), s.size()));
+    }
+
+    std::string from_views(abel::SHA256::kDigestLength * storage.size(), '\0');
+    std::string from_spans(from_views.size(), '\0');
+    abel::sha256_many(views, reinterpret_cast<uint8_t *>(&from_views[0]));
+    abel::sha256_many(spans, reinterpret_cast<uint8_t *>(&from_spans[0]));
+    for (size_t i = 0; i < storage.size(); ++i) {
+        const std::string expected = abel::SHA256(storage[i]).digest();
+        EXPECT_EQ(expected, from_views.substr(32 * i, 32)) << storage[i].size();
+        EXPECT_EQ(expected, from_spans.substr(32 * i, 32)) << storage[i].size();
+    }
+
+    abel::sha256_many(abel::Span<const abel::string_view>(), nullptr);
+}
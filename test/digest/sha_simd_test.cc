@@ -0,0 +1,104 @@
+//
+
+#include <abel/digest/internal/sha_simd.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <abel/digest/sha1.h>
+#include <abel/digest/sha256.h>
+
+namespace {
+
+std::string random_bytes (std::mt19937 &rng, size_t size) {
+    std::string s(size, '\0');
+    for (char &c : s) {
+        c = static_cast<char>(rng());
+    }
+    return s;
+}
+
+const uint8_t *bytes (const std::string &s) {
+    return reinterpret_cast<const uint8_t *>(s.data());
+}
+
+TEST(ShaSimd, BestKernels) {
+    const abel::digest_detail::sha_kernels &best = abel::digest_detail::sha_best_kernels();
+    if (abel::digest_detail::cpu_supports_sha_ni() &&
+        abel::digest_detail::sha_ni_kernels() != nullptr) {
+        EXPECT_STREQ("sha-ni", best.name);
+    } else {
+        EXPECT_STREQ("scalar", best.name);
+    }
+}
+
+TEST(ShaSimd, ShaNiMatchesScalar) {
+    const abel::digest_detail::sha_kernels *ni = abel::digest_detail::sha_ni_kernels();
+    if (ni == nullptr || !abel::digest_detail::cpu_supports_sha_ni()) {
+        return;
+    }
+    const abel::digest_detail::sha_kernels &scalar = abel::digest_detail::sha_scalar_kernels();
+    std::mt19937 rng(7);
+    for (size_t blocks : {1, 2, 3, 16, 100}) {
+        const std::string data = random_bytes(rng, 64 * blocks);
+
+        uint32_t expected1[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+        uint32_t actual1[5];
+        std::copy(expected1, expected1 + 5, actual1);
+        scalar.sha1_blocks(expected1, bytes(data), blocks);
+        ni->sha1_blocks(actual1, bytes(data), blocks);
+        EXPECT_EQ(std::vector<uint32_t>(expected1, expected1 + 5),
+                  std::vector<uint32_t>(actual1, actual1 + 5)) << blocks;
+
+        uint32_t expected256[8];
+        for (int i = 0; i < 8; ++i) {
+            expected256[i] = static_cast<uint32_t>(rng());
+        }
+        uint32_t actual256[8];
+        std::copy(expected256, expected256 + 8, actual256);
+        scalar.sha256_blocks(expected256, bytes(data), blocks);
+        ni->sha256_blocks(actual256, bytes(data), blocks);
+        EXPECT_EQ(std::vector<uint32_t>(expected256, expected256 + 8),
+                  std::vector<uint32_t>(actual256, actual256 + 8)) << blocks;
+    }
+}
+
+TEST(ShaSimd, Avx2LanesMatchSha256) {
+    abel::digest_detail::sha256_x8_kernel kernel = abel::digest_detail::sha256_x8_avx2_kernel();
+    if (kernel == nullptr || !abel::digest_detail::cpu_supports_avx2()) {
+        return;
+    }
+    std::mt19937 rng(11);
+    // Counts that leave lanes idle, and sizes that finish at different times.
+    for (size_t count : {1, 7, 8, 9, 31, 100}) {
+        std::vector<std::string> storage;
+        for (size_t i = 0; i < count; ++i) {
+            const size_t size = i % 17 == 16 ? 5000 + rng() % 3000 : rng() % 300;
+            storage.push_back(random_bytes(rng, size));
+        }
+        std::vector<abel::string_view> messages(storage.begin(), storage.end());
+        std::string digests(abel::SHA256::kDigestLength * count, '\0');
+        abel::digest_detail::sha256_many_x8(kernel, messages,
+                                            reinterpret_cast<uint8_t *>(&digests[0]));
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(abel::SHA256(storage[i]).digest(), digests.substr(32 * i, 32))
+                << count << " " << i << " " << storage[i].size();
+        }
+    }
+}
+
+TEST(ShaSimd, Sha1AcrossBlockBoundaries) {
+    std::mt19937 rng(3);
+    const std::string data = random_bytes(rng, 1000);
+    const std::string whole = abel::SHA1(data).digest();
+    for (size_t split : {0, 1, 63, 64, 65, 128, 500, 999}) {
+        abel::SHA1 h;
+        h.process(data.data(), static_cast<uint32_t>(split));
+        h.process(data.data() + split, static_cast<uint32_t>(data.size() - split));
+        EXPECT_EQ(whole, h.digest()) << split;
+    }
+}
+
+}  // namespace
@@ -0,0 +1,172 @@
+//
+
+#include <abel/memory/biased_shared_ptr.h>
+
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+struct tracked {
+    static std::atomic<int> alive;
+    int value;
+
+    explicit tracked (int v) : value(v) { ++alive; }
+    ~tracked () { --alive; }
+};
+
+std::atomic<int> tracked::alive(0);
+
+TEST(biased_shared_ptr, owner_thread) {
+    {
+        auto p = abel::make_biased_shared<tracked>(7);
+        EXPECT_EQ(p->value, 7);
+        EXPECT_EQ(p.use_count(), 1);
+        auto q = p;
+        EXPECT_EQ(p.use_count(), 2);
+        EXPECT_TRUE(p == q);
+        abel::biased_shared_ptr<tracked> r(std::move(q));
+        EXPECT_FALSE(q);
+        EXPECT_EQ(r.use_count(), 2);
+        r = nullptr;
+        EXPECT_EQ(p.use_count(), 1);
+        EXPECT_EQ(tracked::alive, 1);
+    }
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(biased_shared_ptr, const_and_hash) {
+    auto p = abel::make_biased_shared<int>(3);
+    abel::biased_shared_ptr<const int> c = p;
+    EXPECT_TRUE(c == p);
+    EXPECT_EQ(*c, 3);
+    std::unordered_set<abel::biased_shared_ptr<int>> set;
+    set.insert(p);
+    EXPECT_EQ(set.count(p), 1u);
+}
+
+TEST(biased_shared_ptr, other_thread_drops_copy) {
+    auto p = abel::make_biased_shared<tracked>(1);
+    std::thread t([p] {
+        auto q = p;
+        EXPECT_EQ(q->value, 1);
+    });
+    t.join();
+    // The lambda's copy was counted by the owner, so dropping it on the other
+    // thread queued the object.
+    EXPECT_EQ(p.use_count(), 2);
+    abel::biased_shared_merge_queued();
+    EXPECT_EQ(p.use_count(), 1);
+    p = nullptr;
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(biased_shared_ptr, other_thread_drops_last_reference) {
+    auto p = abel::make_biased_shared<tracked>(1);
+    std::thread t([&p] {
+        auto q = std::move(p);
+    });
+    t.join();
+    // The owner still counts the reference moved away, so the object waits
+    // in its queue.
+    EXPECT_EQ(tracked::alive, 1);
+    abel::biased_shared_merge_queued();
+    EXPECT_EQ(tracked::alive, 0);
+
+    p = abel::make_biased_shared<tracked>(2);
+    std::thread t2([&p] {
+        auto q = std::move(p);
+    });
+    t2.join();
+    // Making another object processes the queue.
+    auto other = abel::make_biased_shared<tracked>(3);
+    EXPECT_EQ(tracked::alive, 1);
+}
+
+TEST(biased_shared_ptr, owner_drops_last_reference_after_others) {
+    auto p = abel::make_biased_shared<tracked>(1);
+    abel::biased_shared_ptr<tracked> copy;
+    std::thread t([&] {
+        copy = p;
+        auto q = copy;
+    });
+    t.join();
+    copy = nullptr;
+    p = nullptr;
+    abel::biased_shared_merge_queued();
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(biased_shared_ptr, owner_exits_first) {
+    abel::biased_shared_ptr<tracked> p;
+    std::thread t([&p] {
+        auto local = abel::make_biased_shared<tracked>(1);
+        p = local;
+    });
+    t.join();
+    EXPECT_EQ(p->value, 1);
+    auto q = p;
+    EXPECT_EQ(tracked::alive, 1);
+    p = nullptr;
+    q = nullptr;
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(biased_shared_ptr, queued_to_exiting_owner) {
+    std::atomic<int> stage(0);
+    abel::biased_shared_ptr<tracked> p;
+    std::thread owner([&] {
+        p = abel::make_biased_shared<tracked>(1);
+        stage = 1;
+        while (stage != 2) {
+            std::this_thread::yield();
+        }
+    });
+    while (stage != 1) {
+        std::this_thread::yield();
+    }
+    p = nullptr;
+    EXPECT_EQ(tracked::alive, 1);
+    stage = 2;
+    owner.join();
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(biased_shared_ptr, stress) {
+    constexpr int kThreads = 4;
+    constexpr int kObjects = 200;
+    std::vector<abel::biased_shared_ptr<tracked>> objects;
+    for (int i = 0; i < kObjects; ++i) {
+        objects.push_back(abel::make_biased_shared<tracked>(i));
+    }
+    std::atomic<int> copied(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&objects, &copied] {
+            std::vector<abel::biased_shared_ptr<tracked>> mine(objects);
+            ++copied;
+            for (int round = 0; round < 20; ++round) {
+                for (auto &p : mine) {
+                    auto q = p;
+                    EXPECT_GE(q->value, 0);
+                }
+            }
+        });
+    }
+    while (copied != kThreads) {
+        std::this_thread::yield();
+    }
+    // The owner lets go while the other threads still use the objects.
+    objects.clear();
+    for (auto &t : threads) {
+        t.join();
+    }
+    abel::biased_shared_merge_queued();
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+}  // namespace
@@ -0,0 +1,201 @@
+//
+
+#include <abel/memory/object_pool.h>
+#include <abel/memory/pool_allocator.h>
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <abel/container/btree_map.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(pool_allocator, size_classes) {
+    size_t prev = 0;
+    for (size_t size = 1; size <= abel::memory_internal::kPoolMaxSize; ++size) {
+        const size_t cl = abel::memory_internal::pool_size_class(size);
+        ASSERT_LT(cl, abel::memory_internal::kPoolNumClasses) << size;
+        const size_t class_size = abel::memory_internal::pool_class_size(cl);
+        ASSERT_GE(class_size, size);
+        ASSERT_EQ(class_size % abel::memory_internal::kPoolAlignment, 0u);
+        // The next smaller class is too small.
+        if (cl > 0) {
+            ASSERT_LT(abel::memory_internal::pool_class_size(cl - 1), size);
+        }
+        ASSERT_GE(cl, prev);
+        prev = cl;
+    }
+    EXPECT_EQ(prev, abel::memory_internal::kPoolNumClasses - 1);
+    EXPECT_EQ(abel::memory_internal::pool_class_size(prev), abel::memory_internal::kPoolMaxSize);
+}
+
+TEST(pool_allocator, allocate_and_reuse) {
+    std::vector<void *> blocks;
+    for (size_t size = 1; size <= 5000; size += 37) {
+        void *p = abel::pool_allocate(size);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % abel::memory_internal::kPoolAlignment, 0u);
+        std::memset(p, 0xab, size);
+        blocks.push_back(p);
+    }
+    std::set<void *> unique(blocks.begin(), blocks.end());
+    EXPECT_EQ(unique.size(), blocks.size());
+    size_t size = 1;
+    for (void *p : blocks) {
+        abel::pool_deallocate(p, size);
+        size += 37;
+    }
+
+    // A freed object is handed out again by the same thread.
+    void *p = abel::pool_allocate(64);
+    abel::pool_deallocate(p, 64);
+    EXPECT_EQ(abel::pool_allocate(64), p);
+    abel::pool_deallocate(p, 64);
+}
+
+TEST(pool_allocator, many_objects) {
+    // More than a thread cache holds, so objects go through the central lists.
+    std::vector<void *> blocks;
+    for (int i = 0; i < 100000; ++i) {
+        void *p = abel::pool_allocate(48);
+        *static_cast<int *>(p) = i;
+        blocks.push_back(p);
+    }
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(*static_cast<int *>(blocks[i]), i);
+    }
+    for (void *p : blocks) {
+        abel::pool_deallocate(p, 48);
+    }
+}
+
+TEST(pool_allocator, containers) {
+    std::list<int, abel::pool_allocator<int>> list;
+    for (int i = 0; i < 1000; ++i) {
+        list.push_back(i);
+    }
+    EXPECT_EQ(list.size(), 1000u);
+    EXPECT_EQ(list.front(), 0);
+    EXPECT_EQ(list.back(), 999);
+
+    std::map<int, std::string, std::less<int>,
+             abel::pool_allocator<std::pair<const int, std::string>>> map;
+    abel::btree_map<int, std::string, std::less<int>,
+                    abel::pool_allocator<std::pair<const int, std::string>>> btree;
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = std::to_string(i);
+        btree[i] = std::to_string(i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        map.erase(i);
+        btree.erase(i);
+    }
+    ASSERT_EQ(map.size(), btree.size());
+    auto it = btree.begin();
+    for (const auto &kv : map) {
+        EXPECT_EQ(kv.first, it->first);
+        EXPECT_EQ(kv.second, it->second);
+        ++it;
+    }
+
+    // Vectors grow past the largest class into operator new.
+    std::vector<int, abel::pool_allocator<int>> vec;
+    for (int i = 0; i < 10000; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ(vec[9999], 9999);
+
+    EXPECT_TRUE(abel::pool_allocator<int>() == abel::pool_allocator<char>());
+    EXPECT_FALSE(abel::pool_allocator<int>() != abel::pool_allocator<char>());
+}
+
+struct tracked {
+    static int alive;
+    int value;
+    char payload[40];
+
+    explicit tracked (int v) : value(v) {
+        if (v < 0) {
+            throw std::invalid_argument("negative");
+        }
+        ++alive;
+    }
+    ~tracked () { --alive; }
+};
+
+int tracked::alive = 0;
+
+TEST(object_pool, create_destroy) {
+    using pool = abel::object_pool<tracked>;
+    tracked *t = pool::create(5);
+    EXPECT_EQ(t->value, 5);
+    EXPECT_EQ(tracked::alive, 1);
+    pool::destroy(t);
+    EXPECT_EQ(tracked::alive, 0);
+    pool::destroy(nullptr);
+
+    {
+        pool::unique_ptr u = pool::make_unique(7);
+        EXPECT_EQ(u->value, 7);
+        EXPECT_EQ(tracked::alive, 1);
+    }
+    EXPECT_EQ(tracked::alive, 0);
+
+    // The memory of a throwing constructor goes back to the pool.
+    void *p = abel::pool_allocate(sizeof(tracked));
+    abel::pool_deallocate(p, sizeof(tracked));
+    EXPECT_THROW(pool::create(-1), std::invalid_argument);
+    EXPECT_EQ(tracked::alive, 0);
+    EXPECT_EQ(abel::pool_allocate(sizeof(tracked)), p);
+    abel::pool_deallocate(p, sizeof(tracked));
+}
+
+TEST(object_pool, cross_thread) {
+    using pool = abel::object_pool<tracked>;
+    constexpr int kObjects = 20000;
+    std::vector<tracked *> objects(kObjects);
+    std::thread producer([&] {
+        for (int i = 0; i < kObjects; ++i) {
+            objects[i] = pool::create(i);
+        }
+    });
+    producer.join();
+    // The producer's cache went back to the central lists when it exited.
+    std::thread consumer([&] {
+        for (int i = 0; i < kObjects; ++i) {
+            ASSERT_EQ(objects[i]->value, i);
+            pool::destroy(objects[i]);
+        }
+    });
+    consumer.join();
+    EXPECT_EQ(tracked::alive, 0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            std::vector<tracked *> mine;
+            for (int round = 0; round < 20; ++round) {
+                for (int i = 0; i < 1000; ++i) {
+                    mine.push_back(pool::create(i));
+                }
+                for (tracked *p : mine) {
+                    pool::destroy(p);
+                }
+                mine.clear();
+            }
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+}  // namespace
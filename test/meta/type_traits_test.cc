@@ -3,6 +3,7 @@
 #include <abel/meta/type_traits.h>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -1353,4 +1354,22 @@ TEST(TypeTraitsTest, IsNothrowSwappable) {
   //EXPECT_TRUE(IsNothrowSwappable<adl_namespace::SpecialNoexceptSwap>::value);
 }
 
+TEST(TypeTraitsTest, IsTriviallyRelocatable) {
+  struct Trivial {
+    int a;
+    double b;
+  };
+  struct NonTrivial {
+    NonTrivial(const NonTrivial&) {}
+  };
+  EXPECT_TRUE(abel::is_trivially_relocatable<int>::value);
+  EXPECT_TRUE(abel::is_trivially_relocatable<int*>::value);
+  EXPECT_TRUE(abel::is_trivially_relocatable<Trivial>::value);
+  EXPECT_FALSE(abel::is_trivially_relocatable<NonTrivial>::value);
+  EXPECT_TRUE(abel::is_trivially_relocatable<std::unique_ptr<int>>::value);
+  EXPECT_TRUE(abel::is_trivially_relocatable<std::shared_ptr<int>>::value);
+  EXPECT_TRUE(abel::is_trivially_relocatable<std::weak_ptr<int>>::value);
+  EXPECT_FALSE(abel::is_trivially_relocatable<std::string>::value);
+}
+
 }  // namespace
@@ -8,6 +8,7 @@
 #include <cctype>
 #include <clocale>
 #include <cstring>
+#include <random>
 #include <string>
 #include <gtest/gtest.h>
 #include <abel/base/profile.h>
@@ -45,3 +46,39 @@ TEST(AsciiStrTo, Upper) {
                    mutable_buf, abel::ascii::to_upper);
     EXPECT_STREQ("MUTABLE", mutable_buf);
 }
+
+// Every length and alignment around the vector block sizes, with all 256
+// byte values, against the ascii tables.
+TEST(AsciiStrTo, LongAndUnaligned) {
+    std::mt19937 gen(7);
+    for (size_t len = 0; len < 100; ++len) {
+        for (size_t offset = 0; offset < 4; ++offset) {
+            std::string s(offset + len, 'x');
+            for (auto &c : s) c = static_cast<char>(gen());
+            std::string lower = s.substr(offset);
+            std::string upper = lower;
+            bool ascii = true;
+            for (size_t i = 0; i < len; ++i) {
+                lower[i] = abel::ascii::to_lower(lower[i]);
+                upper[i] = abel::ascii::to_upper(upper[i]);
+                ascii = ascii && abel::ascii::is_ascii(s[offset + i]);
+            }
+            const abel::string_view view(s.data() + offset, len);
+            EXPECT_EQ(lower, abel::string_to_lower(view));
+            EXPECT_EQ(upper, abel::string_to_upper(view));
+            EXPECT_EQ(ascii, abel::string_is_ascii(view));
+        }
+    }
+}
+
+TEST(AsciiStrTo, IsAscii) {
+    EXPECT_TRUE(abel::string_is_ascii(""));
+    EXPECT_TRUE(abel::string_is_ascii("plain text"));
+    for (size_t len = 1; len < 80; ++len) {
+        for (size_t pos = 0; pos < len; ++pos) {
+            std::string s(len, 'a');
+            s[pos] = '\x80';
+            EXPECT_FALSE(abel::string_is_ascii(s)) << len << " " << pos;
+        }
+    }
+}
@@ -2,8 +2,14 @@
 
 #include <abel/strings/char_conv.h>
 
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
 #include <string>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -565,6 +571,69 @@ TEST(FromChars, TestVersusStrtof) {
     }
 }
 
+// Random digit strings of up to 25 digits, so past the 19 that are kept
+// exactly, over the whole exponent range, against strtod() and strtof().
+// Halfway cases and numbers next to the subnormal boundary are mixed in,
+// which are the ones the Eisel-Lemire fast path has to hand on.
+TEST(FromChars, RandomDigitsVersusStrtod) {
+    std::mt19937_64 rng(29);
+    std::vector<std::string> inputs = {
+        "9007199254740993", "9007199254740992.5", "9007199254740993.0000000001",
+        "2.2250738585072011e-308", "2.2250738585072012e-308",
+        "2.2250738585072014e-308", "4.9406564584124654e-324",
+        "2.4703282292062327e-324", "2.4703282292062328e-324",
+        "1.7976931348623157e308", "1.7976931348623158e308",
+        "1.7976931348623159e308", "7.038531e-26", "1.00000005960464477539062499",
+        "1.000000059604644775390625", "3.4028235677973366e38", "0.1", "0.3",
+        "123456789012345678901234567890", "1e23", "8.988465674311579e307"};
+    for (int i = 0; i < 200000; ++i) {
+        std::string digits;
+        const int n = 1 + static_cast<int>(rng() % 25);
+        for (int j = 0; j < n; ++j) {
+            digits.push_back(static_cast<char>('0' + rng() % 10));
+        }
+        const int exponent = static_cast<int>(rng() % 700) - 360;
+        inputs.push_back(abel::string_cat(digits, "e", exponent));
+    }
+    // from_chars() reports overflow with the largest finite value where
+    // strtod() returns infinity.
+    for (const std::string &input : inputs) {
+        double d = 0;
+        abel::from_chars(input.data(), input.data() + input.size(), d);
+        const double want_d = strtod(input.c_str(), nullptr);
+        if (std::isfinite(want_d)) {
+            ASSERT_EQ(want_d, d) << input;
+        } else {
+            ASSERT_EQ(std::numeric_limits<double>::max(), d) << input;
+        }
+        float f = 0;
+        abel::from_chars(input.data(), input.data() + input.size(), f);
+        const float want_f = strtof(input.c_str(), nullptr);
+        if (std::isfinite(want_f)) {
+            ASSERT_EQ(want_f, f) << input;
+        } else {
+            ASSERT_EQ(std::numeric_limits<float>::max(), f) << input;
+        }
+    }
+}
+
+// Every double printed with 17 digits, which is how most of them reach a
+// parser, comes back exactly.
+TEST(FromChars, RandomDoublesRoundTrip) {
+    std::mt19937_64 rng(31);
+    for (int i = 0; i < 200000; ++i) {
+        const uint64_t bits = rng();
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        if (!std::isfinite(d)) continue;
+        char buf[32];
+        const int len = snprintf(buf, sizeof(buf), "%.17g", d);
+        double parsed = 0;
+        abel::from_chars(buf, buf + len, parsed);
+        ASSERT_EQ(0, memcmp(&d, &parsed, sizeof(d))) << buf;
+    }
+}
+
 // Tests if two floating point values have identical bit layouts.  (EXPECT_EQ
 // is not suitable for NaN testing, since NaNs are never equal.)
 template<typename Float>
@@ -4,6 +4,9 @@
 
 #include <abel/strings/compare.h>
 #include <gtest/gtest.h>
+#include <abel/strings/ascii.h>
+#include <abel/strings/case_conv.h>
+#include <string>
 
 namespace {
 
@@ -18,4 +21,47 @@ TEST(MatchTest, EqualsIgnoreCase) {
     EXPECT_FALSE(abel::equal_case(data, "then"));
 }
 
-}
\ No newline at end of file
+TEST(MatchTest, CompareCase) {
+    EXPECT_EQ(0, abel::compare_case("", ""));
+    EXPECT_EQ(0, abel::compare_case("Hello", "hELLO"));
+    EXPECT_EQ(-1, abel::compare_case("apple", "Banana"));
+    EXPECT_EQ(+1, abel::compare_case("Cherry", "banana"));
+    EXPECT_EQ(-1, abel::compare_case("then", "the"));
+    EXPECT_EQ(+1, abel::compare_case("the", "then"));
+}
+
+// A single difference at every position of strings around the vector block
+// sizes, with letters on both sides of the case boundaries.
+TEST(MatchTest, CompareCaseLong) {
+    const std::string alphabet = "aZ@[`{09 \x80\xff";
+    for (size_t len = 1; len < 90; ++len) {
+        std::string a;
+        for (size_t i = 0; i < len; ++i) a += "The Quick Brown Fox"[i % 19];
+        std::string b = abel::string_to_lower(a);
+        EXPECT_EQ(0, abel::compare_case(a, b));
+        EXPECT_TRUE(abel::equal_case(a, b));
+        EXPECT_EQ(abel::hash_case(a), abel::hash_case(b));
+        for (size_t pos = 0; pos < len; ++pos) {
+            for (char c : alphabet) {
+                std::string d = b;
+                d[pos] = c;
+                const int ca = abel::ascii::to_lower(a[pos]);
+                const int cd = abel::ascii::to_lower(c);
+                const int expected = ca == cd ? 0 : (ca < cd ? -1 : +1);
+                EXPECT_EQ(expected, abel::compare_case(a, d)) << len << " " << pos;
+                EXPECT_EQ(expected == 0, abel::equal_case(a, d));
+            }
+        }
+    }
+}
+
+TEST(MatchTest, HashCase) {
+    EXPECT_EQ(abel::hash_case("Content-Length"), abel::hash_case("content-length"));
+    EXPECT_NE(abel::hash_case("Content-Length"), abel::hash_case("Content-Type"));
+    const std::string upper(1000, 'Q');
+    const std::string lower(1000, 'q');
+    EXPECT_EQ(abel::hash_case(upper), abel::hash_case(lower));
+    EXPECT_NE(abel::hash_case(upper), abel::hash_case(upper.substr(1)));
+}
+
+}
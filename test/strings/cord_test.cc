@@ -0,0 +1,282 @@
+//
+
+#include <abel/strings/cord.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <abel/strings/str_cat.h>
+#include <abel/strings/string_view.h>
+
+namespace {
+
+std::vector<std::string> Chunks(const abel::cord& c) {
+  std::vector<std::string> chunks;
+  for (abel::string_view chunk : c.chunks()) {
+    chunks.push_back(std::string(chunk));
+  }
+  return chunks;
+}
+
+TEST(Cord, Empty) {
+  abel::cord c;
+  EXPECT_TRUE(c.empty());
+  EXPECT_EQ(0u, c.size());
+  EXPECT_EQ(0u, c.chunk_count());
+  EXPECT_EQ("", std::string(c));
+  EXPECT_EQ("", c.flatten());
+  EXPECT_TRUE(c == "");
+  EXPECT_TRUE(c == abel::cord());
+}
+
+TEST(Cord, AppendAndPrepend) {
+  abel::cord c("world");
+  c.append("!");
+  c.prepend(", ");
+  c.prepend(std::string("Hello"));
+  EXPECT_EQ(13u, c.size());
+  EXPECT_EQ("Hello, world!", std::string(c));
+  EXPECT_EQ('H', c[0]);
+  EXPECT_EQ('w', c[7]);
+  EXPECT_EQ('!', c[12]);
+}
+
+TEST(Cord, SmallAppendsShareAChunk) {
+  abel::cord c;
+  std::string expected;
+  for (int i = 0; i < 1000; ++i) {
+    c.append("abc");
+    expected += "abc";
+  }
+  EXPECT_EQ(expected, std::string(c));
+  // Every chunk after the first holds at least as much as all before it.
+  EXPECT_LT(c.chunk_count(), 10u);
+}
+
+TEST(Cord, AdoptsLargeStrings) {
+  std::string big(1000, 'x');
+  const char* data = big.data();
+  abel::cord c(std::move(big));
+  ASSERT_EQ(1u, c.chunk_count());
+  EXPECT_EQ(data, (*c.chunks().begin()).data());
+}
+
+TEST(Cord, AppendCordSharesChunks) {
+  const std::string big(1000, 'y');
+  abel::cord a(big);
+  abel::cord b("head:");
+  b.append(a);
+  b.append(a);
+  ASSERT_EQ(3u, b.chunk_count());
+  auto it = b.chunks().begin();
+  ++it;
+  EXPECT_EQ((*a.chunks().begin()).data(), (*it).data());
+  EXPECT_EQ("head:" + big + big, std::string(b));
+
+  // Appending to `a` now cannot show through `b`.
+  a.append("tail");
+  EXPECT_EQ("head:" + big + big, std::string(b));
+  EXPECT_EQ(big + "tail", std::string(a));
+
+  // Nor to `b` through `a`.
+  b.append("more");
+  EXPECT_EQ(big + "tail", std::string(a));
+}
+
+TEST(Cord, SelfAppend) {
+  abel::cord c(std::string(300, 'z'));
+  c.append(c);
+  EXPECT_EQ(std::string(600, 'z'), std::string(c));
+  c.prepend(c);
+  EXPECT_EQ(std::string(1200, 'z'), std::string(c));
+}
+
+TEST(Cord, Subcord) {
+  abel::cord c;
+  c.append(std::string(200, 'a'));
+  c.append(std::string(200, 'b'));
+  c.append(std::string(200, 'c'));
+  const std::string flat(c);
+
+  const abel::cord whole = c.subcord(0, 10000);
+  EXPECT_EQ(flat, std::string(whole));
+  EXPECT_EQ(3u, whole.chunk_count());
+
+  const abel::cord middle = c.subcord(150, 300);
+  EXPECT_EQ(flat.substr(150, 300), std::string(middle));
+  EXPECT_EQ(3u, middle.chunk_count());
+
+  EXPECT_EQ(flat.substr(250, 10), std::string(c.subcord(250, 10)));
+  EXPECT_TRUE(c.subcord(600, 5).empty());
+  EXPECT_TRUE(c.subcord(200, 0).empty());
+}
+
+TEST(Cord, RemovePrefixAndSuffix) {
+  abel::cord c("0123456789");
+  c.append(std::string(200, 'x'));
+  c.prepend("abc");
+  c.remove_prefix(5);
+  EXPECT_EQ("23456789" + std::string(200, 'x'), std::string(c));
+  c.remove_suffix(195);
+  EXPECT_EQ("23456789xxxxx", std::string(c));
+  // A trimmed piece must not be extended in place.
+  c.append("!");
+  EXPECT_EQ("23456789xxxxx!", std::string(c));
+  c.remove_suffix(c.size());
+  EXPECT_TRUE(c.empty());
+  EXPECT_EQ(0u, c.chunk_count());
+}
+
+TEST(Cord, Flatten) {
+  abel::cord c("abc");
+  c.append(std::string(300, 'd'));
+  c.prepend("xyz");
+  const abel::cord copy = c;
+  EXPECT_EQ(3u, c.chunk_count());
+  const abel::string_view flat = c.flatten();
+  EXPECT_EQ("xyzabc" + std::string(300, 'd'), flat);
+  EXPECT_EQ(1u, c.chunk_count());
+  EXPECT_EQ(flat.data(), c.flatten().data());
+  EXPECT_EQ(3u, copy.chunk_count());
+  EXPECT_EQ(c, copy);
+}
+
+TEST(Cord, Compare) {
+  abel::cord a("abc");
+  a.append(std::string(200, 'd'));
+  abel::cord b("ab");
+  b.append("c" + std::string(200, 'd'));
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(0, a.compare(b));
+  EXPECT_TRUE(a == "abc" + std::string(200, 'd'));
+  EXPECT_TRUE("abc" + std::string(200, 'd') == a);
+
+  b.append("e");
+  EXPECT_NE(a, b);
+  EXPECT_LT(a.compare(b), 0);
+  EXPECT_GT(b.compare(a), 0);
+  EXPECT_TRUE(a < b);
+  EXPECT_LT(a.compare(abel::string_view("abd")), 0);
+  EXPECT_GT(a.compare(abel::string_view("abc")), 0);
+  EXPECT_LT(abel::cord("ab").compare(abel::string_view("abc")), 0);
+  EXPECT_TRUE(a != "abc");
+}
+
+TEST(Cord, CopyAndMove) {
+  abel::cord a("hello");
+  a.append(std::string(200, '!'));
+  abel::cord b = a;
+  abel::cord c = std::move(a);
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(b, c);
+  a = c;
+  EXPECT_EQ(b, a);
+  a = std::move(b);
+  EXPECT_EQ(c, a);
+  a = a;
+  EXPECT_EQ(c, a);
+}
+
+TEST(Cord, StringAppend) {
+  abel::cord c;
+  abel::string_append(&c, "x=", 42, ", y=", -7, ", ok=", true);
+  EXPECT_EQ("x=42, y=-7, ok=1", std::string(c));
+  EXPECT_EQ(1u, c.chunk_count());
+
+  std::string s = "prefix:";
+  abel::string_append(&s, c);
+  EXPECT_EQ("prefix:x=42, y=-7, ok=1", s);
+
+  std::ostringstream os;
+  os << c;
+  EXPECT_EQ("x=42, y=-7, ok=1", os.str());
+}
+
+// Cords that share chunks are used and dropped on different threads.
+TEST(Cord, SharedAcrossThreads) {
+  abel::cord base("shared:");
+  base.append(std::string(1000, 's'));
+  const std::string expected(base);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([base, t, &expected] {
+      for (int i = 0; i < 1000; ++i) {
+        abel::cord c = base;
+        abel::string_append(&c, "thread ", t, " round ", i);
+        c.append(base.subcord(7, 10));
+        EXPECT_EQ(expected, std::string(c.subcord(0, expected.size())));
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_EQ(expected, std::string(base));
+}
+
+// Random edits against a std::string model.
+TEST(Cord, RandomEdits) {
+  std::mt19937 rng(17);
+  abel::cord c;
+  std::string model;
+  std::vector<abel::cord> saved;
+  std::vector<std::string> saved_models;
+  for (int i = 0; i < 5000; ++i) {
+    const std::string piece(rng() % 300, static_cast<char>('a' + rng() % 26));
+    switch (rng() % 8) {
+      case 0:
+        c.append(piece);
+        model += piece;
+        break;
+      case 1:
+        c.prepend(piece);
+        model = piece + model;
+        break;
+      case 2: {
+        const size_t n = model.empty() ? 0 : rng() % (model.size() + 1);
+        c.remove_prefix(n);
+        model.erase(0, n);
+        break;
+      }
+      case 3: {
+        const size_t n = model.empty() ? 0 : rng() % (model.size() / 4 + 1);
+        c.remove_suffix(n);
+        model.resize(model.size() - n);
+        break;
+      }
+      case 4: {
+        const size_t pos = rng() % (model.size() + 1);
+        const size_t n = rng() % 500;
+        abel::cord sub = c.subcord(pos, n);
+        ASSERT_EQ(model.substr(pos, n), std::string(sub));
+        c.append(sub);
+        model += model.substr(pos, n);
+        break;
+      }
+      case 5:
+        saved.push_back(c);
+        saved_models.push_back(model);
+        break;
+      case 6:
+        c.append(std::string(piece));
+        model += piece;
+        break;
+      default:
+        if (model.size() > 100000) {
+          c = c.subcord(model.size() / 2, model.size());
+          model = model.substr(model.size() / 2);
+        }
+        break;
+    }
+    ASSERT_EQ(model.size(), c.size());
+  }
+  EXPECT_EQ(model, std::string(c));
+  for (size_t i = 0; i < saved.size(); ++i) {
+    ASSERT_EQ(saved_models[i], std::string(saved[i]));
+  }
+}
+
+}  // namespace
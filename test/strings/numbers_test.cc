@@ -257,6 +257,124 @@ void VerifySimpleAtoiBad(in_val_type in_value) {
   EXPECT_FALSE(simple_atoi(s.c_str(), &x));
 }
 
+std::string ShortestDouble(double d) {
+  char buf[abel::numbers_internal::kFastToBufferSize];
+  char* end = abel::numbers_internal::fast_double_to_buffer(d, buf);
+  EXPECT_EQ(end, buf + strlen(buf));
+  return std::string(buf, end);
+}
+
+std::string ShortestFloat(float f) {
+  char buf[abel::numbers_internal::kFastToBufferSize];
+  char* end = abel::numbers_internal::fast_float_to_buffer(f, buf);
+  EXPECT_EQ(end, buf + strlen(buf));
+  return std::string(buf, end);
+}
+
+TEST(Numbers, FastDoubleToBuffer) {
+  EXPECT_EQ("0", ShortestDouble(0.0));
+  EXPECT_EQ("-0", ShortestDouble(-0.0));
+  EXPECT_EQ("inf", ShortestDouble(std::numeric_limits<double>::infinity()));
+  EXPECT_EQ("-inf", ShortestDouble(-std::numeric_limits<double>::infinity()));
+  EXPECT_EQ("nan", ShortestDouble(std::numeric_limits<double>::quiet_NaN()));
+  EXPECT_EQ("0.1", ShortestDouble(0.1));
+  EXPECT_EQ("0.30000000000000004", ShortestDouble(0.1 + 0.2));
+  EXPECT_EQ("1", ShortestDouble(1.0));
+  EXPECT_EQ("-1.5", ShortestDouble(-1.5));
+  EXPECT_EQ("123.456", ShortestDouble(123.456));
+  EXPECT_EQ("100", ShortestDouble(100.0));
+  EXPECT_EQ("0.0001", ShortestDouble(0.0001));
+  EXPECT_EQ("1e-05", ShortestDouble(0.00001));
+  EXPECT_EQ("1.5e-07", ShortestDouble(1.5e-7));
+  EXPECT_EQ("9007199254740992", ShortestDouble(9007199254740992.0));
+  EXPECT_EQ("10000000000000000", ShortestDouble(1e16));
+  EXPECT_EQ("1e+17", ShortestDouble(1e17));
+  EXPECT_EQ("1e+21", ShortestDouble(1e21));
+  EXPECT_EQ("1e+23", ShortestDouble(1e23));
+  EXPECT_EQ("5e-324", ShortestDouble(std::numeric_limits<double>::denorm_min()));
+  EXPECT_EQ("2.2250738585072014e-308",
+            ShortestDouble(std::numeric_limits<double>::min()));
+  EXPECT_EQ("1.7976931348623157e+308",
+            ShortestDouble(std::numeric_limits<double>::max()));
+  EXPECT_EQ("-1.2345678901234567e+100", ShortestDouble(-1.2345678901234567e100));
+}
+
+TEST(Numbers, FastFloatToBuffer) {
+  EXPECT_EQ("0", ShortestFloat(0.0f));
+  EXPECT_EQ("-inf", ShortestFloat(-std::numeric_limits<float>::infinity()));
+  EXPECT_EQ("0.1", ShortestFloat(0.1f));
+  EXPECT_EQ("3.1415927", ShortestFloat(3.14159265358979f));
+  EXPECT_EQ("16777216", ShortestFloat(16777216.0f));
+  EXPECT_EQ("1e+09", ShortestFloat(1e9f));
+  EXPECT_EQ("1e-45", ShortestFloat(std::numeric_limits<float>::denorm_min()));
+  EXPECT_EQ("3.4028235e+38", ShortestFloat(std::numeric_limits<float>::max()));
+}
+
+// The fewest significant digits with which printf's correctly rounded
+// "%.*e" reads back as `d`.
+template <typename T>
+int PrintfShortestDigits(T d, int max_digits, std::string* printed) {
+  for (int p = 1; p <= max_digits; ++p) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*e", p - 1, static_cast<double>(d));
+    if (static_cast<T>(strtod(buf, nullptr)) == d ||
+        (sizeof(T) == sizeof(float) && strtof(buf, nullptr) == d)) {
+      *printed = buf;
+      return p;
+    }
+  }
+  return max_digits + 1;
+}
+
+// The significant digits of `s`, whatever its notation.
+std::string SignificantDigits(const std::string& s) {
+  std::string digits;
+  for (char c : s) {
+    if (c == 'e') break;
+    if (c >= '0' && c <= '9' && !(digits.empty() && c == '0')) {
+      digits.push_back(c);
+    }
+  }
+  while (!digits.empty() && digits.back() == '0') digits.pop_back();
+  return digits;
+}
+
+template <typename T, typename Bits>
+void CheckShortestRandom(std::string (*format)(T), int max_digits) {
+  std::mt19937_64 rng(5);
+  int differ = 0;
+  for (int i = 0; i < 100000; ++i) {
+    const Bits bits = static_cast<Bits>(rng());
+    T d;
+    memcpy(&d, &bits, sizeof(d));
+    if (!std::isfinite(d) || d == 0) continue;
+    const std::string s = format(d);
+    T back;
+    if (sizeof(T) == sizeof(float)) {
+      back = static_cast<T>(strtof(s.c_str(), nullptr));
+    } else {
+      back = static_cast<T>(strtod(s.c_str(), nullptr));
+    }
+    ASSERT_EQ(d, back) << s;
+    std::string printed;
+    const int want = PrintfShortestDigits(d, max_digits, &printed);
+    const std::string digits = SignificantDigits(s);
+    ASSERT_EQ(static_cast<int>(digits.size()), want) << s << " vs " << printed;
+    // The closest of the shortest, which is printf's unless that one does not
+    // read back and another of the same length does.
+    if (digits != SignificantDigits(printed)) ++differ;
+  }
+  EXPECT_LT(differ, 10);
+}
+
+TEST(Numbers, FastDoubleToBufferIsShortest) {
+  CheckShortestRandom<double, uint64_t>(ShortestDouble, 17);
+}
+
+TEST(Numbers, FastFloatToBufferIsShortest) {
+  CheckShortestRandom<float, uint32_t>(ShortestFloat, 9);
+}
+
 TEST(NumbersTest, Atoi) {
   // simple_atoi(abel::string_view, int32_t)
   VerifySimpleAtoiGood<int32_t>(0, 0);
@@ -400,6 +518,98 @@ TEST(NumbersTest, Atoenum) {
   VerifySimpleAtoiGood<E_biguint>(E_biguint_max32, E_biguint_max32);
 }
 
+TEST(NumbersTest, ParseIntColumn) {
+  int64_t values[8];
+  auto parse = [&values](abel::string_view text, char delimiter) {
+    return abel::parse_int_column(text, delimiter, abel::MakeSpan(values));
+  };
+  EXPECT_EQ(0u, parse("", ','));
+  ASSERT_EQ(3u, parse("17,-3,+42", ','));
+  EXPECT_EQ(17, values[0]);
+  EXPECT_EQ(-3, values[1]);
+  EXPECT_EQ(42, values[2]);
+
+  // Field widths on either side of the 8- and 16-digit blocks.
+  ASSERT_EQ(6u, parse("12345678\t123456789\t1234567890123456\t"
+                      "12345678901234567\t1577836800000000000\t0000000000000000007",
+                      '\t'));
+  EXPECT_EQ(12345678, values[0]);
+  EXPECT_EQ(123456789, values[1]);
+  EXPECT_EQ(1234567890123456, values[2]);
+  EXPECT_EQ(12345678901234567, values[3]);
+  EXPECT_EQ(1577836800000000000, values[4]);
+  EXPECT_EQ(7, values[5]);
+
+  ASSERT_EQ(2u, parse("9223372036854775807 -9223372036854775808", ' '));
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), values[0]);
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), values[1]);
+
+  // Fields simple_atoi() accepts with spaces or leading zeros past 19 digits.
+  ASSERT_EQ(3u, parse(" 5 ,00000000000000000000012, -6\n", ','));
+  EXPECT_EQ(5, values[0]);
+  EXPECT_EQ(12, values[1]);
+  EXPECT_EQ(-6, values[2]);
+
+  // Parsing stops at the first bad field.
+  EXPECT_EQ(1u, parse("1,,3", ','));
+  EXPECT_EQ(2u, parse("1,2,", ','));
+  EXPECT_EQ(1u, parse("1,2x,3", ','));
+  EXPECT_EQ(0u, parse("-", ','));
+  EXPECT_EQ(0u, parse("9223372036854775808", ','));
+  EXPECT_EQ(1u, parse("1;-9223372036854775809", ';'));
+  EXPECT_EQ(0u, parse("12345678901234567890123", ','));
+
+  // And once `out` is full.
+  EXPECT_EQ(8u, parse("1,2,3,4,5,6,7,8,9,10", ','));
+  EXPECT_EQ(8, values[7]);
+}
+
+TEST(NumbersTest, FormatInts) {
+  const int64_t values[] = {0,
+                            7,
+                            -7,
+                            42,
+                            100,
+                            12345678,
+                            -123456789,
+                            1234567890123456,
+                            1577836800000000000,
+                            std::numeric_limits<int64_t>::max(),
+                            std::numeric_limits<int64_t>::min()};
+  char buf[sizeof(values) / sizeof(values[0]) *
+           abel::kFormatIntsBytesPerValue];
+  char* end = abel::format_ints(values, ',', buf);
+  EXPECT_EQ(
+      "0,7,-7,42,100,12345678,-123456789,1234567890123456,1577836800000000000,"
+      "9223372036854775807,-9223372036854775808",
+      std::string(buf, end));
+  EXPECT_EQ(buf, abel::format_ints(abel::Span<const int64_t>(), ',', buf));
+}
+
+TEST(NumbersTest, FormatIntsRoundTrip) {
+  std::mt19937_64 rng(3);
+  std::vector<int64_t> values(10000);
+  for (int64_t& v : values) {
+    // Every width, by shifting out a random number of bits.
+    v = static_cast<int64_t>(rng()) >> (rng() % 64);
+  }
+  std::vector<char> buf(values.size() * abel::kFormatIntsBytesPerValue);
+  char* end = abel::format_ints(values, '\n', buf.data());
+  const abel::string_view text(buf.data(), end - buf.data());
+
+  size_t pos = 0;
+  for (int64_t v : values) {
+    const size_t next = std::min(text.find('\n', pos), text.size());
+    ASSERT_EQ(std::to_string(v), text.substr(pos, next - pos));
+    pos = next + 1;
+  }
+
+  std::vector<int64_t> parsed(values.size());
+  ASSERT_EQ(values.size(),
+            abel::parse_int_column(text, '\n', abel::MakeSpan(parsed)));
+  EXPECT_EQ(values, parsed);
+}
+
 TEST(stringtest, safe_strto32_base) {
   int32_t value;
   EXPECT_TRUE(safe_strto32_base("0x34234324", &value, 16));
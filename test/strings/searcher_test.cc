@@ -0,0 +1,142 @@
+
+#include <abel/strings/searcher.h>
+
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <abel/strings/internal/char_traits.h>
+#include <abel/strings/string_view.h>
+
+namespace {
+
+std::string RandomString(std::mt19937 *rng, size_t size, int alphabet) {
+  std::uniform_int_distribution<int> letter(0, alphabet - 1);
+  std::string s(size, 'a');
+  for (char &c : s) c = static_cast<char>('a' + letter(*rng));
+  return s;
+}
+
+// Small alphabets give lots of near misses and periodic needles.
+TEST(Searcher, MatchesStdFind) {
+  std::mt19937 rng(42);
+  for (int alphabet : {1, 2, 3, 26}) {
+    for (size_t m = 0; m <= 40; ++m) {
+      for (int trial = 0; trial < 20; ++trial) {
+        const std::string hay = RandomString(&rng, rng() % 300, alphabet);
+        std::string needle = RandomString(&rng, m, alphabet);
+        // Make a match likely by taking the needle from the haystack now
+        // and then.
+        if (trial % 2 == 0 && hay.size() >= m) {
+          needle = hay.substr(rng() % (hay.size() - m + 1), m);
+        }
+        const abel::searcher s(needle);
+        const abel::string_view hv(hay);
+        for (size_t pos : {size_t{0}, size_t{1}, hay.size() / 2, hay.size(),
+                           hay.size() + 1}) {
+          const size_t want = hay.find(needle, pos);
+          EXPECT_EQ(s.find(hay, pos), want)
+              << "needle=" << needle << " hay=" << hay << " pos=" << pos;
+          EXPECT_EQ(hv.find(needle, pos), want)
+              << "needle=" << needle << " hay=" << hay << " pos=" << pos;
+        }
+      }
+    }
+  }
+}
+
+// Long haystacks over one or two letters, where the filter hands long
+// needles over to the Two-Way search part way through.
+TEST(Searcher, MatchesStdFindAfterFallback) {
+  std::mt19937 rng(7);
+  for (int alphabet : {1, 2}) {
+    for (size_t m : {17, 18, 24, 33, 64, 200}) {
+      for (int trial = 0; trial < 20; ++trial) {
+        std::string hay = RandomString(&rng, 6000, alphabet);
+        std::string needle = hay.substr(rng() % (hay.size() - m), m);
+        // Mostly runs of 'a' so that almost every position is a candidate.
+        for (size_t i = 0; i < hay.size(); ++i) {
+          if (rng() % 64 != 0) hay[i] = 'a';
+        }
+        if (trial % 2 == 0) {
+          hay.replace(4000 + rng() % 1000, m, needle);
+        }
+        const abel::searcher s(needle);
+        for (size_t pos : {size_t{0}, size_t{3001}}) {
+          const size_t want = hay.find(needle, pos);
+          EXPECT_EQ(s.find(hay, pos), want) << "needle=" << needle;
+          EXPECT_EQ(abel::string_view(hay).find(needle, pos), want)
+              << "needle=" << needle;
+        }
+      }
+    }
+  }
+}
+
+TEST(Searcher, EdgeCases) {
+  const abel::searcher empty("");
+  EXPECT_EQ(empty.find(""), 0u);
+  EXPECT_EQ(empty.find("abc"), 0u);
+  EXPECT_EQ(empty.find("abc", 3), 3u);
+  EXPECT_EQ(empty.find("abc", 4), abel::string_view::npos);
+
+  const abel::searcher one("c");
+  EXPECT_EQ(one.find("abcabc"), 2u);
+  EXPECT_EQ(one.find("abcabc", 3), 5u);
+  EXPECT_EQ(one.find("ab"), abel::string_view::npos);
+
+  const abel::searcher longer("abcd");
+  EXPECT_EQ(longer.find("abc"), abel::string_view::npos);
+  EXPECT_EQ(longer.find("abcd"), 0u);
+  EXPECT_EQ(longer.find(abel::string_view("xxab\0abcd", 9)), 5u);
+  EXPECT_EQ(longer.needle(), "abcd");
+
+  // Bytes with the high bit set.
+  const abel::searcher high("\xff\x80\xff");
+  EXPECT_EQ(high.find("\x80\xff\xff\x80\x80"), abel::string_view::npos);
+  EXPECT_EQ(high.find("\x80\xff\xff\x80\xff"), 2u);
+}
+
+// Haystacks where nearly every position passes the first/last byte filter,
+// which long needles finish with the Two-Way algorithm.
+TEST(Searcher, Pathological) {
+  std::string hay(100000, 'a');
+  std::string needle(5000, 'a');
+  needle[2500] = 'b';
+  EXPECT_EQ(abel::searcher(needle).find(hay), abel::string_view::npos);
+  EXPECT_EQ(abel::string_view(hay).find(needle), abel::string_view::npos);
+
+  hay[90000] = 'b';
+  EXPECT_EQ(abel::searcher(needle).find(hay), 87500u);
+  EXPECT_EQ(abel::string_view(hay).find(needle), 87500u);
+
+  // A periodic needle, found past lots of partial matches.
+  std::string periodic;
+  for (int i = 0; i < 40; ++i) periodic += "abaab";
+  std::string text;
+  for (int i = 0; i < 5000; ++i) text += "abaab";
+  text[text.size() - 3] = 'b';
+  text += periodic;
+  EXPECT_EQ(abel::searcher(periodic).find(text), text.find(periodic));
+  EXPECT_EQ(abel::string_view(text).find(periodic), text.find(periodic));
+}
+
+TEST(Searcher, Reuse) {
+  const abel::searcher s("needle in a haystack");
+  EXPECT_EQ(s.find("a needle in a haystack"), 2u);
+  EXPECT_EQ(s.find("no needles here"), abel::string_view::npos);
+  EXPECT_EQ(s.find("needle in a haystack, needle in a haystack", 1), 22u);
+  const abel::searcher copy = s;
+  EXPECT_EQ(copy.find("xx needle in a haystack"), 3u);
+}
+
+TEST(Searcher, CharMem) {
+  const char hay[] = "the quick brown fox jumps over the lazy dog";
+  EXPECT_EQ(abel::strings_internal::char_mem(hay, sizeof(hay) - 1, "lazy", 4),
+            hay + 35);
+  EXPECT_EQ(abel::strings_internal::char_str(hay, sizeof(hay) - 1, "the"), hay);
+  EXPECT_EQ(abel::strings_internal::char_str(hay, sizeof(hay) - 1, "cat"),
+            nullptr);
+}
+
+}  // namespace
@@ -4,7 +4,9 @@
 
 #include <list>
 #include <map>
+#include <random>
 #include <tuple>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <abel/strings/str_cat.h>
@@ -327,3 +329,151 @@ TEST(string_replace_all, Inplace) {
   EXPECT_EQ(reps, 8);
   EXPECT_EQ(s, "pack my box with five dozen liquor jugs");
 }
+
+TEST(string_replacer, Basic) {
+  const abel::string_replacer replacer(
+      {{"$count", "5"}, {"$who", "Bob"}, {"#Noun", "Apples"}, {"", "x"}});
+  EXPECT_EQ(replacer.size(), 3u);
+  EXPECT_EQ("Bob bought 5 Apples. Thanks Bob!",
+            replacer.replace_all("$who bought $count #Noun. Thanks $who!"));
+  EXPECT_EQ("", replacer.replace_all(""));
+  EXPECT_EQ("$wh", replacer.replace_all("$wh"));
+
+  std::string s = "$who$who";
+  EXPECT_EQ(2, replacer.replace_all(&s));
+  EXPECT_EQ("BobBob", s);
+  EXPECT_EQ(0, replacer.replace_all(&s));
+  EXPECT_EQ("BobBob", s);
+
+  std::string out = "> ";
+  EXPECT_EQ(1, replacer.replace_all("#Noun!", &out));
+  EXPECT_EQ("> Apples!", out);
+
+  const abel::string_replacer none({{"", "x"}});
+  EXPECT_EQ("abc", none.replace_all("abc"));
+}
+
+TEST(string_replacer, LeftmostLongest) {
+  // A longer match that starts earlier wins over one found first.
+  EXPECT_EQ("[abcd]", abel::string_replacer({{"bc", "[bc]"}, {"abcd", "[abcd]"}})
+                          .replace_all("abcd"));
+  // A partial match that fails falls back to the shorter ones.
+  EXPECT_EQ("[a][bc]e", abel::string_replacer({{"bc", "[bc]"}, {"abcd", "[abcd]"},
+                                             {"a", "[a]"}})
+                          .replace_all("abce"));
+  EXPECT_EQ("x[bc]e", abel::string_replacer({{"bc", "[bc]"}, {"abcd", "[abcd]"}})
+                          .replace_all("xbce"));
+  // Replaced text is not scanned again.
+  EXPECT_EQ("xX", abel::string_replacer({{"aa", "x"}, {"a", "X"}})
+                      .replace_all("aaa"));
+  EXPECT_EQ("ab", abel::string_replacer({{"ab", "b"}}).replace_all("aab"));
+}
+
+// The reference is string_replace_all() below its threshold, which searches
+// for each pattern in turn.
+std::string ReplaceOneByOne(
+    abel::string_view s,
+    const std::vector<std::pair<std::string, std::string>>& replacements) {
+  auto subs = abel::strings_internal::find_substitutions(s, replacements);
+  std::string result;
+  abel::strings_internal::apply_substitutions(s, &subs, &result);
+  return result;
+}
+
+std::string RandomString(std::mt19937* rng, size_t size, int alphabet) {
+  std::uniform_int_distribution<int> letter(0, alphabet - 1);
+  std::string s(size, 'a');
+  for (char& c : s) c = static_cast<char>('a' + letter(*rng));
+  return s;
+}
+
+TEST(string_replacer, MatchesOneByOne) {
+  std::mt19937 rng(11);
+  // Twelve letters is more than a string_replacer skips ahead to.
+  for (int alphabet : {2, 3, 5, 12}) {
+    for (int trial = 0; trial < 200; ++trial) {
+      // Distinct patterns; DuplicatePatterns covers repeats.
+      std::map<std::string, std::string> unique;
+      const int count = 1 + rng() % 12;
+      for (int i = 0; i < count; ++i) {
+        unique[RandomString(&rng, 1 + rng() % 5, alphabet)] =
+            abel::string_cat("<", i, ">");
+      }
+      const std::vector<std::pair<std::string, std::string>> replacements(
+          unique.begin(), unique.end());
+      const abel::string_replacer replacer(replacements);
+      const std::string text = RandomString(&rng, rng() % 80, alphabet);
+      EXPECT_EQ(ReplaceOneByOne(text, replacements), replacer.replace_all(text))
+          << "text=" << text;
+    }
+  }
+}
+
+TEST(string_replacer, DuplicatePatterns) {
+  // The first replacement of a repeated pattern wins, on both sides of
+  // string_replace_all()'s threshold.
+  std::vector<std::pair<std::string, std::string>> replacements = {
+      {"a", "X"}, {"a", "YX"}, {"b", "Y"}, {"b", "Z"}};
+  EXPECT_EQ("cdXdXdXYXYdcd",
+            abel::string_replace_all("cdadadababdcd", replacements));
+  EXPECT_EQ("cdXdXdXYXYdcd",
+            abel::string_replacer(replacements).replace_all("cdadadababdcd"));
+  for (int i = 0;
+       replacements.size() <= abel::strings_internal::kReplacerThreshold; ++i) {
+    replacements.emplace_back(abel::string_cat("q", i),
+                              abel::string_cat("<", i, ">"));
+    replacements.emplace_back(abel::string_cat("q", i), "<dup>");
+  }
+  const std::string text = "cdadadababdcd q3 q5 q0";
+  EXPECT_EQ("cdXdXdXYXYdcd <3> <5> <0>",
+            abel::string_replace_all(text, replacements));
+  EXPECT_EQ("cdXdXdXYXYdcd <3> <5> <0>", ReplaceOneByOne(text, replacements));
+  EXPECT_EQ(ReplaceOneByOne(text, replacements),
+            abel::string_replacer(replacements).replace_all(text));
+
+  std::mt19937 rng(5);
+  for (int trial = 0; trial < 200; ++trial) {
+    replacements.clear();
+    const int count = 1 + rng() % 24;
+    for (int i = 0; i < count; ++i) {
+      replacements.emplace_back(RandomString(&rng, 1 + rng() % 3, 3),
+                                abel::string_cat("<", i, ">"));
+    }
+    const std::string t = RandomString(&rng, rng() % 80, 3);
+    EXPECT_EQ(ReplaceOneByOne(t, replacements),
+              abel::string_replacer(replacements).replace_all(t))
+        << "text=" << t;
+  }
+}
+
+// Enough patterns over enough bytes that the automaton is too big for one
+// dense table and follows failure links instead.
+TEST(string_replacer, LargePatternSet) {
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::map<std::string, std::string> unique;
+  while (unique.size() < 8000) {
+    std::string pattern(1 + rng() % 16, '\0');
+    for (char& c : pattern) c = static_cast<char>(byte(rng));
+    unique[pattern] = abel::string_cat("<", unique.size(), ">");
+  }
+  std::vector<std::pair<std::string, std::string>> replacements(unique.begin(),
+                                                                unique.end());
+  std::string text;
+  for (int i = 0; i < 2000; ++i) {
+    if (i % 3 == 0) {
+      text += replacements[rng() % replacements.size()].first;
+    } else {
+      text += static_cast<char>(byte(rng));
+    }
+  }
+  const std::string want = ReplaceOneByOne(text, replacements);
+  EXPECT_EQ(want, abel::string_replacer(replacements).replace_all(text));
+  EXPECT_EQ(want, abel::string_replace_all(text, replacements));
+
+  // And a set above string_replace_all()'s threshold that still fits in the
+  // dense table.
+  replacements.resize(abel::strings_internal::kReplacerThreshold + 1);
+  EXPECT_EQ(ReplaceOneByOne(text, replacements),
+            abel::string_replace_all(text, replacements));
+}
@@ -7,6 +7,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <random>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -877,6 +878,90 @@ TEST(Delimiter, by_any_char) {
 // Tests for  by_length
 //
 
+// Delimiter sets that take each path of the block classifier: one byte,
+// few or many distinct nibbles, and sets only the fallback table can hold.
+TEST(Delimiter, by_any_charMatchesFindFirstOf) {
+  const std::vector<std::string> sets = {
+      ",;",
+      " \t\r\n",
+      ",;:.|/\\-_=+*&^%$#@!?",
+      std::string("\x00\x80\xff", 3),
+      "\x01\x12\x23\x34\x45\x56\x67\x78\x89\x9a",
+      "\x01\x12\x23\x34\x45\x56\x67\x78\x89\x9a\xab\xbc\xcd\xde\xef",
+  };
+  std::mt19937 gen(5);
+  for (const std::string& set : sets) {
+    const abel::by_any_char d(set);
+    for (size_t len = 0; len < 100; ++len) {
+      std::string text(len, '\0');
+      for (char& c : text) {
+        c = gen() % 4 == 0 ? set[gen() % set.size()]
+                           : static_cast<char>(gen());
+      }
+      for (size_t pos = 0; pos <= len; pos += 7) {
+        size_t expected = abel::string_view(text).find_first_of(set, pos);
+        if (expected == abel::string_view::npos) expected = len;
+        EXPECT_EQ(text.data() + expected, d.Find(text, pos).data())
+            << len << " " << pos;
+      }
+    }
+  }
+}
+
+TEST(Split, SplitInto) {
+  abel::string_view fields[4];
+  EXPECT_EQ(3, abel::split_into("a,b;c", abel::by_any_char(",;"), fields));
+  EXPECT_EQ("a", fields[0]);
+  EXPECT_EQ("b", fields[1]);
+  EXPECT_EQ("c", fields[2]);
+
+  // The last slot keeps the rest.
+  EXPECT_EQ(4, abel::split_into("1 2 3 4 5 6", ' ', fields));
+  EXPECT_EQ("3", fields[2]);
+  EXPECT_EQ("4 5 6", fields[3]);
+
+  EXPECT_EQ(2, abel::split_into("key=value", "=", fields));
+  EXPECT_EQ("value", fields[1]);
+  EXPECT_EQ(1, abel::split_into("", ',', fields));
+  EXPECT_EQ("", fields[0]);
+  EXPECT_EQ(0, abel::split_into(abel::string_view(), ',', fields));
+  EXPECT_EQ(0, abel::split_into("a,b", ',',
+                                abel::Span<abel::string_view>()));
+  EXPECT_EQ(3, abel::split_into("abc", abel::by_any_char(""), fields));
+  EXPECT_EQ("c", fields[2]);
+}
+
+// split_into() agrees with  string_split() on long text, for any room left.
+TEST(Split, SplitIntoMatchesSplit) {
+  std::mt19937 gen(9);
+  std::string text;
+  for (int i = 0; i < 500; ++i) {
+    text += "\t,;x"[gen() % 4];
+    if (gen() % 3 == 0) text += "field";
+  }
+  const std::vector<abel::string_view> by_tab = abel::string_split(text, '\t');
+  const std::vector<abel::string_view> by_any =
+      abel::string_split(text, abel::by_any_char("\t,;"));
+  std::vector<abel::string_view> out(by_any.size() + 1);
+  EXPECT_EQ(by_tab.size(), abel::split_into(text, '\t', abel::MakeSpan(out)));
+  EXPECT_TRUE(std::equal(by_tab.begin(), by_tab.end(), out.begin()));
+  EXPECT_EQ(by_any.size(),
+            abel::split_into(text, abel::by_any_char("\t,;"),
+                             abel::MakeSpan(out)));
+  EXPECT_TRUE(std::equal(by_any.begin(), by_any.end(), out.begin()));
+
+  for (size_t room = 1; room < 40; ++room) {
+    const size_t n = abel::split_into(text, abel::by_any_char("\t,;"),
+                                      abel::MakeSpan(out.data(), room));
+    ASSERT_EQ(room, n);
+    EXPECT_TRUE(std::equal(by_any.begin(), by_any.begin() + room - 1,
+                           out.begin()));
+    EXPECT_EQ(text.data() + text.size(),
+              out[room - 1].data() + out[room - 1].size());
+    EXPECT_EQ(by_any[room - 1].data(), out[room - 1].data());
+  }
+}
+
 TEST(Delimiter,  by_length) {
   using abel:: by_length;
 
@@ -0,0 +1,150 @@
+//
+
+#include <abel/strings/string_pool.h>
+
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <abel/container/flat_hash_set.h>
+#include <abel/strings/str_cat.h>
+
+namespace {
+
+TEST(StringPool, InternReturnsSameHandle) {
+  abel::string_pool pool;
+  std::string a = "hello";
+  std::string b = "hello";
+  abel::interned_string x = pool.intern(a);
+  abel::interned_string y = pool.intern(b);
+  EXPECT_EQ(x, y);
+  EXPECT_EQ(x.data(), y.data());
+  EXPECT_NE(a.data(), x.data());
+  EXPECT_EQ("hello", x.view());
+  EXPECT_EQ("hello", x.str());
+  EXPECT_STREQ("hello", x.c_str());
+  EXPECT_EQ(5u, x.size());
+  EXPECT_NE(x, pool.intern("world"));
+  EXPECT_EQ(2u, pool.size());
+}
+
+TEST(StringPool, EmptyString) {
+  abel::string_pool pool;
+  abel::interned_string empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(0u, empty.size());
+  EXPECT_STREQ("", empty.c_str());
+  EXPECT_EQ(0u, empty.id());
+  EXPECT_EQ(empty, pool.intern(""));
+  EXPECT_EQ(empty, pool.intern(abel::string_view()));
+  EXPECT_EQ(0u, pool.size());
+
+  abel::string_pool other;
+  EXPECT_EQ(pool.intern(""), other.intern(""));
+}
+
+TEST(StringPool, EmbeddedNul) {
+  abel::string_pool pool;
+  const std::string s("a\0b", 3);
+  abel::interned_string x = pool.intern(s);
+  EXPECT_EQ(s, x.str());
+  EXPECT_NE(x, pool.intern("a"));
+}
+
+TEST(StringPool, Ids) {
+  abel::string_pool pool;
+  EXPECT_EQ(1u, pool.intern("one").id());
+  EXPECT_EQ(2u, pool.intern("two").id());
+  EXPECT_EQ(1u, pool.intern("one").id());
+  EXPECT_EQ(3u, pool.intern("three").id());
+}
+
+TEST(StringPool, Find) {
+  abel::string_pool pool;
+  EXPECT_FALSE(pool.find("x").has_value());
+  abel::interned_string x = pool.intern("x");
+  ASSERT_TRUE(pool.find("x").has_value());
+  EXPECT_EQ(x, *pool.find("x"));
+  EXPECT_FALSE(pool.find("y").has_value());
+  ASSERT_TRUE(pool.find("").has_value());
+  EXPECT_TRUE(pool.find("")->empty());
+  EXPECT_EQ(1u, pool.size());
+}
+
+TEST(StringPool, LongStrings) {
+  abel::string_pool pool;
+  const std::string big(1 << 20, 'z');
+  abel::interned_string x = pool.intern(big);
+  EXPECT_EQ(big, x.str());
+  EXPECT_EQ(x, pool.intern(big));
+  EXPECT_NE(x, pool.intern(big.substr(1)));
+  EXPECT_GE(pool.memory_usage(), 2 * big.size());
+}
+
+// Enough strings to grow the table several times; every handle stays valid.
+TEST(StringPool, Growth) {
+  abel::string_pool pool;
+  std::vector<abel::interned_string> handles;
+  for (int i = 0; i < 100000; ++i) {
+    handles.push_back(pool.intern(abel::string_cat("key", i)));
+  }
+  EXPECT_EQ(100000u, pool.size());
+  for (int i = 0; i < 100000; ++i) {
+    const std::string key = abel::string_cat("key", i);
+    ASSERT_EQ(key, handles[i].view());
+    ASSERT_EQ(handles[i], pool.intern(key));
+    ASSERT_EQ(static_cast<uint32_t>(i + 1), handles[i].id());
+  }
+}
+
+TEST(StringPool, Hashing) {
+  abel::string_pool pool;
+  abel::flat_hash_set<abel::interned_string> set;
+  std::unordered_set<abel::interned_string> std_set;
+  for (int i = 0; i < 100; ++i) {
+    set.insert(pool.intern(abel::string_cat(i % 10)));
+    std_set.insert(pool.intern(abel::string_cat(i % 10)));
+  }
+  EXPECT_EQ(10u, set.size());
+  EXPECT_EQ(10u, std_set.size());
+  EXPECT_EQ(1u, set.count(pool.intern("7")));
+}
+
+TEST(StringPool, DefaultPool) {
+  abel::interned_string x = abel::string_pool::default_pool().intern("default");
+  EXPECT_EQ(x, abel::string_pool::default_pool().intern("default"));
+}
+
+// Threads intern overlapping keys, so lookups race with inserts and growth,
+// and must all agree on one handle per key.
+TEST(StringPool, Concurrent) {
+  abel::string_pool pool;
+  constexpr int kThreads = 8;
+  constexpr int kKeys = 20000;
+  std::vector<std::vector<abel::interned_string>> handles(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&pool, &handles, t] {
+      for (int i = 0; i < kKeys; ++i) {
+        const int key = (i * (t + 1)) % kKeys;
+        abel::interned_string s = pool.intern(abel::string_cat("k", key));
+        if (s.view() != abel::string_cat("k", key)) {
+          ADD_FAILURE() << "wrong string for k" << key;
+        }
+        handles[t].push_back(s);
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_EQ(static_cast<size_t>(kKeys), pool.size());
+  for (int t = 0; t < kThreads; ++t) {
+    for (int i = 0; i < kKeys; ++i) {
+      const int key = (i * (t + 1)) % kKeys;
+      ASSERT_EQ(pool.intern(abel::string_cat("k", key)), handles[t][i]);
+    }
+  }
+}
+
+}  // namespace
@@ -0,0 +1,168 @@
+//
+
+#include <abel/strings/string_sink.h>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <abel/format/format.h>
+#include <abel/strings/escaping.h>
+#include <abel/strings/hex_dump.h>
+#include <abel/strings/str_cat.h>
+#include <abel/strings/substitute.h>
+
+namespace {
+
+std::string ToString(const fmt::memory_buffer& buf) {
+  return std::string(buf.data(), buf.size());
+}
+
+// A user-defined target: anything with append(const char*, size_t).
+struct chunk_list {
+  void append(const char* data, size_t size) {
+    chunks.push_back(std::string(data, size));
+  }
+  std::vector<std::string> chunks;
+};
+
+TEST(StringSink, Targets) {
+  std::string s = "a";
+  abel::string_cat_to(s, "b", 1, "c");
+  EXPECT_EQ("ab1c", s);
+
+  fmt::memory_buffer buf;
+  abel::string_cat_to(buf, "x=", 42, " y=", -7);
+  EXPECT_EQ("x=42 y=-7", ToString(buf));
+
+  fmt::basic_memory_buffer<char, 4> small;
+  abel::string_cat_to(small, "longer than four bytes");
+  EXPECT_EQ("longer than four bytes", std::string(small.data(), small.size()));
+
+  chunk_list chunks;
+  abel::string_cat_to(chunks, "one", "two");
+  EXPECT_EQ((std::vector<std::string>{"one", "two"}), chunks.chunks);
+
+  abel::string_cat_to(s);
+  EXPECT_EQ("ab1c", s);
+}
+
+TEST(StringSink, CharArraySink) {
+  char storage[8];
+  abel::char_array_sink out(storage);
+  EXPECT_EQ(8u, out.capacity());
+  abel::string_cat_to(out, "abc", 12);
+  EXPECT_EQ("abc12", out.view());
+  EXPECT_FALSE(out.truncated());
+  abel::string_cat_to(out, "3456");
+  EXPECT_EQ("abc12345", out.view());
+  EXPECT_TRUE(out.truncated());
+  abel::string_cat_to(out, "7");
+  EXPECT_EQ(8u, out.size());
+
+  out.clear();
+  EXPECT_EQ("", out.view());
+  EXPECT_FALSE(out.truncated());
+  abel::string_cat_to(out, "again");
+  EXPECT_EQ("again", std::string(out.data(), out.size()));
+
+  abel::char_array_sink none(nullptr, 0);
+  abel::string_cat_to(none, "x");
+  EXPECT_EQ(0u, none.size());
+  EXPECT_TRUE(none.truncated());
+}
+
+TEST(StringSink, StringCatToMatchesStringCat) {
+  fmt::memory_buffer buf;
+  for (int i = -50; i < 50; ++i) {
+    buf.resize(0);
+    abel::string_cat_to(buf, "i=", i, " hex=", abel::hex(i * 977),
+                        " d=", i * 0.25, " b=", i % 2 == 0, "!");
+    EXPECT_EQ(abel::string_cat("i=", i, " hex=", abel::hex(i * 977), " d=",
+                               i * 0.25, " b=", i % 2 == 0, "!"),
+              ToString(buf));
+  }
+}
+
+TEST(StringSink, SubstituteTo) {
+  std::string s = ">";
+  abel::substitute_to(s, "$1 purchased $0 $2 for $$10. Thanks $1!", 5, "Bob",
+                      "Apples");
+  EXPECT_EQ(">Bob purchased 5 Apples for $10. Thanks Bob!", s);
+
+  fmt::memory_buffer buf;
+  abel::substitute_to(buf, "$0$1$2$3$4$5$6$7$8$9", 0, 1, 2, 3, 4, 5, 6, 7, 8,
+                      9);
+  EXPECT_EQ("0123456789", ToString(buf));
+
+  buf.resize(0);
+  abel::substitute_to(buf, "no args, $$ only");
+  EXPECT_EQ("no args, $ only", ToString(buf));
+
+  // More pieces than one batch.
+  buf.resize(0);
+  const std::string many = "<$0|$1|$$|$0|$1|$$|$0|$1|$$|$0|$1|$$|$0|$1|$$>";
+  abel::substitute_to(buf, many, "a", 2.5);
+  EXPECT_EQ(abel::Substitute(many, "a", 2.5), ToString(buf));
+
+  char storage[16];
+  abel::char_array_sink out(storage);
+  abel::substitute_to(out, "$0 $1", static_cast<void*>(nullptr), true);
+  EXPECT_EQ("NULL true", out.view());
+
+  std::vector<bool> bools = {true, false};
+  s.clear();
+  abel::substitute_to(s, "$0/$1", bools[0], bools[1]);
+  EXPECT_EQ("true/false", s);
+}
+
+#ifdef NDEBUG
+TEST(StringSink, SubstituteToInvalidFormat) {
+  std::string s = "kept";
+  abel::substitute_to(s, "$1", "only one");
+  abel::substitute_to(s, "trailing $");
+  EXPECT_EQ("kept", s);
+}
+#endif
+
+TEST(StringSink, HexDumpTo) {
+  std::string bytes;
+  for (int i = 0; i < 1000; ++i) bytes.push_back(static_cast<char>(i * 37));
+  fmt::memory_buffer buf;
+  abel::hex_dump_to(buf, bytes.data(), bytes.size());
+  EXPECT_EQ(abel::hex_dump(bytes), ToString(buf));
+  buf.resize(0);
+  abel::hex_dump_lc_to(buf, bytes.data(), bytes.size());
+  EXPECT_EQ(abel::hex_dump_lc(bytes), ToString(buf));
+
+  char storage[5];
+  abel::char_array_sink out(storage);
+  abel::hex_dump_to(out, "\x01\xab\xff", 3);
+  EXPECT_EQ("01ABF", out.view());
+  EXPECT_TRUE(out.truncated());
+}
+
+TEST(StringSink, EscapeTo) {
+  std::string src = "foo\rbar\tbaz\010\011\012\013\014\x0d\n\"'\\ \x7f\xc3\xa9";
+  // Long enough to cross the writer's buffer.
+  for (int i = 0; i < 200; ++i) src += static_cast<char>(i);
+
+  fmt::memory_buffer buf;
+  abel::escape_to(buf, src);
+  EXPECT_EQ(abel::escape(src), ToString(buf));
+  buf.resize(0);
+  abel::hex_escape_to(buf, src);
+  EXPECT_EQ(abel::hex_escape(src), ToString(buf));
+  buf.resize(0);
+  abel::utf8_safe_escape_to(buf, src);
+  EXPECT_EQ(abel::utf8_safe_escape(src), ToString(buf));
+  buf.resize(0);
+  abel::utf8_safe_hex_escape_to(buf, src);
+  EXPECT_EQ(abel::utf8_safe_hex_escape(src), ToString(buf));
+
+  chunk_list chunks;
+  abel::escape_to(chunks, "nothing to escape");
+  EXPECT_EQ((std::vector<std::string>{"nothing to escape"}), chunks.chunks);
+}
+
+}  // namespace
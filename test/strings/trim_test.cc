@@ -142,4 +142,32 @@ TEST(trim_complete, InPlace) {
         abel::trim_complete(&s);
         EXPECT_EQ(outputs[i], s);
     }
-}
\ No newline at end of file
+}
+
+// Whitespace runs of every length around the vector block sizes, made of
+// every ascii::is_space() byte, around text that ends in bytes near them.
+TEST(trim_all, LongRuns) {
+    const char kSpaces[] = " \t\n\v\f\r";
+    const char kNonSpaces[] = "\x08\x0e\x1f!a\x80\xff";
+    for (size_t left = 0; left < 70; left += 3) {
+        for (size_t right = 0; right < 70; right += 5) {
+            for (size_t mid = 0; mid < 40; mid += 7) {
+                std::string text;
+                for (size_t i = 0; i < mid; ++i) text += kNonSpaces[i % 7];
+                if (mid > 1) text[mid / 2] = ' ';
+                std::string s;
+                for (size_t i = 0; i < left; ++i) s += kSpaces[i % 6];
+                s += text;
+                for (size_t i = 0; i < right; ++i) s += kSpaces[(i + 3) % 6];
+
+                const std::string expected = mid == 0 ? "" : text;
+                EXPECT_EQ(expected, abel::trim_all(abel::string_view(s)));
+                std::string in_place = s;
+                EXPECT_EQ(expected, abel::trim_all(&in_place));
+                EXPECT_EQ(mid == 0 ? "" : s.substr(left), abel::trim_left(abel::string_view(s)));
+                EXPECT_EQ(s.substr(0, mid == 0 ? 0 : left + mid),
+                          abel::trim_right(abel::string_view(s)));
+            }
+        }
+    }
+}
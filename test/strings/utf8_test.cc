@@ -2,10 +2,15 @@
 #include <abel/strings/internal/utf8.h>
 
 #include <cstdint>
+#include <random>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <abel/base/profile.h>
+#include <abel/strings/internal/utf8_simd.h>
+#include <abel/strings/utf8.h>
 
 namespace {
 
@@ -50,4 +55,200 @@ TEST(EncodeUTF8Char, BasicFunction) {
 #endif
 #endif  // !defined(__cpp_char8_t)
 
+// The kernels the running CPU can use.
+std::vector<const abel::strings_internal::utf8_kernels *> SupportedKernels() {
+  using namespace abel::strings_internal;
+  std::vector<const utf8_kernels *> kernels = {&utf8_scalar_kernels()};
+  if (utf8_sse4_kernels() != nullptr && cpu_supports_sse4()) {
+    kernels.push_back(utf8_sse4_kernels());
+  }
+  if (utf8_avx2_kernels() != nullptr && cpu_supports_avx2()) {
+    kernels.push_back(utf8_avx2_kernels());
+  }
+  return kernels;
+}
+
+TEST(Utf8Validate, KnownSequences) {
+  const std::pair<std::string, bool> cases[] = {
+      {"", true},
+      {"a", true},
+      {"\xC2\x80", true},
+      {"\xDF\xBF", true},
+      {"\xE0\xA0\x80", true},
+      {"\xED\x9F\xBF", true},
+      {"\xEE\x80\x80", true},
+      {"\xEF\xBF\xBF", true},
+      {"\xF0\x90\x80\x80", true},
+      {"\xF4\x8F\xBF\xBF", true},
+      {"\x80", false},              // lone continuation
+      {"\xBF\xBF", false},          // two continuations
+      {"\xC0\x80", false},          // overlong 2-byte
+      {"\xC1\xBF", false},          // overlong 2-byte
+      {"\xC2", false},              // truncated
+      {"\xC2" "a", false},          // too short
+      {"\xC2\x80\x80", false},      // too long
+      {"\xE0\x9F\xBF", false},      // overlong 3-byte
+      {"\xE2\x82", false},          // truncated
+      {"\xED\xA0\x80", false},      // surrogate
+      {"\xED\xBF\xBF", false},      // surrogate
+      {"\xF0\x8F\xBF\xBF", false},  // overlong 4-byte
+      {"\xF0\x90\x80", false},      // truncated
+      {"\xF4\x90\x80\x80", false},  // past U+10FFFF
+      {"\xF5\x80\x80\x80", false},  // past U+10FFFF
+      {"\xF8\x88\x80\x80\x80", false},
+      {"\xFF", false},
+  };
+  for (const auto *kernels : SupportedKernels()) {
+    for (const auto &c : cases) {
+      // Move each sequence across block boundaries.
+      for (size_t before = 0; before < 70; ++before) {
+        for (size_t after : {0, 1, 2, 3, 40}) {
+          const std::string s =
+              std::string(before, 'a') + c.first + std::string(after, 'b');
+          EXPECT_EQ(kernels->validate(s.data(), s.size()), c.second)
+              << kernels->name << " " << before << " " << after;
+          EXPECT_EQ(abel::strings_internal::utf8_valid_prefix(s.data(), s.size()) == s.size(),
+                    c.second);
+        }
+      }
+    }
+  }
+}
+
+// Random text of 1- to `max_len`-byte characters, with a byte replaced at
+// random if `corrupt`.
+std::string RandomUtf8(std::mt19937 &gen, size_t chars, bool corrupt, int max_len = 4) {
+  std::string s;
+  for (size_t i = 0; i < chars; ++i) {
+    char32_t cp;
+    switch (gen() % max_len) {
+      case 0: cp = gen() % 0x80; break;
+      case 1: cp = 0x80 + gen() % (0x800 - 0x80); break;
+      case 2: cp = 0x800 + gen() % (0x10000 - 0x800); break;
+      default: cp = 0x10000 + gen() % (0x110000 - 0x10000); break;
+    }
+    if (cp >= 0xD800 && cp <= 0xDFFF) cp = 'x';
+    char buf[abel::strings_internal::kMaxEncodedUTF8Size];
+    s.append(buf, abel::strings_internal::EncodeUTF8Char(buf, cp));
+  }
+  if (corrupt && !s.empty()) {
+    s[gen() % s.size()] = static_cast<char>(gen());
+  }
+  return s;
+}
+
+TEST(Utf8Validate, RandomMatchesScalar) {
+  std::mt19937 gen(7);
+  const auto &scalar = abel::strings_internal::utf8_scalar_kernels();
+  for (int iter = 0; iter < 3000; ++iter) {
+    const std::string s = RandomUtf8(gen, gen() % 100, iter % 2 == 1);
+    const bool valid =
+        abel::strings_internal::utf8_valid_prefix(s.data(), s.size()) == s.size();
+    if (iter % 2 == 0) {
+      ASSERT_TRUE(valid) << iter;
+    }
+    for (const auto *kernels : SupportedKernels()) {
+      ASSERT_EQ(kernels->validate(s.data(), s.size()), valid) << kernels->name << " " << iter;
+      EXPECT_EQ(kernels->count_code_points(s.data(), s.size()),
+                scalar.count_code_points(s.data(), s.size()));
+      EXPECT_EQ(kernels->count_utf16_units(s.data(), s.size()),
+                scalar.count_utf16_units(s.data(), s.size()));
+    }
+  }
+}
+
+// Decodes valid UTF-8 one code point at a time, for reference.
+std::u32string DecodeReference(const std::string &s) {
+  std::u32string out;
+  for (size_t i = 0; i < s.size();) {
+    const unsigned char c = s[i];
+    const int len = c < 0x80 ? 1 : c < 0xE0 ? 2 : c < 0xF0 ? 3 : 4;
+    char32_t cp = len == 1 ? c : c & (0x7F >> len);
+    for (int k = 1; k < len; ++k) cp = (cp << 6) | (s[i + k] & 0x3F);
+    out.push_back(cp);
+    i += len;
+  }
+  return out;
+}
+
+TEST(Utf8Kernels, Transcode) {
+  std::mt19937 gen(5);
+  for (int iter = 0; iter < 2000; ++iter) {
+    // Mostly 1- and 2-byte characters, the ones the vector code handles.
+    const std::string s = std::string(gen() % 40, 'x') +
+                          RandomUtf8(gen, gen() % 60, false, iter % 4 == 0 ? 4 : 2);
+    const std::u32string expected = DecodeReference(s);
+    for (const auto *kernels : SupportedKernels()) {
+      std::u16string u16(s.size(), u'\0');
+      std::u32string u32(s.size(), U'\0');
+      size_t written16, written32;
+      const size_t consumed16 = kernels->utf8_to_utf16(s.data(), s.size(), &u16[0], &written16);
+      const size_t consumed32 = kernels->utf8_to_utf32(s.data(), s.size(), &u32[0], &written32);
+      ASSERT_EQ(consumed16, consumed32) << kernels->name;
+      ASSERT_EQ(written16, written32);
+      const std::u32string prefix = DecodeReference(s.substr(0, consumed32));
+      ASSERT_EQ(u32.substr(0, written32), prefix) << kernels->name << " " << iter;
+      ASSERT_EQ(expected.substr(0, prefix.size()), prefix);
+      ASSERT_EQ(std::u32string(u16.begin(), u16.begin() + written16), prefix);
+    }
+  }
+}
+
+TEST(Utf8Kernels, AsciiRuns) {
+  for (const auto *kernels : SupportedKernels()) {
+    for (size_t len = 0; len < 80; ++len) {
+      const std::string s = std::string(len, 'q') + "\xE2\x82\xAC" "tail";
+      EXPECT_EQ(kernels->ascii_prefix(s.data(), s.size()), len) << kernels->name;
+
+      std::u16string w16 = std::u16string(len, u'q') + u"étail";
+      std::u32string w32 = std::u32string(len, U'q') + U"\U0001F600tail";
+      std::string out(w32.size(), '\0');
+      EXPECT_EQ(kernels->utf16_ascii_to_utf8(w16.data(), w16.size(), &out[0]), len);
+      EXPECT_EQ(out.substr(0, len), std::string(len, 'q'));
+      EXPECT_EQ(kernels->utf32_ascii_to_utf8(w32.data(), w32.size(), &out[0]), len);
+    }
+  }
+}
+
+TEST(Utf8, Transcode) {
+  std::mt19937 gen(11);
+  for (int iter = 0; iter < 500; ++iter) {
+    const std::string s = RandomUtf8(gen, gen() % 200, false);
+    std::u16string u16;
+    ASSERT_TRUE(abel::utf8::to_utf16(s, &u16));
+    EXPECT_EQ(u16.size(), abel::utf8::utf16_length(s));
+    std::u32string u32;
+    ASSERT_TRUE(abel::utf8::to_utf32(s, &u32));
+    EXPECT_EQ(u32.size(), abel::utf8::count_code_points(s));
+
+    std::string back;
+    ASSERT_TRUE(abel::utf8::from_utf16(u16, &back));
+    EXPECT_EQ(back, s);
+    back.clear();
+    ASSERT_TRUE(abel::utf8::from_utf32(u32, &back));
+    EXPECT_EQ(back, s);
+  }
+
+  std::u16string u16;
+  EXPECT_TRUE(abel::utf8::to_utf16("caf\xC3\xA9 \xF0\x9F\x98\x80", &u16));
+  EXPECT_EQ(u16, u"café \U0001F600");
+  EXPECT_FALSE(abel::utf8::to_utf16("caf\xC3", &u16));
+
+  std::string out;
+  EXPECT_FALSE(abel::utf8::from_utf16(std::u16string(1, char16_t(0xD800)), &out));
+  EXPECT_FALSE(abel::utf8::from_utf16(std::u16string(1, char16_t(0xDC00)), &out));
+  EXPECT_FALSE(abel::utf8::from_utf32(std::u32string(1, char32_t(0x110000)), &out));
+  EXPECT_FALSE(abel::utf8::from_utf32(std::u32string(1, char32_t(0xDFFF)), &out));
+}
+
+TEST(Utf8, ValidPrefix) {
+  EXPECT_TRUE(abel::utf8::is_valid("abc \xE2\x82\xAC"));
+  EXPECT_EQ(abel::utf8::valid_prefix("abc \xE2\x82\xAC"), 7u);
+  EXPECT_EQ(abel::utf8::valid_prefix("abc \xE2\x82" "d"), 4u);
+  const std::string s = std::string(100, 'a') + "\xED\xA0\x80";
+  EXPECT_FALSE(abel::utf8::is_valid(s));
+  EXPECT_EQ(abel::utf8::valid_prefix(s), 100u);
+  EXPECT_NE(std::string(abel::utf8::implementation()), "");
+}
+
 }  // namespace
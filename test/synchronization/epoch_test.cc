@@ -0,0 +1,196 @@
+//
+
+#include <abel/synchronization/epoch.h>
+
+#include <atomic>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace abel {
+namespace {
+
+struct Node {
+  static std::atomic<int> live;
+
+  explicit Node(int v) : value(v), next(nullptr) { ++live; }
+  ~Node() { --live; }
+
+  int value;
+  Node* next;
+};
+
+std::atomic<int> Node::live(0);
+
+// Treiber stack reclaiming popped nodes through `domain`.
+class Stack {
+ public:
+  explicit Stack(epoch_domain* domain) : domain_(domain), head_(nullptr) {}
+  ~Stack() {
+    Node* node = head_.load();
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  void Push(int v) {
+    Node* node = new Node(v);
+    node->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  bool Pop(int* v) {
+    epoch_guard guard(*domain_);
+    Node* node = head_.load(std::memory_order_acquire);
+    while (node != nullptr &&
+           !head_.compare_exchange_weak(node, node->next,
+                                        std::memory_order_acquire,
+                                        std::memory_order_acquire)) {
+    }
+    if (node == nullptr) {
+      return false;
+    }
+    *v = node->value;
+    domain_->retire(node);
+    return true;
+  }
+
+ private:
+  epoch_domain* domain_;
+  std::atomic<Node*> head_;
+};
+
+TEST(EpochTest, GuardHoldsBackReclamation) {
+  epoch_domain domain;
+  {
+    epoch_guard guard(domain);
+    domain.retire(new Node(1));
+    domain.reclaim();
+    domain.reclaim();
+    domain.reclaim();
+    EXPECT_EQ(Node::live, 1);
+  }
+  domain.reclaim();
+  domain.reclaim();
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(EpochTest, OtherThreadGuardHoldsBackReclamation) {
+  epoch_domain domain;
+  std::atomic<int> stage(0);
+  std::thread reader([&] {
+    epoch_guard guard(domain);
+    stage = 1;
+    while (stage != 2) {
+      std::this_thread::yield();
+    }
+  });
+  while (stage != 1) {
+    std::this_thread::yield();
+  }
+  domain.retire(new Node(1));
+  for (int i = 0; i < 4; ++i) {
+    domain.reclaim();
+  }
+  EXPECT_EQ(Node::live, 1);
+  stage = 2;
+  reader.join();
+  domain.reclaim();
+  domain.reclaim();
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(EpochTest, GuardsNest) {
+  epoch_domain domain;
+  {
+    epoch_guard outer(domain);
+    {
+      epoch_guard inner(domain);
+    }
+    domain.retire(new Node(1));
+    for (int i = 0; i < 4; ++i) {
+      domain.reclaim();
+    }
+    EXPECT_EQ(Node::live, 1);
+  }
+  domain.reclaim();
+  domain.reclaim();
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(EpochTest, RetiresInBatches) {
+  epoch_domain domain;
+  for (int i = 0; i < 1000; ++i) {
+    domain.retire(new Node(i));
+  }
+  EXPECT_LT(Node::live, 1000);
+  domain.reclaim();
+  domain.reclaim();
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(EpochTest, ExitingThreadHandsOverRetired) {
+  epoch_domain domain;
+  std::thread t([&] { domain.retire(new Node(1)); });
+  t.join();
+  EXPECT_EQ(Node::live, 1);
+  domain.reclaim();
+  domain.reclaim();
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(EpochTest, DomainDestructorFreesRetired) {
+  {
+    epoch_domain domain;
+    epoch_guard guard(domain);
+    domain.retire(new Node(1));
+  }
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(EpochTest, ConcurrentStack) {
+  constexpr int kThreads = 4;
+  constexpr int kOps = 20000;
+  {
+    epoch_domain domain;
+    Stack stack(&domain);
+    std::atomic<long> pushed(0);
+    std::atomic<long> popped(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&] {
+        long sum_in = 0;
+        long sum_out = 0;
+        for (int i = 1; i <= kOps; ++i) {
+          stack.Push(i);
+          sum_in += i;
+          int v;
+          if (stack.Pop(&v)) {
+            sum_out += v;
+          }
+        }
+        pushed += sum_in;
+        popped += sum_out;
+      });
+    }
+    for (std::thread& t : threads) {
+      t.join();
+    }
+    int v;
+    long rest = 0;
+    while (stack.Pop(&v)) {
+      rest += v;
+    }
+    EXPECT_EQ(pushed.load(), popped.load() + rest);
+  }
+  EXPECT_EQ(Node::live, 0);
+}
+
+}  // namespace
+}  // namespace abel
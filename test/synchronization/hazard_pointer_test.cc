@@ -0,0 +1,211 @@
+//
+
+#include <abel/synchronization/hazard_pointer.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace abel {
+namespace {
+
+struct Node {
+  static std::atomic<int> live;
+
+  explicit Node(int v) : value(v), next(nullptr) { ++live; }
+  ~Node() { --live; }
+
+  int value;
+  Node* next;
+};
+
+std::atomic<int> Node::live(0);
+
+// Treiber stack reclaiming popped nodes through `domain`.
+class Stack {
+ public:
+  explicit Stack(hazard_pointer_domain* domain)
+      : domain_(domain), head_(nullptr) {}
+  ~Stack() {
+    Node* node = head_.load();
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  void Push(int v) {
+    Node* node = new Node(v);
+    node->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  bool Pop(int* v) {
+    hazard_pointer hp(*domain_);
+    Node* node = hp.protect(head_);
+    while (node != nullptr &&
+           !head_.compare_exchange_weak(node, node->next,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+      node = hp.protect(head_);
+    }
+    hp.reset_protection();
+    if (node == nullptr) {
+      return false;
+    }
+    *v = node->value;
+    domain_->retire(node);
+    return true;
+  }
+
+ private:
+  hazard_pointer_domain* domain_;
+  std::atomic<Node*> head_;
+};
+
+TEST(HazardPointerTest, ProtectedObjectIsKept) {
+  {
+    hazard_pointer_domain domain;
+    std::atomic<Node*> src(new Node(1));
+    hazard_pointer hp(domain);
+    Node* node = hp.protect(src);
+    EXPECT_EQ(node->value, 1);
+    src.store(nullptr);
+    domain.retire(node);
+    domain.reclaim();
+    EXPECT_EQ(Node::live, 1);
+    hp.reset_protection();
+    domain.reclaim();
+    EXPECT_EQ(Node::live, 0);
+  }
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(HazardPointerTest, TryProtectReportsChange) {
+  hazard_pointer_domain domain;
+  Node a(1);
+  Node b(2);
+  std::atomic<Node*> src(&a);
+  hazard_pointer hp(domain);
+  Node* p = src.load();
+  src.store(&b);
+  EXPECT_FALSE(hp.try_protect(p, src));
+  EXPECT_EQ(p, &b);
+  EXPECT_TRUE(hp.try_protect(p, src));
+}
+
+TEST(HazardPointerTest, RetiresInBatches) {
+  hazard_pointer_domain domain;
+  for (int i = 0; i < 1000; ++i) {
+    domain.retire(new Node(i));
+  }
+  // The batch threshold is far below 1000 with a single thread.
+  EXPECT_LT(Node::live, 1000);
+  domain.reclaim();
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(HazardPointerTest, MoreHazardPointersThanSlots) {
+  hazard_pointer_domain domain;
+  constexpr int kCount = hazard_pointer_domain::kSlotsPerThread + 4;
+  std::vector<std::unique_ptr<hazard_pointer>> hps;
+  std::vector<Node*> nodes;
+  for (int i = 0; i < kCount; ++i) {
+    std::atomic<Node*> src(new Node(i));
+    hps.emplace_back(new hazard_pointer(domain));
+    nodes.push_back(hps.back()->protect(src));
+  }
+  for (Node* node : nodes) {
+    domain.retire(node);
+  }
+  domain.reclaim();
+  EXPECT_EQ(Node::live, kCount);
+  hps.clear();
+  domain.reclaim();
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(HazardPointerTest, ExitingThreadHandsOverRetired) {
+  hazard_pointer_domain domain;
+  std::atomic<Node*> src(new Node(1));
+  hazard_pointer hp(domain);
+  Node* node = hp.protect(src);
+  std::thread t([&] {
+    domain.retire(src.exchange(nullptr));
+    domain.reclaim();
+  });
+  t.join();
+  EXPECT_EQ(Node::live, 1);
+  EXPECT_EQ(node->value, 1);
+  hp.reset_protection();
+  domain.reclaim();
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(HazardPointerTest, DomainDestructorFreesRetired) {
+  {
+    hazard_pointer_domain domain;
+    std::atomic<Node*> src(new Node(1));
+    hazard_pointer hp(domain);
+    domain.retire(hp.protect(src));
+  }
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(HazardPointerTest, ConcurrentStack) {
+  constexpr int kThreads = 4;
+  constexpr int kOps = 20000;
+  {
+    hazard_pointer_domain domain;
+    Stack stack(&domain);
+    std::atomic<long> pushed(0);
+    std::atomic<long> popped(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&] {
+        long sum_in = 0;
+        long sum_out = 0;
+        for (int i = 1; i <= kOps; ++i) {
+          stack.Push(i);
+          sum_in += i;
+          int v;
+          if (stack.Pop(&v)) {
+            sum_out += v;
+          }
+        }
+        pushed += sum_in;
+        popped += sum_out;
+      });
+    }
+    for (std::thread& t : threads) {
+      t.join();
+    }
+    int v;
+    long rest = 0;
+    while (stack.Pop(&v)) {
+      rest += v;
+    }
+    EXPECT_EQ(pushed.load(), popped.load() + rest);
+  }
+  EXPECT_EQ(Node::live, 0);
+}
+
+TEST(HazardPointerTest, DefaultDomain) {
+  std::atomic<Node*> src(new Node(1));
+  hazard_pointer hp;
+  Node* node = hp.protect(src);
+  hazard_pointer_domain::default_domain().retire(node);
+  hp.reset_protection();
+  hazard_pointer_domain::default_domain().reclaim();
+  EXPECT_EQ(Node::live, 0);
+}
+
+}  // namespace
+}  // namespace abel
@@ -1,6 +1,7 @@
 //
 
 #include <abel/synchronization/internal/per_thread_sem.h>
+#include <abel/synchronization/internal/parking_lot.h>
 
 #include <atomic>
 #include <condition_variable>  // NOLINT(build/c++11)
@@ -161,6 +162,31 @@ TEST_F(PerThreadSemTest, Timeouts) {
     EXPECT_TRUE(wait(negative_timeout));
 }
 
+// A notification that lands just as a timed ParkingLot wait expires must not
+// leave its post behind on the waiter's semaphore.
+TEST_F(PerThreadSemTest, ParkingLotTimeoutConsumesRacingPost) {
+    ParkingLot lot;
+    std::atomic<bool> done(false);
+    std::thread notifier([&] () {
+        while (!done.load(std::memory_order_relaxed)) {
+            lot.NotifyOne();
+        }
+    });
+    int stale_posts = 0;
+    for (int i = 0; i < 5000; ++i) {
+        lot.WaitUntil([] () { return false; },
+                      KernelTimeout(abel::now() + abel::microseconds(1)));
+        // The racing notifier posts after releasing the lot's lock, so give
+        // it a moment to do so.
+        if (wait(abel::now() + abel::microseconds(100))) {
+            ++stale_posts;
+        }
+    }
+    done.store(true, std::memory_order_relaxed);
+    notifier.join();
+    EXPECT_EQ(0, stale_posts);
+}
+
 }  // namespace
 
 }  // namespace synchronization_internal
@@ -0,0 +1,144 @@
+//
+
+#include <abel/synchronization/internal/reclamation.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <abel/synchronization/internal/create_thread_identity.h>
+
+namespace abel {
+namespace synchronization_internal {
+
+class ReclamationDomainPeer {
+ public:
+  // Returns the position of `domain` in the calling thread's record cache,
+  // or -1 if it is not cached.
+  static int CachedAt(const ReclamationDomain& domain) {
+    ReclamationDomain::CachedRecord* cached = ReclamationDomain::Cached();
+    for (int i = 0; i < ReclamationDomain::kCachedRecords; ++i) {
+      if (cached[i].domain_id == domain.id_) {
+        return i;
+      }
+    }
+    return -1;
+  }
+};
+
+namespace {
+
+class TestDomain : public ReclamationDomain {
+ public:
+  ~TestDomain() override { Shutdown(); }
+
+  ReclamationRecord* Current() { return CurrentRecord(); }
+  using ReclamationDomain::record_count;
+
+ private:
+  ReclamationRecord* NewRecord() override { return new ReclamationRecord(); }
+  void ResetRecord(ReclamationRecord*) override {}
+};
+
+TEST(ReclamationTest, AlternatingDomainsStayCached) {
+  TestDomain a;
+  TestDomain b;
+  ReclamationRecord* ra = a.Current();
+  ReclamationRecord* rb = b.Current();
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(ra, a.Current());
+    EXPECT_EQ(0, ReclamationDomainPeer::CachedAt(a));
+    EXPECT_EQ(1, ReclamationDomainPeer::CachedAt(b));
+    EXPECT_EQ(rb, b.Current());
+    EXPECT_EQ(0, ReclamationDomainPeer::CachedAt(b));
+    EXPECT_EQ(1, ReclamationDomainPeer::CachedAt(a));
+  }
+  EXPECT_EQ(1u, a.record_count());
+  EXPECT_EQ(1u, b.record_count());
+}
+
+TEST(ReclamationTest, LeastRecentlyUsedIsEvicted) {
+  TestDomain domains[5];
+  ReclamationRecord* records[5];
+  for (int i = 0; i < 5; ++i) {
+    records[i] = domains[i].Current();
+  }
+  EXPECT_EQ(-1, ReclamationDomainPeer::CachedAt(domains[0]));
+  for (int i = 1; i < 5; ++i) {
+    EXPECT_EQ(4 - i, ReclamationDomainPeer::CachedAt(domains[i]));
+  }
+  // Using domains[1] again makes domains[2] the least recently used.
+  EXPECT_EQ(records[1], domains[1].Current());
+  EXPECT_EQ(records[0], domains[0].Current());
+  EXPECT_EQ(-1, ReclamationDomainPeer::CachedAt(domains[2]));
+  EXPECT_EQ(records[2], domains[2].Current());
+  EXPECT_EQ(1u, domains[0].record_count());
+}
+
+TEST(ReclamationTest, ExitingThreadGivesRecordsBack) {
+  TestDomain a;
+  TestDomain b;
+  std::thread([&] {
+    a.Current();
+    b.Current();
+  }).join();
+  std::thread([&] {
+    a.Current();
+    b.Current();
+    EXPECT_EQ(0, ReclamationDomainPeer::CachedAt(b));
+  }).join();
+  EXPECT_EQ(1u, a.record_count());
+  EXPECT_EQ(1u, b.record_count());
+}
+
+struct TestHook : threading_internal::ThreadExitHook {
+  TestHook() : threading_internal::ThreadExitHook() {}
+  std::atomic<bool> ran{false};
+};
+
+TEST(ThreadExitHookTest, HooksMayRegisterAndUnregisterHooks) {
+  static TestHook first;
+  static TestHook second;
+  static TestHook removed;
+  first.on_exit = [](threading_internal::ThreadExitHook* hook) {
+    static_cast<TestHook*>(hook)->ran = true;
+    RegisterThreadExitHook(&second);
+    UnregisterThreadExitHook(&removed);
+  };
+  second.on_exit = removed.on_exit = [](threading_internal::ThreadExitHook* hook) {
+    static_cast<TestHook*>(hook)->ran = true;
+  };
+  std::thread([] {
+    // Runs after `first`, which is registered last.
+    RegisterThreadExitHook(&removed);
+    RegisterThreadExitHook(&first);
+  }).join();
+  EXPECT_TRUE(first.ran);
+  EXPECT_TRUE(second.ran);
+  EXPECT_FALSE(removed.ran);
+}
+
+TEST(ThreadExitHookTest, UnregisterWaitsForRunningHook) {
+  static std::atomic<bool> started{false};
+  static std::atomic<bool> finished{false};
+  TestHook* hook = new TestHook();
+  hook->on_exit = [](threading_internal::ThreadExitHook*) {
+    started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    finished = true;
+  };
+  std::thread t([hook] { RegisterThreadExitHook(hook); });
+  while (!started) {
+    std::this_thread::yield();
+  }
+  UnregisterThreadExitHook(hook);
+  EXPECT_TRUE(finished);
+  delete hook;
+  t.join();
+}
+
+}  // namespace
+}  // namespace synchronization_internal
+}  // namespace abel